@@ -68,6 +68,47 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include "dal.h"
 
 #include <ctype.h>
+#include <stdlib.h>
+
+// These DALs do not populate the optional checkpoint / vectored / asynchronous functions, so clear them
+// ( disabling rebuild checkpoints, and selecting the generic fallbacks for the rest )
+static DAL no_optional_ops(DAL dal)
+{
+   if (dal)
+   {
+      dal->checkpoint = NULL;
+      dal->resume = NULL;
+      dal->getv = NULL;
+      dal->putv = NULL;
+      dal->submit_get = NULL;
+      dal->submit_put = NULL;
+      dal->submit_meta = NULL;
+      dal->poll = NULL;
+      dal->wait = NULL;
+   }
+   return dal;
+}
+
+// Request of a DAL lacking asynchronous functions, holding the outcome of the op performed at submission
+typedef struct dal_sync_req_struct
+{
+   ssize_t result;
+   int err;
+} * DAL_SYNC_REQ;
+
+static DAL_REQ sync_req(ssize_t result)
+{
+   int err = errno;
+   DAL_SYNC_REQ sreq = malloc(sizeof(struct dal_sync_req_struct));
+   if (sreq == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate space for a DAL request\n");
+      return NULL;
+   }
+   sreq->result = result;
+   sreq->err = err;
+   return (DAL_REQ)sreq;
+}
 
 // Function to provide specific DAL initialization calls based on name
 DAL init_dal(xmlNode *dal_conf_root, DAL_location max_loc)
@@ -114,13 +155,17 @@ DAL init_dal(xmlNode *dal_conf_root, DAL_location max_loc)
    {
       return posix_dal_init(dal_conf_root->children, max_loc);
    }
+   else if (strncasecmp((char *)typetxt->content, "posix_uring", 12) == 0)
+   {
+      return posix_uring_dal_init(dal_conf_root->children, max_loc);
+   }
    else if (strncasecmp((char *)typetxt->content, "fuzzing", 8) == 0)
    {
-      return fuzzing_dal_init(dal_conf_root->children, max_loc);
+      return no_optional_ops(fuzzing_dal_init(dal_conf_root->children, max_loc));
    }
    else if (strncasecmp((char *)typetxt->content, "s3", 3) == 0)
    {
-      return s3_dal_init(dal_conf_root->children, max_loc);
+      return no_optional_ops(s3_dal_init(dal_conf_root->children, max_loc));
    }
 
    // if no DAL found, return NULL
@@ -128,3 +173,105 @@ DAL init_dal(xmlNode *dal_conf_root, DAL_location max_loc)
    errno = ENODEV;
    return NULL;
 }
+
+// Vectored read, falling back upon a get() per buffer
+ssize_t dal_getv(DAL dal, BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   if (dal->getv)
+   {
+      return dal->getv(ctxt, iov, iovcnt, offset);
+   }
+   ssize_t total = 0;
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      ssize_t res = dal->get(ctxt, iov[i].iov_base, iov[i].iov_len, offset + total);
+      if (res < 0)
+      {
+         // as with preadv(), only report a failure if no data was retrieved
+         return (total) ? total : res;
+      }
+      total += res;
+      if (res < iov[i].iov_len)
+      {
+         break; // end of the object
+      }
+   }
+   return total;
+}
+
+// Vectored write, falling back upon a put() per buffer
+int dal_putv(DAL dal, BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+   if (dal->putv)
+   {
+      return dal->putv(ctxt, iov, iovcnt);
+   }
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      if (iov[i].iov_len && dal->put(ctxt, iov[i].iov_base, iov[i].iov_len))
+      {
+         return -1;
+      }
+   }
+   return 0;
+}
+
+// Begin an asynchronous get(), performing it immediately if the DAL lacks asynchronous functions
+DAL_REQ dal_submit_get(DAL dal, BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
+{
+   if (dal->submit_get)
+   {
+      return dal->submit_get(ctxt, buf, size, offset);
+   }
+   return sync_req(dal->get(ctxt, buf, size, offset));
+}
+
+// Begin an asynchronous put(), performing it immediately if the DAL lacks asynchronous functions
+DAL_REQ dal_submit_put(DAL dal, BLOCK_CTXT ctxt, const void *buf, size_t size)
+{
+   if (dal->submit_put)
+   {
+      return dal->submit_put(ctxt, buf, size);
+   }
+   return sync_req((dal->put(ctxt, buf, size)) ? -1 : 0);
+}
+
+// Begin an asynchronous get_meta(), performing it immediately if the DAL lacks asynchronous functions
+DAL_REQ dal_submit_meta(DAL dal, BLOCK_CTXT ctxt, char *meta_buf, size_t size)
+{
+   if (dal->submit_meta)
+   {
+      return dal->submit_meta(ctxt, meta_buf, size);
+   }
+   return sync_req(dal->get_meta(ctxt, meta_buf, size));
+}
+
+// Check for completion of an asynchronous request
+int dal_poll(DAL dal, BLOCK_CTXT ctxt, DAL_REQ req, ssize_t *result)
+{
+   if (dal->poll)
+   {
+      return dal->poll(ctxt, req, result);
+   }
+   *result = dal_wait(dal, ctxt, req);
+   return 1;
+}
+
+// Wait for completion of an asynchronous request
+ssize_t dal_wait(DAL dal, BLOCK_CTXT ctxt, DAL_REQ req)
+{
+   if (dal->wait)
+   {
+      return dal->wait(ctxt, req);
+   }
+   DAL_SYNC_REQ sreq = (DAL_SYNC_REQ)req;
+   ssize_t result = sreq->result;
+   if (result < 0)
+   {
+      errno = sreq->err;
+   }
+   free(sreq);
+   return result;
+}
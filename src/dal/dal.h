@@ -65,6 +65,7 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <libxml/tree.h>
 #include <string.h>
 #include <errno.h>
+#include <sys/uio.h>
 
 #ifndef LIBXML_TREE_ENABLED
 #error "Included Libxml2 does not support tree functionality!"
@@ -73,6 +74,7 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 // just to provide some type safety (don't want to pass the wrong void*)
 typedef void *DAL_CTXT;
 typedef void *BLOCK_CTXT;
+typedef void *DAL_REQ;
 
 // location struct
 typedef struct DAL_location_struct
@@ -89,7 +91,8 @@ typedef enum DAL_MODE_enum
    DAL_READ = 0,    // retrieve the data and/or meta info of an object
    DAL_WRITE = 1,   // store data and/or meta info to an object
    DAL_REBUILD = 2, // same as WRITE, but with a distinct temporary location (if applicable)
-   DAL_METAREAD = 4 // retrieve the meta info of an object
+   DAL_METAREAD = 4, // retrieve the meta info of an object
+   DAL_RESUME = 8    // same as REBUILD, but continuing from the last checkpoint of an interrupted REBUILD/RESUME
 } DAL_MODE;
 
 typedef struct DAL_struct
@@ -145,32 +148,63 @@ typedef struct DAL_struct
    BLOCK_CTXT(*open)
    (DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const char *objID);
    // Description:
-   //  Open a READ/WRITE/REBUILD/META_READ handle for accessing the specified object.
+   //  Open a READ/WRITE/REBUILD/RESUME/META_READ handle for accessing the specified object.
    // Return Values:
    //  Non-NULL on success, NULL if the operation could not be completed
    int (*set_meta)(BLOCK_CTXT ctxt, const char *meta_buf, size_t size);
    // Description:
-   //  Attach the provided meta information to the object associated with the given WRITE/REBUILD BLOCK_CTXT.
+   //  Attach the provided meta information to the object associated with the given WRITE/REBUILD/RESUME BLOCK_CTXT
+   //  (replacing any checkpoint meta information).
    // Return Values:
    //  Zero on success, Non-zero if the operation could not be completed
    ssize_t (*get_meta)(BLOCK_CTXT ctxt, char *meta_buf, size_t size);
    // Description:
-   //  Retrieve the meta information of the object associated with the given READ/META_READ BLOCK_CTXT.
+   //  Retrieve the meta information of the object associated with the given READ/META_READ BLOCK_CTXT
+   //  (or the checkpoint meta information associated with the given RESUME BLOCK_CTXT).
    // Return Values:
    //  Meta byte count on success, negative if the operation could not be completed
    int (*put)(BLOCK_CTXT ctxt, const void *buf, size_t size);
    // Description:
-   //  Store data to the object associated with the given WRITE/REBUILD BLOCK_CTXT.
+   //  Store data to the object associated with the given WRITE/REBUILD/RESUME BLOCK_CTXT.
    // Return Values:
    //  Zero on success, Non-zero if the operation could not be completed
+   int (*putv)(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt);
+   // Description:
+   //  Store the contents of each of the given buffers, in order, to the object associated with the given
+   //  WRITE/REBUILD/RESUME BLOCK_CTXT.  Equivalent to a put() of each buffer in turn.
+   //  Note - this function is optional (may be NULL), in which case dal_putv() issues a put() per buffer.
+   // Return Values:
+   //  Zero on success, Non-zero if the operation could not be completed
+   int (*checkpoint)(BLOCK_CTXT ctxt, const char *meta_buf, size_t size);
+   // Description:
+   //  Durably store all data 'put' to the given REBUILD/RESUME BLOCK_CTXT thus far, along with meta information
+   //  describing that data.  If the BLOCK_CTXT is never closed (interrupted rebuild), a later RESUME BLOCK_CTXT
+   //  of the same object will retrieve this meta information via get_meta().
+   //  Note - this function is optional (may be NULL), in which case DAL_RESUME is unsupported.
+   // Return Values:
+   //  Zero on success, Non-zero if the operation could not be completed
+   int (*resume)(BLOCK_CTXT ctxt, off_t offset);
+   // Description:
+   //  Discard all data of the given RESUME BLOCK_CTXT beyond 'offset', such that subsequent 'put' calls continue
+   //  from that point.  An 'offset' of zero discards all data of the interrupted REBUILD.
+   //  Note - this function is optional (may be NULL), in which case DAL_RESUME is unsupported.
+   // Return Values:
+   //  Zero on success, Non-zero if the operation could not be completed (such as if less data exists)
    ssize_t (*get)(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
    // Description:
    //  Retrieve data from the object associated with the given READ BLOCK_CTXT.
    // Return Values:
    //  Byte count on success, Non-zero if the operation could not be completed
+   ssize_t (*getv)(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset);
+   // Description:
+   //  Retrieve contiguous data, beginning at 'offset', from the object associated with the given READ BLOCK_CTXT,
+   //  filling each of the given buffers in order.  Equivalent to a get() of each buffer in turn.
+   //  Note - this function is optional (may be NULL), in which case dal_getv() issues a get() per buffer.
+   // Return Values:
+   //  Byte count on success (short only if the object ends early), negative if the operation could not be completed
    int (*abort)(BLOCK_CTXT ctxt);
    // Description:
-   //  Abandon a given WRITE/REBUILD BLOCK_CTXT.  This is roughly equivalent to calling close() on the
+   //  Abandon a given WRITE/REBUILD/RESUME BLOCK_CTXT.  This is roughly equivalent to calling close() on the
    //  BLOCK_CTXT; however, NO data changes should be applied to the underlying object (same state as before
    //  the BLOCK_CTXT was opened).
    // Return Values:
@@ -180,14 +214,61 @@ typedef struct DAL_struct
    //  Close a given BLOCK_CTXT reference, freeing any associated resources and finalizing any data changes.
    // Return Values:
    //  Zero on success, Non-zero if the operation could not be completed
+
+   // Asynchronous DAL Functions --
+   //  These are optional, but must be provided ( or left NULL ) as a complete set.  DALs lacking them are driven
+   //  through the dal_submit_*() / dal_poll() / dal_wait() functions below, which perform each op synchronously.
+   //  Any number of requests may be outstanding against a BLOCK_CTXT, and each must be completed via poll() or
+   //  wait() prior to close() / abort() of that BLOCK_CTXT.  Puts are applied in the order of their submission.
+   DAL_REQ (*submit_get)(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
+   // Description:
+   //  Begin a get() of the given READ BLOCK_CTXT.  The buffer must remain valid until the request completes.
+   // Return Values:
+   //  A request reference on success, NULL if the operation could not be started
+   DAL_REQ (*submit_put)(BLOCK_CTXT ctxt, const void *buf, size_t size);
+   // Description:
+   //  Begin a put() to the given WRITE/REBUILD/RESUME BLOCK_CTXT.  The buffer must remain unaltered until the
+   //  request completes.
+   // Return Values:
+   //  A request reference on success, NULL if the operation could not be started
+   DAL_REQ (*submit_meta)(BLOCK_CTXT ctxt, char *meta_buf, size_t size);
+   // Description:
+   //  Begin a get_meta() of the given READ/META_READ/RESUME BLOCK_CTXT.  The buffer must remain valid until the
+   //  request completes.
+   // Return Values:
+   //  A request reference on success, NULL if the operation could not be started
+   int (*poll)(BLOCK_CTXT ctxt, DAL_REQ req, ssize_t *result);
+   // Description:
+   //  Check for completion of the given request, without blocking.  Once complete, the request reference is
+   //  freed and 'result' is populated with the value the equivalent synchronous function would have returned
+   //  ( with errno set accordingly ).
+   // Return Values:
+   //  Non-zero if the request has completed, zero if it is still in progress
+   ssize_t (*wait)(BLOCK_CTXT ctxt, DAL_REQ req);
+   // Description:
+   //  Wait for completion of the given request, then free the request reference.
+   // Return Values:
+   //  The value the equivalent synchronous function would have returned ( with errno set accordingly )
 } * DAL;
 
 // Forward decls of specific DAL initializations
 DAL posix_dal_init(xmlNode *posix_dal_conf_root, DAL_location max_loc);
+DAL posix_uring_dal_init(xmlNode *posix_uring_dal_conf_root, DAL_location max_loc);
 DAL fuzzing_dal_init(xmlNode *fuzzing_dal_conf_root, DAL_location max_loc);
 DAL s3_dal_init(xmlNode *s3_dal_conf_root, DAL_location max_loc);
 
 // Function to provide specific DAL initialization calls based on name
 DAL init_dal(xmlNode *dal_conf_root, DAL_location max_loc); // {
 
+// Vectored I/O through the given DAL, falling back upon one get()/put() per buffer for DALs lacking getv()/putv()
+ssize_t dal_getv(DAL dal, BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset);
+int dal_putv(DAL dal, BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt);
+
+// Asynchronous I/O through the given DAL, completing each op at submission for DALs lacking the asynchronous functions
+DAL_REQ dal_submit_get(DAL dal, BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
+DAL_REQ dal_submit_put(DAL dal, BLOCK_CTXT ctxt, const void *buf, size_t size);
+DAL_REQ dal_submit_meta(DAL dal, BLOCK_CTXT ctxt, char *meta_buf, size_t size);
+int dal_poll(DAL dal, BLOCK_CTXT ctxt, DAL_REQ req, ssize_t *result);
+ssize_t dal_wait(DAL dal, BLOCK_CTXT ctxt, DAL_REQ req);
+
 #endif
@@ -58,6 +58,7 @@ LANL contributions is found at https://github.com/jti-lanl/aws4c.
 GNU licenses can be found at http://www.gnu.org/licenses/.
 */
 
+#define _GNU_SOURCE // for O_DIRECT
 #include "erasureUtils_auto_config.h"
 #if defined(DEBUG_ALL) || defined(DEBUG_DAL)
 #define DEBUG 1
@@ -65,7 +66,7 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #define LOG_PREFIX "posix_dal"
 
 #include "logging/logging.h"
-#include "dal.h"
+#include "posix_dal.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -75,35 +76,7 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <pwd.h>
-
-#define SFX_PADDING 14         // number of extra chars required to fit any suffix combo
-#define WRITE_SFX ".partial"   // 8 characters
-#define REBUILD_SFX ".rebuild" // 8 characters
-#define META_SFX ".meta"       // 5 characters (in ADDITION to other suffixes!)
-
-#define IO_SIZE 1048576 // Preferred I/O Size
-
-//   -------------    POSIX CONTEXT    -------------
-
-typedef struct posix_block_context_struct
-{
-   int fd;         // File Descriptor (if open)
-   int mfd;        // Meta File Descriptor (if open)
-   int sfd;        // Secure Root File Descriptor (if open)
-   char *filepath; // File Path (if open)
-   int filelen;    // Length of filepath string
-   off_t offset;   // Current file offset (only relevant when reading)
-   DAL_MODE mode;  // Mode in which this block was opened
-} * POSIX_BLOCK_CTXT;
-
-typedef struct posix_dal_context_struct
-{
-   char *dirtmp;         // Template string for generating directory paths
-   int tmplen;           // Length of the dirtmp string
-   DAL_location max_loc; // Maximum pod/cap/block/scatter values
-   int dirpad;           // Number of chars by which dirtmp may expand via substitutions
-   int sec_root;         // Handle of secure root directory
-} * POSIX_DAL_CTXT;
+#include <stdint.h>
 
 //   -------------    POSIX INTERNAL FUNCTIONS    -------------
 
@@ -169,20 +142,36 @@ static int num_digits(int value)
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * Expand the given template string, substituting in the values of the given DAL_location
- * @param const char* parse : Template string to be parsed
- * @param char* fill : String to be populated with the expanded path
- * @param DAL_location loc : Location values to be substituted into the template
- * @param DAL_location* loc_flags : If non-NULL, flags are set for each location value referenced by the template
- * @param int dir : If non-zero, the expanded string is truncated after the final '/' character
- * @return char* : Reference to the end of the populated string, or NULL on failure
+ * Parse the dir_template string of the given context into a list of segments, each consisting of literal 
+ * text followed by an optional location value substitution, so that paths may later be produced without 
+ * re-parsing the template
+ * @param POSIX_DAL_CTXT dctxt : Context reference of the current POSIX DAL ( dirtmp and tmplen must be set )
+ * @return int : Zero on success, -1 on failure
  */
-static char *expand_path(const char *parse, char *fill, DAL_location loc, DAL_location *loc_flags, int dir)
+static int compile_template(POSIX_DAL_CTXT dctxt)
 {
-   char *end = fill;
+   // every segment other than the last ends in a substitution or a '/', each consuming at least one char
+   dctxt->segs = malloc(sizeof(POSIX_TMPL_SEG) * (dctxt->tmplen + 1));
+   dctxt->segtext = malloc(sizeof(char) * (dctxt->tmplen + 1));
+   if (dctxt->segs == NULL || dctxt->segtext == NULL)
+   {
+      free(dctxt->segs);
+      free(dctxt->segtext);
+      return -1;
+   } // malloc will set errno
+   dctxt->nsegs = 0;
+   dctxt->dirsegs = 0;
+   memset(&(dctxt->dirvals), 0, sizeof(DAL_location));
+
+   DAL_location vals = {.pod = 0, .block = 0, .cap = 0, .scatter = 0};
+   const char *parse = dctxt->dirtmp;
+   char *fill = dctxt->segtext;
+   POSIX_TMPL_SEG *seg = dctxt->segs;
+   seg->text = fill;
    char escp = 0;
    while (*parse != '\0')
    {
+      char end = 0; // set if the current segment ends with this char
       switch (*parse)
       {
       case '\\': // check for escape character
@@ -204,75 +193,38 @@ static char *expand_path(const char *parse, char *fill, DAL_location loc, DAL_lo
             *fill = '{';
             fill++;
             escp = 0;
+            break;
          }
-         else
+         parse++;
+         if (*parse != 'p' && *parse != 'b' && *parse != 'c' && *parse != 's')
          {
-            parse++;
-            int fillval = 0;
-            if (*parse == 'p')
-            {
-               fillval = loc.pod;
-               if (loc_flags)
-               {
-                  loc_flags->pod = 1;
-               }
-            }
-            else if (*parse == 'b')
-            {
-               fillval = loc.block;
-               if (loc_flags)
-               {
-                  loc_flags->block = 1;
-               }
-            }
-            else if (*parse == 'c')
-            {
-               fillval = loc.cap;
-               if (loc_flags)
-               {
-                  loc_flags->cap = 1;
-               }
-            }
-            else if (*parse == 's')
-            {
-               fillval = loc.scatter;
-               if (loc_flags)
-               {
-                  loc_flags->scatter = 1;
-               }
-            }
-            else
-            {
-               LOG(LOG_WARNING, "dir_template contains an unescaped '{' followed by '%c', rather than an expected 'p'/'b'/'c'/'s'\n", *parse);
-               *fill = '{';
-               fill++;
-               continue;
-            }
-            // ensure the '}' (end of substitution character) follows
-            if (*(parse + 1) != '}')
-            {
-               LOG(LOG_WARNING, "dir_template contains an '{%c' substitution sequence with no closing '}' character\n", *parse);
-               *fill = '{';
-               fill++;
-               continue;
-            }
-            // print the numeric value into the fill string
-            fillval = snprintf(fill, 5, "%d", fillval);
-            if (fillval <= 0)
-            {
-               // if snprintf failed for some reason, we can't recover
-               LOG(LOG_ERR, "snprintf failed when attempting dir_template substitution!\n");
-               return NULL;
-            }
-            fill += fillval; // update fill pointer to refernce the new end of the string
-            parse++;         // skip over the '}' character that we have already verified
+            LOG(LOG_WARNING, "dir_template contains an unescaped '{' followed by '%c', rather than an expected 'p'/'b'/'c'/'s'\n", *parse);
+            *fill = '{';
+            fill++;
+            continue;
          }
+         // ensure the '}' (end of substitution character) follows
+         if (*(parse + 1) != '}')
+         {
+            LOG(LOG_WARNING, "dir_template contains an '{%c' substitution sequence with no closing '}' character\n", *parse);
+            *fill = '{';
+            fill++;
+            continue;
+         }
+         end = *parse;
+         seg->sub = *parse;
+         vals.pod |= (*parse == 'p');
+         vals.block |= (*parse == 'b');
+         vals.cap |= (*parse == 'c');
+         vals.scatter |= (*parse == 's');
+         parse++; // skip over the '}' character that we have already verified
          break;
 
       case '/': // check for the end of a directory
          *fill = *parse;
          fill++;
-         end = fill;
+         end = *parse;
+         seg->sub = '\0';
          break;
 
       default:
@@ -286,12 +238,74 @@ static char *expand_path(const char *parse, char *fill, DAL_location loc, DAL_lo
          break;
       }
 
+      if (end)
+      {
+         // complete this segment and begin the next
+         seg->textlen = fill - seg->text;
+         dctxt->nsegs++;
+         if (end == '/')
+         {
+            dctxt->dirsegs = dctxt->nsegs;
+            dctxt->dirvals = vals;
+         }
+         seg++;
+         seg->text = fill;
+      }
       parse++;
    }
-   if (dir)
+   // complete any trailing literal text
+   seg->textlen = fill - seg->text;
+   seg->sub = '\0';
+   if (seg->textlen)
    {
-      *end = '\0';
+      dctxt->nsegs++;
    }
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Produce a range of segments of the compiled dir_template, substituting in the values of the given DAL_location
+ * @param POSIX_DAL_CTXT dctxt : Context reference of the current POSIX DAL
+ * @param int first : Index of the first segment to be produced
+ * @param int last : Index beyond the final segment to be produced
+ * @param DAL_location loc : Location values to be substituted into the template
+ * @param char* fill : String to be populated ( will be NULL terminated )
+ * @return char* : Reference to the end of the populated string, or NULL on failure
+ */
+static char *fill_template(POSIX_DAL_CTXT dctxt, int first, int last, DAL_location loc, char *fill)
+{
+   for (int i = first; i < last; i++)
+   {
+      const POSIX_TMPL_SEG *seg = dctxt->segs + i;
+      memcpy(fill, seg->text, seg->textlen);
+      fill += seg->textlen;
+      if (seg->sub)
+      {
+         int fillval = loc.pod;
+         if (seg->sub == 'b')
+         {
+            fillval = loc.block;
+         }
+         else if (seg->sub == 'c')
+         {
+            fillval = loc.cap;
+         }
+         else if (seg->sub == 's')
+         {
+            fillval = loc.scatter;
+         }
+         // print the numeric value into the fill string
+         fillval = snprintf(fill, 5, "%d", fillval);
+         if (fillval <= 0)
+         {
+            // if snprintf failed for some reason, we can't recover
+            LOG(LOG_ERR, "snprintf failed when attempting dir_template substitution!\n");
+            return NULL;
+         }
+         fill += fillval; // update fill pointer to refernce the new end of the string
+      }
+   }
+   *fill = '\0';
    return fill;
 }
 
@@ -303,7 +317,7 @@ static char *expand_path(const char *parse, char *fill, DAL_location loc, DAL_lo
  * @param const char* objID : Object ID to be referenced by bctxt
  * @return int : Zero on success, -1 on failure
  */
-static int expand_dir_template(POSIX_DAL_CTXT dctxt, POSIX_BLOCK_CTXT bctxt, DAL_location loc, const char *objID)
+int expand_dir_template(POSIX_DAL_CTXT dctxt, POSIX_BLOCK_CTXT bctxt, DAL_location loc, const char *objID)
 {
    // check that our DAL_location is within bounds
    if (check_loc_limits(loc, &(dctxt->max_loc)) != 0)
@@ -312,17 +326,28 @@ static int expand_dir_template(POSIX_DAL_CTXT dctxt, POSIX_BLOCK_CTXT bctxt, DAL
       return -1;
    }
 
-   //
+   // paths are relative to the secure root, until a directory handle is acquired
    bctxt->sfd = dctxt->sec_root;
+   bctxt->diroff = 0;
+   bctxt->dirslot = -1;
+   bctxt->dctxt = (DAL_CTXT)dctxt;
 
    // allocate string to hold the dirpath
    // NOTE -- allocation size is an estimate, based on the above pod/block/cap/scat limits
    bctxt->filepath = malloc(sizeof(char) * (dctxt->tmplen + dctxt->dirpad + strlen(objID) + SFX_PADDING + 1));
+   if (bctxt->filepath == NULL)
+   {
+      return -1;
+   } // malloc will set errno
 
-   // parse through the directory template string, populating filepath as we go
-   const char *parse = dctxt->dirtmp;
-   char *fill = bctxt->filepath;
-   if (!(fill = expand_path(parse, fill, loc, NULL, 0)))
+   // produce the directory portion of the path, then any file prefix from the compiled template
+   char *fill = fill_template(dctxt, 0, dctxt->dirsegs, loc, bctxt->filepath);
+   if (fill != NULL)
+   {
+      bctxt->dirlen = fill - bctxt->filepath;
+      fill = fill_template(dctxt, dctxt->dirsegs, dctxt->nsegs, loc, fill);
+   }
+   if (fill == NULL)
    {
       free(bctxt->filepath);
       bctxt->filepath = NULL;
@@ -330,7 +355,7 @@ static int expand_dir_template(POSIX_DAL_CTXT dctxt, POSIX_BLOCK_CTXT bctxt, DAL
    }
 
    // parse through the given objID, populating filepath as we go
-   parse = objID;
+   const char *parse = objID;
    while (*parse != '\0')
    {
 
@@ -359,95 +384,222 @@ static int expand_dir_template(POSIX_DAL_CTXT dctxt, POSIX_BLOCK_CTXT bctxt, DAL
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * Delete various components of a given object, identified by it's block context.
- * @param POSIX_BLOCK_CTXT bctxt : Context of the object to be deleted
- * @param char components : Identifies which components of the object to delete
- *                          0 - working data/meta files only
- *                          1 - ALL data/meta files
- * @return int : Zero on success, -1 on failure
+ * Allocate a new, empty, directory handle cache
+ * @param int size : Number of directory handles to be retained by the cache
+ * @return POSIX_DIR_CACHE : Reference to the new cache, or NULL on failure
  */
-static int block_delete(POSIX_BLOCK_CTXT bctxt, char components)
+static POSIX_DIR_CACHE create_dir_cache(int size)
 {
-   char *working_suffix = WRITE_SFX;
-   if (bctxt->mode == DAL_REBUILD)
+   POSIX_DIR_CACHE cache = malloc(sizeof(struct posix_dir_cache_struct));
+   if (cache == NULL)
    {
-      working_suffix = REBUILD_SFX;
+      return NULL;
+   } // malloc will set errno
+   cache->handles = malloc(sizeof(POSIX_DIR_HANDLE) * size);
+   if (cache->handles == NULL)
+   {
+      free(cache);
+      return NULL;
+   } // malloc will set errno
+   if (pthread_mutex_init(&(cache->lock), NULL))
+   {
+      free(cache->handles);
+      free(cache);
+      return NULL;
    }
-   // append the meta suffix and check for success
-   char *res = strncat(bctxt->filepath + bctxt->filelen, META_SFX, SFX_PADDING);
-   if (res != (bctxt->filepath + bctxt->filelen))
+   for (int i = 0; i < size; i++)
    {
-      LOG(LOG_ERR, "failed to append meta suffix \"%s\" to file path \"%s\"!\n", META_SFX, bctxt->filepath);
-      errno = EBADF;
-      return -1;
+      cache->handles[i].fd = -1;
+      cache->handles[i].refs = 0;
+      cache->handles[i].used = 0;
    }
+   cache->size = size;
+   cache->clock = 0;
+   return cache;
+}
 
-   int metalen = strlen(META_SFX);
-
-   // append the working suffix and check for success
-   res = strncat(bctxt->filepath + bctxt->filelen + metalen, working_suffix, SFX_PADDING - metalen);
-   if (res != (bctxt->filepath + bctxt->filelen + metalen))
+/** (INTERNAL HELPER FUNCTION)
+ * Close all handles of the given directory handle cache and free it
+ * @param POSIX_DIR_CACHE cache : Cache to be destroyed ( may be NULL )
+ */
+static void destroy_dir_cache(POSIX_DIR_CACHE cache)
+{
+   if (cache == NULL)
    {
-      LOG(LOG_ERR, "failed to append working suffix \"%s\" to file path \"%s\"!\n", working_suffix, bctxt->filepath);
-      errno = EBADF;
-      *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
-      return -1;
+      return;
    }
-
-   // unlink any in-progress meta file (only failure with ENOENT is acceptable)
-   if (unlinkat(bctxt->sfd, bctxt->filepath, 0) != 0 && errno != ENOENT)
+   for (int i = 0; i < cache->size; i++)
    {
-      LOG(LOG_ERR, "failed to unlink \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
-      *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
-      return -1;
+      if (cache->handles[i].fd >= 0)
+      {
+         close(cache->handles[i].fd);
+      }
    }
+   pthread_mutex_destroy(&(cache->lock));
+   free(cache->handles);
+   free(cache);
+}
 
-   // trim the working suffix off
-   *(bctxt->filepath + bctxt->filelen + metalen) = '\0';
-
-   if (components)
+/** (INTERNAL HELPER FUNCTION)
+ * Attempt to make the file paths of a populated POSIX_BLOCK_CTXT relative to a cached handle of the object's 
+ * directory, opening ( and caching ) that handle if necessary.  On failure, paths simply remain relative to 
+ * the secure root.
+ * NOTE -- directories of the dir_template must not be removed or replaced while this DAL remains in use
+ * @param POSIX_DAL_CTXT dctxt : Context reference of the current POSIX DAL
+ * @param POSIX_BLOCK_CTXT bctxt : Block context, as populated by expand_dir_template()
+ * @param DAL_location loc : Location of the object referenced by bctxt
+ */
+void acquire_dir_handle(POSIX_DAL_CTXT dctxt, POSIX_BLOCK_CTXT bctxt, DAL_location loc)
+{
+   POSIX_DIR_CACHE cache = dctxt->dircache;
+   if (cache == NULL || bctxt->dirlen == 0)
+   {
+      return;
+   } // no cache, or no directory beneath the secure root
+   // only location values which appear in the directory portion of the template identify the directory
+   DAL_location dirloc = {.pod = (dctxt->dirvals.pod) ? loc.pod : 0,
+                          .block = (dctxt->dirvals.block) ? loc.block : 0,
+                          .cap = (dctxt->dirvals.cap) ? loc.cap : 0,
+                          .scatter = (dctxt->dirvals.scatter) ? loc.scatter : 0};
+
+   pthread_mutex_lock(&(cache->lock));
+   cache->clock++;
+   int slot = -1;
+   int victim = -1;
+   for (int i = 0; i < cache->size; i++)
+   {
+      POSIX_DIR_HANDLE *handle = cache->handles + i;
+      if (handle->fd >= 0 && memcmp(&(handle->loc), &dirloc, sizeof(DAL_location)) == 0)
+      {
+         slot = i;
+         break;
+      }
+      // unused entries have a 'used' value of zero, so are always preferred for eviction
+      if (handle->refs == 0 && (victim < 0 || handle->used < cache->handles[victim].used))
+      {
+         victim = i;
+      }
+   }
+   if (slot < 0 && victim >= 0)
    {
-      // unlink any meta file (only failure with ENOENT is acceptable)
-      if (unlinkat(bctxt->sfd, bctxt->filepath, 0) != 0 && errno != ENOENT)
+      // open the directory, temporarily terminating the path after it
+      char tmp = *(bctxt->filepath + bctxt->dirlen);
+      *(bctxt->filepath + bctxt->dirlen) = '\0';
+      int fd = openat(dctxt->sec_root, bctxt->filepath, O_DIRECTORY);
+      if (fd < 0)
       {
-         LOG(LOG_ERR, "failed to unlink \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
-         *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
-         return -1;
+         LOG(LOG_INFO, "failed to open directory \"%s\", using secure root relative paths (%s)\n", bctxt->filepath, strerror(errno));
+      }
+      *(bctxt->filepath + bctxt->dirlen) = tmp;
+      if (fd >= 0)
+      {
+         // replace the least recently used handle
+         POSIX_DIR_HANDLE *handle = cache->handles + victim;
+         if (handle->fd >= 0)
+         {
+            close(handle->fd);
+         }
+         handle->loc = dirloc;
+         handle->fd = fd;
+         slot = victim;
       }
    }
+   if (slot >= 0)
+   {
+      cache->handles[slot].refs++;
+      cache->handles[slot].used = cache->clock;
+      bctxt->sfd = cache->handles[slot].fd;
+      bctxt->diroff = bctxt->dirlen;
+      bctxt->dirslot = slot;
+   }
+   pthread_mutex_unlock(&(cache->lock));
+}
 
-   // trim the meta suffix off and attach a working suffix in its place
-   *(bctxt->filepath + bctxt->filelen) = '\0';
-   res = strncat(bctxt->filepath + bctxt->filelen, working_suffix, SFX_PADDING - metalen);
-   if (res != (bctxt->filepath + bctxt->filelen))
+/** (INTERNAL HELPER FUNCTION)
+ * Free the file path of the given POSIX_BLOCK_CTXT, releasing any directory handle it references
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of the path to be freed
+ */
+void free_block_path(POSIX_BLOCK_CTXT bctxt)
+{
+   if (bctxt->dirslot >= 0)
    {
-      LOG(LOG_ERR, "failed to append working suffix \"%s\" to file path \"%s\"!\n", working_suffix, bctxt->filepath);
-      errno = EBADF;
-      *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
-      return -1;
+      POSIX_DIR_CACHE cache = ((POSIX_DAL_CTXT)bctxt->dctxt)->dircache;
+      pthread_mutex_lock(&(cache->lock));
+      cache->handles[bctxt->dirslot].refs--;
+      pthread_mutex_unlock(&(cache->lock));
+      bctxt->dirslot = -1;
    }
+   bctxt->sfd = -1;
+   free(bctxt->filepath);
+   bctxt->filepath = NULL;
+}
 
-   // unlink any in-progress data file (only failure with ENOENT is acceptable)
-   if (unlinkat(bctxt->sfd, bctxt->filepath, 0) != 0 && errno != ENOENT)
+/** (INTERNAL HELPER FUNCTION)
+ * Unlink a single file of a given object, identified by its block context and a file suffix
+ * @param POSIX_BLOCK_CTXT bctxt : Context of the object
+ * @param const char* sfx : Suffix of the file to be unlinked ( at most SFX_PADDING chars, "" for the data file )
+ * @return int : Zero on success ( including if the file does not exist ), -1 on failure
+ */
+static int unlink_block_file(POSIX_BLOCK_CTXT bctxt, const char *sfx)
+{
+   snprintf(bctxt->filepath + bctxt->filelen, SFX_PADDING + 1, "%s", sfx);
+   // only failure with ENOENT is acceptable, as this implies a non-existent file
+   int ret = 0;
+   if (unlinkat(bctxt->sfd, bctxt->filepath + bctxt->diroff, 0) != 0 && errno != ENOENT)
    {
       LOG(LOG_ERR, "failed to unlink \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
-      *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
-      return -1;
+      ret = -1;
    }
-
    *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
+   return ret;
+}
 
-   if (components)
+/** (INTERNAL HELPER FUNCTION)
+ * Unlink the working data/meta files of a given object, left by a write or a rebuild
+ * @param POSIX_BLOCK_CTXT bctxt : Context of the object
+ * @param const char* working_suffix : Suffix of the working files ( WRITE_SFX or REBUILD_SFX )
+ * @return int : Zero on success ( including if the files do not exist ), -1 on failure
+ */
+int unlink_working_files(POSIX_BLOCK_CTXT bctxt, const char *working_suffix)
+{
+   char meta_suffix[SFX_PADDING + 1];
+   snprintf(meta_suffix, SFX_PADDING + 1, "%s%s", META_SFX, working_suffix);
+   // unlink any in-progress meta file, prior to the data it describes
+   if (unlink_block_file(bctxt, meta_suffix) || unlink_block_file(bctxt, working_suffix))
+   {
+      return -1;
+   }
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Delete various components of a given object, identified by it's block context.
+ * @param POSIX_BLOCK_CTXT bctxt : Context of the object to be deleted
+ * @param char components : Identifies which components of the object to delete
+ *                          0 - working data/meta files of the current mode only
+ *                          1 - ALL data/meta files ( including those of any interrupted write or rebuild )
+ * @return int : Zero on success, -1 on failure
+ */
+int block_delete(POSIX_BLOCK_CTXT bctxt, char components)
+{
+   if (!components)
    {
-      // unlink any data file (only failure with ENOENT is acceptable, as this implies a non-existent file)
-      if (unlinkat(bctxt->sfd, bctxt->filepath, 0) != 0 && errno != ENOENT)
+      char *working_suffix = WRITE_SFX;
+      if (bctxt->mode == DAL_REBUILD || bctxt->mode == DAL_RESUME)
       {
-         LOG(LOG_ERR, "failed to unlink \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
-         *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
-         return -1;
+         working_suffix = REBUILD_SFX;
       }
+      return unlink_working_files(bctxt, working_suffix);
+   }
+   // a leftover rebuild must not outlive the object, or a later rebuild could resume upon it
+   if (unlink_working_files(bctxt, WRITE_SFX) || unlink_working_files(bctxt, REBUILD_SFX))
+   {
+      return -1;
+   }
+   if (unlink_block_file(bctxt, META_SFX) || unlink_block_file(bctxt, ""))
+   {
+      return -1;
    }
-
    return 0;
 }
 
@@ -554,22 +706,219 @@ static int r_mkdirat(int dirfd, char *pathname, mode_t mode)
    return num_err;
 }
 
-// forward-declarations to allow these functions to be used in manual_migrate
-int posix_del(DAL_CTXT ctxt, DAL_location location, const char *objID);
-
-BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const char *objID);
-
-int posix_set_meta(BLOCK_CTXT ctxt, const char *meta_buf, size_t size);
+/** (INTERNAL HELPER FUNCTION)
+ * Ensure that the O_DIRECT staging buffer of the given block is at least the given size
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of an O_DIRECT data file
+ * @param size_t size : Required size of the staging buffer ( must be a multiple of the alignment )
+ * @return int : Zero on success, -1 on failure
+ */
+static int direct_buffer(POSIX_BLOCK_CTXT bctxt, size_t size)
+{
+   if (bctxt->dbuf != NULL && bctxt->dcap >= size)
+   {
+      return 0;
+   }
+   char *newbuf = NULL;
+   if ((errno = posix_memalign((void **)&newbuf, bctxt->dalign, size)))
+   {
+      LOG(LOG_ERR, "failed to allocate a %zu byte staging buffer for \"%s\"\n", size, bctxt->filepath);
+      return -1;
+   }
+   if (bctxt->dbuf != NULL)
+   {
+      memcpy(newbuf, bctxt->dbuf, bctxt->dfill);
+      free(bctxt->dbuf);
+   }
+   bctxt->dbuf = newbuf;
+   bctxt->dcap = size;
+   return 0;
+}
 
-ssize_t posix_get_meta(BLOCK_CTXT ctxt, char *meta_buf, size_t size);
+/** (INTERNAL HELPER FUNCTION)
+ * Write the given aligned buffer to the O_DIRECT data file of the given block
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of an O_DIRECT data file
+ * @param const void* buf : Aligned buffer to be written
+ * @param size_t size : Size of the write ( must be a multiple of the alignment )
+ * @param off_t offset : Offset of the write ( must be a multiple of the alignment )
+ * @return int : Zero on success, -1 on failure
+ */
+static int direct_write(POSIX_BLOCK_CTXT bctxt, const void *buf, size_t size, off_t offset)
+{
+   const char *parse = buf;
+   while (size)
+   {
+      ssize_t res = pwrite(bctxt->fd, parse, size, offset);
+      if (res <= 0)
+      {
+         LOG(LOG_ERR, "direct write of %zu bytes at offset %zd of \"%s\" failed (%s)\n", size, offset, bctxt->filepath, (res) ? strerror(errno) : "no progress");
+         if (res == 0)
+         {
+            errno = EIO;
+         }
+         return -1;
+      }
+      parse += res;
+      size -= res;
+      offset += res;
+   }
+   return 0;
+}
 
-int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size);
+/** (INTERNAL HELPER FUNCTION)
+ * Write out any data held in the O_DIRECT staging buffer of the given block.  A partial trailing
+ * sector is written zero-padded, and the data file is then truncated to its true length.
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of an O_DIRECT data file
+ * @param char final : If zero, a partial trailing sector is retained in the staging buffer, allowing
+ *                     later writes to complete it; otherwise, the staging buffer is emptied
+ * @return int : Zero on success, -1 on failure
+ */
+static int direct_flush(POSIX_BLOCK_CTXT bctxt, char final)
+{
+   if (bctxt->dfill == 0)
+   {
+      return 0;
+   }
+   size_t padded = ((bctxt->dfill + bctxt->dalign - 1) / bctxt->dalign) * bctxt->dalign;
+   memset(bctxt->dbuf + bctxt->dfill, 0, padded - bctxt->dfill);
+   if (direct_write(bctxt, bctxt->dbuf, padded, bctxt->doff))
+   {
+      return -1;
+   }
+   if (ftruncate(bctxt->fd, bctxt->doff + bctxt->dfill))
+   {
+      LOG(LOG_ERR, "failed to truncate \"%s\" to %zd bytes (%s)\n", bctxt->filepath, bctxt->doff + bctxt->dfill, strerror(errno));
+      return -1;
+   }
+   // retain only the partial trailing sector, if any
+   size_t done = (final) ? bctxt->dfill : (bctxt->dfill / bctxt->dalign) * bctxt->dalign;
+   if (done < bctxt->dfill)
+   {
+      memmove(bctxt->dbuf, bctxt->dbuf + done, bctxt->dfill - done);
+   }
+   bctxt->doff += done;
+   bctxt->dfill -= done;
+   return 0;
+}
 
-ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
+/** (INTERNAL HELPER FUNCTION)
+ * Store data to the O_DIRECT data file of the given block, staging any data which does not form
+ * complete, aligned sectors
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of an O_DIRECT data file
+ * @param const void* buf : Data to be written
+ * @param size_t size : Size of the data
+ * @return int : Zero on success, -1 on failure
+ */
+static int direct_put(POSIX_BLOCK_CTXT bctxt, const void *buf, size_t size)
+{
+   const char *parse = buf;
+   while (size)
+   {
+      // aligned data may bypass an empty staging buffer
+      if (bctxt->dfill == 0 && ((uintptr_t)parse % bctxt->dalign) == 0 && size >= bctxt->dalign)
+      {
+         size_t direct = (size / bctxt->dalign) * bctxt->dalign;
+         if (direct_write(bctxt, parse, direct, bctxt->doff))
+         {
+            return -1;
+         }
+         bctxt->doff += direct;
+         parse += direct;
+         size -= direct;
+         continue;
+      }
+      if (direct_buffer(bctxt, bctxt->dcap))
+      {
+         return -1;
+      }
+      size_t copy = bctxt->dcap - bctxt->dfill;
+      if (copy > size)
+      {
+         copy = size;
+      }
+      memcpy(bctxt->dbuf + bctxt->dfill, parse, copy);
+      bctxt->dfill += copy;
+      parse += copy;
+      size -= copy;
+      if (bctxt->dfill == bctxt->dcap)
+      {
+         if (direct_write(bctxt, bctxt->dbuf, bctxt->dcap, bctxt->doff))
+         {
+            return -1;
+         }
+         bctxt->doff += bctxt->dcap;
+         bctxt->dfill = 0;
+      }
+   }
+   return 0;
+}
 
-int posix_abort(BLOCK_CTXT ctxt);
+/** (INTERNAL HELPER FUNCTION)
+ * Retrieve contiguous data from the O_DIRECT data file of the given block into any number of buffers,
+ * reading the aligned extent covering the request into the staging buffer with a single call
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of an O_DIRECT data file
+ * @param const struct iovec* iov : Buffers to be populated, in order
+ * @param int iovcnt : Count of buffers
+ * @param off_t offset : Offset of the read
+ * @return ssize_t : Byte count on success, or -1 on failure
+ */
+static ssize_t direct_getv(POSIX_BLOCK_CTXT bctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   size_t size = 0;
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      size += iov[i].iov_len;
+   }
+   off_t start = (offset / bctxt->dalign) * bctxt->dalign;
+   size_t len = (((offset + size) + bctxt->dalign - 1) / bctxt->dalign) * bctxt->dalign - start;
+   if (direct_buffer(bctxt, len))
+   {
+      return -1;
+   }
+   ssize_t res = pread(bctxt->fd, bctxt->dbuf, len, start);
+   if (res < 0)
+   {
+      return -1;
+   }
+   res -= (offset - start);
+   if (res <= 0)
+   {
+      return 0;
+   }
+   if (res > size)
+   {
+      res = size;
+   }
+   const char *parse = bctxt->dbuf + (offset - start);
+   size_t left = res;
+   for (i = 0; i < iovcnt && left; i++)
+   {
+      size_t copy = (iov[i].iov_len < left) ? iov[i].iov_len : left;
+      memcpy(iov[i].iov_base, parse, copy);
+      parse += copy;
+      left -= copy;
+   }
+   return res;
+}
 
-int posix_close(BLOCK_CTXT ctxt);
+/** (INTERNAL HELPER FUNCTION)
+ * Retrieve data from the O_DIRECT data file of the given block, reading through the staging buffer
+ * if the request is not aligned
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of an O_DIRECT data file
+ * @param void* buf : Buffer to be populated
+ * @param size_t size : Size of the read
+ * @param off_t offset : Offset of the read
+ * @return ssize_t : Byte count on success, or -1 on failure
+ */
+static ssize_t direct_get(POSIX_BLOCK_CTXT bctxt, void *buf, size_t size, off_t offset)
+{
+   if (((uintptr_t)buf % bctxt->dalign) == 0 && (size % bctxt->dalign) == 0 && (offset % bctxt->dalign) == 0)
+   {
+      return pread(bctxt->fd, buf, size, offset);
+   }
+   struct iovec iov = {.iov_base = buf, .iov_len = size};
+   return direct_getv(bctxt, &iov, 1, offset);
+}
 
 /** (INTERNAL HELPER FUNCTION)
  * Attempt to manually migrate an object from one location to another using put/get/set_meta/get_meta dal functions..
@@ -744,16 +1093,19 @@ int posix_verify(DAL_CTXT ctxt, char fix)
          num_err++;
       }
    }
-   char *path = malloc(sizeof(char) * (dctxt->tmplen + dctxt->dirpad + SFX_PADDING + 1));
-   DAL_location loc = {.pod = 0, .block = 0, .cap = 0, .scatter = 0};
-   DAL_location loc_flags = {.pod = 0, .block = 0, .cap = 0, .scatter = 0};
-   expand_path(dctxt->dirtmp, path, dctxt->max_loc, &loc_flags, 1);
    // return if there are not any directories to check
-   if (!strlen(path))
+   if (dctxt->dirsegs == 0)
    {
-      free(path);
       return num_err;
    }
+   char *path = malloc(sizeof(char) * (dctxt->tmplen + dctxt->dirpad + SFX_PADDING + 1));
+   if (path == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate space for a directory path (%s)\n", strerror(errno));
+      return ++num_err;
+   }
+   DAL_location loc = {.pod = 0, .block = 0, .cap = 0, .scatter = 0};
+   DAL_location loc_flags = dctxt->dirvals;
    // check every valid combination of pod/block/cap/scatter
    for (int p = 0; p <= (loc_flags.pod ? dctxt->max_loc.pod : 0); p++)
    {
@@ -767,7 +1119,7 @@ int posix_verify(DAL_CTXT ctxt, char fix)
             for (int s = 0; s <= (loc_flags.scatter ? dctxt->max_loc.scatter : 0); s++)
             {
                loc.scatter = s;
-               expand_path(dctxt->dirtmp, path, loc, NULL, 1);
+               fill_template(dctxt, 0, dctxt->dirsegs, loc, path);
                LOG(LOG_INFO, "checking path %s\n", path);
                if (fstatat(dctxt->sec_root, path, &info, 0) || !S_ISDIR(info.st_mode))
                {
@@ -1031,10 +1383,11 @@ int posix_del(DAL_CTXT ctxt, DAL_location location, const char *objID)
       free(bctxt);
       return -1;
    }
+   acquire_dir_handle(dctxt, bctxt, location);
 
    int res = block_delete(bctxt, 1);
 
-   free(bctxt->filepath);
+   free_block_path(bctxt);
    free(bctxt);
    return res;
 }
@@ -1061,12 +1414,13 @@ int posix_stat(DAL_CTXT ctxt, DAL_location location, const char *objID)
       free(bctxt);
       return -1;
    }
+   acquire_dir_handle(dctxt, bctxt, location);
 
    // perform a stat() call, and just check the return code
    struct stat sstr;
-   int res = fstatat(dctxt->sec_root, bctxt->filepath, &sstr, 0);
+   int res = fstatat(bctxt->sfd, bctxt->filepath + bctxt->diroff, &sstr, 0);
 
-   free(bctxt->filepath);
+   free_block_path(bctxt);
    free(bctxt);
    return res;
 }
@@ -1081,7 +1435,10 @@ int posix_cleanup(DAL dal)
    POSIX_DAL_CTXT dctxt = (POSIX_DAL_CTXT)dal->ctxt; // should have been passed a posix context
 
    // free DAL context state
+   destroy_dir_cache(dctxt->dircache);
    close(dctxt->sec_root);
+   free(dctxt->segs);
+   free(dctxt->segtext);
    free(dctxt->dirtmp);
    free(dctxt);
    // free the DAL struct and its associated state
@@ -1111,10 +1468,25 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
       free(bctxt);
       return NULL;
    }
+   acquire_dir_handle(dctxt, bctxt, location);
 
    // populate other BLOCK context fields
    bctxt->offset = 0;
    bctxt->mode = mode;
+   bctxt->dalign = 0;
+   bctxt->dbuf = NULL;
+   bctxt->dcap = dctxt->direct_cap;
+   bctxt->dfill = 0;
+   bctxt->doff = 0;
+
+   // a new version of the object invalidates any interrupted rebuild of the previous one
+   if (mode == DAL_WRITE && unlink_working_files(bctxt, REBUILD_SFX))
+   {
+      LOG(LOG_ERR, "failed to remove rebuild files of a previous version of \"%s\"\n", bctxt->filepath);
+      free_block_path(bctxt);
+      free(bctxt);
+      return NULL;
+   }
 
    char *res = NULL;
 
@@ -1124,7 +1496,7 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
    {
       LOG(LOG_ERR, "failed to append meta suffix \"%s\" to file path!\n", META_SFX);
       errno = EBADF;
-      free(bctxt->filepath);
+      free_block_path(bctxt);
       free(bctxt);
       return NULL;
    }
@@ -1132,25 +1504,35 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
    int metalen = strlen(META_SFX);
 
    int oflags = O_WRONLY | O_CREAT | O_TRUNC;
+   int moflags = oflags;
    if (mode == DAL_READ)
    {
       LOG(LOG_INFO, "Open for READ\n");
       oflags = O_RDONLY;
+      moflags = oflags;
    }
    else if (mode == DAL_METAREAD)
    {
       LOG(LOG_INFO, "Open for METAREAD\n");
       oflags = O_RDONLY;
+      moflags = oflags;
       bctxt->fd = -1;
    }
-   else
+   else if (mode == DAL_RESUME)
+   {
+      // keep any data and checkpoint meta info of the interrupted rebuild
+      // NOTE -- data must be readable, allowing an O_DIRECT file to stage its final partial sector
+      oflags = O_RDWR | O_CREAT;
+      moflags = O_RDWR | O_CREAT;
+   }
+   if (mode != DAL_READ && mode != DAL_METAREAD)
    {
       // append the proper suffix and check for success
       if (mode == DAL_WRITE)
       {
          res = strncat(bctxt->filepath + bctxt->filelen + metalen, WRITE_SFX, SFX_PADDING - metalen);
       }
-      else if (mode == DAL_REBUILD)
+      else if (mode == DAL_REBUILD || mode == DAL_RESUME)
       {
          res = strncat(bctxt->filepath + bctxt->filelen + metalen, REBUILD_SFX, SFX_PADDING - metalen);
       }
@@ -1158,7 +1540,7 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
       {
          LOG(LOG_ERR, "failed to append suffix to meta path!\n");
          errno = EBADF;
-         free(bctxt->filepath);
+         free_block_path(bctxt);
          free(bctxt);
          return NULL;
       }
@@ -1166,14 +1548,14 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
 
    // open the meta file and check for success
    mode_t mask = umask(0);
-   bctxt->mfd = openat(dctxt->sec_root, bctxt->filepath, oflags, S_IRWXU | S_IRWXG | S_IRWXO); // mode arg should be harmlessly ignored if reading
+   bctxt->mfd = openat(bctxt->sfd, bctxt->filepath + bctxt->diroff, moflags, S_IRWXU | S_IRWXG | S_IRWXO); // mode arg should be harmlessly ignored if reading
    if (bctxt->mfd < 0)
    {
       LOG(LOG_ERR, "failed to open meta file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
       if (mode == DAL_METAREAD)
       {
          umask(mask);
-         free(bctxt->filepath);
+         free_block_path(bctxt);
          free(bctxt);
          return NULL;
       }
@@ -1181,7 +1563,7 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
    // remove any suffix in the simplest possible manner
    *(bctxt->filepath + bctxt->filelen) = '\0';
 
-   if (mode == DAL_WRITE || mode == DAL_REBUILD)
+   if (mode == DAL_WRITE || mode == DAL_REBUILD || mode == DAL_RESUME)
    {
       // append the proper suffix
       if (mode == DAL_WRITE)
@@ -1189,9 +1571,9 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
          LOG(LOG_INFO, "Open for WRITE\n");
          res = strncat(bctxt->filepath + bctxt->filelen, WRITE_SFX, SFX_PADDING);
       }
-      else if (mode == DAL_REBUILD)
+      else if (mode == DAL_REBUILD || mode == DAL_RESUME)
       {
-         LOG(LOG_INFO, "Open for REBUILD\n");
+         LOG(LOG_INFO, "Open for %s\n", (mode == DAL_REBUILD) ? "REBUILD" : "RESUME");
          res = strncat(bctxt->filepath + bctxt->filelen, REBUILD_SFX, SFX_PADDING);
       } // NOTE -- invalid mode will leave res == NULL
       // check for success appending the suffix
@@ -1200,7 +1582,7 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
          LOG(LOG_ERR, "failed to append suffix to file path!\n");
          errno = EBADF;
          umask(mask);
-         free(bctxt->filepath);
+         free_block_path(bctxt);
          free(bctxt);
          return NULL;
       }
@@ -1209,12 +1591,29 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
    if (mode != DAL_METAREAD)
    {
       // open the file and check for success
-      bctxt->fd = openat(dctxt->sec_root, bctxt->filepath, oflags, S_IRWXU | S_IRWXG | S_IRWXO); // mode arg should be harmlessly ignored if reading
+      bctxt->fd = -1;
+      if (dctxt->direct_align)
+      {
+         // bypass the page cache, if the underlying filesystem permits
+         bctxt->fd = openat(bctxt->sfd, bctxt->filepath + bctxt->diroff, oflags | O_DIRECT, S_IRWXU | S_IRWXG | S_IRWXO);
+         if (bctxt->fd >= 0)
+         {
+            bctxt->dalign = dctxt->direct_align;
+         }
+         else if (errno == EINVAL)
+         {
+            LOG(LOG_WARNING, "O_DIRECT is unsupported for file: \"%s\", using buffered I/O\n", bctxt->filepath);
+         }
+      }
+      if (bctxt->fd < 0 && (dctxt->direct_align == 0 || errno == EINVAL))
+      {
+         bctxt->fd = openat(bctxt->sfd, bctxt->filepath + bctxt->diroff, oflags, S_IRWXU | S_IRWXG | S_IRWXO); // mode arg should be harmlessly ignored if reading
+      }
       if (bctxt->fd < 0)
       {
          LOG(LOG_ERR, "failed to open file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
          umask(mask);
-         free(bctxt->filepath);
+         free_block_path(bctxt);
          free(bctxt);
          return NULL;
       }
@@ -1239,8 +1638,8 @@ int posix_set_meta(BLOCK_CTXT ctxt, const char *meta_buf, size_t size)
    }
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
-   // write the provided buffer out to the sidecar file
-   if (write(bctxt->mfd, meta_buf, size) != size)
+   // write the provided buffer out to the sidecar file, replacing any checkpoint meta info
+   if (pwrite(bctxt->mfd, meta_buf, size, 0) != size || ftruncate(bctxt->mfd, size))
    {
       LOG(LOG_ERR, "failed to write buffer to meta file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
       return -1;
@@ -1272,6 +1671,16 @@ int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
    }
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
+   if (bctxt->dalign)
+   {
+      if (direct_put(bctxt, buf, size))
+      {
+         LOG(LOG_ERR, "write to \"%s\" failed (%s)\n", bctxt->filepath, strerror(errno));
+         return -1;
+      }
+      return 0;
+   }
+
    // just a write to our pre-opened FD
    if (write(bctxt->fd, buf, size) != size)
    {
@@ -1279,7 +1688,133 @@ int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
       return -1;
    }
 
-   return size;
+   return 0;
+}
+
+int posix_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   size_t size = 0;
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      // O_DIRECT data is gathered into aligned sectors by the staging buffer anyhow
+      if (bctxt->dalign && direct_put(bctxt, iov[i].iov_base, iov[i].iov_len))
+      {
+         LOG(LOG_ERR, "write to \"%s\" failed (%s)\n", bctxt->filepath, strerror(errno));
+         return -1;
+      }
+      size += iov[i].iov_len;
+   }
+   if (bctxt->dalign)
+   {
+      return 0;
+   }
+
+   // just a single gathered write to our pre-opened FD
+   if (writev(bctxt->fd, iov, iovcnt) != size)
+   {
+      LOG(LOG_ERR, "write to \"%s\" failed (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+
+   return 0;
+}
+
+int posix_checkpoint(BLOCK_CTXT ctxt, const char *meta_buf, size_t size)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   // abort, unless we're rebuilding
+   if (bctxt->mode != DAL_REBUILD && bctxt->mode != DAL_RESUME)
+   {
+      LOG(LOG_ERR, "Can only checkpoint a DAL_REBUILD or DAL_RESUME block handle!\n");
+      errno = EINVAL;
+      return -1;
+   }
+
+   // all data described by the checkpoint must be stable before the checkpoint itself
+   if ((bctxt->dalign && direct_flush(bctxt, 0)) || fdatasync(bctxt->fd))
+   {
+      LOG(LOG_ERR, "failed to sync data file \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+   if (posix_set_meta(ctxt, meta_buf, size) || fdatasync(bctxt->mfd))
+   {
+      LOG(LOG_ERR, "failed to store checkpoint meta info of \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+
+   return 0;
+}
+
+int posix_resume(BLOCK_CTXT ctxt, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   // abort, unless we're resuming
+   if (bctxt->mode != DAL_RESUME)
+   {
+      LOG(LOG_ERR, "Can only resume a DAL_RESUME block handle!\n");
+      errno = EINVAL;
+      return -1;
+   }
+
+   // we can't resume from beyond the data which actually survived
+   struct stat stval;
+   if (fstat(bctxt->fd, &stval))
+   {
+      LOG(LOG_ERR, "failed to stat data file \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+   if (stval.st_size < offset)
+   {
+      LOG(LOG_ERR, "data file \"%s\" is too short (%zd bytes) to resume from offset %zd\n", bctxt->filepath, stval.st_size, offset);
+      errno = ERANGE;
+      return -1;
+   }
+
+   // discard anything following the resume offset, and continue writing from there
+   if (ftruncate(bctxt->fd, offset) || lseek(bctxt->fd, offset, SEEK_SET) != offset)
+   {
+      LOG(LOG_ERR, "failed to truncate data file \"%s\" to offset %zd (%s)\n", bctxt->filepath, offset, strerror(errno));
+      return -1;
+   }
+   bctxt->offset = offset;
+
+   // an O_DIRECT file continues from the start of its final sector, which must be staged
+   if (bctxt->dalign)
+   {
+      bctxt->doff = (offset / bctxt->dalign) * bctxt->dalign;
+      bctxt->dfill = 0;
+      if (offset > bctxt->doff)
+      {
+         if (direct_buffer(bctxt, bctxt->dcap) || direct_get(bctxt, bctxt->dbuf, offset - bctxt->doff, bctxt->doff) != offset - bctxt->doff)
+         {
+            LOG(LOG_ERR, "failed to stage the final sector of data file \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+            return -1;
+         }
+         bctxt->dfill = offset - bctxt->doff;
+      }
+   }
+
+   return 0;
 }
 
 ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
@@ -1298,6 +1833,17 @@ ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
       return -1;
    }
 
+   // O_DIRECT reads are positioned, and never rely upon the file offset
+   if (bctxt->dalign)
+   {
+      ssize_t res = direct_get(bctxt, buf, size, offset);
+      if (res > 0)
+      {
+         bctxt->offset = offset + res;
+      }
+      return res;
+   }
+
    // check if we need to seek
    if (offset != bctxt->offset)
    {
@@ -1323,6 +1869,32 @@ ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
    return res;
 }
 
+ssize_t posix_getv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   // abort, unless we're reading
+   if (bctxt->mode != DAL_READ)
+   {
+      LOG(LOG_ERR, "Can only perform get ops on a DAL_READ block handle!\n");
+      return -1;
+   }
+
+   // a positioned read leaves the file offset of the FD, which we track for get(), untouched
+   ssize_t res = (bctxt->dalign) ? direct_getv(bctxt, iov, iovcnt, offset) : preadv(bctxt->fd, iov, iovcnt, offset);
+   if (res < 0)
+   {
+      LOG(LOG_ERR, "failed to read %d buffers at offset %zd of file \"%s\" (%s)\n", iovcnt, offset, bctxt->filepath, strerror(errno));
+   }
+
+   return res;
+}
+
 int posix_abort(BLOCK_CTXT ctxt)
 {
    if (ctxt == NULL)
@@ -1349,7 +1921,8 @@ int posix_abort(BLOCK_CTXT ctxt)
    }
 
    // free state
-   free(bctxt->filepath);
+   free(bctxt->dbuf);
+   free_block_path(bctxt);
    free(bctxt);
    return retval;
 }
@@ -1363,6 +1936,13 @@ int posix_close(BLOCK_CTXT ctxt)
    }
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
+   // write out any partial sector of an O_DIRECT file
+   if (bctxt->dalign && bctxt->mode != DAL_READ && direct_flush(bctxt, 1))
+   {
+      LOG(LOG_ERR, "failed to write out staged data of file \"%s\"\n", bctxt->filepath);
+      return -1;
+   }
+
    // if this is not a meta-only reference, attempt to close our FD and check for success
    if ((bctxt->mode != DAL_METAREAD) && (close(bctxt->fd) != 0))
    {
@@ -1378,7 +1958,7 @@ int posix_close(BLOCK_CTXT ctxt)
    }
 
    char *res = NULL;
-   if (bctxt->mode == DAL_WRITE || bctxt->mode == DAL_REBUILD)
+   if (bctxt->mode == DAL_WRITE || bctxt->mode == DAL_REBUILD || bctxt->mode == DAL_RESUME)
    {
       if (bctxt->mode == DAL_WRITE)
       {
@@ -1404,7 +1984,7 @@ int posix_close(BLOCK_CTXT ctxt)
       *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
 
       // attempt to rename and check for success
-      if (renameat(bctxt->sfd, write_path, bctxt->sfd, bctxt->filepath) != 0)
+      if (renameat(bctxt->sfd, write_path + bctxt->diroff, bctxt->sfd, bctxt->filepath + bctxt->diroff) != 0)
       {
          LOG(LOG_ERR, "failed to rename data file \"%s\" to \"%s\" (%s)\n", write_path, bctxt->filepath, strerror(errno));
          free(write_path);
@@ -1428,7 +2008,7 @@ int posix_close(BLOCK_CTXT ctxt)
       {
          res = strncat(bctxt->filepath + bctxt->filelen + metalen, WRITE_SFX, SFX_PADDING - metalen);
       }
-      if (bctxt->mode == DAL_REBUILD)
+      if (bctxt->mode == DAL_REBUILD || bctxt->mode == DAL_RESUME)
       {
          res = strncat(bctxt->filepath + bctxt->filelen + metalen, REBUILD_SFX, SFX_PADDING - metalen);
       }
@@ -1445,7 +2025,7 @@ int posix_close(BLOCK_CTXT ctxt)
       *(bctxt->filepath + bctxt->filelen + metalen) = '\0'; // make sure no suffix remains
 
       // attempt to rename and check for success
-      if (renameat(bctxt->sfd, meta_path, bctxt->sfd, bctxt->filepath) != 0)
+      if (renameat(bctxt->sfd, meta_path + bctxt->diroff, bctxt->sfd, bctxt->filepath + bctxt->diroff) != 0)
       {
          LOG(LOG_ERR, "failed to rename meta file \"%s\" to \"%s\" (%s)\n", meta_path, bctxt->filepath, strerror(errno));
          free(meta_path);
@@ -1455,7 +2035,8 @@ int posix_close(BLOCK_CTXT ctxt)
    }
 
    // free state
-   free(bctxt->filepath);
+   free(bctxt->dbuf);
+   free_block_path(bctxt);
    free(bctxt);
    return 0;
 }
@@ -1557,9 +2138,20 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
             parse++; // next char
          }
 
+         // parse the template once, so that paths may be produced without re-parsing it
+         if (compile_template(dctxt))
+         {
+            LOG(LOG_ERR, "failed to allocate space for the compiled dir_template\n");
+            free(dctxt->dirtmp);
+            free(dctxt);
+            return NULL;
+         }
+
          size_t io_size = IO_SIZE;
+         int dir_cache = DIR_CACHE_SIZE;
 
          dctxt->sec_root = -1;
+         dctxt->direct_align = 0;
          errno = EINVAL;
          char *sec_root_path = "not found";
 
@@ -1585,22 +2177,63 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
                   io_size = atol((char *)root->children->content);
                }
             }
+            else if (root->type == XML_ELEMENT_NODE && strncmp((char *)root->name, "dir_cache", 10) == 0)
+            {
+               // number of directory handles to retain ( zero disables the cache )
+               if (root->children != NULL && root->children->type == XML_TEXT_NODE)
+               {
+                  dir_cache = atoi((char *)root->children->content);
+               }
+            }
+            else if (root->type == XML_ELEMENT_NODE && strncmp((char *)root->name, "direct_io", 10) == 0)
+            {
+               // an optional value overrides the default alignment of O_DIRECT I/O
+               dctxt->direct_align = DIRECT_ALIGN;
+               if (root->children != NULL && root->children->type == XML_TEXT_NODE && atol((char *)root->children->content) > 0)
+               {
+                  dctxt->direct_align = atol((char *)root->children->content);
+               }
+               if (dctxt->direct_align & (dctxt->direct_align - 1))
+               {
+                  LOG(LOG_WARNING, "direct_io alignment of %zu is not a power of two, using %d\n", dctxt->direct_align, DIRECT_ALIGN);
+                  dctxt->direct_align = DIRECT_ALIGN;
+               }
+            }
             root = root->next;
          }
 
+         // O_DIRECT writes are staged in whole sectors, up to the size of a full I/O
+         dctxt->direct_cap = 0;
+         if (dctxt->direct_align)
+         {
+            dctxt->direct_cap = ((io_size + dctxt->direct_align - 1) / dctxt->direct_align) * dctxt->direct_align;
+         }
+
          // make sure the secure root handle was set
          if (dctxt->sec_root == -1)
          {
             LOG(LOG_ERR, "failed to find or open secure root handle: %s\n", sec_root_path);
+            free(dctxt->segs);
+            free(dctxt->segtext);
             free(dctxt);
             return NULL;
          }
 
+         // object operations may then resolve paths relative to cached directory handles
+         dctxt->dircache = NULL;
+         if (dir_cache > 0 && dctxt->dirsegs > 0 && (dctxt->dircache = create_dir_cache(dir_cache)) == NULL)
+         {
+            LOG(LOG_WARNING, "failed to allocate a directory handle cache, paths will be resolved from the secure root\n");
+         }
+
          // allocate and populate a new DAL structure
          DAL pdal = malloc(sizeof(struct DAL_struct));
          if (pdal == NULL)
          {
             LOG(LOG_ERR, "failed to allocate space for a DAL_struct\n");
+            destroy_dir_cache(dctxt->dircache);
+            free(dctxt->segs);
+            free(dctxt->segtext);
             free(dctxt);
             return NULL;
          } // malloc will set errno
@@ -1613,12 +2246,22 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
          pdal->set_meta = posix_set_meta;
          pdal->get_meta = posix_get_meta;
          pdal->put = posix_put;
+         pdal->putv = posix_putv;
+         pdal->checkpoint = posix_checkpoint;
+         pdal->resume = posix_resume;
          pdal->get = posix_get;
+         pdal->getv = posix_getv;
          pdal->abort = posix_abort;
          pdal->close = posix_close;
          pdal->del = posix_del;
          pdal->stat = posix_stat;
          pdal->cleanup = posix_cleanup;
+         // all ops complete synchronously, so asynchronous requests are handled by the generic shim
+         pdal->submit_get = NULL;
+         pdal->submit_put = NULL;
+         pdal->submit_meta = NULL;
+         pdal->poll = NULL;
+         pdal->wait = NULL;
          return pdal;
       }
       else
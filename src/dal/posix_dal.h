@@ -0,0 +1,171 @@
+#ifndef __POSIX_DAL_H__
+#define __POSIX_DAL_H__
+
+
+
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+// Internal definitions shared by the posix DAL and DALs built upon it ( such as posix_uring )
+
+#include "dal.h"
+
+#include <sys/types.h>
+#include <pthread.h>
+
+#define SFX_PADDING 14         // number of extra chars required to fit any suffix combo
+#define WRITE_SFX ".partial"   // 8 characters
+#define REBUILD_SFX ".rebuild" // 8 characters
+#define META_SFX ".meta"       // 5 characters (in ADDITION to other suffixes!)
+
+#define IO_SIZE 1048576 // Preferred I/O Size
+#define DIRECT_ALIGN 4096 // Default alignment of O_DIRECT I/O ( sufficient for logical block sizes of up to 4KiB )
+#define DIR_CACHE_SIZE 64 // Default number of open directory handles retained by each DAL instance
+
+//   -------------    POSIX CONTEXT    -------------
+
+typedef struct posix_block_context_struct
+{
+   int fd;         // File Descriptor (if open)
+   int mfd;        // Meta File Descriptor (if open)
+   int sfd;        // Handle of the directory to which file paths are relative (if open)
+   char *filepath; // File Path (if open)
+   int filelen;    // Length of filepath string
+   int dirlen;     // Length of the directory portion of filepath
+   int diroff;     // Offset of the portion of filepath which is relative to sfd
+   int dirslot;    // Index of the directory cache entry referenced by sfd ( -1 if sfd is the secure root )
+   off_t offset;   // Current file offset (only relevant when reading)
+   DAL_MODE mode;  // Mode in which this block was opened
+   DAL_CTXT dctxt; // Context of the DAL which opened this block
+   size_t dalign;  // Required alignment of data file I/O, if opened with O_DIRECT ( zero otherwise )
+   char *dbuf;     // Aligned staging buffer for O_DIRECT I/O ( if allocated )
+   size_t dcap;    // Size of the staging buffer
+   size_t dfill;   // Amount of written data held in the staging buffer
+   off_t doff;     // Data file offset of the start of the staging buffer ( always aligned )
+} * POSIX_BLOCK_CTXT;
+
+typedef struct posix_template_segment_struct
+{
+   const char *text; // Literal text of this segment ( not NULL terminated )
+   int textlen;      // Length of the literal text
+   char sub;         // Location value substituted after the text ( 'p'/'b'/'c'/'s', or '\0' for none )
+} POSIX_TMPL_SEG;
+
+typedef struct posix_dir_handle_struct
+{
+   DAL_location loc;   // Location of the directory ( values not referenced by the directory template are zero )
+   int fd;             // Open handle of the directory ( -1 if this entry is unused )
+   int refs;           // Number of block contexts currently relying upon this handle
+   unsigned long used; // Value of the cache clock when this handle was last referenced
+} POSIX_DIR_HANDLE;
+
+typedef struct posix_dir_cache_struct
+{
+   pthread_mutex_t lock;      // Lock protecting all cache state
+   POSIX_DIR_HANDLE *handles; // Cache entries
+   int size;                  // Number of cache entries
+   unsigned long clock;       // Incremented by every lookup, to identify the least recently used entry
+} * POSIX_DIR_CACHE;
+
+typedef struct posix_dal_context_struct
+{
+   char *dirtmp;         // Template string for generating directory paths
+   int tmplen;           // Length of the dirtmp string
+   POSIX_TMPL_SEG *segs; // Compiled form of dirtmp
+   int nsegs;            // Number of compiled segments
+   int dirsegs;          // Number of leading segments which produce the directory portion of a path
+   DAL_location dirvals; // Flags for each location value referenced by the directory portion of dirtmp
+   char *segtext;        // Literal text of all compiled segments
+   DAL_location max_loc; // Maximum pod/cap/block/scatter values
+   int dirpad;           // Number of chars by which dirtmp may expand via substitutions
+   int sec_root;         // Handle of secure root directory
+   size_t direct_align;  // Alignment of O_DIRECT data file I/O ( zero if data files should use the page cache )
+   size_t direct_cap;    // Size of the O_DIRECT write staging buffer of each block
+   POSIX_DIR_CACHE dircache; // Cache of open directory handles ( NULL if disabled )
+} * POSIX_DAL_CTXT;
+
+//   -------------    POSIX INTERNAL FUNCTIONS    -------------
+
+int expand_dir_template(POSIX_DAL_CTXT dctxt, POSIX_BLOCK_CTXT bctxt, DAL_location loc, const char *objID);
+void acquire_dir_handle(POSIX_DAL_CTXT dctxt, POSIX_BLOCK_CTXT bctxt, DAL_location loc);
+void free_block_path(POSIX_BLOCK_CTXT bctxt);
+int unlink_working_files(POSIX_BLOCK_CTXT bctxt, const char *working_suffix);
+int block_delete(POSIX_BLOCK_CTXT bctxt, char components);
+
+//   -------------    POSIX IMPLEMENTATION    -------------
+
+int posix_verify(DAL_CTXT ctxt, char fix);
+int posix_migrate(DAL_CTXT ctxt, const char *objID, DAL_location src, DAL_location dest, char offline);
+int posix_del(DAL_CTXT ctxt, DAL_location location, const char *objID);
+int posix_stat(DAL_CTXT ctxt, DAL_location location, const char *objID);
+int posix_cleanup(DAL dal);
+BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const char *objID);
+int posix_set_meta(BLOCK_CTXT ctxt, const char *meta_buf, size_t size);
+ssize_t posix_get_meta(BLOCK_CTXT ctxt, char *meta_buf, size_t size);
+int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size);
+int posix_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt);
+int posix_checkpoint(BLOCK_CTXT ctxt, const char *meta_buf, size_t size);
+int posix_resume(BLOCK_CTXT ctxt, off_t offset);
+ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
+ssize_t posix_getv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset);
+int posix_abort(BLOCK_CTXT ctxt);
+int posix_close(BLOCK_CTXT ctxt);
+
+#endif
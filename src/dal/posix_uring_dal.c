@@ -0,0 +1,1440 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+/*
+The posix_uring DAL stores objects exactly as the posix DAL does ( same dir_template, sec_root, and 
+'.partial' / '.rebuild' / '.meta' file conventions ), but routes opens, reads, writes, syncs, closes, 
+and renames through a single io_uring instance shared by every block of the DAL.
+
+Block threads place their requests into the shared submission queue and whichever thread finds 
+queued entries submits all of them at once, so concurrent requests from many blocks are batched 
+into few io_uring_enter() calls.  A dedicated thread reaps completions and wakes each requester.
+The asynchronous DAL functions are native to this DAL : submit_get / submit_put / submit_meta each 
+place a single entry and return at once ( never staging data through registered buffers ), allowing a 
+requester to keep any number of ops in flight before collecting their results via poll / wait.
+
+Additional ( optional ) config elements, beyond those of the posix DAL :
+   <queue_depth>N</queue_depth>    : number of submission queue entries ( default 256 )
+   <reg_buffers>N</reg_buffers>    : number of io_size buffers to register with the ring ( default 0 )
+                                     data is staged through these for READ_FIXED / WRITE_FIXED ops
+
+If io_uring is unavailable ( at build time or at run time ), this DAL falls back to the plain posix DAL.
+*/
+
+#include "erasureUtils_auto_config.h"
+#if defined(DEBUG_ALL) || defined(DEBUG_DAL)
+#define DEBUG 1
+#endif
+#define LOG_PREFIX "posix_uring_dal"
+
+#include "logging/logging.h"
+#include "posix_dal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define URING_QUEUE_DEPTH 256 // default number of submission queue entries
+#define URING_MAX_LINK 4      // largest number of ops submitted together by any single DAL call
+
+//   -------------    POSIX_URING CONTEXT    -------------
+
+typedef struct uring_request_struct
+{
+   int res;             // result of the completed op ( negative errno values on failure )
+   char done;           // flag indicating that the op has completed
+   pthread_cond_t cond; // signaled upon completion
+} uring_request;
+
+typedef struct uring_async_struct
+{
+   uring_request req; // completion state of the op
+   int op;            // IORING_OP_READ or IORING_OP_WRITE
+   const char *buf;   // buffer of the op
+   size_t size;       // size of the op
+   off_t offset;      // target offset of the op ( -1 for the current file position )
+} * URING_ASYNC_REQ;
+
+typedef struct uring_dal_context_struct
+{
+   struct posix_dal_context_struct pctxt; // NOTE -- must be first, so that posix functions can operate on this context
+   // ring state
+   int ringfd;                // io_uring file descriptor
+   void *sqmap;               // mapping of the submission ring
+   size_t sqmaplen;           // length of the submission ring mapping
+   void *cqmap;               // mapping of the completion ring ( may match sqmap )
+   size_t cqmaplen;           // length of the completion ring mapping
+   struct io_uring_sqe *sqes; // mapping of the submission queue entries
+   size_t sqeslen;            // length of the submission queue entry mapping
+   unsigned int *sqhead;
+   unsigned int *sqtail;
+   unsigned int sqmask;
+   unsigned int sqentries;
+   unsigned int *sqarray;
+   unsigned int *cqhead;
+   unsigned int *cqtail;
+   unsigned int cqmask;
+   unsigned int cqentries;
+   struct io_uring_cqe *cqes;
+   // submission state
+   pthread_mutex_t lock;  // protects all following fields
+   pthread_cond_t space;  // signaled whenever ring capacity is released
+   unsigned int queued;   // number of entries placed in the ring, but not yet submitted
+   unsigned int inflight; // number of entries placed in the ring, but not yet reaped
+   char flushing;         // flag indicating that some thread is submitting queued entries
+   int broken;            // errno value of any unrecoverable submission failure
+   pthread_t reaper;      // completion thread
+   // registered buffers
+   int nbufs;             // number of registered buffers ( zero if disabled )
+   size_t bufsz;          // size of each registered buffer
+   char *bufmem;          // allocation backing all registered buffers
+   int *freebufs;         // stack of unused buffer indices
+   int nfree;             // number of unused buffers
+   pthread_cond_t bufavail; // signaled whenever a registered buffer is released
+} * URING_DAL_CTXT;
+
+//   -------------    POSIX_URING INTERNAL FUNCTIONS    -------------
+
+/** (INTERNAL HELPER FUNCTION)
+ * Populate a submission queue entry
+ * @param struct io_uring_sqe* sqe : Entry to be populated
+ * @param int op : IORING_OP_* value
+ * @param int fd : Target file descriptor
+ * @param const void* addr : Buffer or path reference
+ * @param unsigned int len : Buffer length ( or op specific value )
+ * @param off_t offset : Target file offset ( or op specific value )
+ */
+static void uring_prep(struct io_uring_sqe *sqe, int op, int fd, const void *addr, unsigned int len, off_t offset)
+{
+   memset(sqe, 0, sizeof(struct io_uring_sqe));
+   sqe->opcode = op;
+   sqe->fd = fd;
+   sqe->addr = (unsigned long)addr;
+   sqe->len = len;
+   sqe->off = offset;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Submit all queued entries of the ring, unless another thread is already doing so
+ * NOTE -- caller must hold the ring lock
+ * @param URING_DAL_CTXT uctxt : Context of the ring
+ */
+static void uring_flush(URING_DAL_CTXT uctxt)
+{
+   if (uctxt->flushing)
+   {
+      return;
+   } // the active submitter will pick up our entries as well
+   uctxt->flushing = 1;
+   while (uctxt->queued && !uctxt->broken)
+   {
+      unsigned int count = uctxt->queued;
+      pthread_mutex_unlock(&uctxt->lock);
+      int res = syscall(__NR_io_uring_enter, uctxt->ringfd, count, 0, 0, NULL, 0);
+      int enterr = errno;
+      pthread_mutex_lock(&uctxt->lock);
+      if (res < 0)
+      {
+         if (enterr == EINTR || enterr == EAGAIN || enterr == EBUSY)
+         {
+            pthread_mutex_unlock(&uctxt->lock);
+            sched_yield();
+            pthread_mutex_lock(&uctxt->lock);
+            continue;
+         }
+         LOG(LOG_ERR, "failed to submit %u ring entries (%s)\n", count, strerror(enterr));
+         uctxt->broken = enterr;
+         pthread_cond_broadcast(&uctxt->space);
+         break;
+      }
+      uctxt->queued -= res;
+   }
+   uctxt->flushing = 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Place a sequence of entries into the ring and submit them, without waiting for their completion
+ * NOTE -- entries which are flagged with IOSQE_IO_LINK will be placed contiguously
+ * @param URING_DAL_CTXT uctxt : Context of the ring
+ * @param struct io_uring_sqe* ops : Array of populated entries
+ * @param uring_request* reqs : Array of request structs, one per entry, to be populated with results
+ *                              ( these must remain valid until each is flagged as done )
+ * @param int count : Number of entries
+ * @return int : Zero on success, -1 if the ops could not be submitted
+ */
+static int uring_queue(URING_DAL_CTXT uctxt, struct io_uring_sqe *ops, uring_request *reqs, int count)
+{
+   pthread_mutex_lock(&uctxt->lock);
+   // wait for enough space in both the submission and completion queues
+   while (!uctxt->broken &&
+          (uctxt->inflight + count > uctxt->cqentries ||
+           (*uctxt->sqtail - __atomic_load_n(uctxt->sqhead, __ATOMIC_ACQUIRE)) + count > uctxt->sqentries))
+   {
+      pthread_cond_wait(&uctxt->space, &uctxt->lock);
+   }
+   if (uctxt->broken)
+   {
+      pthread_mutex_unlock(&uctxt->lock);
+      LOG(LOG_ERR, "ring is unusable due to a previous submission failure\n");
+      errno = uctxt->broken;
+      return -1;
+   }
+   // place all entries into the ring
+   unsigned int tail = *uctxt->sqtail;
+   int i;
+   for (i = 0; i < count; i++)
+   {
+      unsigned int index = tail & uctxt->sqmask;
+      reqs[i].done = 0;
+      reqs[i].res = 0;
+      pthread_cond_init(&reqs[i].cond, NULL);
+      ops[i].user_data = (unsigned long)&reqs[i];
+      uctxt->sqes[index] = ops[i];
+      uctxt->sqarray[index] = index;
+      tail++;
+   }
+   __atomic_store_n(uctxt->sqtail, tail, __ATOMIC_RELEASE);
+   uctxt->queued += count;
+   uctxt->inflight += count;
+   uring_flush(uctxt);
+   pthread_mutex_unlock(&uctxt->lock);
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Place a sequence of entries into the ring, submit them, and wait for all of them to complete
+ * NOTE -- entries which are flagged with IOSQE_IO_LINK will be placed contiguously
+ * @param URING_DAL_CTXT uctxt : Context of the ring
+ * @param struct io_uring_sqe* ops : Array of populated entries
+ * @param uring_request* reqs : Array of request structs, one per entry, to be populated with results
+ * @param int count : Number of entries
+ * @return int : Zero on success ( regardless of per-op results ), -1 if the ops could not be submitted
+ */
+static int uring_run(URING_DAL_CTXT uctxt, struct io_uring_sqe *ops, uring_request *reqs, int count)
+{
+   if (uring_queue(uctxt, ops, reqs, count))
+   {
+      return -1;
+   }
+   pthread_mutex_lock(&uctxt->lock);
+   // wait for all completions
+   int i;
+   for (i = 0; i < count; i++)
+   {
+      while (!reqs[i].done)
+      {
+         pthread_cond_wait(&reqs[i].cond, &uctxt->lock);
+      }
+   }
+   pthread_mutex_unlock(&uctxt->lock);
+   for (i = 0; i < count; i++)
+   {
+      pthread_cond_destroy(&reqs[i].cond);
+   }
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Reap completions from the ring, waking each associated requester
+ * NOTE -- a completion with no associated request terminates this thread
+ * @param void* arg : Context of the ring
+ * @return void* : Always NULL
+ */
+static void *uring_reaper(void *arg)
+{
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)arg;
+   char stop = 0;
+   while (!stop)
+   {
+      if (syscall(__NR_io_uring_enter, uctxt->ringfd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR)
+      {
+         LOG(LOG_ERR, "failed to wait for ring completions (%s)\n", strerror(errno));
+         sched_yield();
+      }
+      pthread_mutex_lock(&uctxt->lock);
+      unsigned int head = *uctxt->cqhead;
+      unsigned int tail = __atomic_load_n(uctxt->cqtail, __ATOMIC_ACQUIRE);
+      for (; head != tail; head++)
+      {
+         struct io_uring_cqe *cqe = &uctxt->cqes[head & uctxt->cqmask];
+         uring_request *req = (uring_request *)(unsigned long)cqe->user_data;
+         if (req == NULL)
+         {
+            stop = 1;
+         }
+         else
+         {
+            req->res = cqe->res;
+            req->done = 1;
+            pthread_cond_signal(&req->cond);
+         }
+         uctxt->inflight--;
+      }
+      __atomic_store_n(uctxt->cqhead, head, __ATOMIC_RELEASE);
+      pthread_cond_broadcast(&uctxt->space);
+      pthread_mutex_unlock(&uctxt->lock);
+   }
+   return NULL;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Acquire an unused registered buffer, waiting for one to be released if necessary
+ * @param URING_DAL_CTXT uctxt : Context of the ring
+ * @return int : Index of the acquired buffer
+ */
+static int uring_get_buf(URING_DAL_CTXT uctxt)
+{
+   pthread_mutex_lock(&uctxt->lock);
+   while (uctxt->nfree == 0)
+   {
+      pthread_cond_wait(&uctxt->bufavail, &uctxt->lock);
+   }
+   uctxt->nfree--;
+   int index = uctxt->freebufs[uctxt->nfree];
+   pthread_mutex_unlock(&uctxt->lock);
+   return index;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Release a previously acquired registered buffer
+ * @param URING_DAL_CTXT uctxt : Context of the ring
+ * @param int index : Index of the buffer to be released
+ */
+static void uring_put_buf(URING_DAL_CTXT uctxt, int index)
+{
+   pthread_mutex_lock(&uctxt->lock);
+   uctxt->freebufs[uctxt->nfree] = index;
+   uctxt->nfree++;
+   pthread_cond_signal(&uctxt->bufavail);
+   pthread_mutex_unlock(&uctxt->lock);
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Perform a single read or write op, staging the data through a registered buffer, if possible
+ * @param URING_DAL_CTXT uctxt : Context of the ring
+ * @param int write : Non-zero for a write op, zero for a read op
+ * @param int fd : Target file descriptor
+ * @param void* buf : Source / destination buffer
+ * @param size_t size : Size of the op ( limited to the registered buffer size, if staged )
+ * @param off_t offset : Target file offset ( -1 to use, and update, the current file position )
+ * @return ssize_t : Byte count of the completed op, or -1 on failure ( errno is set )
+ */
+static ssize_t uring_rw(URING_DAL_CTXT uctxt, int write, int fd, void *buf, size_t size, off_t offset)
+{
+   struct io_uring_sqe op;
+   uring_request req;
+   int bufindex = -1;
+   if (uctxt->nbufs && offset >= 0)
+   {
+      bufindex = uring_get_buf(uctxt);
+      if (size > uctxt->bufsz)
+      {
+         size = uctxt->bufsz;
+      }
+      char *fixed = uctxt->bufmem + (uctxt->bufsz * bufindex);
+      if (write)
+      {
+         memcpy(fixed, buf, size);
+      }
+      uring_prep(&op, (write) ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED, fd, fixed, size, offset);
+      op.buf_index = bufindex;
+   }
+   else
+   {
+      uring_prep(&op, (write) ? IORING_OP_WRITE : IORING_OP_READ, fd, buf, size, offset);
+   }
+   if (uring_run(uctxt, &op, &req, 1))
+   {
+      if (bufindex >= 0)
+      {
+         uring_put_buf(uctxt, bufindex);
+      }
+      return -1;
+   }
+   if (bufindex >= 0)
+   {
+      if (!write && req.res > 0)
+      {
+         memcpy(buf, uctxt->bufmem + (uctxt->bufsz * bufindex), req.res);
+      }
+      uring_put_buf(uctxt, bufindex);
+   }
+   if (req.res < 0)
+   {
+      errno = -req.res;
+      return -1;
+   }
+   return req.res;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Begin an op of the given block, returning without waiting for its completion
+ * NOTE -- async ops never stage data through registered buffers
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of the op
+ * @param int op : IORING_OP_READ or IORING_OP_WRITE
+ * @param int fd : Target file descriptor
+ * @param const void* buf : Buffer of the op ( must remain valid until the op completes )
+ * @param size_t size : Size of the op
+ * @param off_t offset : Target offset of the op ( -1 for the current file position )
+ * @return URING_ASYNC_REQ : Reference to the new request, or NULL on failure
+ */
+static URING_ASYNC_REQ uring_submit(POSIX_BLOCK_CTXT bctxt, int op, int fd, const void *buf, size_t size, off_t offset)
+{
+   URING_ASYNC_REQ areq = malloc(sizeof(struct uring_async_struct));
+   if (areq == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate space for a posix_uring request\n");
+      return NULL;
+   }
+   areq->op = op;
+   areq->buf = buf;
+   areq->size = size;
+   areq->offset = offset;
+   struct io_uring_sqe sqe;
+   uring_prep(&sqe, op, fd, buf, size, offset);
+   if (uring_queue((URING_DAL_CTXT)bctxt->dctxt, &sqe, &(areq->req), 1))
+   {
+      free(areq);
+      return NULL;
+   }
+   return areq;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Finalize a completed async op of the given block, and free the request
+ * @param POSIX_BLOCK_CTXT bctxt : Block context of the op
+ * @param URING_ASYNC_REQ areq : Completed request
+ * @return ssize_t : Return value of the equivalent synchronous DAL function
+ */
+static ssize_t uring_complete(POSIX_BLOCK_CTXT bctxt, URING_ASYNC_REQ areq)
+{
+   pthread_cond_destroy(&(areq->req.cond));
+   ssize_t res = areq->req.res;
+   if (res < 0)
+   {
+      errno = -res;
+      LOG(LOG_ERR, "async %s of %zu bytes at offset %zd of \"%s\" failed (%s)\n", (areq->op == IORING_OP_WRITE) ? "write" : "read", areq->size, areq->offset, bctxt->filepath, strerror(errno));
+      res = -1;
+   }
+   else if (areq->op == IORING_OP_WRITE)
+   {
+      // continue after any short write, via synchronous ops
+      const char *parse = areq->buf + res;
+      size_t size = areq->size - res;
+      off_t offset = areq->offset + res;
+      res = 0;
+      while (size)
+      {
+         ssize_t wres = uring_rw((URING_DAL_CTXT)bctxt->dctxt, 1, bctxt->fd, (void *)parse, size, offset);
+         if (wres <= 0)
+         {
+            LOG(LOG_ERR, "write to \"%s\" failed (%s)\n", bctxt->filepath, (wres) ? strerror(errno) : "no progress");
+            if (wres == 0)
+            {
+               errno = EIO;
+            }
+            res = -1;
+            break;
+         }
+         parse += wres;
+         size -= wres;
+         offset += wres;
+      }
+   }
+   free(areq);
+   return res;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Duplicate the file path of the given block, appending the given suffixes
+ * @param POSIX_BLOCK_CTXT bctxt : Block context whose path should be duplicated
+ * @param const char* sfx : First suffix to append ( may be NULL )
+ * @param const char* sfx2 : Second suffix to append ( may be NULL )
+ * @return char* : Newly allocated path string, or NULL on failure
+ */
+static char *suffixed_path(POSIX_BLOCK_CTXT bctxt, const char *sfx, const char *sfx2)
+{
+   char *path = malloc(sizeof(char) * (bctxt->filelen + SFX_PADDING + 1));
+   if (path == NULL)
+   {
+      return NULL;
+   } // malloc will set errno
+   snprintf(path, bctxt->filelen + SFX_PADDING + 1, "%s%s%s", bctxt->filepath, (sfx) ? sfx : "", (sfx2) ? sfx2 : "");
+   return path;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Tear down the ring of the given context
+ * @param URING_DAL_CTXT uctxt : Context of the ring
+ * @param int reaping : Non-zero if the completion thread has been started
+ */
+static void uring_teardown(URING_DAL_CTXT uctxt, int reaping)
+{
+   if (reaping)
+   {
+      // queue a completion with no associated request, to terminate the reaper
+      pthread_mutex_lock(&uctxt->lock);
+      while (!uctxt->broken && (*uctxt->sqtail - __atomic_load_n(uctxt->sqhead, __ATOMIC_ACQUIRE)) >= uctxt->sqentries)
+      {
+         pthread_cond_wait(&uctxt->space, &uctxt->lock);
+      }
+      if (uctxt->broken)
+      {
+         pthread_mutex_unlock(&uctxt->lock);
+         pthread_cancel(uctxt->reaper);
+      }
+      else
+      {
+         unsigned int index = *uctxt->sqtail & uctxt->sqmask;
+         uring_prep(&uctxt->sqes[index], IORING_OP_NOP, -1, NULL, 0, 0);
+         uctxt->sqes[index].user_data = 0;
+         uctxt->sqarray[index] = index;
+         __atomic_store_n(uctxt->sqtail, *uctxt->sqtail + 1, __ATOMIC_RELEASE);
+         uctxt->queued++;
+         uctxt->inflight++;
+         uring_flush(uctxt);
+         pthread_mutex_unlock(&uctxt->lock);
+      }
+      pthread_join(uctxt->reaper, NULL);
+   }
+   if (uctxt->sqes)
+   {
+      munmap(uctxt->sqes, uctxt->sqeslen);
+   }
+   if (uctxt->cqmap && uctxt->cqmap != uctxt->sqmap)
+   {
+      munmap(uctxt->cqmap, uctxt->cqmaplen);
+   }
+   if (uctxt->sqmap)
+   {
+      munmap(uctxt->sqmap, uctxt->sqmaplen);
+   }
+   if (uctxt->ringfd >= 0)
+   {
+      close(uctxt->ringfd); // also releases any registered buffers
+   }
+   if (uctxt->bufmem)
+   {
+      free(uctxt->bufmem);
+   }
+   if (uctxt->freebufs)
+   {
+      free(uctxt->freebufs);
+   }
+   pthread_cond_destroy(&uctxt->bufavail);
+   pthread_cond_destroy(&uctxt->space);
+   pthread_mutex_destroy(&uctxt->lock);
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Verify that the kernel supports every io_uring op used by this DAL
+ * NOTE -- kernels which cannot report their supported ops ( those prior to 5.6 ) lack several of them
+ * @param int ringfd : File descriptor of a new ring
+ * @return int : Zero if every op is supported, -1 if not
+ */
+static int uring_probe_ops(int ringfd)
+{
+   static const int required[] = {IORING_OP_NOP, IORING_OP_OPENAT, IORING_OP_CLOSE, IORING_OP_RENAMEAT,
+                                  IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READV, IORING_OP_WRITEV,
+                                  IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED, IORING_OP_FSYNC};
+   unsigned int nops = 256; // the most that a probe may describe
+   struct io_uring_probe *probe = calloc(1, sizeof(struct io_uring_probe) + (nops * sizeof(struct io_uring_probe_op)));
+   if (probe == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate space for an io_uring probe\n");
+      return -1;
+   }
+   if (syscall(__NR_io_uring_register, ringfd, IORING_REGISTER_PROBE, probe, nops))
+   {
+      LOG(LOG_ERR, "kernel cannot report its supported io_uring ops (%s)\n", strerror(errno));
+      free(probe);
+      return -1;
+   }
+   int i;
+   for (i = 0; i < sizeof(required) / sizeof(int); i++)
+   {
+      if (required[i] > probe->last_op || !(probe->ops[required[i]].flags & IO_URING_OP_SUPPORTED))
+      {
+         LOG(LOG_ERR, "kernel does not support io_uring op %d\n", required[i]);
+         free(probe);
+         return -1;
+      }
+   }
+   free(probe);
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Create and map a new ring for the given context, register any buffers, and start the completion thread
+ * @param URING_DAL_CTXT uctxt : Context to be populated with the new ring
+ * @param unsigned int depth : Number of submission queue entries
+ * @param int nbufs : Number of buffers to register
+ * @param size_t bufsz : Size of each registered buffer
+ * @return int : Zero on success, -1 on failure
+ */
+static int uring_setup(URING_DAL_CTXT uctxt, unsigned int depth, int nbufs, size_t bufsz)
+{
+   uctxt->ringfd = -1;
+   uctxt->sqmap = NULL;
+   uctxt->cqmap = NULL;
+   uctxt->sqes = NULL;
+   uctxt->queued = 0;
+   uctxt->inflight = 0;
+   uctxt->flushing = 0;
+   uctxt->broken = 0;
+   uctxt->nbufs = 0;
+   uctxt->bufsz = bufsz;
+   uctxt->bufmem = NULL;
+   uctxt->freebufs = NULL;
+   uctxt->nfree = 0;
+   pthread_mutex_init(&uctxt->lock, NULL);
+   pthread_cond_init(&uctxt->space, NULL);
+   pthread_cond_init(&uctxt->bufavail, NULL);
+
+   struct io_uring_params params;
+   memset(&params, 0, sizeof(struct io_uring_params));
+   uctxt->ringfd = syscall(__NR_io_uring_setup, depth, &params);
+   if (uctxt->ringfd < 0)
+   {
+      LOG(LOG_ERR, "failed to create a ring of depth %u (%s)\n", depth, strerror(errno));
+      uring_teardown(uctxt, 0);
+      return -1;
+   }
+   // older kernels accept the ring, yet would reject every op which they do not support
+   if (uring_probe_ops(uctxt->ringfd))
+   {
+      uring_teardown(uctxt, 0);
+      return -1;
+   }
+
+   // map the submission and completion rings
+   uctxt->sqmaplen = params.sq_off.array + (params.sq_entries * sizeof(unsigned int));
+   uctxt->cqmaplen = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+   if (params.features & IORING_FEAT_SINGLE_MMAP)
+   {
+      if (uctxt->cqmaplen > uctxt->sqmaplen)
+      {
+         uctxt->sqmaplen = uctxt->cqmaplen;
+      }
+      uctxt->cqmaplen = uctxt->sqmaplen;
+   }
+   uctxt->sqmap = mmap(NULL, uctxt->sqmaplen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uctxt->ringfd, IORING_OFF_SQ_RING);
+   if (uctxt->sqmap == MAP_FAILED)
+   {
+      LOG(LOG_ERR, "failed to map the submission ring (%s)\n", strerror(errno));
+      uctxt->sqmap = NULL;
+      uring_teardown(uctxt, 0);
+      return -1;
+   }
+   if (params.features & IORING_FEAT_SINGLE_MMAP)
+   {
+      uctxt->cqmap = uctxt->sqmap;
+   }
+   else
+   {
+      uctxt->cqmap = mmap(NULL, uctxt->cqmaplen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uctxt->ringfd, IORING_OFF_CQ_RING);
+      if (uctxt->cqmap == MAP_FAILED)
+      {
+         LOG(LOG_ERR, "failed to map the completion ring (%s)\n", strerror(errno));
+         uctxt->cqmap = NULL;
+         uring_teardown(uctxt, 0);
+         return -1;
+      }
+   }
+   uctxt->sqeslen = params.sq_entries * sizeof(struct io_uring_sqe);
+   uctxt->sqes = mmap(NULL, uctxt->sqeslen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uctxt->ringfd, IORING_OFF_SQES);
+   if (uctxt->sqes == MAP_FAILED)
+   {
+      LOG(LOG_ERR, "failed to map the submission queue entries (%s)\n", strerror(errno));
+      uctxt->sqes = NULL;
+      uring_teardown(uctxt, 0);
+      return -1;
+   }
+   char *sqbase = (char *)uctxt->sqmap;
+   char *cqbase = (char *)uctxt->cqmap;
+   uctxt->sqhead = (unsigned int *)(sqbase + params.sq_off.head);
+   uctxt->sqtail = (unsigned int *)(sqbase + params.sq_off.tail);
+   uctxt->sqmask = *(unsigned int *)(sqbase + params.sq_off.ring_mask);
+   uctxt->sqentries = params.sq_entries;
+   uctxt->sqarray = (unsigned int *)(sqbase + params.sq_off.array);
+   uctxt->cqhead = (unsigned int *)(cqbase + params.cq_off.head);
+   uctxt->cqtail = (unsigned int *)(cqbase + params.cq_off.tail);
+   uctxt->cqmask = *(unsigned int *)(cqbase + params.cq_off.ring_mask);
+   uctxt->cqentries = params.cq_entries;
+   uctxt->cqes = (struct io_uring_cqe *)(cqbase + params.cq_off.cqes);
+
+   // register any staging buffers
+   if (nbufs > 0)
+   {
+      struct iovec *iovs = malloc(sizeof(struct iovec) * nbufs);
+      uctxt->freebufs = malloc(sizeof(int) * nbufs);
+      if (iovs == NULL || uctxt->freebufs == NULL || posix_memalign((void **)&uctxt->bufmem, getpagesize(), bufsz * nbufs))
+      {
+         LOG(LOG_ERR, "failed to allocate %d registered buffers of %zu bytes\n", nbufs, bufsz);
+         uctxt->bufmem = NULL;
+         if (iovs)
+         {
+            free(iovs);
+         }
+         uring_teardown(uctxt, 0);
+         return -1;
+      }
+      int i;
+      for (i = 0; i < nbufs; i++)
+      {
+         iovs[i].iov_base = uctxt->bufmem + (bufsz * i);
+         iovs[i].iov_len = bufsz;
+         uctxt->freebufs[i] = i;
+      }
+      if (syscall(__NR_io_uring_register, uctxt->ringfd, IORING_REGISTER_BUFFERS, iovs, nbufs))
+      {
+         LOG(LOG_ERR, "failed to register %d buffers of %zu bytes (%s)\n", nbufs, bufsz, strerror(errno));
+         free(iovs);
+         uring_teardown(uctxt, 0);
+         return -1;
+      }
+      free(iovs);
+      uctxt->nbufs = nbufs;
+      uctxt->nfree = nbufs;
+   }
+
+   if ((errno = pthread_create(&uctxt->reaper, NULL, uring_reaper, uctxt)))
+   {
+      LOG(LOG_ERR, "failed to start the ring completion thread (%s)\n", strerror(errno));
+      uring_teardown(uctxt, 0);
+      return -1;
+   }
+   LOG(LOG_INFO, "created a ring with %u submission / %u completion entries and %d registered buffers\n",
+       uctxt->sqentries, uctxt->cqentries, uctxt->nbufs);
+   return 0;
+}
+
+//   -------------    POSIX_URING IMPLEMENTATION    -------------
+
+int posix_uring_cleanup(DAL dal)
+{
+   if (dal == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL dal!\n");
+      return -1;
+   }
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)dal->ctxt; // should have been passed a posix_uring context
+
+   uring_teardown(uctxt, 1);
+   // the posix DAL frees the remainder of our state
+   return posix_cleanup(dal);
+}
+
+BLOCK_CTXT posix_uring_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const char *objID)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL dal context!\n");
+      return NULL;
+   }
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)ctxt; // should have been passed a posix_uring context
+
+   // allocate space for a new BLOCK context
+   POSIX_BLOCK_CTXT bctxt = malloc(sizeof(struct posix_block_context_struct));
+   if (bctxt == NULL)
+   {
+      return NULL;
+   } // malloc will set errno
+
+   // popultate the full file path for this object
+   if (expand_dir_template(&uctxt->pctxt, bctxt, location, objID) != 0)
+   {
+      free(bctxt);
+      return NULL;
+   }
+   acquire_dir_handle(&uctxt->pctxt, bctxt, location);
+
+   // populate other BLOCK context fields
+   bctxt->offset = 0;
+   bctxt->mode = mode;
+   bctxt->fd = -1;
+   bctxt->mfd = -1;
+   bctxt->dalign = 0; // data files are never opened with O_DIRECT
+   bctxt->dbuf = NULL;
+   bctxt->dcap = 0;
+   bctxt->dfill = 0;
+   bctxt->doff = 0;
+
+   const char *sfx = NULL;
+   int oflags = O_WRONLY | O_CREAT | O_TRUNC;
+   int moflags = oflags;
+   if (mode == DAL_READ || mode == DAL_METAREAD)
+   {
+      LOG(LOG_INFO, "Open for %s\n", (mode == DAL_READ) ? "READ" : "METAREAD");
+      oflags = O_RDONLY;
+      moflags = oflags;
+   }
+   else if (mode == DAL_WRITE)
+   {
+      LOG(LOG_INFO, "Open for WRITE\n");
+      sfx = WRITE_SFX;
+      // a new version of the object invalidates any interrupted rebuild of the previous one
+      if (unlink_working_files(bctxt, REBUILD_SFX))
+      {
+         LOG(LOG_ERR, "failed to remove rebuild files of a previous version of \"%s\"\n", bctxt->filepath);
+         free_block_path(bctxt);
+         free(bctxt);
+         return NULL;
+      }
+   }
+   else if (mode == DAL_REBUILD || mode == DAL_RESUME)
+   {
+      LOG(LOG_INFO, "Open for %s\n", (mode == DAL_REBUILD) ? "REBUILD" : "RESUME");
+      sfx = REBUILD_SFX;
+      if (mode == DAL_RESUME)
+      {
+         // keep any data and checkpoint meta info of the interrupted rebuild
+         oflags = O_WRONLY | O_CREAT;
+         moflags = O_RDWR | O_CREAT;
+      }
+   }
+   else
+   {
+      LOG(LOG_ERR, "received an invalid open mode: %d\n", mode);
+      errno = EINVAL;
+      free_block_path(bctxt);
+      free(bctxt);
+      return NULL;
+   }
+
+   char *metapath = suffixed_path(bctxt, META_SFX, sfx);
+   char *datapath = suffixed_path(bctxt, sfx, NULL);
+   if (metapath == NULL || datapath == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate space for suffixed file paths!\n");
+      free(metapath);
+      free(datapath);
+      free_block_path(bctxt);
+      free(bctxt);
+      return NULL;
+   }
+
+   // open the meta and data files together
+   struct io_uring_sqe ops[2];
+   uring_request reqs[2];
+   int count = (mode == DAL_METAREAD) ? 1 : 2;
+   uring_prep(&ops[0], IORING_OP_OPENAT, bctxt->sfd, metapath + bctxt->diroff, S_IRWXU | S_IRWXG | S_IRWXO, 0);
+   ops[0].open_flags = moflags;
+   uring_prep(&ops[1], IORING_OP_OPENAT, bctxt->sfd, datapath + bctxt->diroff, S_IRWXU | S_IRWXG | S_IRWXO, 0);
+   ops[1].open_flags = oflags;
+   mode_t mask = umask(0);
+   int res = uring_run(uctxt, ops, reqs, count);
+   umask(mask);
+   if (res)
+   {
+      free(metapath);
+      free(datapath);
+      free_block_path(bctxt);
+      free(bctxt);
+      return NULL;
+   }
+
+   bctxt->mfd = reqs[0].res;
+   if (bctxt->mfd < 0)
+   {
+      LOG(LOG_ERR, "failed to open meta file: \"%s\" (%s)\n", metapath, strerror(-reqs[0].res));
+      errno = -reqs[0].res;
+      if (mode == DAL_METAREAD)
+      {
+         free(metapath);
+         free(datapath);
+         free_block_path(bctxt);
+         free(bctxt);
+         return NULL;
+      }
+   }
+   if (mode != DAL_METAREAD)
+   {
+      bctxt->fd = reqs[1].res;
+      if (bctxt->fd < 0)
+      {
+         LOG(LOG_ERR, "failed to open file: \"%s\" (%s)\n", datapath, strerror(-reqs[1].res));
+         if (bctxt->mfd >= 0)
+         {
+            close(bctxt->mfd);
+         }
+         errno = -reqs[1].res;
+         free(metapath);
+         free(datapath);
+         free_block_path(bctxt);
+         free(bctxt);
+         return NULL;
+      }
+   }
+   free(metapath);
+   free(datapath);
+
+   // finally, return a reference to our BLOCK context
+   return bctxt;
+}
+
+int posix_uring_set_meta(BLOCK_CTXT ctxt, const char *meta_buf, size_t size)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+
+   // write the provided buffer out to the sidecar file, replacing any checkpoint meta info
+   if (uring_rw(uctxt, 1, bctxt->mfd, (void *)meta_buf, size, 0) != size || ftruncate(bctxt->mfd, size))
+   {
+      LOG(LOG_ERR, "failed to write buffer to meta file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+
+   return 0;
+}
+
+ssize_t posix_uring_get_meta(BLOCK_CTXT ctxt, char *meta_buf, size_t size)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+
+   // read from the current position of the meta file, as the posix DAL does
+   return uring_rw(uctxt, 0, bctxt->mfd, meta_buf, size, -1);
+}
+
+int posix_uring_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+
+   // write at our tracked offset, continuing after any short write
+   const char *parse = buf;
+   while (size)
+   {
+      ssize_t res = uring_rw(uctxt, 1, bctxt->fd, (void *)parse, size, bctxt->offset);
+      if (res <= 0)
+      {
+         LOG(LOG_ERR, "write to \"%s\" failed (%s)\n", bctxt->filepath, (res) ? strerror(errno) : "no progress");
+         return -1;
+      }
+      bctxt->offset += res;
+      parse += res;
+      size -= res;
+   }
+
+   return 0;
+}
+
+int posix_uring_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+
+   // gather all buffers into a single entry at our tracked offset
+   struct io_uring_sqe op;
+   uring_request req;
+   uring_prep(&op, IORING_OP_WRITEV, bctxt->fd, iov, iovcnt, bctxt->offset);
+   if (uring_run(uctxt, &op, &req, 1))
+   {
+      return -1;
+   }
+   if (req.res < 0)
+   {
+      errno = -req.res;
+      LOG(LOG_ERR, "write to \"%s\" failed (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+   bctxt->offset += req.res;
+
+   // continue after any short write
+   size_t done = req.res;
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      if (done >= iov[i].iov_len)
+      {
+         done -= iov[i].iov_len;
+         continue;
+      }
+      if (posix_uring_put(ctxt, (char *)iov[i].iov_base + done, iov[i].iov_len - done))
+      {
+         return -1;
+      }
+      done = 0;
+   }
+
+   return 0;
+}
+
+int posix_uring_checkpoint(BLOCK_CTXT ctxt, const char *meta_buf, size_t size)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+
+   // abort, unless we're rebuilding
+   if (bctxt->mode != DAL_REBUILD && bctxt->mode != DAL_RESUME)
+   {
+      LOG(LOG_ERR, "Can only checkpoint a DAL_REBUILD or DAL_RESUME block handle!\n");
+      errno = EINVAL;
+      return -1;
+   }
+
+   // all data described by the checkpoint must be stable before the checkpoint itself
+   struct io_uring_sqe ops[2];
+   uring_request reqs[2];
+   uring_prep(&ops[0], IORING_OP_FSYNC, bctxt->fd, NULL, 0, 0);
+   ops[0].fsync_flags = IORING_FSYNC_DATASYNC;
+   ops[0].flags = IOSQE_IO_LINK;
+   uring_prep(&ops[1], IORING_OP_WRITE, bctxt->mfd, meta_buf, size, 0);
+   if (uring_run(uctxt, ops, reqs, 2))
+   {
+      return -1;
+   }
+   if (reqs[0].res < 0)
+   {
+      LOG(LOG_ERR, "failed to sync data file \"%s\" (%s)\n", bctxt->filepath, strerror(-reqs[0].res));
+      errno = -reqs[0].res;
+      return -1;
+   }
+   if (reqs[1].res != size)
+   {
+      errno = (reqs[1].res < 0) ? -reqs[1].res : EIO;
+      LOG(LOG_ERR, "failed to store checkpoint meta info of \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+   if (ftruncate(bctxt->mfd, size))
+   {
+      LOG(LOG_ERR, "failed to truncate checkpoint meta info of \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+   uring_prep(&ops[0], IORING_OP_FSYNC, bctxt->mfd, NULL, 0, 0);
+   ops[0].fsync_flags = IORING_FSYNC_DATASYNC;
+   if (uring_run(uctxt, ops, reqs, 1))
+   {
+      return -1;
+   }
+   if (reqs[0].res < 0)
+   {
+      LOG(LOG_ERR, "failed to sync checkpoint meta info of \"%s\" (%s)\n", bctxt->filepath, strerror(-reqs[0].res));
+      errno = -reqs[0].res;
+      return -1;
+   }
+
+   return 0;
+}
+
+ssize_t posix_uring_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+
+   // abort, unless we're reading
+   if (bctxt->mode != DAL_READ)
+   {
+      LOG(LOG_ERR, "Can only perform get ops on a DAL_READ block handle!\n");
+      return -1;
+   }
+
+   // positioned reads require no seek
+   ssize_t res = uring_rw(uctxt, 0, bctxt->fd, buf, size, offset);
+   if (res < 0)
+   {
+      LOG(LOG_ERR, "failed to read %zu bytes at offset %zd of file \"%s\" (%s)\n", size, offset, bctxt->filepath, strerror(errno));
+      return -1;
+   }
+   bctxt->offset = offset + res;
+
+   return res;
+}
+
+ssize_t posix_uring_getv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+
+   // abort, unless we're reading
+   if (bctxt->mode != DAL_READ)
+   {
+      LOG(LOG_ERR, "Can only perform get ops on a DAL_READ block handle!\n");
+      return -1;
+   }
+
+   // scatter a single positioned read across all buffers
+   struct io_uring_sqe op;
+   uring_request req;
+   uring_prep(&op, IORING_OP_READV, bctxt->fd, iov, iovcnt, offset);
+   if (uring_run(uctxt, &op, &req, 1))
+   {
+      return -1;
+   }
+   if (req.res < 0)
+   {
+      errno = -req.res;
+      LOG(LOG_ERR, "failed to read %d buffers at offset %zd of file \"%s\" (%s)\n", iovcnt, offset, bctxt->filepath, strerror(errno));
+      return -1;
+   }
+   bctxt->offset = offset + req.res;
+
+   return req.res;
+}
+
+DAL_REQ posix_uring_submit_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return NULL;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   // abort, unless we're reading
+   if (bctxt->mode != DAL_READ)
+   {
+      LOG(LOG_ERR, "Can only perform get ops on a DAL_READ block handle!\n");
+      return NULL;
+   }
+
+   return (DAL_REQ)uring_submit(bctxt, IORING_OP_READ, bctxt->fd, buf, size, offset);
+}
+
+DAL_REQ posix_uring_submit_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return NULL;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   // claim the next range of the file, so that later puts may be submitted before this one completes
+   URING_ASYNC_REQ areq = uring_submit(bctxt, IORING_OP_WRITE, bctxt->fd, buf, size, bctxt->offset);
+   if (areq != NULL)
+   {
+      bctxt->offset += size;
+   }
+
+   return (DAL_REQ)areq;
+}
+
+DAL_REQ posix_uring_submit_meta(BLOCK_CTXT ctxt, char *meta_buf, size_t size)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return NULL;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   // read from the current position of the meta file, as get_meta() does
+   return (DAL_REQ)uring_submit(bctxt, IORING_OP_READ, bctxt->mfd, meta_buf, size, -1);
+}
+
+int posix_uring_poll(BLOCK_CTXT ctxt, DAL_REQ req, ssize_t *result)
+{
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+   URING_ASYNC_REQ areq = (URING_ASYNC_REQ)req;
+
+   pthread_mutex_lock(&uctxt->lock);
+   char done = areq->req.done;
+   pthread_mutex_unlock(&uctxt->lock);
+   if (!done)
+   {
+      return 0;
+   }
+   *result = uring_complete(bctxt, areq);
+
+   return 1;
+}
+
+ssize_t posix_uring_wait(BLOCK_CTXT ctxt, DAL_REQ req)
+{
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+   URING_ASYNC_REQ areq = (URING_ASYNC_REQ)req;
+
+   pthread_mutex_lock(&uctxt->lock);
+   while (!areq->req.done)
+   {
+      pthread_cond_wait(&(areq->req.cond), &uctxt->lock);
+   }
+   pthread_mutex_unlock(&uctxt->lock);
+
+   return uring_complete(bctxt, areq);
+}
+
+int posix_uring_close(BLOCK_CTXT ctxt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+   URING_DAL_CTXT uctxt = (URING_DAL_CTXT)bctxt->dctxt;
+
+   struct io_uring_sqe ops[URING_MAX_LINK];
+   uring_request reqs[URING_MAX_LINK];
+   int count = 0;
+   char *write_path = NULL;
+   char *meta_path = NULL;
+   char *final_meta_path = NULL;
+
+   // if this is not a meta-only reference, close our FD
+   if (bctxt->mode != DAL_METAREAD)
+   {
+      uring_prep(&ops[count], IORING_OP_CLOSE, bctxt->fd, NULL, 0, 0);
+      count++;
+   }
+   uring_prep(&ops[count], IORING_OP_CLOSE, bctxt->mfd, NULL, 0, 0);
+   count++;
+
+   if (bctxt->mode == DAL_WRITE || bctxt->mode == DAL_REBUILD || bctxt->mode == DAL_RESUME)
+   {
+      const char *sfx = (bctxt->mode == DAL_WRITE) ? WRITE_SFX : REBUILD_SFX;
+      write_path = suffixed_path(bctxt, sfx, NULL);
+      meta_path = suffixed_path(bctxt, META_SFX, sfx);
+      final_meta_path = suffixed_path(bctxt, META_SFX, NULL);
+      if (write_path == NULL || meta_path == NULL || final_meta_path == NULL)
+      {
+         LOG(LOG_ERR, "failed to allocate space for suffixed file paths!\n");
+         free(write_path);
+         free(meta_path);
+         free(final_meta_path);
+         return -1;
+      }
+      // link the closes to the data rename and the data rename to the meta rename, so that the
+      // object is only committed ( meta renamed into place ) if every preceding step succeeds
+      for (int i = 0; i < count; i++)
+      {
+         ops[i].flags = IOSQE_IO_LINK;
+      }
+      uring_prep(&ops[count], IORING_OP_RENAMEAT, bctxt->sfd, write_path + bctxt->diroff, bctxt->sfd, (off_t)(unsigned long)(bctxt->filepath + bctxt->diroff));
+      ops[count].flags = IOSQE_IO_LINK;
+      count++;
+      uring_prep(&ops[count], IORING_OP_RENAMEAT, bctxt->sfd, meta_path + bctxt->diroff, bctxt->sfd, (off_t)(unsigned long)(final_meta_path + bctxt->diroff));
+      count++;
+   }
+
+   int res = uring_run(uctxt, ops, reqs, count);
+   if (res == 0)
+   {
+      for (int i = 0; i < count; i++)
+      {
+         if (reqs[i].res < 0)
+         {
+            errno = -reqs[i].res;
+            if (errno == ECANCELED)
+            {
+               continue;
+            } // a previous op of the chain already failed
+            if (ops[i].opcode == IORING_OP_CLOSE)
+            {
+               LOG(LOG_ERR, "failed to close %s file \"%s\" (%s)\n", (ops[i].fd == bctxt->mfd) ? "meta" : "data", bctxt->filepath, strerror(errno));
+            }
+            else
+            {
+               LOG(LOG_ERR, "failed to rename %s file \"%s\" (%s)\n", (i + 1 == count) ? "meta" : "data", (i + 1 == count) ? meta_path : write_path, strerror(errno));
+            }
+            res = -1;
+            break;
+         }
+      }
+   }
+   free(write_path);
+   free(meta_path);
+   free(final_meta_path);
+   if (res)
+   {
+      return -1;
+   }
+
+   // free state
+   free_block_path(bctxt);
+   free(bctxt);
+   return 0;
+}
+
+#endif // HAVE_LINUX_IO_URING_H
+
+//   -------------    POSIX_URING INITIALIZATION    -------------
+
+DAL posix_uring_dal_init(xmlNode *root, DAL_location max_loc)
+{
+   // the posix DAL parses and validates all shared config elements
+   DAL pdal = posix_dal_init(root, max_loc);
+   if (pdal == NULL)
+   {
+      return NULL;
+   }
+#ifndef HAVE_LINUX_IO_URING_H
+   LOG(LOG_WARNING, "io_uring support was not built, falling back to the posix DAL\n");
+   return pdal;
+#else
+   unsigned int depth = URING_QUEUE_DEPTH;
+   int nbufs = 0;
+   for (; root != NULL; root = root->next)
+   {
+      if (root->type != XML_ELEMENT_NODE || root->children == NULL || root->children->type != XML_TEXT_NODE)
+      {
+         continue;
+      }
+      if (strncmp((char *)root->name, "queue_depth", 12) == 0)
+      {
+         if (atoi((char *)root->children->content) > 0)
+         {
+            depth = atoi((char *)root->children->content);
+         }
+      }
+      else if (strncmp((char *)root->name, "reg_buffers", 12) == 0)
+      {
+         nbufs = atoi((char *)root->children->content);
+         if (nbufs < 0)
+         {
+            nbufs = 0;
+         }
+      }
+   }
+
+   // grow the posix context into a posix_uring context
+   URING_DAL_CTXT uctxt = malloc(sizeof(struct uring_dal_context_struct));
+   if (uctxt == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate space for a posix_uring DAL context\n");
+      posix_cleanup(pdal);
+      return NULL;
+   } // malloc will set errno
+   uctxt->pctxt = *((POSIX_DAL_CTXT)pdal->ctxt);
+   if (uring_setup(uctxt, depth, nbufs, pdal->io_size))
+   {
+      LOG(LOG_WARNING, "failed to initialize io_uring, falling back to the posix DAL\n");
+      free(uctxt);
+      return pdal;
+   }
+   free(pdal->ctxt);
+   pdal->ctxt = (DAL_CTXT)uctxt;
+   if (uctxt->pctxt.direct_align)
+   {
+      LOG(LOG_WARNING, "direct_io is not supported by the posix_uring DAL, and will be ignored\n");
+      uctxt->pctxt.direct_align = 0;
+   }
+
+   pdal->name = "posix_uring";
+   pdal->open = posix_uring_open;
+   pdal->set_meta = posix_uring_set_meta;
+   pdal->get_meta = posix_uring_get_meta;
+   pdal->put = posix_uring_put;
+   pdal->putv = (nbufs) ? NULL : posix_uring_putv; // registered buffers cannot be gathered
+   pdal->checkpoint = posix_uring_checkpoint;
+   pdal->get = posix_uring_get;
+   pdal->getv = (nbufs) ? NULL : posix_uring_getv;
+   pdal->close = posix_uring_close;
+   pdal->cleanup = posix_uring_cleanup;
+   pdal->submit_get = posix_uring_submit_get;
+   pdal->submit_put = posix_uring_submit_put;
+   pdal->submit_meta = posix_uring_submit_meta;
+   pdal->poll = posix_uring_poll;
+   pdal->wait = posix_uring_wait;
+   // verify / migrate / del / stat / resume / abort operate identically to the posix DAL
+   return pdal;
+#endif
+}
@@ -0,0 +1,245 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#include "dal/dal.h"
+#include <libxml/parser.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define CHUNKSZ 10007
+#define CHUNKS 40
+#define TEST_TOTSZ ( CHUNKSZ * CHUNKS )
+
+// DAL configurations to test against, both with native asynchronous ops and through the synchronous shim
+char* dal_configs[] = {
+   "<DAL type=\"posix\"><dir_template>./test_dal_async.block{b}</dir_template><sec_root></sec_root></DAL>",
+   "<DAL type=\"posix\"><dir_template>./test_dal_async.block{b}</dir_template><sec_root></sec_root>"
+   "<io_size>65536</io_size><direct_io/></DAL>",
+   "<DAL type=\"posix_uring\"><dir_template>./test_dal_async.block{b}</dir_template><sec_root></sec_root></DAL>",
+   "<DAL type=\"posix_uring\"><dir_template>./test_dal_async.block{b}</dir_template><sec_root></sec_root>"
+   "<reg_buffers>4</reg_buffers></DAL>"
+};
+DAL_location loc = { .pod = 0, .block = 0, .cap = 0, .scatter = 0 };
+
+
+int test_async( DAL dal, const char* src, char* dst ) {
+   // many puts in flight, following a synchronous one, and completed in reverse order via poll() or wait()
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_WRITE, loc, "async" );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open block for write!\n" );
+      return -1;
+   }
+   DAL_REQ reqs[CHUNKS];
+   if ( dal->put( block, src, CHUNKSZ ) ) {
+      printf( "ERROR: Failed to put first chunk!\n" );
+      dal->abort( block );
+      return -1;
+   }
+   int ret = 0;
+   int i;
+   for ( i = 1; i < CHUNKS; i++ ) {
+      if ( (reqs[i] = dal_submit_put( dal, block, src + ( i * CHUNKSZ ), CHUNKSZ )) == NULL ) {
+         printf( "ERROR: Failed to submit put of chunk %d!\n", i );
+         ret = -1;
+         break;
+      }
+   }
+   int submitted = i;
+   for ( i = submitted - 1; i >= 1; i-- ) {
+      ssize_t result = -5;
+      if ( i % 3 == 0  &&  dal_poll( dal, block, reqs[i], &result ) ) {
+         if ( result ) {
+            printf( "ERROR: Polled put of chunk %d returned %zd!\n", i, result );
+            ret = -1;
+         }
+         continue;
+      }
+      if ( dal_wait( dal, block, reqs[i] ) ) {
+         printf( "ERROR: Put of chunk %d failed!\n", i );
+         ret = -1;
+      }
+   }
+   if ( ret ) {
+      dal->abort( block );
+      return -1;
+   }
+   if ( dal->set_meta( block, "meta!", 6 )  ||  dal->close( block ) ) {
+      printf( "ERROR: Failed to complete written block!\n" );
+      return -1;
+   }
+
+   // many gets in flight, then gets reaching beyond the end of the object and a meta read, polled to completion
+   block = dal->open( dal->ctxt, DAL_READ, loc, "async" );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open block for read!\n" );
+      return -1;
+   }
+   memset( dst, 0, TEST_TOTSZ );
+   for ( i = 0; i < CHUNKS; i++ ) {
+      if ( (reqs[i] = dal_submit_get( dal, block, dst + ( i * CHUNKSZ ), CHUNKSZ, i * CHUNKSZ )) == NULL ) {
+         printf( "ERROR: Failed to submit get of chunk %d!\n", i );
+         ret = -1;
+         break;
+      }
+   }
+   submitted = i;
+   for ( i = 0; i < submitted; i++ ) {
+      if ( dal_wait( dal, block, reqs[i] ) != CHUNKSZ ) {
+         printf( "ERROR: Get of chunk %d failed!\n", i );
+         ret = -1;
+      }
+   }
+   if ( ret == 0  &&  memcmp( src, dst, TEST_TOTSZ ) ) {
+      printf( "ERROR: Retrieved data does not match!\n" );
+      ret = -1;
+   }
+   char meta[16] = { 0 };
+   DAL_REQ tail = dal_submit_get( dal, block, dst, 100, TEST_TOTSZ - 40 );
+   DAL_REQ metareq = dal_submit_meta( dal, block, meta, sizeof( meta ) );
+   if ( tail == NULL  ||  metareq == NULL ) {
+      printf( "ERROR: Failed to submit tail get and meta requests!\n" );
+      if ( tail ) { dal_wait( dal, block, tail ); }
+      if ( metareq ) { dal_wait( dal, block, metareq ); }
+      dal->close( block );
+      return -1;
+   }
+   ssize_t result;
+   while ( !(dal_poll( dal, block, tail, &result )) ) { usleep( 100 ); }
+   if ( result != 40  ||  memcmp( dst, src + TEST_TOTSZ - 40, 40 ) ) {
+      printf( "ERROR: Tail get returned %zd bytes, rather than 40 matching bytes!\n", result );
+      ret = -1;
+   }
+   if ( (result = dal_wait( dal, block, metareq )) != 6  ||  strcmp( meta, "meta!" ) ) {
+      printf( "ERROR: Meta request returned %zd ( \"%s\" )!\n", result, meta );
+      ret = -1;
+   }
+   if ( dal->close( block ) ) {
+      printf( "ERROR: Failed to close block after read!\n" );
+      ret = -1;
+   }
+
+   // a get from a write handle fails at either submission or completion
+   block = dal->open( dal->ctxt, DAL_WRITE, loc, "async_bad" );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open second block for write!\n" );
+      return -1;
+   }
+   DAL_REQ badreq = dal_submit_get( dal, block, dst, 100, 0 );
+   if ( badreq != NULL  &&  dal_wait( dal, block, badreq ) >= 0 ) {
+      printf( "ERROR: Get from a write handle succeeded!\n" );
+      ret = -1;
+   }
+   if ( dal->abort( block ) ) {
+      printf( "ERROR: Failed to abort second block!\n" );
+      ret = -1;
+   }
+   if ( dal->del( dal->ctxt, loc, "async" ) ) {
+      printf( "ERROR: Failed to delete test object!\n" );
+      ret = -1;
+   }
+   return ret;
+}
+
+
+
+DAL init_config( char* dal_config ) {
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return NULL;
+   }
+   DAL dal = init_dal( xmlDocGetRootElement( config ), loc );
+   xmlFreeDoc( config );
+   if ( dal == NULL ) {
+      printf( "ERROR: Failed to initialize DAL!\n" );
+   }
+   return dal;
+}
+
+
+
+int main( int argc, char** argv ) {
+   setvbuf( stdout, NULL, _IONBF, 0 );
+   char* src = malloc( TEST_TOTSZ );
+   char* dst = malloc( TEST_TOTSZ );
+   if ( src == NULL  ||  dst == NULL ) {
+      printf( "ERROR: Failed to allocate test buffers!\n" );
+      return -1;
+   }
+   size_t i;
+   for ( i = 0; i < TEST_TOTSZ; i++ ) { src[i] = (char)( ( i * 13 ) + ( i / 97 ) ); }
+
+   int ret = 0;
+   int config;
+   for ( config = 0; ret == 0  &&  config < sizeof( dal_configs ) / sizeof( char* ); config++ ) {
+      DAL dal = init_config( dal_configs[config] );
+      if ( dal == NULL ) { ret = -1; break; }
+      printf( "Testing asynchronous ops of DAL config: %s ( %s )\n", dal_configs[config],
+              ( dal->submit_get ) ? "native" : "shim" );
+      if ( test_async( dal, src, dst ) ) { ret = -1; }
+      dal->cleanup( dal );
+   }
+   xmlCleanupParser();
+   free( src );
+   free( dst );
+   return ret;
+}
@@ -0,0 +1,334 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#include "dal/posix_dal.h"
+#include <libxml/parser.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+
+#define ROOT "./test_dal_dircache.root"
+#define PODS 2
+#define BLOCKS 6
+#define SCATTERS 3
+#define WORKERS 4
+#define WORKER_OPS 100
+
+// a template with escaped characters, an unrecognized substitution, and a substitution within the file name
+// ( producing paths such as "p1/b{4}\x/s2/f4{q}.<objID>" )
+char* dir_template = ROOT "/p{p}/b\\{{b}}\\\\x/s{s}/f{b}{q}.";
+DAL_location max_loc = { .pod = PODS - 1, .block = BLOCKS - 1, .cap = 0, .scatter = SCATTERS - 1 };
+
+
+// create ( or remove ) all directories referenced by the template
+int make_dirs( int create ) {
+   char path[256];
+   if ( create  &&  mkdir( ROOT, 0755 )  &&  errno != EEXIST ) { return -1; }
+   int pod;
+   for ( pod = 0; pod < PODS; pod++ ) {
+      snprintf( path, sizeof( path ), ROOT "/p%d", pod );
+      if ( create  &&  mkdir( path, 0755 )  &&  errno != EEXIST ) { return -1; }
+      int block;
+      for ( block = 0; block < BLOCKS; block++ ) {
+         snprintf( path, sizeof( path ), ROOT "/p%d/b{%d}\\x", pod, block );
+         if ( create  &&  mkdir( path, 0755 )  &&  errno != EEXIST ) { return -1; }
+         int scatter;
+         for ( scatter = 0; scatter < SCATTERS; scatter++ ) {
+            snprintf( path, sizeof( path ), ROOT "/p%d/b{%d}\\x/s%d", pod, block, scatter );
+            if ( create ) {
+               if ( mkdir( path, 0755 )  &&  errno != EEXIST ) { return -1; }
+            }
+            else { rmdir( path ); }
+         }
+         if ( !(create) ) {
+            snprintf( path, sizeof( path ), ROOT "/p%d/b{%d}\\x", pod, block );
+            rmdir( path );
+         }
+      }
+      if ( !(create) ) {
+         snprintf( path, sizeof( path ), ROOT "/p%d", pod );
+         rmdir( path );
+      }
+   }
+   if ( !(create) ) { rmdir( ROOT ); }
+   return 0;
+}
+
+
+
+// initialize a posix DAL with the given template and cache size ( negative for the default )
+DAL init_config( const char* template, int cache ) {
+   char dal_config[512];
+   char cache_elem[64] = "";
+   if ( cache >= 0 ) { snprintf( cache_elem, sizeof( cache_elem ), "<dir_cache>%d</dir_cache>", cache ); }
+   snprintf( dal_config, sizeof( dal_config ), "<DAL type=\"posix\"><dir_template>%s</dir_template>"
+             "<sec_root></sec_root>%s</DAL>", template, cache_elem );
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return NULL;
+   }
+   DAL dal = init_dal( xmlDocGetRootElement( config ), max_loc );
+   xmlFreeDoc( config );
+   if ( dal == NULL ) {
+      printf( "ERROR: Failed to initialize DAL!\n" );
+   }
+   return dal;
+}
+
+
+
+int file_exists( const char* path ) {
+   return ( access( path, F_OK ) == 0 );
+}
+
+
+
+// write, verify, and delete many objects at varying locations, concurrently with other workers
+void* worker( void* arg ) {
+   DAL dal = ((DAL*)arg)[0];
+   long id = (long)((DAL*)arg)[1];
+   char objID[32];
+   char buf[1000];
+   char rbuf[1000];
+   int op;
+   for ( op = 0; op < WORKER_OPS; op++ ) {
+      DAL_location loc = { .pod = ( id + op ) % PODS, .block = ( ( op * 7 ) + id ) % BLOCKS, .cap = 0, .scatter = op % SCATTERS };
+      snprintf( objID, sizeof( objID ), "w%ld/%d", id, op );
+      memset( buf, (char)( id + op ), sizeof( buf ) );
+      BLOCK_CTXT block = dal->open( dal->ctxt, DAL_WRITE, loc, objID );
+      if ( block == NULL ) { return (void*)1; }
+      if ( dal->put( block, buf, sizeof( buf ) )  ||  dal->set_meta( block, "m", 2 )  ||  dal->close( block ) ) { return (void*)1; }
+      if ( dal->stat( dal->ctxt, loc, objID ) ) { return (void*)1; }
+      if ( (block = dal->open( dal->ctxt, DAL_READ, loc, objID )) == NULL ) { return (void*)1; }
+      ssize_t got = dal->get( block, rbuf, sizeof( rbuf ), 0 );
+      if ( dal->close( block )  ||  got != sizeof( rbuf )  ||  memcmp( buf, rbuf, sizeof( rbuf ) ) ) { return (void*)1; }
+      if ( dal->del( dal->ctxt, loc, objID )  ||  dal->stat( dal->ctxt, loc, objID ) == 0 ) { return (void*)1; }
+   }
+   return NULL;
+}
+
+
+
+int test_cache( int cache ) {
+   DAL dal = init_config( dir_template, cache );
+   if ( dal == NULL ) { return -1; }
+   POSIX_DAL_CTXT dctxt = (POSIX_DAL_CTXT)dal->ctxt;
+   printf( "Testing directory handle cache of %d entries\n", ( dctxt->dircache ) ? dctxt->dircache->size : 0 );
+   if ( ( cache == 0 ) != ( dctxt->dircache == NULL ) ) {
+      printf( "ERROR: Unexpected directory handle cache state!\n" );
+      dal->cleanup( dal );
+      return -1;
+   }
+
+   // the compiled template must produce the same paths as the template string
+   DAL_location loc = { .pod = 1, .block = 4, .cap = 0, .scatter = 2 };
+   const char* path = ROOT "/p1/b{4}\\x/s2/f4{q}.a#b";
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_WRITE, loc, "a/b" );
+   if ( block == NULL  ||  dal->put( block, "xyz", 3 )  ||  dal->set_meta( block, "m", 2 ) ) {
+      printf( "ERROR: Failed to write object \"a/b\"!\n" );
+      dal->cleanup( dal );
+      return -1;
+   }
+   int ret = 0;
+   char working[256];
+   snprintf( working, sizeof( working ), "%s%s", path, WRITE_SFX );
+   if ( !(file_exists( working )) ) {
+      printf( "ERROR: Expected working file \"%s\" does not exist!\n", working );
+      ret = -1;
+   }
+   if ( dal->close( block ) ) {
+      printf( "ERROR: Failed to close object \"a/b\"!\n" );
+      ret = -1;
+   }
+   char meta[256];
+   snprintf( meta, sizeof( meta ), "%s%s", path, META_SFX );
+   if ( !(file_exists( path ))  ||  !(file_exists( meta )) ) {
+      printf( "ERROR: Expected files of \"%s\" do not exist!\n", path );
+      ret = -1;
+   }
+
+   // aborted rebuilds remove their working file
+   block = dal->open( dal->ctxt, DAL_REBUILD, loc, "a/b" );
+   snprintf( working, sizeof( working ), "%s%s", path, REBUILD_SFX );
+   if ( block == NULL  ||  dal->put( block, "q", 1 )  ||  !(file_exists( working ))  ||  dal->abort( block )  ||  file_exists( working ) ) {
+      printf( "ERROR: Failed to abort a rebuild of object \"a/b\"!\n" );
+      ret = -1;
+   }
+
+   // more blocks open at once than there are cache entries
+   BLOCK_CTXT blocks[BLOCKS];
+   int i;
+   for ( i = 0; i < BLOCKS; i++ ) {
+      DAL_location bloc = { .pod = 0, .block = i, .cap = 0, .scatter = 0 };
+      if ( (blocks[i] = dal->open( dal->ctxt, DAL_WRITE, bloc, "many" )) == NULL  ||  dal->put( blocks[i], "z", 1 ) ) {
+         printf( "ERROR: Failed to write block %d of object \"many\"!\n", i );
+         ret = -1;
+      }
+   }
+   for ( i = 0; i < BLOCKS; i++ ) {
+      DAL_location bloc = { .pod = 0, .block = i, .cap = 0, .scatter = 0 };
+      if ( blocks[i] == NULL ) { continue; }
+      if ( dal->close( blocks[i] )  ||  dal->stat( dal->ctxt, bloc, "many" )  ||  dal->del( dal->ctxt, bloc, "many" )  ||
+           dal->stat( dal->ctxt, bloc, "many" ) == 0 ) {
+         printf( "ERROR: Failed to complete block %d of object \"many\"!\n", i );
+         ret = -1;
+      }
+   }
+
+   // migration between directories
+   DAL_location dest = { .pod = 0, .block = 4, .cap = 0, .scatter = 1 };
+   if ( dal->migrate( dal->ctxt, "a/b", loc, dest, 1 )  ||  dal->stat( dal->ctxt, dest, "a/b" )  ||  dal->stat( dal->ctxt, loc, "a/b" ) == 0  ||
+        dal->del( dal->ctxt, dest, "a/b" ) ) {
+      printf( "ERROR: Failed to migrate object \"a/b\"!\n" );
+      ret = -1;
+   }
+
+   // directories removed while the DAL is in use ( after any handle of them was cached )
+   DAL_location missing = { .pod = 0, .block = 5, .cap = 0, .scatter = 0 };
+   char missing_dir[256];
+   snprintf( missing_dir, sizeof( missing_dir ), ROOT "/p0/b{5}\\x/s0" );
+   if ( rmdir( missing_dir ) ) {
+      printf( "ERROR: Failed to remove directory \"%s\"!\n", missing_dir );
+      ret = -1;
+   }
+   if ( (block = dal->open( dal->ctxt, DAL_WRITE, missing, "x" )) != NULL ) {
+      printf( "ERROR: Opened a block within a missing directory!\n" );
+      dal->abort( block );
+      ret = -1;
+   }
+   if ( mkdir( missing_dir, 0755 ) ) {
+      printf( "ERROR: Failed to recreate directory \"%s\"!\n", missing_dir );
+      ret = -1;
+   }
+
+   // many threads, sharing cache entries
+   pthread_t threads[WORKERS];
+   void* args[WORKERS][2];
+   for ( i = 0; i < WORKERS; i++ ) {
+      args[i][0] = dal;
+      args[i][1] = (void*)(long)i;
+      if ( pthread_create( &threads[i], NULL, worker, args[i] ) ) {
+         printf( "ERROR: Failed to create worker thread %d!\n", i );
+         return -1;
+      }
+   }
+   for ( i = 0; i < WORKERS; i++ ) {
+      void* wret = NULL;
+      pthread_join( threads[i], &wret );
+      if ( wret ) {
+         printf( "ERROR: Worker thread %d failed!\n", i );
+         ret = -1;
+      }
+   }
+   if ( dctxt->dircache ) {
+      for ( i = 0; i < dctxt->dircache->size; i++ ) {
+         if ( dctxt->dircache->handles[i].refs ) {
+            printf( "ERROR: Directory handle cache entry %d retains %d references!\n", i, dctxt->dircache->handles[i].refs );
+            ret = -1;
+         }
+      }
+   }
+   if ( dal->cleanup( dal ) ) {
+      printf( "ERROR: Failed to clean up DAL!\n" );
+      ret = -1;
+   }
+   return ret;
+}
+
+
+
+int main( int argc, char** argv ) {
+   setvbuf( stdout, NULL, _IONBF, 0 );
+   if ( make_dirs( 1 ) ) {
+      printf( "ERROR: Failed to create test directories!\n" );
+      return -1;
+   }
+   int ret = 0;
+   if ( test_cache( -1 )  ||  test_cache( 0 )  ||  test_cache( 2 ) ) { ret = -1; }
+
+   // templates with only literal directories, or none at all ( which never cache handles )
+   char* templates[] = { ROOT "/flat.", "test_dal_dircache.flat." };
+   char* files[] = { ROOT "/flat.o", "test_dal_dircache.flat.o" };
+   int i;
+   for ( i = 0; ret == 0  &&  i < 2; i++ ) {
+      printf( "Testing template \"%s\"\n", templates[i] );
+      DAL dal = init_config( templates[i], 4 );
+      if ( dal == NULL ) { ret = -1; break; }
+      if ( i  &&  ((POSIX_DAL_CTXT)dal->ctxt)->dircache != NULL ) {
+         printf( "ERROR: Directory handle cache created for a template without directories!\n" );
+         ret = -1;
+      }
+      DAL_location loc = { .pod = 0, .block = 0, .cap = 0, .scatter = 0 };
+      BLOCK_CTXT block = dal->open( dal->ctxt, DAL_WRITE, loc, "o" );
+      if ( block == NULL  ||  dal->close( block )  ||  !(file_exists( files[i] ))  ||  dal->del( dal->ctxt, loc, "o" ) ) {
+         printf( "ERROR: Failed to write an object through template \"%s\"!\n", templates[i] );
+         ret = -1;
+      }
+      dal->cleanup( dal );
+   }
+   make_dirs( 0 );
+   xmlCleanupParser();
+   return ret;
+}
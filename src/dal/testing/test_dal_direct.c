@@ -0,0 +1,298 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#define _GNU_SOURCE // for O_DIRECT
+#include "dal/posix_dal.h"
+#include <libxml/parser.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+
+
+#define TEST_IOSZ 8192
+#define TEST_TOTSZ 100003   // not sector aligned, leaving a partial sector at the tail of each block
+
+char* dal_config = "<DAL type=\"posix\"><dir_template>./test_dal_direct.block{b}</dir_template>"
+                   "<sec_root></sec_root><io_size>8192</io_size><direct_io/></DAL>";
+DAL_location loc = { .pod = 0, .block = 0, .cap = 0, .scatter = 0 };
+
+
+int is_direct( BLOCK_CTXT block ) {
+   return ( fcntl( ((POSIX_BLOCK_CTXT)block)->fd, F_GETFL ) & O_DIRECT ) ? 1 : 0;
+}
+
+
+
+// compare the data file of the given object against the expected content
+int check_file( const char* objID, const char* src, size_t totsz ) {
+   char path[256];
+   snprintf( path, sizeof( path ), "./test_dal_direct.block0%s", objID );
+   FILE* file = fopen( path, "r" );
+   if ( file == NULL ) {
+      printf( "ERROR: Failed to open data file \"%s\"!\n", path );
+      return -1;
+   }
+   char* content = malloc( totsz + 4096 );
+   if ( content == NULL ) {
+      printf( "ERROR: Failed to allocate a comparison buffer!\n" );
+      fclose( file );
+      return -1;
+   }
+   size_t filesz = fread( content, 1, totsz + 4096, file );
+   fclose( file );
+   int ret = 0;
+   if ( filesz != totsz  ||  memcmp( content, src, totsz ) ) {
+      printf( "ERROR: Data file \"%s\" does not match ( %zu of %zu bytes )!\n", path, filesz, totsz );
+      ret = -1;
+   }
+   free( content );
+   return ret;
+}
+
+
+
+// write an object in chunks of the given size, from an ( optionally ) unaligned source, checkpointing midway
+int test_put( DAL dal, const char* src, size_t chunksz, int unaligned ) {
+   printf( "Testing O_DIRECT puts of %zu bytes ( %s buffers )\n", chunksz, ( unaligned ) ? "unaligned" : "aligned" );
+   char* abuf = NULL;
+   if ( posix_memalign( (void**)&abuf, DIRECT_ALIGN, TEST_TOTSZ + 1 ) ) {
+      printf( "ERROR: Failed to allocate an aligned buffer!\n" );
+      return -1;
+   }
+   memcpy( abuf + unaligned, src, TEST_TOTSZ );
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_REBUILD, loc, "put" );
+   if ( block == NULL  ||  !(is_direct( block )) ) {
+      printf( "ERROR: Failed to open an O_DIRECT rebuild block!\n" );
+      free( abuf );
+      return -1;
+   }
+   size_t done = 0;
+   int checkpointed = 0;
+   while ( done < TEST_TOTSZ ) {
+      size_t putsz = ( chunksz > TEST_TOTSZ - done ) ? TEST_TOTSZ - done : chunksz;
+      if ( dal->put( block, abuf + unaligned + done, putsz ) ) {
+         printf( "ERROR: Failed to put %zu bytes at offset %zu!\n", putsz, done );
+         dal->abort( block );
+         free( abuf );
+         return -1;
+      }
+      done += putsz;
+      // a checkpoint must flush any unaligned tail, and staging must then continue from that point
+      if ( !(checkpointed)  &&  done > TEST_TOTSZ / 2 ) {
+         if ( dal->checkpoint( block, "ckpt\n", 6 ) ) {
+            printf( "ERROR: Failed to checkpoint at offset %zu!\n", done );
+            dal->abort( block );
+            free( abuf );
+            return -1;
+         }
+         checkpointed = 1;
+      }
+   }
+   free( abuf );
+   if ( dal->set_meta( block, "meta", 5 )  ||  dal->close( block ) ) {
+      printf( "ERROR: Failed to complete O_DIRECT rebuild block!\n" );
+      return -1;
+   }
+   return check_file( "put", src, TEST_TOTSZ );
+}
+
+
+
+// read the object back at aligned and unaligned offsets, into aligned and unaligned buffers
+int test_get( DAL dal, const char* src ) {
+   printf( "Testing O_DIRECT gets\n" );
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_READ, loc, "put" );
+   if ( block == NULL  ||  !(is_direct( block )) ) {
+      printf( "ERROR: Failed to open an O_DIRECT read block!\n" );
+      return -1;
+   }
+   char* dst = malloc( TEST_IOSZ + 1 );
+   if ( dst == NULL ) {
+      printf( "ERROR: Failed to allocate a read buffer!\n" );
+      dal->close( block );
+      return -1;
+   }
+   off_t offsets[] = { 0, 4096, 777, TEST_TOTSZ - 10, TEST_TOTSZ };
+   int ret = 0;
+   int i;
+   for ( i = 0; ret == 0  &&  i < sizeof( offsets ) / sizeof( off_t ); i++ ) {
+      int shift = i & 1;
+      size_t expected = ( TEST_TOTSZ - offsets[i] < TEST_IOSZ ) ? TEST_TOTSZ - offsets[i] : TEST_IOSZ;
+      ssize_t got = dal->get( block, dst + shift, TEST_IOSZ, offsets[i] );
+      if ( got != expected  ||  memcmp( dst + shift, src + offsets[i], expected ) ) {
+         printf( "ERROR: Get at offset %zd returned %zd bytes, rather than %zu matching bytes!\n", offsets[i], got, expected );
+         ret = -1;
+      }
+   }
+   char meta[16] = { 0 };
+   if ( ret == 0  &&  ( dal->get_meta( block, meta, sizeof( meta ) ) != 5  ||  strcmp( meta, "meta" ) ) ) {
+      printf( "ERROR: Failed to retrieve meta info of O_DIRECT block!\n" );
+      ret = -1;
+   }
+   free( dst );
+   if ( dal->close( block ) ) {
+      printf( "ERROR: Failed to close O_DIRECT read block!\n" );
+      ret = -1;
+   }
+   return ret;
+}
+
+
+
+// interrupt a rebuild after a checkpoint at an unaligned offset, then resume it from the given offset
+int test_resume( DAL dal, const char* src, size_t ckptsz, size_t resumesz ) {
+   printf( "Testing O_DIRECT resume at offset %zu, after a checkpoint at offset %zu\n", resumesz, ckptsz );
+   pid_t child = fork();
+   if ( child == 0 ) {
+      BLOCK_CTXT block = dal->open( dal->ctxt, DAL_REBUILD, loc, "resume" );
+      if ( block == NULL  ||  dal->put( block, src, ckptsz )  ||  dal->checkpoint( block, "ckpt\n", 6 ) ) { _exit( 1 ); }
+      // data beyond the checkpoint, which may or may not reach the data file, before the rebuild is interrupted
+      if ( dal->put( block, src + ckptsz, 5000 ) ) { _exit( 1 ); }
+      _exit( 0 );
+   }
+   int status;
+   if ( child < 0  ||  waitpid( child, &status, 0 ) != child  ||  !WIFEXITED( status )  ||  WEXITSTATUS( status ) ) {
+      printf( "ERROR: Failed to produce an interrupted O_DIRECT rebuild!\n" );
+      return -1;
+   }
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_RESUME, loc, "resume" );
+   if ( block == NULL  ||  !(is_direct( block )) ) {
+      printf( "ERROR: Failed to open an O_DIRECT resume block!\n" );
+      return -1;
+   }
+   char meta[16] = { 0 };
+   if ( dal->get_meta( block, meta, sizeof( meta ) ) != 6  ||  strcmp( meta, "ckpt\n" ) ) {
+      printf( "ERROR: Failed to retrieve the checkpoint of the interrupted rebuild!\n" );
+      dal->abort( block );
+      return -1;
+   }
+   // resuming within a sector requires the leading portion of that sector to be staged again
+   if ( dal->resume( block, resumesz )  ||  dal->put( block, src + resumesz, TEST_TOTSZ - resumesz ) ) {
+      printf( "ERROR: Failed to resume the interrupted rebuild!\n" );
+      dal->abort( block );
+      return -1;
+   }
+   if ( dal->set_meta( block, "meta", 5 )  ||  dal->close( block ) ) {
+      printf( "ERROR: Failed to complete the resumed rebuild!\n" );
+      return -1;
+   }
+   if ( check_file( "resume", src, TEST_TOTSZ ) ) { return -1; }
+   if ( dal->del( dal->ctxt, loc, "resume" ) ) {
+      printf( "ERROR: Failed to delete the resumed object!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+int main( int argc, char** argv ) {
+   setvbuf( stdout, NULL, _IONBF, 0 );
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return -1;
+   }
+   DAL_location max_loc = { .pod = 0, .block = 0, .cap = 0, .scatter = 0 };
+   DAL dal = init_dal( xmlDocGetRootElement( config ), max_loc );
+   xmlFreeDoc( config );
+   xmlCleanupParser();
+   if ( dal == NULL ) {
+      printf( "ERROR: Failed to initialize DAL!\n" );
+      return -1;
+   }
+   char* src = malloc( TEST_TOTSZ );
+   if ( src == NULL ) {
+      printf( "ERROR: Failed to allocate source data!\n" );
+      return -1;
+   }
+   size_t i;
+   for ( i = 0; i < TEST_TOTSZ; i++ ) { src[i] = (char)( ( i * 7 ) + ( i / 251 ) ); }
+
+   int ret = 0;
+   if ( test_put( dal, src, DIRECT_ALIGN, 0 )  ||  test_put( dal, src, 1000, 1 )  ||  test_put( dal, src, 12345, 1 )  ||
+        test_get( dal, src )  ||
+        test_resume( dal, src, 30001, 30001 )  ||  test_resume( dal, src, 30001, 20487 )  ||
+        test_resume( dal, src, 30001, 2 * DIRECT_ALIGN )  ||  test_resume( dal, src, 4 * DIRECT_ALIGN, 0 ) ) {
+      ret = -1;
+   }
+   if ( ret == 0 ) {
+      // an aborted write must leave nothing behind
+      printf( "Testing O_DIRECT abort\n" );
+      BLOCK_CTXT block = dal->open( dal->ctxt, DAL_WRITE, loc, "abort" );
+      if ( block == NULL  ||  dal->put( block, src, 777 )  ||  dal->abort( block ) ) {
+         printf( "ERROR: Failed to abort an O_DIRECT write!\n" );
+         ret = -1;
+      }
+      else if ( access( "./test_dal_direct.block0abort" WRITE_SFX, F_OK ) == 0  ||  dal->stat( dal->ctxt, loc, "abort" ) == 0 ) {
+         printf( "ERROR: Aborted O_DIRECT write left files behind!\n" );
+         ret = -1;
+      }
+   }
+   if ( dal->del( dal->ctxt, loc, "put" ) ) {
+      printf( "ERROR: Failed to delete test object!\n" );
+      ret = -1;
+   }
+   free( src );
+   dal->cleanup( dal );
+   return ret;
+}
@@ -0,0 +1,230 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#include "dal/dal.h"
+#include <libxml/parser.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define MAX_IOV 64
+#define TEST_TOTSZ ( 3 * 1048576 + 12345 )
+
+// DAL configurations to test against, including those lacking native vectored ops
+char* dal_configs[] = {
+   "<DAL type=\"posix\"><dir_template>./test_dal_vector.block{b}</dir_template><sec_root></sec_root></DAL>",
+   "<DAL type=\"posix\"><dir_template>./test_dal_vector.block{b}</dir_template><sec_root></sec_root>"
+   "<io_size>65536</io_size><direct_io/></DAL>",
+   "<DAL type=\"posix_uring\"><dir_template>./test_dal_vector.block{b}</dir_template><sec_root></sec_root></DAL>",
+   "<DAL type=\"posix_uring\"><dir_template>./test_dal_vector.block{b}</dir_template><sec_root></sec_root>"
+   "<reg_buffers>4</reg_buffers></DAL>"
+};
+DAL_location loc = { .pod = 0, .block = 0, .cap = 0, .scatter = 0 };
+
+
+// produce a set of buffer lengths ( some zero ), varying with the given seed
+int fill_iov( struct iovec* iov, char* base, size_t maxsz, unsigned int seed ) {
+   int iovcnt = ( seed % MAX_IOV ) + 1;
+   size_t total = 0;
+   int i;
+   for ( i = 0; i < iovcnt; i++ ) {
+      size_t len = ( ( seed + i ) % 7 == 0 ) ? 0 : ( ( seed * 31 ) + ( i * 4099 ) ) % 20000;
+      if ( len > maxsz - total ) { len = maxsz - total; }
+      iov[i].iov_base = base + total;
+      iov[i].iov_len = len;
+      total += len;
+   }
+   return iovcnt;
+}
+
+
+
+size_t iov_total( struct iovec* iov, int iovcnt ) {
+   size_t total = 0;
+   int i;
+   for ( i = 0; i < iovcnt; i++ ) { total += iov[i].iov_len; }
+   return total;
+}
+
+
+
+int test_vectors( DAL dal, const char* src, char* dst ) {
+   // write the object through a mix of putv() and put() calls
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_WRITE, loc, "vec" );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open block for write!\n" );
+      return -1;
+   }
+   struct iovec iov[MAX_IOV];
+   size_t done = 0;
+   unsigned int seed = 1;
+   while ( done < TEST_TOTSZ ) {
+      if ( seed % 5 == 0 ) {
+         size_t putsz = ( TEST_TOTSZ - done < 7777 ) ? TEST_TOTSZ - done : 7777;
+         if ( dal->put( block, src + done, putsz ) ) {
+            printf( "ERROR: Failed to put %zu bytes at offset %zu!\n", putsz, done );
+            dal->abort( block );
+            return -1;
+         }
+         done += putsz;
+      }
+      else {
+         int iovcnt = fill_iov( iov, (char*)src + done, TEST_TOTSZ - done, seed );
+         if ( dal_putv( dal, block, iov, iovcnt ) ) {
+            printf( "ERROR: Failed to put %d buffers at offset %zu!\n", iovcnt, done );
+            dal->abort( block );
+            return -1;
+         }
+         done += iov_total( iov, iovcnt );
+      }
+      seed++;
+   }
+   if ( dal->set_meta( block, "meta", 5 )  ||  dal->close( block ) ) {
+      printf( "ERROR: Failed to complete written block!\n" );
+      return -1;
+   }
+
+   // read it back through getv() calls at varying offsets, including those reaching the end of the object
+   block = dal->open( dal->ctxt, DAL_READ, loc, "vec" );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open block for read!\n" );
+      return -1;
+   }
+   int ret = 0;
+   off_t offset = 0;
+   for ( seed = 3; ret == 0; seed += 7 ) {
+      int iovcnt = fill_iov( iov, dst, TEST_TOTSZ, seed );
+      size_t expected = iov_total( iov, iovcnt );
+      if ( expected > TEST_TOTSZ - offset ) { expected = TEST_TOTSZ - offset; }
+      memset( dst, 0, expected );
+      ssize_t got = dal_getv( dal, block, iov, iovcnt, offset );
+      if ( got != expected  ||  memcmp( dst, src + offset, expected ) ) {
+         printf( "ERROR: Get of %d buffers at offset %zd returned %zd bytes, rather than %zu matching bytes!\n",
+                 iovcnt, offset, got, expected );
+         ret = -1;
+      }
+      if ( offset == TEST_TOTSZ ) { break; }
+      // overlap the previous read, finishing with a read at the very end of the object
+      offset += ( expected / 2 ) + 1;
+      if ( offset > TEST_TOTSZ ) { offset = TEST_TOTSZ; }
+   }
+   if ( dal->close( block ) ) {
+      printf( "ERROR: Failed to close block after read!\n" );
+      ret = -1;
+   }
+   if ( dal->del( dal->ctxt, loc, "vec" ) ) {
+      printf( "ERROR: Failed to delete test object!\n" );
+      ret = -1;
+   }
+   return ret;
+}
+
+
+
+DAL init_config( char* dal_config ) {
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return NULL;
+   }
+   DAL dal = init_dal( xmlDocGetRootElement( config ), loc );
+   xmlFreeDoc( config );
+   if ( dal == NULL ) {
+      printf( "ERROR: Failed to initialize DAL!\n" );
+   }
+   return dal;
+}
+
+
+
+int main( int argc, char** argv ) {
+   setvbuf( stdout, NULL, _IONBF, 0 );
+   char* src = malloc( TEST_TOTSZ );
+   char* dst = malloc( TEST_TOTSZ );
+   if ( src == NULL  ||  dst == NULL ) {
+      printf( "ERROR: Failed to allocate test buffers!\n" );
+      return -1;
+   }
+   size_t i;
+   for ( i = 0; i < TEST_TOTSZ; i++ ) { src[i] = (char)( ( i * 13 ) + ( i / 97 ) ); }
+
+   int ret = 0;
+   int config;
+   for ( config = 0; ret == 0  &&  config < sizeof( dal_configs ) / sizeof( char* ); config++ ) {
+      DAL dal = init_config( dal_configs[config] );
+      if ( dal == NULL ) { ret = -1; break; }
+      printf( "Testing vectored ops of DAL config: %s ( native putv = %s, getv = %s )\n", dal_configs[config],
+              ( dal->putv ) ? "yes" : "no", ( dal->getv ) ? "yes" : "no" );
+      if ( test_vectors( dal, src, dst ) ) { ret = -1; }
+      // repeat through the per-buffer fallbacks of dal_putv() / dal_getv()
+      if ( ret == 0  &&  ( dal->putv  ||  dal->getv ) ) {
+         printf( "Testing vectored op fallbacks\n" );
+         dal->putv = NULL;
+         dal->getv = NULL;
+         if ( test_vectors( dal, src, dst ) ) { ret = -1; }
+      }
+      dal->cleanup( dal );
+   }
+   xmlCleanupParser();
+   free( src );
+   free( dst );
+   return ret;
+}
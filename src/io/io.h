@@ -70,10 +70,15 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <pthread.h>
 #include <stdint.h>
 
-#define SUPER_BLOCK_CNT 2
+#define SUPER_BLOCK_CNT 2 // default number of ioblocks per ioqueue
+#define SUPER_BLOCK_MAX 4 // maximum number of ioblocks per ioqueue ( extras are only allocated for deep readahead )
+#define IOBLOCK_ALIGN 4096 // alignment of ioblock buffers ( permits O_DIRECT transfers directly to / from them )
+#define IOV_IO_MAX 64 // maximum number of IOs ( each data + CRC ) transferred by a single vectored DAL call
 #define CRC_BYTES 4 // DO NOT decrease without adjusting CRC gen and block creation code!
 #define CRC_SEED 57
-#define MINFO_VER 1
+#define MINFO_VER 2 // binary encoding ( see metainfo.c ); version 1 strings remain readable
+#define MINFO_TEXT_VER 1
+#define CKPT_VER 2 // version 2 adds the identity of the rebuilt object
 
 
 // forward declaration of DAL references (anything actually using this file will need to include "dal.h" as well!)
@@ -100,6 +105,18 @@ typedef struct meta_info_struct {
 } meta_info;
 
 
+// Progress of an interrupted block rebuild, allowing it to be resumed ( see DAL_RESUME )
+// NOTE -- the previous checkpoint is retained, as the output threads of a rebuild 
+//         may be interrupted on either side of any one checkpoint
+typedef struct rebuild_ckpt_struct {
+   meta_info minfo;     // meta info of the block, with blocksz / crcsum reflecting the data stored as of the checkpoint
+   ssize_t   prevsz;    // block size as of the previous checkpoint ( zero, if none )
+   long long prevcrc;   // CRC sum as of the previous checkpoint
+   long long objsum;    // identity of the object being rebuilt ( see ne_rebuild() ), so that a checkpoint left 
+                        //  by some prior version of the object is never resumed
+} rebuild_ckpt;
+
+
 /**
  * Perform a DAL get_meta call and parse the resulting string 
  * into the provided meta_info_struct reference.
@@ -111,7 +128,7 @@ typedef struct meta_info_struct {
 int dal_get_minfo( DAL dal, BLOCK_CTXT handle, meta_info* minfo );
 
 /**
- * Convert a meta_info struct to string format and perform a DAL set_meta call
+ * Convert a meta_info struct to its binary ( MINFO_VER ) format and perform a DAL set_meta call
  * @param DAL dal : Dal on which to perfrom the get_meta operation
  * @param BLOCK_CTXT handle : Block on which this operation is being performed
  * @param meta_info* minfo : meta_info reference to populate with values 
@@ -120,6 +137,26 @@ int dal_get_minfo( DAL dal, BLOCK_CTXT handle, meta_info* minfo );
 int dal_set_minfo( DAL dal, BLOCK_CTXT handle, meta_info* minfo );
 
 
+/**
+ * Convert a rebuild_ckpt struct to string format and perform a DAL checkpoint call
+ * @param DAL dal : Dal on which to perfrom the checkpoint operation
+ * @param BLOCK_CTXT handle : REBUILD/RESUME block on which this operation is being performed
+ * @param rebuild_ckpt* ckpt : rebuild_ckpt reference to be stored
+ * @return int : Zero on success, or a negative value if an error occurred 
+ */
+int dal_set_ckpt( DAL dal, BLOCK_CTXT handle, rebuild_ckpt* ckpt );
+
+/**
+ * Perform a DAL get_meta call on a RESUME block and parse the resulting 
+ * string into the provided rebuild_ckpt reference.
+ * @param DAL dal : Dal on which to perfrom the get_meta operation
+ * @param BLOCK_CTXT handle : RESUME block on which this operation is being performed
+ * @param rebuild_ckpt* ckpt : rebuild_ckpt reference to populate with values
+ * @return int : Zero on success, or a negative value if no complete checkpoint could be retrieved
+ */
+int dal_get_ckpt( DAL dal, BLOCK_CTXT handle, rebuild_ckpt* ckpt );
+
+
 /*
  * Duplicates info from one meta_info struct to another
  * @param meta_info* target : Target struct reference
@@ -145,6 +182,7 @@ typedef struct ioblock_struct {
  //  off_t  error_start;  // offset in buffer at which data errors begin
    off_t  error_end;    // offset in buffer at which data errors end
    void*  buff;         // buffer for data transfer
+   int    shares;       // number of additional holders of this ioblock ( see ioblock_share() )
 } ioblock;
 
 
@@ -154,7 +192,13 @@ typedef struct ioqueue_struct {
    pthread_cond_t  avail_block;  // condition for awaiting an available block
    int             head;         // integer indicating location of the next available block
    int             depth;        // current depth of the queue
-   ioblock         block_list[SUPER_BLOCK_CNT]; // list of ioblocks
+   int             blockcnt;     // number of ioblocks currently in rotation
+   int             readahead;    // number of filled ioblocks a producer may get ahead of its consumer
+   char            nonblock;     // if set, producers fail with EAGAIN rather than waiting on the consumer
+   char            yielded;      // a nonblocking producer failed with EAGAIN, and has not yet been woken
+   void          (*wake)( void* ); // called to wake a nonblocking producer which yielded ( may be NULL )
+   void*           wake_arg;     // argument to the wake function
+   ioblock         block_list[SUPER_BLOCK_MAX]; // list of ioblocks
 
    //size_t          fill_threshold;
    size_t          split_threshold;
@@ -189,6 +233,44 @@ int destroy_ioqueue( ioqueue* ioq );
  */
 ssize_t ioqueue_maxdata( ioqueue* ioq );
 
+/**
+ * Retrieve the number of ioblocks currently in rotation within the given IOQueue
+ * @param ioqueue* ioq : IOQueue to be checked
+ * @return int : Number of ioblocks, or a negative value if an error occurred
+ */
+int ioqueue_blockcnt( ioqueue* ioq );
+
+/**
+ * Sets the readahead of the given IOQueue
+ * NOTE -- readahead beyond SUPER_BLOCK_CNT - 1 ioblocks takes effect gradually, as the producer cycles through ioblocks
+ * @param ioqueue* ioq : IOQueue to be updated
+ * @param int readahead : Number of filled ioblocks the producer may get ahead of its consumer ( zero to only ever
+ *                        fill an ioblock once the consumer has released all others )
+ * @return int : Zero on success and a negative value if an error occurred
+ */
+int ioqueue_set_readahead( ioqueue* ioq, int readahead );
+
+/**
+ * Sets whether producers of the given IOQueue may block while waiting on the consumer
+ * NOTE -- this is intended for producers run by a shared thread pool, which should yield rather than block
+ * @param ioqueue* ioq : IOQueue to be updated
+ * @param char nonblock : If non-zero, reserve_ioblock() and ioqueue_wait_readahead() will fail with 
+ *                        errno == EAGAIN, rather than waiting for the consumer to release an ioblock
+ * @param void (*wake)( void* ) : Function called ( without the queue lock held ) once the consumer releases an 
+ *                                ioblock or raises the readahead after the producer yielded ( may be NULL )
+ * @param void* wake_arg : Argument to be passed to the wake function
+ * @return int : Zero on success and a negative value if an error occurred
+ */
+int ioqueue_set_nonblocking( ioqueue* ioq, char nonblock, void (*wake)( void* ), void* wake_arg );
+
+/**
+ * Wait until the producer of the given IOQueue is permitted to fill its current ioblock, based on the queue readahead
+ * @param ioqueue* ioq : IOQueue to wait on
+ * @return int : Zero on success and a negative value if an error occurred 
+ *               ( errno == EAGAIN, if the ioqueue is nonblocking and the producer would have to wait )
+ */
+int ioqueue_wait_readahead( ioqueue* ioq );
+
 /**
  * Sets ioblock fill level such that a specific data split will occur (used to align ioblock to a specific offset)
  * @param ioblock* iob : Current ioblock
@@ -206,7 +288,8 @@ int align_ioblock( ioblock* cur_block, size_t trim, ioqueue* ioq );
  * @param ioqueue* ioq : Reference to the ioqueue struct from which ioblocks should be gathered
  * @return int : A positive value if the passed ioblock is full and push_block has been set (cur_block updated and push_block set),
  *               a value of zero if the current ioblock is now safe to fill (cur_block set to new ioblock reference OR unchanged), 
- *               and a negative value if an error was encountered.
+ *               and a negative value if an error was encountered ( errno == EAGAIN, if the ioqueue is nonblocking 
+ *               and no ioblock is available; cur_block is left unchanged and the call may simply be repeated ).
  * 
  * NOTE: It is an error to write data of size != both erasure part size and the IO size to an ioblock.
  * 
@@ -254,6 +337,23 @@ size_t ioblock_get_fill( ioblock* block );
  */
 int release_ioblock( ioqueue* ioq );
 
+/**
+ * Adds a holder to an ioblock, allowing it to be handed off to another consumer ( such as a write thread ) 
+ *  without copying its data.  The ioblock will only be made available again once all holders have called 
+ *  release_shared_ioblock().
+ * @param ioblock* block : Reference to the ioblock to be shared
+ */
+void ioblock_share( ioblock* block );
+
+/**
+ * Drops a holder of an ioblock, releasing it to its ioqueue if no other holders remain ( equivalent to 
+ *  release_ioblock(), for an ioblock which was never shared )
+ * @param ioblock* block : Reference to the ioblock to be released
+ * @param ioqueue* ioq : Reference to the ioqueue the ioblock belongs to
+ * @return int : Zero on success and a negative value if an error occurred
+ */
+int release_shared_ioblock( ioblock* block, ioqueue* ioq );
+
 
 
 /* ------------------------------   THREAD BEHAVIOR   ------------------------------ */
@@ -270,6 +370,13 @@ typedef struct global_state_struct {
    char         meta_error;
    char         data_error;
    ioqueue*     ioq;
+   char         shared_iob; // write threads only -- ioblocks are shared from the consumer of a read ioq 
+                            //   ( see ioblock_share() ), and may span any number of IOs
+   unsigned int ckpt_ios;   // write threads only -- number of IOs between rebuild checkpoints ( zero for none ),
+                            //   which are only taken when consuming shared ioblocks
+   rebuild_ckpt ckpt;       // write threads only -- most recent rebuild checkpoint ( for DAL_RESUME, populated with 
+                            //   that of the interrupted rebuild by write_init(), then replaced with the actual resume 
+                            //   point prior to the first write )
 } gthread_state;
 
 
@@ -281,6 +388,11 @@ typedef struct thread_state_struct {
    ioblock*     iob;
    uint64_t     crcsumchk;
    char         continuous;
+   size_t       iofill;     // data written to the current IO, when consuming shared ioblocks
+   uint32_t     iocrc;      // running CRC of the current IO, when consuming shared ioblocks
+   char         resumed;    // set once a DAL_RESUME handle has been positioned at the resume point
+   size_t       skip;       // data of shared ioblocks yet to be discarded, when resuming partway through a stripe
+   DAL_REQ      pending;    // outstanding put of our previous ioblock, when consuming our own ioblocks
 } thread_state;
 
 
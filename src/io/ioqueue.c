@@ -131,6 +131,18 @@ underlying skt_etc() functions.
 /* ------------------------------   IO QUEUE/BLOCK INTERACTION   ------------------------------ */
 
 
+/**
+ * Allocate an ioblock buffer, aligned such that DALs may transfer data directly to / from it
+ * @param size_t size : Byte size of the buffer
+ * @return void* : Reference to the new buffer, or NULL on failure
+ */
+static void* alloc_ioblock_buff( size_t size ) {
+   void* buff = NULL;
+   if ( posix_memalign( &buff, IOBLOCK_ALIGN, size ) ) { return NULL; }
+   return buff;
+}
+
+
 /**
  * Creates a new IOQueue
  * @param size_t iosz : Byte size of each IO to be performed
@@ -180,6 +192,12 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
    ioq->partcnt = partcnt;
    ioq->head = 0;
    ioq->depth = SUPER_BLOCK_CNT;
+   ioq->blockcnt = SUPER_BLOCK_CNT;
+   ioq->readahead = SUPER_BLOCK_CNT - 1;
+   ioq->nonblock = 0;
+   ioq->yielded = 0;
+   ioq->wake = NULL;
+   ioq->wake_arg = NULL;
    // calculate the blocksz we must allocate to allways fit written data
    // NOTE -- assuming perfect IOSZ and PARTSZ alignment, we will need space for a full buffer plus
    //         room for trailing CRC bytes.
@@ -201,7 +219,7 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
    int i;
    for ( i = 0; i < SUPER_BLOCK_CNT; i++ ) {
       // initialize state and struct for each ioblock
-      ioq->block_list[i].buff = malloc( sizeof( char ) * ioq->blocksz );
+      ioq->block_list[i].buff = alloc_ioblock_buff( sizeof( char ) * ioq->blocksz );
       if ( ioq->block_list[i].buff == NULL ) {
          // we've messed up, time to try to clean everything up
          LOG( LOG_ERR, "failed to allocate space for ioblock %d!\n", i );
@@ -215,6 +233,14 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
       }
       ioq->block_list[i].data_size   = 0;
       ioq->block_list[i].error_end   = 0;
+      ioq->block_list[i].shares      = 0;
+   }
+   // any additional ioblocks are only allocated if readahead is increased
+   for ( ; i < SUPER_BLOCK_MAX; i++ ) {
+      ioq->block_list[i].buff        = NULL;
+      ioq->block_list[i].data_size   = 0;
+      ioq->block_list[i].error_end   = 0;
+      ioq->block_list[i].shares      = 0;
    }
    return ioq;
 }
@@ -226,12 +252,12 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
  * @return int : Zero on success and a negative value if an error occurred
  */
 int destroy_ioqueue( ioqueue* ioq ) {
-   if ( ioq->depth != SUPER_BLOCK_CNT ) {
+   if ( ioq->depth != ioq->blockcnt ) {
       LOG( LOG_ERR, "Cannot destroy ioqueue struct while ioblocks are in use!\n" );
       return -1;
    }
    int i;
-   for ( i = 0; i < SUPER_BLOCK_CNT; i++ ) {
+   for ( i = 0; i < SUPER_BLOCK_MAX; i++ ) {
       free( ioq->block_list[i].buff );
    }
    pthread_cond_destroy( &(ioq->avail_block) );
@@ -252,7 +278,170 @@ ssize_t ioqueue_maxdata( ioqueue* ioq ) {
 		LOG( LOG_ERR, "Received NULL ioqueue reference!\n" );
 		return -1;
 	}
-	return ( ioq->depth * ioq->split_threshold );
+	if ( pthread_mutex_lock(&ioq->qlock) ) {
+		LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
+		return -1;
+	}
+	ssize_t maxdata = ioq->depth * ioq->split_threshold;
+	pthread_mutex_unlock(&ioq->qlock);
+	return maxdata;
+}
+
+
+/**
+ * Retrieve the number of ioblocks currently in rotation within the given IOQueue
+ * @param ioqueue* ioq : IOQueue to be checked
+ * @return int : Number of ioblocks, or a negative value if an error occurred
+ */
+int ioqueue_blockcnt( ioqueue* ioq ) {
+   if ( ioq == NULL ) {
+      LOG( LOG_ERR, "Received NULL ioqueue reference!\n" );
+      return -1;
+   }
+   if ( pthread_mutex_lock(&ioq->qlock) ) {
+      LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
+      return -1;
+   }
+   int blockcnt = ioq->blockcnt;
+   pthread_mutex_unlock(&ioq->qlock);
+   return blockcnt;
+}
+
+
+/**
+ * Signal the producer of the given IOQueue that it may be able to proceed
+ * NOTE -- the caller must hold the queue lock
+ * @param ioqueue* ioq : IOQueue whose producer should be signaled
+ * @return char : Non-zero if the producer yielded, and its wake function must be called once the lock is released
+ */
+static char signal_producer( ioqueue* ioq ) {
+   pthread_cond_signal(&ioq->avail_block); // a waiting producer may now be able to proceed
+   if ( !(ioq->yielded) ) { return 0; }
+   ioq->yielded = 0;
+   return ( ioq->wake != NULL );
+}
+
+
+/**
+ * Sets the readahead of the given IOQueue
+ * NOTE -- readahead beyond SUPER_BLOCK_CNT - 1 ioblocks takes effect gradually, as the producer cycles through ioblocks
+ * @param ioqueue* ioq : IOQueue to be updated
+ * @param int readahead : Number of filled ioblocks the producer may get ahead of its consumer ( zero to only ever
+ *                        fill an ioblock once the consumer has released all others )
+ * @return int : Zero on success and a negative value if an error occurred
+ */
+int ioqueue_set_readahead( ioqueue* ioq, int readahead ) {
+   if ( ioq == NULL ) {
+      LOG( LOG_ERR, "Received NULL ioqueue reference!\n" );
+      return -1;
+   }
+   if ( readahead < 0  ||  readahead >= SUPER_BLOCK_MAX ) {
+      LOG( LOG_ERR, "Readahead value of %d is outside the supported range\n", readahead );
+      return -1;
+   }
+   if ( pthread_mutex_lock(&ioq->qlock) ) {
+      LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
+      return -1;
+   }
+   LOG( LOG_INFO, "Adjusting readahead from %d to %d ioblocks\n", ioq->readahead, readahead );
+   ioq->readahead = readahead;
+   char wake = signal_producer( ioq );
+   pthread_mutex_unlock(&ioq->qlock);
+   if ( wake ) { ioq->wake( ioq->wake_arg ); } // a yielded producer is otherwise only retried by polling
+   return 0;
+}
+
+
+/**
+ * Sets whether producers of the given IOQueue may block while waiting on the consumer
+ * NOTE -- this is intended for producers run by a shared thread pool, which should yield rather than block
+ * @param ioqueue* ioq : IOQueue to be updated
+ * @param char nonblock : If non-zero, reserve_ioblock() and ioqueue_wait_readahead() will fail with 
+ *                        errno == EAGAIN, rather than waiting for the consumer to release an ioblock
+ * @param void (*wake)( void* ) : Function called ( without the queue lock held ) once the consumer releases an 
+ *                                ioblock or raises the readahead after the producer yielded ( may be NULL )
+ * @param void* wake_arg : Argument to be passed to the wake function
+ * @return int : Zero on success and a negative value if an error occurred
+ */
+int ioqueue_set_nonblocking( ioqueue* ioq, char nonblock, void (*wake)( void* ), void* wake_arg ) {
+   if ( ioq == NULL ) {
+      LOG( LOG_ERR, "Received NULL ioqueue reference!\n" );
+      return -1;
+   }
+   if ( pthread_mutex_lock(&ioq->qlock) ) {
+      LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
+      return -1;
+   }
+   ioq->nonblock = nonblock;
+   ioq->wake = wake;
+   ioq->wake_arg = wake_arg;
+   pthread_mutex_unlock(&ioq->qlock);
+   return 0;
+}
+
+
+/**
+ * Wait until the producer of the given IOQueue is permitted to fill its current ioblock, based on the queue readahead
+ * @param ioqueue* ioq : IOQueue to wait on
+ * @return int : Zero on success and a negative value if an error occurred 
+ *               ( errno == EAGAIN, if the ioqueue is nonblocking and the producer would have to wait )
+ */
+int ioqueue_wait_readahead( ioqueue* ioq ) {
+   if ( ioq == NULL ) {
+      LOG( LOG_ERR, "Received NULL ioqueue reference!\n" );
+      return -1;
+   }
+   if ( pthread_mutex_lock(&ioq->qlock) ) {
+      LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
+      return -1;
+   }
+   // NOTE -- one of the ioblocks in use is the one the producer is filling
+   while ( (ioq->blockcnt - ioq->depth) - 1 > ioq->readahead ) {
+      if ( ioq->nonblock ) {
+         LOG( LOG_INFO, "Producer is at readahead of %d, yielding\n", ioq->readahead );
+         ioq->yielded = 1;
+         pthread_mutex_unlock(&ioq->qlock);
+         errno = EAGAIN;
+         return -1;
+      }
+      LOG( LOG_INFO, "Waiting for the consumer to catch up to readahead of %d\n", ioq->readahead );
+      pthread_cond_wait( &ioq->avail_block, &ioq->qlock );
+   }
+   pthread_mutex_unlock(&ioq->qlock);
+   return 0;
+}
+
+
+/**
+ * Adjust the number of ioblocks in rotation to suit the current readahead, as the head of the queue wraps around
+ * NOTE -- the caller must hold the queue lock, and the in-use ioblocks must be those immediately preceding the head
+ * @param ioqueue* ioq : IOQueue to be adjusted
+ */
+static void resize_ioqueue( ioqueue* ioq ) {
+   int want = ioq->readahead + 1;
+   if ( want < SUPER_BLOCK_CNT ) { want = SUPER_BLOCK_CNT; }
+   int inuse = ioq->blockcnt - ioq->depth;
+   if ( want > ioq->blockcnt ) {
+      // append new ioblocks after the current head, which will be the next to be reserved
+      int i;
+      for ( i = ioq->blockcnt; i < want; i++ ) {
+         if ( ioq->block_list[i].buff == NULL  &&
+              (ioq->block_list[i].buff = alloc_ioblock_buff( sizeof( char ) * ioq->blocksz )) == NULL ) {
+            LOG( LOG_WARNING, "Failed to allocate additional ioblock %d, readahead will be limited\n", i );
+            break;
+         }
+      }
+      LOG( LOG_INFO, "Growing ioqueue from %d to %d ioblocks\n", ioq->blockcnt, i );
+      ioq->depth += ( i - ioq->blockcnt );
+      ioq->blockcnt = i;
+   }
+   else if ( want < ioq->blockcnt  &&  inuse <= want  &&  inuse <= ioq->blockcnt - want ) {
+      // all ioblocks in use lie beyond the reduced rotation, so the next 'want' blocks are free
+      LOG( LOG_INFO, "Shrinking ioqueue from %d to %d ioblocks\n", ioq->blockcnt, want );
+      ioq->depth -= ( ioq->blockcnt - want );
+      ioq->blockcnt = want;
+   }
+   if ( ioq->head >= ioq->blockcnt ) { ioq->head = 0; }
 }
 
 
@@ -345,6 +534,14 @@ int reserve_ioblock( ioblock** cur_block, ioblock** push_block, ioqueue* ioq ) {
    }
    // wait for a block to be available for use
    while ( ioq->depth == 0 ) {
+      if ( ioq->nonblock ) {
+         LOG( LOG_INFO, "No ioblock is available, yielding\n" );
+         ioq->yielded = 1;
+         pthread_mutex_unlock(&ioq->qlock);
+         if ( prev_block != NULL ) { (*push_block) = NULL; } // the caller still holds the previous block
+         errno = EAGAIN;
+         return -1;
+      }
       LOG( LOG_INFO, "Waiting for ioblock to become available\n" );
       pthread_cond_wait( &ioq->avail_block, &ioq->qlock );
    }
@@ -353,7 +550,7 @@ int reserve_ioblock( ioblock** cur_block, ioblock** push_block, ioqueue* ioq ) {
    // update queue values to reflect the block being in use
    ioq->depth--;
    ioq->head += 1;
-   if ( ioq->head == SUPER_BLOCK_CNT ) { ioq->head = 0; }
+   if ( ioq->head == ioq->blockcnt ) { resize_ioqueue( ioq ); }
    pthread_mutex_unlock(&ioq->qlock);
 
    // clear any old values in this newly reserved block
@@ -455,16 +652,49 @@ int release_ioblock( ioqueue* ioq ) {
       LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
       return -1;
    }
-   if ( ioq->depth == SUPER_BLOCK_CNT ) {
+   if ( ioq->depth == ioq->blockcnt ) {
       LOG( LOG_ERR, "No outstanding ioblocks to be released!\n" );
+      pthread_mutex_unlock(&ioq->qlock);
       return -1;
    }
    ioq->depth++;
-   LOG( LOG_INFO, "%d out of %d ioblocks available\n", ioq->depth, SUPER_BLOCK_CNT );
-   pthread_cond_signal(&ioq->avail_block);
+   LOG( LOG_INFO, "%d out of %d ioblocks available\n", ioq->depth, ioq->blockcnt );
+   char wake = signal_producer( ioq );
    pthread_mutex_unlock(&ioq->qlock);
+   if ( wake ) { ioq->wake( ioq->wake_arg ); } // a yielded producer is otherwise only retried by polling
    return 0;
 }
 
 
+/**
+ * Adds a holder to an ioblock, allowing it to be handed off to another consumer ( such as a write thread ) 
+ *  without copying its data.  The ioblock will only be made available again once all holders have called 
+ *  release_shared_ioblock().
+ * @param ioblock* block : Reference to the ioblock to be shared
+ */
+void ioblock_share( ioblock* block ) {
+   __atomic_add_fetch( &block->shares, 1, __ATOMIC_SEQ_CST );
+}
+
+
+/**
+ * Drops a holder of an ioblock, releasing it to its ioqueue if no other holders remain ( equivalent to 
+ *  release_ioblock(), for an ioblock which was never shared )
+ * NOTE -- every holder releases its ioblocks in queue order, so the final release of each ioblock 
+ *         still occurs in queue order
+ * @param ioblock* block : Reference to the ioblock to be released
+ * @param ioqueue* ioq : Reference to the ioqueue the ioblock belongs to
+ * @return int : Zero on success and a negative value if an error occurred
+ */
+int release_shared_ioblock( ioblock* block, ioqueue* ioq ) {
+   if ( __atomic_fetch_sub( &block->shares, 1, __ATOMIC_SEQ_CST ) > 0 ) {
+      LOG( LOG_INFO, "Ioblock is still held elsewhere, leaving it in use\n" );
+      return 0;
+   }
+   // we were the final holder, so no one else can reference this ioblock
+   block->shares = 0;
+   return release_ioblock( ioq );
+}
+
+
 
@@ -181,6 +181,11 @@ int write_init( unsigned int tID, void* global_state, void** state ) {
    tstate->iob    = NULL;
    tstate->crcsumchk = 0;
    tstate->continuous = 1;
+   tstate->iofill = 0;
+   tstate->iocrc = 0;
+   tstate->resumed = 0;
+   tstate->skip = 0;
+   tstate->pending = NULL;
    tstate->handle = dal->open( dal->ctxt, gstate->dmode, gstate->location, gstate->objID );
    if( tstate->handle == NULL ) {
       LOG( LOG_ERR, "failed to open handle for block %d!\n", gstate->location.block );
@@ -189,6 +194,17 @@ int write_init( unsigned int tID, void* global_state, void** state ) {
       return -1;
    }
 
+   // retrieve the progress of any interrupted rebuild, for the master proc to pick a resume point
+   if ( gstate->dmode == DAL_RESUME  &&  dal_get_ckpt( dal, tstate->handle, &(gstate->ckpt) ) ) {
+      LOG( LOG_INFO, "No usable checkpoint for block %d, any rebuild will start over\n", gstate->location.block );
+      gstate->ckpt.minfo.N = 0;
+      gstate->ckpt.minfo.blocksz = 0;
+      gstate->ckpt.minfo.crcsum = 0;
+      gstate->ckpt.prevsz = 0;
+      gstate->ckpt.prevcrc = 0;
+      gstate->ckpt.objsum = 0;
+   }
+
    return 0;
 }
 
@@ -227,6 +243,9 @@ int read_init( unsigned int tID, void* global_state, void** state ) {
    tstate->iob    = NULL;
    tstate->crcsumchk = 0;
    tstate->continuous = 1;
+   tstate->iofill = 0;
+   tstate->iocrc = 0;
+   tstate->pending = NULL;
    if ( tstate->offset ) { tstate->continuous = 0; }
 
    // open a handle for this block
@@ -254,6 +273,197 @@ int read_init( unsigned int tID, void* global_state, void** state ) {
 }
 
 
+/**
+ * Position a DAL_RESUME write thread at the resume point selected by the master proc ( gstate->ckpt ), 
+ *  if not done already
+ * @param thread_state* tstate : Thread state reference
+ * @return int : Zero on success, -1 on failure
+ */
+static int resume_shared_io( thread_state* tstate ) {
+   gthread_state* gstate = (gthread_state*) (tstate->gstate);
+   if ( gstate->dmode != DAL_RESUME  ||  tstate->resumed ) { return 0; }
+   tstate->resumed = 1;
+   gstate->minfo.blocksz = gstate->ckpt.minfo.blocksz;
+   gstate->minfo.crcsum = gstate->ckpt.minfo.crcsum;
+   // our first shared ioblock begins with the stripe containing the resume point
+   size_t resume_data = ( gstate->minfo.blocksz / gstate->minfo.versz ) * ( gstate->minfo.versz - CRC_BYTES );
+   tstate->skip = resume_data % gstate->minfo.partsz;
+   LOG( LOG_INFO, "Resuming rebuild of block %d at offset %zd\n", gstate->location.block, gstate->minfo.blocksz );
+   if ( gstate->dal->resume( tstate->handle, gstate->minfo.blocksz ) ) {
+      LOG( LOG_ERR, "Failed to resume block %d at offset %zd!\n", gstate->location.block, gstate->minfo.blocksz );
+      gstate->data_error = 1;
+      return -1;
+   }
+   // replace the checkpoint of the interrupted rebuild, which may lie beyond our resume point
+   if ( gstate->ckpt_ios  &&  dal_set_ckpt( gstate->dal, tstate->handle, &(gstate->ckpt) ) ) {
+      LOG( LOG_WARNING, "Failed to record resume point of block %d\n", gstate->location.block );
+   }
+   return 0;
+}
+
+
+/**
+ * Account for the CRC which completes the current IO of a write thread consuming shared ioblocks
+ * @param thread_state* tstate : Thread state reference
+ * @return char : Non-zero if the completed IO ends a checkpoint interval
+ */
+static char complete_shared_io( thread_state* tstate ) {
+   gthread_state* gstate = (gthread_state*) (tstate->gstate);
+   gstate->minfo.crcsum += tstate->iocrc;
+   gstate->minfo.blocksz += CRC_BYTES;
+   tstate->iofill = 0;
+   size_t iocnt = gstate->minfo.blocksz / gstate->minfo.versz;
+   return ( gstate->ckpt_ios  &&  ( gstate->minfo.blocksz % gstate->minfo.versz ) == 0  &&
+            ( iocnt % gstate->ckpt_ios ) == 0 );
+}
+
+
+/**
+ * Checkpoint the progress of a write thread consuming shared ioblocks, once all completed IOs have been written
+ * @param thread_state* tstate : Thread state reference
+ */
+static void checkpoint_shared_io( thread_state* tstate ) {
+   gthread_state* gstate = (gthread_state*) (tstate->gstate);
+   if ( gstate->data_error ) { return; }
+   LOG( LOG_INFO, "Checkpointing block %d at offset %zd\n", gstate->location.block, gstate->minfo.blocksz );
+   gstate->ckpt.prevsz = gstate->ckpt.minfo.blocksz;
+   gstate->ckpt.prevcrc = gstate->ckpt.minfo.crcsum;
+   cpy_minfo( &(gstate->ckpt.minfo), &(gstate->minfo) );
+   gstate->ckpt.minfo.crcsum = gstate->minfo.crcsum;
+   // failing to checkpoint only means that an interrupted rebuild will have to repeat more work
+   if ( dal_set_ckpt( gstate->dal, tstate->handle, &(gstate->ckpt) ) ) {
+      LOG( LOG_WARNING, "Failed to checkpoint block %d\n", gstate->location.block );
+   }
+}
+
+
+/**
+ * Write out a list of buffers via the DAL, but only if we have not yet encountered a write error
+ * @param thread_state* tstate : Thread state reference
+ * @param struct iovec* iov : Buffers to be written
+ * @param int iovcnt : Count of buffers
+ * @return int : Zero on success, -1 on failure
+ */
+static int put_shared_iov( thread_state* tstate, struct iovec* iov, int iovcnt ) {
+   gthread_state* gstate = (gthread_state*) (tstate->gstate);
+   if ( iovcnt == 0  ||  gstate->data_error ) { return 0; }
+   if ( dal_putv( gstate->dal, tstate->handle, iov, iovcnt ) ) {
+      LOG( LOG_ERR, "Failed to write %d buffers to block %d!\n", iovcnt, gstate->location.block );
+      gstate->data_error = 1;
+      // don't bother to abort yet, we'll do that on close
+      return -1;
+   }
+   return 0;
+}
+
+
+/**
+ * Complete the current IO of a write thread consuming shared ioblocks, by writing out its CRC
+ *  ( and checkpointing our progress, if this IO completes a checkpoint interval )
+ * @param thread_state* tstate : Thread state reference
+ * @return int : Zero on success, -1 on failure
+ */
+static int finish_shared_io( thread_state* tstate ) {
+   if ( tstate->iofill == 0 ) { return 0; }
+   uint32_t crc = tstate->iocrc;
+   char ckpt = complete_shared_io( tstate );
+   struct iovec iov = { .iov_base = &crc, .iov_len = CRC_BYTES };
+   if ( put_shared_iov( tstate, &iov, 1 ) ) { return -1; }
+   if ( ckpt ) { checkpoint_shared_io( tstate ); }
+   return 0;
+}
+
+
+/**
+ * Write out the data of a shared ioblock, which may span any number of IOs ( unlike our own ioblocks, we 
+ *  have no room to append CRCs in place, so these are gathered in following the data of each IO )
+ * @param thread_state* tstate : Thread state reference
+ * @param void* datasrc : Data to be written
+ * @param size_t datasz : Size of the data
+ * @return int : Zero on success, -1 on failure
+ */
+static int write_shared_data( thread_state* tstate, void* datasrc, size_t datasz ) {
+   gthread_state* gstate = (gthread_state*) (tstate->gstate);
+   size_t iodata = gstate->minfo.versz - CRC_BYTES;
+   struct iovec iov[ 2 * IOV_IO_MAX ];
+   uint32_t crcs[ IOV_IO_MAX ];
+   int iovcnt = 0;
+   int crccnt = 0;
+   // discard any data preceding our resume point
+   if ( tstate->skip ) {
+      size_t skip = ( tstate->skip < datasz ) ? tstate->skip : datasz;
+      tstate->skip -= skip;
+      datasrc += skip;
+      datasz -= skip;
+   }
+   while ( datasz ) {
+      size_t chunk = iodata - tstate->iofill;
+      if ( chunk > datasz ) { chunk = datasz; }
+      // the CRC of each IO is accumulated across ioblocks
+      tstate->iocrc = crc32_ieee( (tstate->iofill) ? tstate->iocrc : CRC_SEED, datasrc, chunk );
+      tstate->iofill += chunk;
+      gstate->minfo.blocksz += chunk;
+      iov[iovcnt].iov_base = datasrc;
+      iov[iovcnt].iov_len = chunk;
+      iovcnt++;
+      datasrc += chunk;
+      datasz -= chunk;
+      if ( tstate->iofill == iodata ) {
+         crcs[crccnt] = tstate->iocrc;
+         iov[iovcnt].iov_base = &(crcs[crccnt]);
+         iov[iovcnt].iov_len = CRC_BYTES;
+         iovcnt++;
+         crccnt++;
+         char ckpt = complete_shared_io( tstate );
+         // a checkpoint may only describe data which has actually been written
+         if ( ckpt  ||  crccnt == IOV_IO_MAX ) {
+            if ( put_shared_iov( tstate, iov, iovcnt ) ) { return -1; }
+            iovcnt = 0;
+            crccnt = 0;
+            if ( ckpt ) { checkpoint_shared_io( tstate ); }
+         }
+      }
+   }
+   return put_shared_iov( tstate, iov, iovcnt );
+}
+
+
+/**
+ * Release one of our own ioblocks, once its put has completed
+ * @param thread_state* tstate : Thread state reference
+ * @param ssize_t result : Result of the put of the ioblock ( zero if it was never written )
+ * @return int : Zero on success, -1 if the ioblock could not be released
+ */
+static int release_put_ioblock( thread_state* tstate, ssize_t result ) {
+   gthread_state* gstate = (gthread_state*) (tstate->gstate);
+   if ( result ) {
+      LOG( LOG_ERR, "Failed to write ioblock to block %d!\n", gstate->location.block );
+      gstate->data_error = 1;
+      // don't bother to abort yet, we'll do that on close
+   }
+   if ( release_ioblock( gstate->ioq ) ) {
+      LOG( LOG_ERR, "Block %d failed to release ioblock!\n", gstate->location.block );
+      gstate->data_error = 1;
+      return -1;
+   }
+   return 0;
+}
+
+
+/**
+ * Complete the outstanding put of our previous ioblock ( if any ), and release that ioblock
+ * @param thread_state* tstate : Thread state reference
+ * @return int : Zero on success, -1 if the ioblock could not be released
+ */
+static int complete_pending_put( thread_state* tstate ) {
+   gthread_state* gstate = (gthread_state*) (tstate->gstate);
+   if ( tstate->pending == NULL ) { return 0; }
+   ssize_t result = dal_wait( gstate->dal, tstate->handle, tstate->pending );
+   tstate->pending = NULL;
+   return release_put_ioblock( tstate, result );
+}
+
+
 /**
  * Consume data buffers, generate CRCs for them, and write blocks out to their targets
  * @param void** state : Thread state reference
@@ -274,10 +484,23 @@ int write_consume( void** state, void** work_todo ) {
    if ( datasrc == NULL ) {
       LOG( LOG_ERR, "Block %d received a NULL read target from ioblock!\n", gstate->location.block );
       gstate->data_error = 1;
-      release_ioblock( gstate->ioq );
+      if ( gstate->shared_iob ) { release_shared_ioblock( iob, gstate->ioq ); }
+      else { release_ioblock( gstate->ioq ); }
       return -1;
    }
 
+   // shared ioblocks are written without modification, and then given back to their owner
+   if ( gstate->shared_iob ) {
+      int retval = resume_shared_io( tstate );
+      if ( retval == 0 ) { retval = write_shared_data( tstate, datasrc, datasz ); }
+      if ( release_shared_ioblock( iob, gstate->ioq ) ) {
+         LOG( LOG_ERR, "Block %d failed to release shared ioblock!\n", gstate->location.block );
+         gstate->data_error = 1;
+         return -1;
+      }
+      return retval;
+   }
+
    // sanity check that our data size makes sense
    if ( datasz > ( gstate->minfo.versz - CRC_BYTES ) ) {
       LOG( LOG_ERR, "Block %d received unexpectedly large data size: %zd\n", gstate->location.block, datasz );
@@ -286,6 +509,7 @@ int write_consume( void** state, void** work_todo ) {
       return -1;
    }
 
+   DAL_REQ req = NULL;
    if ( datasz > 0 ) {
       // calculate a CRC for this data and append it to the buffer
       *(uint32_t*)( datasrc + datasz ) = crc32_ieee(CRC_SEED, datasrc, datasz);
@@ -294,29 +518,42 @@ int write_consume( void** state, void** work_todo ) {
       // increment our block size
       gstate->minfo.blocksz += datasz;
 
-      // write data out via the DAL, but only if we have not yet encoutered a write error
-      if ( (gstate->data_error == 0)  &&  gstate->dal->put( tstate->handle, datasrc, datasz ) ) {
-         LOG( LOG_ERR, "Failed to write %zu bytes to block %d!\n", datasz, gstate->location.block );
-         gstate->data_error = 1;
-         // don't bother to abort yet, we'll do that on close
+      // begin writing data out via the DAL, but only if we have not yet encoutered a write error
+      if ( gstate->data_error == 0 ) {
+         req = dal_submit_put( gstate->dal, tstate->handle, datasrc, datasz );
+         if ( req == NULL ) {
+            LOG( LOG_ERR, "Failed to write %zu bytes to block %d!\n", datasz, gstate->location.block );
+            gstate->data_error = 1;
+            // don't bother to abort yet, we'll do that on close
+         }
       }
    }
 
-   // regardless of success, we need to free up our ioblock
-   if ( release_ioblock( gstate->ioq ) ) {
-      LOG( LOG_ERR, "Block %d failed to release ioblock!\n", gstate->location.block );
-      gstate->data_error = 1;
-      return -1;
+   // ioblocks are released in order, so the put of our previous ioblock must complete first
+   int retval = complete_pending_put( tstate );
+
+   // this ioblock is only released once its put completes, which may overlap with the put of the next
+   ssize_t result = 0;
+   if ( req  &&  dal_poll( gstate->dal, tstate->handle, req, &result ) == 0 ) {
+      // our producer must retain two ioblocks of its own ( the one it fills, and the next to take its overflow ), 
+      //  so we can only hold onto this one if the ioqueue has been given an extra
+      if ( ioqueue_blockcnt( gstate->ioq ) > SUPER_BLOCK_CNT ) {
+         tstate->pending = req;
+         return retval;
+      }
+      result = dal_wait( gstate->dal, tstate->handle, req );
    }
+   if ( release_put_ioblock( tstate, result ) ) { return -1; }
 
-   return 0;
+   return retval;
 }
 
 
 /**
  * Read data from our target, verify its CRC, and continue until we have a full buffer to push
  * @param void** state : Thread state reference
- * @param void** work_tofill : Reference to be populated with the produced buffer
+ * @param void** work_tofill : Reference to be populated with the produced buffer 
+ *                             ( left NULL, if the producer must yield on a nonblocking ioqueue )
  * @return int : Integer return code ( -1 on error, 0 on success, and 2 once all buffers have been read )
  */
 int read_produce( void** state, void** work_tofill ) {
@@ -354,6 +591,12 @@ int read_produce( void** state, void** work_tofill ) {
       resres = reserve_ioblock( &(tstate->iob), &push_block, gstate->ioq );
       // check for an error condition
       if ( resres == -1 ) {
+         if ( errno == EAGAIN ) {
+            // a nonblocking ioqueue has no free ioblock, so yield until our consumer releases one
+            LOG( LOG_INFO, "No ioblock available for block %d, yielding\n", gstate->location.block );
+            *work_tofill = NULL;
+            return 0;
+         }
          LOG( LOG_ERR, "Failed to reserve an ioblock!\n" );
          return -1;
       }
@@ -373,32 +616,70 @@ int read_produce( void** state, void** work_tofill ) {
          tstate->iob = NULL;
          break;
       }
+      // don't get any further ahead of our consumer than our readahead allows
+      if ( ioqueue_wait_readahead( gstate->ioq ) ) {
+         if ( errno == EAGAIN ) {
+            // our partially filled ioblock is retained, and we'll pick up here on the next call
+            LOG( LOG_INFO, "Block %d is at its readahead limit, yielding\n", gstate->location.block );
+            *work_tofill = NULL;
+            return 0;
+         }
+         LOG( LOG_ERR, "Failed to wait for readahead allowance!\n" );
+         return -1;
+      }
+      // gather every IO which this ioblock can accept into a single read, with CRCs split out of the data
+      size_t fill = ioblock_get_fill( tstate->iob );
       void* store_tgt = ioblock_write_target( tstate->iob );
-      char data_err = 0;
-      LOG( LOG_INFO, "Reading %zd bytes from offset %zu of block %d\n", to_read, tstate->offset, gstate->location.block );
-      if ( (read_data = gstate->dal->get( tstate->handle, store_tgt, to_read, tstate->offset )) <
+      struct iovec iov[ 2 * IOV_IO_MAX ];
+      uint32_t crcs[ IOV_IO_MAX ];
+      size_t iosz[ IOV_IO_MAX ];
+      int iocnt = 0;
+      to_read = 0;
+      while ( iocnt < IOV_IO_MAX  &&  tstate->offset + to_read < gstate->minfo.blocksz  &&
+              ( iocnt == 0  ||  fill < gstate->ioq->split_threshold ) ) {
+         iosz[iocnt] = ( gstate->minfo.versz > (gstate->minfo.blocksz - (tstate->offset + to_read)) ) ? 
+                         (gstate->minfo.blocksz - (tstate->offset + to_read)) : gstate->minfo.versz;
+         iov[2*iocnt].iov_base = store_tgt;
+         iov[2*iocnt].iov_len = iosz[iocnt] - CRC_BYTES;
+         iov[2*iocnt + 1].iov_base = &(crcs[iocnt]);
+         iov[2*iocnt + 1].iov_len = CRC_BYTES;
+         store_tgt += iosz[iocnt] - CRC_BYTES;
+         fill += iosz[iocnt] - CRC_BYTES;
+         to_read += iosz[iocnt];
+         iocnt++;
+      }
+      LOG( LOG_INFO, "Reading %d IOs (%zd bytes) from offset %zu of block %d\n", iocnt, to_read, tstate->offset, gstate->location.block );
+      if ( (read_data = dal_getv( gstate->dal, tstate->handle, iov, 2 * iocnt, tstate->offset )) <
             to_read ) {
          LOG( LOG_ERR, "Expected read return value of %zd for block %d, but recieved: %zd\n", 
                to_read, gstate->location.block, read_data );
          gstate->data_error = 1;
-         data_err = 1;
       }
-      to_read -= CRC_BYTES;
-      // check the crc
-      if ( data_err == 0 ) {
-         uint32_t crc = crc32_ieee(CRC_SEED, store_tgt, to_read);
-         uint32_t scrc = *((uint32_t*) (store_tgt + to_read));
-         tstate->crcsumchk += scrc; // track our global crc, for reference
-         if ( crc != scrc ) {
-            LOG( LOG_ERR, "Calculated CRC of data (%u) does not match stored CRC: %u\n", crc, scrc );
-            gstate->data_error = 1;
-            data_err = 1;
+      // check the crc of each IO
+      store_tgt = ioblock_write_target( tstate->iob );
+      int i;
+      for ( i = 0; i < iocnt; i++ ) {
+         size_t datasz = iosz[i] - CRC_BYTES;
+         char data_err = 0;
+         if ( read_data < (ssize_t)iosz[i] ) {
+            data_err = 1; // this IO was not (entirely) retrieved
+         }
+         else {
+            uint32_t crc = crc32_ieee(CRC_SEED, store_tgt, datasz);
+            tstate->crcsumchk += crcs[i]; // track our global crc, for reference
+            if ( crc != crcs[i] ) {
+               LOG( LOG_ERR, "Calculated CRC of data (%u) does not match stored CRC: %u\n", crc, crcs[i] );
+               gstate->data_error = 1;
+               data_err = 1;
+            }
          }
+         read_data -= iosz[i];
+         // note how much REAL data (no CRC) we've stored to the ioblock
+         ioblock_update_fill( tstate->iob, datasz, data_err );
+         store_tgt += datasz;
+         // note our increased offset within the data (MUST include the CRC!)
+         tstate->offset += iosz[i];
       }
-      // note how much REAL data (no CRC) we've stored to the ioblock
-      ioblock_update_fill( tstate->iob, to_read, data_err );
-      // note our increased offset within the data (MUST include the CRC!)
-      tstate->offset += (to_read + CRC_BYTES);
    }
 
    // populate our workpackage with the filled ioblock
@@ -546,13 +827,21 @@ void write_term( void** state, void** prev_work ) {
    // get a reference to the global state for this block
    gthread_state* gstate = (gthread_state*) (tstate->gstate);
 
+   // complete any put still in flight
+   complete_pending_put( tstate );
+
    // if we never used an IOBlock reference, we need to release it
-   if ( *(prev_work) != NULL  &&  release_ioblock( gstate->ioq ) ) {
+   if ( *(prev_work) != NULL  &&  
+        ( (gstate->shared_iob) ? release_shared_ioblock( (ioblock*)(*prev_work), gstate->ioq ) : release_ioblock( gstate->ioq ) ) ) {
       LOG( LOG_ERR, "Failed to release previous IOBlock!\n" );
       gstate->data_error = 1;
       // not much to do besides complain
    }
 
+   // complete any partial IO of shared ioblocks ( positioning a resumed block first, if we never consumed any )
+   resume_shared_io( tstate );
+   finish_shared_io( tstate );
+
    // attempt to write out meta info
    if ( dal_set_minfo( gstate->dal, tstate->handle, &(gstate->minfo) ) ) {
       LOG( LOG_ERR, "Failed to set meta value for block %d!\n", gstate->location.block );
@@ -84,6 +84,11 @@ These fields, in order, are:
     ncompsz   is the size of the part but might get used if we ever compress the parts
     totsz     is the total real data in the N part files.
 
+As of MINFO_VER 2, these values are instead stored as a fixed-size, 
+little-endian binary record, ending in a CRC of all preceding bytes ( see 
+the MINFO_BIN_* offsets below ).  Version 1 strings, and the untagged strings 
+which preceded them, can still be read.
+
 Since creating erasure requires full stripe writes, the last part of the
 file may all be zeros in the parts.  Thus, totsz is the real size of the
 data, not counting the trailing zeros.
@@ -128,16 +133,97 @@ underlying skt_etc() functions.
 #include <pthread.h>
 
 
+#ifdef HAVE_LIBISAL
+extern uint32_t crc32_ieee(uint32_t seed, uint8_t * buf, uint64_t len);
+#else
+extern uint32_t crc32_ieee_base(uint32_t seed, uint8_t * buf, uint64_t len);
+#endif
+
+
+// Layout of a binary ( MINFO_VER 2 ) meta_info record
+// NOTE -- later versions may only append fields ( ahead of the CRC ), growing the record size accordingly
+#define MINFO_BIN_MAGIC   "NEMI"
+#define MINFO_BIN_VER      4 // u16 : record version
+#define MINFO_BIN_SIZE     6 // u16 : total record size, including the trailing CRC
+#define MINFO_BIN_N        8 // u32
+#define MINFO_BIN_E       12 // u32
+#define MINFO_BIN_O       16 // u32
+#define MINFO_BIN_CSUMTYPE 20 // u8  : type of the checksums within the block data ( 1 == CRC32 )
+#define MINFO_BIN_CODEC   21 // u8  : codec applied to the block data ( 0 == none )
+#define MINFO_BIN_FLAGS   22 // u16 : reserved
+#define MINFO_BIN_PARTSZ  24 // s64
+#define MINFO_BIN_VERSZ   32 // s64
+#define MINFO_BIN_BLOCKSZ 40 // s64
+#define MINFO_BIN_CRCSUM  48 // s64
+#define MINFO_BIN_TOTSZ   56 // s64
+#define MINFO_BIN_COMPSZ  64 // s64 : size of the block data once compressed ( zero if uncompressed )
+#define MINFO_BIN_LEN     96 // size of a version 2 record ( bytes 72 through 91 are reserved )
+#define MINFO_BIN_MAX    512 // largest record accepted from any later version
+
+
 
 /* ------------------------------   INTERNAL HELPER FUNCTIONS   ------------------------------ */
 
 
+// Internal helper functions
+// Store / load little-endian values of the given width, regardless of host byte order
+static void put_le( unsigned char* buf, uint64_t val, int bytes ) {
+   int i;
+   for ( i = 0; i < bytes; i++ ) { buf[i] = (unsigned char)( val >> ( 8 * i ) ); }
+}
+static uint64_t get_le( const unsigned char* buf, int bytes ) {
+   uint64_t val = 0;
+   int i;
+   for ( i = bytes - 1; i >= 0; i-- ) { val = ( val << 8 ) | buf[i]; }
+   return val;
+}
+
+
 // Internal helper function
 // Estimate the space required for a meta_info string representation
 size_t get_minfo_strlen( ) {
    // Note: Binary 3bits == max value of 7, so decimal representation requires at most 1byte per 3bits of the struct 
    //       plus an additional 13bytes for version tag, whitespace, and the terminating null character.
-   return ( ( sizeof( struct meta_info_struct ) * 8 ) / 3 ) + 13;
+   size_t textlen = ( ( sizeof( struct meta_info_struct ) * 8 ) / 3 ) + 13;
+   // also leave room for a binary record of any later version ( plus a byte, to detect an oversized one )
+   return ( textlen > MINFO_BIN_MAX ) ? textlen : MINFO_BIN_MAX + 1;
+}
+
+
+// Internal helper function
+// Decode a binary meta_info record
+// Returns zero on success, or -1 if the record is corrupt or unrecognized
+static int parse_minfo_bin( const unsigned char* buf, ssize_t len, meta_info* minfo ) {
+   if ( len < MINFO_BIN_LEN ) {
+      LOG( LOG_ERR, "binary meta info is truncated ( %zd bytes )\n", len );
+      return -1;
+   }
+   uint16_t ver = (uint16_t) get_le( buf + MINFO_BIN_VER, 2 );
+   uint16_t size = (uint16_t) get_le( buf + MINFO_BIN_SIZE, 2 );
+   if ( ver < 2  ||  size < MINFO_BIN_LEN  ||  size > len ) {
+      LOG( LOG_ERR, "invalid binary meta info header ( version %u, size %u, %zd bytes )\n", ver, size, len );
+      return -1;
+   }
+   uint32_t crc = (uint32_t) get_le( buf + size - CRC_BYTES, CRC_BYTES );
+   if ( crc32_ieee( CRC_SEED, (uint8_t*) buf, size - CRC_BYTES ) != crc ) {
+      LOG( LOG_ERR, "binary meta info fails its CRC check\n" );
+      return -1;
+   }
+   if ( buf[MINFO_BIN_CSUMTYPE] != 1  ||  buf[MINFO_BIN_CODEC] != 0 ) {
+      LOG( LOG_ERR, "unsupported block encoding ( checksum type %u, codec %u )\n", buf[MINFO_BIN_CSUMTYPE], buf[MINFO_BIN_CODEC] );
+      return -1;
+   }
+   minfo->N       = (int) (int32_t) get_le( buf + MINFO_BIN_N, 4 );
+   minfo->E       = (int) (int32_t) get_le( buf + MINFO_BIN_E, 4 );
+   minfo->O       = (int) (int32_t) get_le( buf + MINFO_BIN_O, 4 );
+   minfo->partsz  = (ssize_t) (int64_t) get_le( buf + MINFO_BIN_PARTSZ, 8 );
+   minfo->versz   = (ssize_t) (int64_t) get_le( buf + MINFO_BIN_VERSZ, 8 );
+   minfo->blocksz = (ssize_t) (int64_t) get_le( buf + MINFO_BIN_BLOCKSZ, 8 );
+   minfo->crcsum  = (long long) (int64_t) get_le( buf + MINFO_BIN_CRCSUM, 8 );
+   minfo->totsz   = (ssize_t) (int64_t) get_le( buf + MINFO_BIN_TOTSZ, 8 );
+   LOG( LOG_INFO, "Got binary values (ver=%u,N=%d,E=%d,O=%d,partsz=%zd,versz=%zd,blocksz=%zd,totsz=%zd)\n",
+                  ver, minfo->N, minfo->E, minfo->O, minfo->partsz, minfo->versz, minfo->blocksz, minfo->totsz );
+   return 0;
 }
 
 
@@ -146,7 +232,7 @@ size_t get_minfo_strlen( ) {
 
 
 /**
- * Perform a DAL get_meta call and parse the resulting string 
+ * Perform a DAL get_meta call and parse the resulting binary record or string 
  * into the provided meta_info_struct reference.
  * @param DAL dal : Dal on which to perfrom the get_meta operation
  * @param int block : Block on which this operation is being performed (for logging only)
@@ -179,6 +265,12 @@ int dal_get_minfo( DAL dal, BLOCK_CTXT handle, meta_info* minfo ) {
       free( str );
       return -1;
    }
+   // binary records are self-verifying, and so are either entirely valid or not at all
+   if ( dstrbytes >= 4  &&  memcmp( str, MINFO_BIN_MAGIC, 4 ) == 0 ) {
+      int binret = parse_minfo_bin( (unsigned char*) str, dstrbytes, minfo );
+      free( str );
+      return binret;
+   }
    // make sure we have a trailing newline
    char valid_suffix = 0;
    if ( dstrbytes >= 2  &&  str[dstrbytes-2] == '\n' ) { valid_suffix = 1; }
@@ -205,7 +297,7 @@ int dal_get_minfo( DAL dal, BLOCK_CTXT handle, meta_info* minfo ) {
    char* parse = str;
    if ( *parse == 'v' ) {
       // now that we know this is tagged, assume it's our current structure until proven otherwise
-      vertag = MINFO_VER;
+      vertag = MINFO_TEXT_VER;
       // read in the version tag value, if possible
       if ( sscanf( parse, "v%d ", &vertag ) ) {
          LOG( LOG_INFO, "Got minfo version tag = %d\n", vertag );
@@ -242,6 +334,8 @@ int dal_get_minfo( DAL dal, BLOCK_CTXT handle, meta_info* minfo ) {
                            metacrcsum,
                            metatotsize);
       strncpy( metaversz, metapartsz, 20 );
+      // account for the versz value, implied by partsz, so that later values are still parsed below
+      if ( ret >= 4 ) { ret++; }
    }
 
    if ( ret < 1 ) {
@@ -282,50 +376,147 @@ int dal_get_minfo( DAL dal, BLOCK_CTXT handle, meta_info* minfo ) {
    LOG( LOG_INFO, "Got values (N=%d,E=%d,O=%d,partsz=%zd,versz=%zd,blocksz=%zd,totsz=%zd)\n",
                   minfo->N, minfo->E, minfo->O, minfo->partsz, minfo->versz, minfo->blocksz, minfo->totsz );
 
+   if ( status <= 0 ) {
+      // nothing usable ( such as a binary record with a damaged magic value ) must never pass for valid meta info
+      LOG( LOG_ERR, "failed to parse any valid values from meta info!\n" );
+      return -1;
+   }
    return ( valid_suffix  &&  status == 8 ) ? 0 : status;
 }
 
 
 /**
- * Convert a meta_info struct to string format and perform a DAL set_meta call
+ * Convert a meta_info struct to its binary ( MINFO_VER ) format and perform a DAL set_meta call
  * @param DAL dal : Dal on which to perfrom the get_meta operation
  * @param BLOCK_CTXT handle : Block on which this operation is being performed
  * @param meta_info* minfo : meta_info reference to populate with values 
  * @return int : Zero on success, or a negative value if an error occurred 
  */
 int dal_set_minfo( DAL dal, BLOCK_CTXT handle, meta_info* minfo ) {
-   // Allocate space for a string
-   size_t strmax = get_minfo_strlen();
-   char* str = (char*) malloc( strmax );
-   if ( str == NULL ) {
-      LOG( LOG_ERR, "failed to allocate space for a meta_info string!\n" );
-      return -1;
-   }
+   unsigned char buf[MINFO_BIN_LEN];
+   memset( buf, 0, MINFO_BIN_LEN );
 
    LOG( LOG_INFO, "partsz %zd\n", minfo->partsz );
    LOG( LOG_INFO, "versz %zd\n", minfo->versz );
    LOG( LOG_INFO, "blocksz %zd\n", minfo->blocksz );
-   LOG( LOG_INFO, "crcsum %zd\n", minfo->crcsum );
+   LOG( LOG_INFO, "crcsum %lld\n", minfo->crcsum );
+
+   // fill the record with meta_info values
+   memcpy( buf, MINFO_BIN_MAGIC, 4 );
+   put_le( buf + MINFO_BIN_VER, MINFO_VER, 2 );
+   put_le( buf + MINFO_BIN_SIZE, MINFO_BIN_LEN, 2 );
+   put_le( buf + MINFO_BIN_N, (uint32_t) minfo->N, 4 );
+   put_le( buf + MINFO_BIN_E, (uint32_t) minfo->E, 4 );
+   put_le( buf + MINFO_BIN_O, (uint32_t) minfo->O, 4 );
+   buf[MINFO_BIN_CSUMTYPE] = 1; // CRC32 of every versz chunk
+   buf[MINFO_BIN_CODEC] = 0;
+   put_le( buf + MINFO_BIN_PARTSZ, (uint64_t) minfo->partsz, 8 );
+   put_le( buf + MINFO_BIN_VERSZ, (uint64_t) minfo->versz, 8 );
+   put_le( buf + MINFO_BIN_BLOCKSZ, (uint64_t) minfo->blocksz, 8 );
+   put_le( buf + MINFO_BIN_CRCSUM, (uint64_t) minfo->crcsum, 8 );
+   put_le( buf + MINFO_BIN_TOTSZ, (uint64_t) minfo->totsz, 8 );
+   put_le( buf + MINFO_BIN_COMPSZ, 0, 8 );
+   put_le( buf + MINFO_BIN_LEN - CRC_BYTES, crc32_ieee( CRC_SEED, buf, MINFO_BIN_LEN - CRC_BYTES ), CRC_BYTES );
+
+   if ( dal->set_meta( handle, (char*) buf, MINFO_BIN_LEN ) ) {
+      LOG( LOG_ERR, "failed to set meta value!\n" );
+      return -1;
+   }
+
+   return 0;
+}
+
 
-	// fill the string allocation with meta_info values
-   if ( snprintf(str,strmax, "v%d %d %d %d %zd %zd %zd %llu %zd\n",
-                  MINFO_VER, minfo->N, minfo->E, minfo->O,
+/**
+ * Convert a rebuild_ckpt struct to string format and perform a DAL checkpoint call
+ * @param DAL dal : Dal on which to perfrom the checkpoint operation
+ * @param BLOCK_CTXT handle : REBUILD/RESUME block on which this operation is being performed
+ * @param rebuild_ckpt* ckpt : rebuild_ckpt reference to be stored
+ * @return int : Zero on success, or a negative value if an error occurred 
+ */
+int dal_set_ckpt( DAL dal, BLOCK_CTXT handle, rebuild_ckpt* ckpt ) {
+   if ( dal->checkpoint == NULL ) {
+      LOG( LOG_ERR, "DAL does not support checkpoints!\n" );
+      errno = ENOTSUP;
+      return -1;
+   }
+   // Allocate space for a string ( same estimate as for meta_info, but accounting for our extra values )
+   size_t strmax = ( ( sizeof( struct rebuild_ckpt_struct ) * 8 ) / 3 ) + 13;
+   char* str = (char*) malloc( strmax );
+   if ( str == NULL ) {
+      LOG( LOG_ERR, "failed to allocate space for a rebuild_ckpt string!\n" );
+      return -1;
+   }
+
+   meta_info* minfo = &(ckpt->minfo);
+   if ( snprintf(str,strmax, "c%d %d %d %d %zd %zd %zd %lld %zd %zd %lld %lld\n",
+                  CKPT_VER, minfo->N, minfo->E, minfo->O,
                   minfo->partsz, minfo->versz,
                   minfo->blocksz, minfo->crcsum,
-                  minfo->totsz) < 0 ) {
-      LOG( LOG_ERR, "failed to convert meta_info to string format!\n" );
+                  minfo->totsz, ckpt->prevsz, ckpt->prevcrc, ckpt->objsum) < 0 ) {
+      LOG( LOG_ERR, "failed to convert rebuild_ckpt to string format!\n" );
       free( str );
       return -1;
    }
 
-	if ( dal->set_meta( handle, str, strlen( str ) + 1 ) ) {
-		LOG( LOG_ERR, "failed to set meta value!\n" );
-		free( str );
-		return -1;
-	}
+   if ( dal->checkpoint( handle, str, strlen( str ) + 1 ) ) {
+      LOG( LOG_ERR, "failed to store checkpoint!\n" );
+      free( str );
+      return -1;
+   }
+
+   free( str );
+   return 0;
+}
+
+
+/**
+ * Perform a DAL get_meta call on a RESUME block and parse the resulting 
+ * string into the provided rebuild_ckpt reference.
+ * @param DAL dal : Dal on which to perfrom the get_meta operation
+ * @param BLOCK_CTXT handle : RESUME block on which this operation is being performed
+ * @param rebuild_ckpt* ckpt : rebuild_ckpt reference to populate with values
+ * @return int : Zero on success, or a negative value if no complete checkpoint could be retrieved
+ */
+int dal_get_ckpt( DAL dal, BLOCK_CTXT handle, rebuild_ckpt* ckpt ) {
+   // Allocate space for a string
+   size_t strmax = ( ( sizeof( struct rebuild_ckpt_struct ) * 8 ) / 3 ) + 13;
+   char* str = (char*) malloc( strmax );
+   if ( str == NULL ) {
+      LOG( LOG_ERR, "failed to allocate space for a rebuild_ckpt string!\n" );
+      return -1;
+   }
+   // get the checkpoint of the interrupted rebuild, if any
+   ssize_t dstrbytes;
+   if ( (dstrbytes = dal->get_meta( handle, str, strmax )) <= 0 ) {
+      LOG( LOG_INFO, "no checkpoint found\n" );
+      free( str );
+      return -1;
+   }
+   // a torn or final meta string is no use to us
+   if ( dstrbytes < 2  ||  str[dstrbytes-2] != '\n'  ||  *str != 'c' ) {
+      LOG( LOG_WARNING, "ignoring unrecognized checkpoint string\n" );
+      free( str );
+      return -1;
+   }
+   str[dstrbytes-1] = '\0';
 
+   int vertag = 0;
+   meta_info* minfo = &(ckpt->minfo);
+   int ret = sscanf( str, "c%d %d %d %d %zd %zd %zd %lld %zd %zd %lld %lld",
+                     &vertag, &(minfo->N), &(minfo->E), &(minfo->O),
+                     &(minfo->partsz), &(minfo->versz),
+                     &(minfo->blocksz), &(minfo->crcsum),
+                     &(minfo->totsz), &(ckpt->prevsz), &(ckpt->prevcrc), &(ckpt->objsum) );
    free( str );
-	return 0;
+   if ( ret != 12  ||  vertag != CKPT_VER ) {
+      LOG( LOG_WARNING, "failed to parse checkpoint string ( version %d, %d values )\n", vertag, ret );
+      return -1;
+   }
+
+   LOG( LOG_INFO, "Got checkpoint (N=%d,E=%d,O=%d,partsz=%zd,versz=%zd,blocksz=%zd,totsz=%zd,prevsz=%zd)\n",
+                  minfo->N, minfo->E, minfo->O, minfo->partsz, minfo->versz, minfo->blocksz, minfo->totsz, ckpt->prevsz );
+   return 0;
 }
 
 
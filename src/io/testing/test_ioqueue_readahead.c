@@ -0,0 +1,295 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#include "io/io.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+
+#define TEST_IOSZ ( 4096 + CRC_BYTES )
+#define TEST_PARTSZ 1024
+#define MAX_CYCLES 20 // limit on ioblocks produced while waiting for the queue to be resized
+
+
+// producer state of the ioqueue, mirroring the reader threads of iothreads.c
+typedef struct producer_struct {
+   ioqueue* ioq;
+   ioblock* cur;   // ioblock currently being filled
+   int pushed;     // number of filled ioblocks not yet released by the 'consumer'
+   int wakes;      // number of times the wake function has been called
+} producer;
+
+void wake_producer( void* arg ) {
+   producer* prod = (producer*)arg;
+   prod->wakes++;
+}
+
+// fill the current ioblock, and reserve the next, returning -1 ( errno == EAGAIN ) if the producer must yield
+int produce( producer* prod ) {
+   if ( prod->cur  &&  ioblock_get_fill( prod->cur ) < prod->ioq->split_threshold ) {
+      // like the reader threads, only fill an ioblock if the readahead allows it
+      if ( ioqueue_wait_readahead( prod->ioq ) ) { return -1; }
+      ioblock_update_fill( prod->cur, prod->ioq->split_threshold - ioblock_get_fill( prod->cur ), 0 );
+   }
+   ioblock* push = NULL;
+   int ret = reserve_ioblock( &(prod->cur), &push, prod->ioq );
+   if ( ret > 0 ) { prod->pushed++; }
+   return ( ret < 0 ) ? -1 : 0;
+}
+
+// consume a single filled ioblock
+int consume( producer* prod ) {
+   if ( prod->pushed == 0 ) {
+      printf( "ERROR: No filled ioblock to be consumed!\n" );
+      return -1;
+   }
+   if ( release_ioblock( prod->ioq ) ) {
+      printf( "ERROR: Failed to release a filled ioblock!\n" );
+      return -1;
+   }
+   prod->pushed--;
+   return 0;
+}
+
+// produce until the producer must yield, returning the number of filled ioblocks waiting on the consumer
+int produce_all( producer* prod ) {
+   int i;
+   for ( i = 0; i < MAX_CYCLES; i++ ) {
+      if ( produce( prod ) ) {
+         if ( errno != EAGAIN ) {
+            printf( "ERROR: Failed to produce an ioblock!\n" );
+            return -1;
+         }
+         return prod->pushed;
+      }
+   }
+   printf( "ERROR: Producer was never limited by the readahead!\n" );
+   return -1;
+}
+
+// consume all filled ioblocks
+int consume_all( producer* prod ) {
+   while ( prod->pushed ) {
+      if ( consume( prod ) ) { return -1; }
+   }
+   return 0;
+}
+
+// cycle ioblocks through the queue, consuming each as it is filled, until it holds the given number of ioblocks
+int cycle_to_blockcnt( producer* prod, int blockcnt ) {
+   int i;
+   for ( i = 0; i < MAX_CYCLES  &&  ioqueue_blockcnt( prod->ioq ) != blockcnt; i++ ) {
+      if ( produce( prod ) ) {
+         printf( "ERROR: Producer yielded while cycling ioblocks!\n" );
+         return -1;
+      }
+      if ( prod->pushed  &&  consume( prod ) ) { return -1; }
+   }
+   if ( ioqueue_blockcnt( prod->ioq ) != blockcnt ) {
+      printf( "ERROR: Ioqueue holds %d ioblocks, rather than %d!\n", ioqueue_blockcnt( prod->ioq ), blockcnt );
+      return -1;
+   }
+   return 0;
+}
+
+
+// a blocking producer waits on the consumer, rather than yielding
+typedef struct waiter_struct {
+   ioqueue* ioq;
+   int result;
+   char done;
+} waiter;
+
+void* wait_readahead_thread( void* arg ) {
+   waiter* wt = (waiter*)arg;
+   wt->result = ioqueue_wait_readahead( wt->ioq );
+   __atomic_store_n( &(wt->done), 1, __ATOMIC_SEQ_CST );
+   return NULL;
+}
+
+int test_blocking( producer* prod ) {
+   printf( "Testing a blocking wait for readahead allowance...\n" );
+   if ( ioqueue_set_nonblocking( prod->ioq, 0, NULL, NULL ) ) {
+      printf( "ERROR: Failed to make ioqueue blocking!\n" );
+      return -1;
+   }
+   // with one ioblock filled ahead of the consumer, a readahead of zero prevents filling another
+   if ( ioqueue_set_readahead( prod->ioq, 0 )  ||  produce( prod )  ||  prod->pushed != 1 ) {
+      printf( "ERROR: Failed to fill an ioblock ahead of the consumer!\n" );
+      return -1;
+   }
+   waiter wt = { .ioq = prod->ioq, .result = -1, .done = 0 };
+   pthread_t thread;
+   if ( pthread_create( &thread, NULL, wait_readahead_thread, &wt ) ) {
+      printf( "ERROR: Failed to create waiting thread!\n" );
+      return -1;
+   }
+   usleep( 50000 );
+   int ret = 0;
+   if ( __atomic_load_n( &(wt.done), __ATOMIC_SEQ_CST ) ) {
+      printf( "ERROR: Producer did not wait on a readahead of zero!\n" );
+      ret = -1;
+   }
+   if ( consume( prod ) ) { ret = -1; }
+   pthread_join( thread, NULL );
+   if ( wt.result ) {
+      printf( "ERROR: Blocking wait for readahead allowance failed!\n" );
+      ret = -1;
+   }
+   return ret;
+}
+
+
+int main( int argc, char** argv ) {
+   ioqueue* ioq = create_ioqueue( TEST_IOSZ, TEST_PARTSZ, DAL_READ );
+   if ( ioq == NULL ) {
+      printf( "ERROR: Failed to create an ioqueue!\n" );
+      return -1;
+   }
+   producer prod = { .ioq = ioq, .cur = NULL, .pushed = 0, .wakes = 0 };
+   if ( ioqueue_set_nonblocking( ioq, 1, wake_producer, &prod ) ) {
+      printf( "ERROR: Failed to make ioqueue nonblocking!\n" );
+      return -1;
+   }
+
+   // the default readahead keeps a single ioblock filled ahead of the consumer
+   printf( "Testing the default readahead...\n" );
+   if ( ioqueue_blockcnt( ioq ) != SUPER_BLOCK_CNT ) {
+      printf( "ERROR: New ioqueue holds %d ioblocks, rather than %d!\n", ioqueue_blockcnt( ioq ), SUPER_BLOCK_CNT );
+      return -1;
+   }
+   int pushed = produce_all( &prod );
+   if ( pushed != SUPER_BLOCK_CNT - 1 ) {
+      printf( "ERROR: Producer filled %d ioblocks ahead with the default readahead, rather than %d!\n", 
+              pushed, SUPER_BLOCK_CNT - 1 );
+      return -1;
+   }
+   if ( consume( &prod )  ||  prod.wakes != 1 ) {
+      printf( "ERROR: Release of an ioblock did not wake the yielded producer ( %d wakes )!\n", prod.wakes );
+      return -1;
+   }
+
+   // invalid readahead values are rejected
+   if ( ioqueue_set_readahead( ioq, -1 ) == 0  ||  ioqueue_set_readahead( ioq, SUPER_BLOCK_MAX ) == 0 ) {
+      printf( "ERROR: Invalid readahead values were accepted!\n" );
+      return -1;
+   }
+
+   // a readahead of zero only fills an ioblock once the consumer has released all others
+   printf( "Testing a readahead of zero...\n" );
+   if ( ioqueue_set_readahead( ioq, 0 ) ) {
+      printf( "ERROR: Failed to set a readahead of zero!\n" );
+      return -1;
+   }
+   if ( consume_all( &prod ) ) { return -1; }
+   pushed = produce_all( &prod );
+   if ( pushed != 1  ||  ioqueue_wait_readahead( ioq ) == 0  ||  errno != EAGAIN ) {
+      printf( "ERROR: Producer was not held to a readahead of zero ( %d ioblocks filled ahead )!\n", pushed );
+      return -1;
+   }
+   // raising the readahead must wake the yielded producer, and allow it to proceed
+   int wakes = prod.wakes;
+   if ( ioqueue_set_readahead( ioq, 1 )  ||  prod.wakes != wakes + 1  ||  ioqueue_wait_readahead( ioq ) ) {
+      printf( "ERROR: Raising the readahead did not release the yielded producer!\n" );
+      return -1;
+   }
+   if ( ioqueue_set_readahead( ioq, 0 ) ) { return -1; }
+   if ( consume_all( &prod ) ) { return -1; }
+
+   // deep readahead grows the queue as the head wraps, then allows that many ioblocks to be filled ahead
+   printf( "Testing the maximum readahead...\n" );
+   if ( ioqueue_set_readahead( ioq, SUPER_BLOCK_MAX - 1 )  ||  cycle_to_blockcnt( &prod, SUPER_BLOCK_MAX ) ) {
+      printf( "ERROR: Ioqueue did not grow for the maximum readahead!\n" );
+      return -1;
+   }
+   if ( consume_all( &prod ) ) { return -1; }
+   pushed = produce_all( &prod );
+   if ( pushed != SUPER_BLOCK_MAX - 1 ) {
+      printf( "ERROR: Producer filled %d ioblocks ahead with the maximum readahead, rather than %d!\n", 
+              pushed, SUPER_BLOCK_MAX - 1 );
+      return -1;
+   }
+
+   // restoring the default readahead shrinks the queue back down, once the ioblocks beyond it are free
+   printf( "Testing a return to the default readahead...\n" );
+   if ( ioqueue_set_readahead( ioq, SUPER_BLOCK_CNT - 1 )  ||  consume_all( &prod )  ||
+        cycle_to_blockcnt( &prod, SUPER_BLOCK_CNT ) ) {
+      printf( "ERROR: Ioqueue did not shrink for the default readahead!\n" );
+      return -1;
+   }
+   if ( consume_all( &prod ) ) { return -1; }
+   pushed = produce_all( &prod );
+   if ( pushed != SUPER_BLOCK_CNT - 1 ) {
+      printf( "ERROR: Producer filled %d ioblocks ahead after a return to the default readahead, rather than %d!\n", 
+              pushed, SUPER_BLOCK_CNT - 1 );
+      return -1;
+   }
+   if ( consume_all( &prod )  ||  test_blocking( &prod ) ) { return -1; }
+
+   // release the ioblock still being filled, and clean up
+   if ( release_ioblock( ioq )  ||  destroy_ioqueue( ioq ) ) {
+      printf( "ERROR: Failed to destroy the ioqueue!\n" );
+      return -1;
+   }
+   return 0;
+}
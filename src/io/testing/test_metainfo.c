@@ -0,0 +1,307 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#include "io/io.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// the same CRC used by metainfo.c to seal binary records
+extern uint32_t crc32_ieee(uint32_t seed, uint8_t * buf, uint64_t len);
+
+
+#define TEST_OBJ "test_metainfo_obj"
+#define BIN_LEN 96      // size of a version 2 binary record
+#define BIN_SIZE_OFF 6  // offset of the record size field
+#define BIN_VER_OFF 4   // offset of the record version field
+
+char* dal_config = "<DAL type=\"posix\"><dir_template>./test_metainfo.block{b}</dir_template>"
+                   "<sec_root></sec_root></DAL>";
+DAL_location loc = { .pod = 0, .block = 0, .cap = 0, .scatter = 0 };
+
+
+void put_le16( unsigned char* buf, uint16_t val ) {
+   buf[0] = (unsigned char) val;
+   buf[1] = (unsigned char)( val >> 8 );
+}
+
+
+
+void put_le32( unsigned char* buf, uint32_t val ) {
+   int i;
+   for ( i = 0; i < 4; i++ ) { buf[i] = (unsigned char)( val >> ( 8 * i ) ); }
+}
+
+
+
+// store the given raw meta value ( along with a bit of block data ) to our test object
+int store_meta( DAL dal, const char* meta, size_t len ) {
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_WRITE, loc, TEST_OBJ );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open test object for write!\n" );
+      return -1;
+   }
+   char data[64];
+   memset( data, 'D', sizeof( data ) );
+   if ( dal->put( block, data, sizeof( data ) ) ) {
+      printf( "ERROR: Failed to put test object data!\n" );
+      dal->abort( block );
+      return -1;
+   }
+   if ( dal->set_meta( block, meta, len ) ) {
+      printf( "ERROR: Failed to set test object meta!\n" );
+      dal->abort( block );
+      return -1;
+   }
+   if ( dal->close( block ) ) {
+      printf( "ERROR: Failed to close test object after write!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+// store the given meta_info to our test object, in the current format
+int store_minfo( DAL dal, meta_info* minfo ) {
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_WRITE, loc, TEST_OBJ );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open test object for write!\n" );
+      return -1;
+   }
+   if ( dal_set_minfo( dal, block, minfo ) ) {
+      printf( "ERROR: Failed to set test object meta info!\n" );
+      dal->abort( block );
+      return -1;
+   }
+   if ( dal->close( block ) ) {
+      printf( "ERROR: Failed to close test object after write!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+// retrieve the raw meta value of our test object
+ssize_t fetch_meta( DAL dal, char* meta, size_t len ) {
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_METAREAD, loc, TEST_OBJ );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open test object for meta read!\n" );
+      return -1;
+   }
+   ssize_t metalen = dal->get_meta( block, meta, len );
+   dal->close( block );
+   return metalen;
+}
+
+
+
+// retrieve and parse the meta info of our test object, returning the result of dal_get_minfo()
+int fetch_minfo( DAL dal, meta_info* minfo ) {
+   BLOCK_CTXT block = dal->open( dal->ctxt, DAL_METAREAD, loc, TEST_OBJ );
+   if ( block == NULL ) {
+      printf( "ERROR: Failed to open test object for meta read!\n" );
+      return -100;
+   }
+   int ret = dal_get_minfo( dal, block, minfo );
+   dal->close( block );
+   return ret;
+}
+
+
+
+int check_minfo( meta_info* got, meta_info* expected, const char* desc ) {
+   if ( cmp_minfo( got, expected )  ||  got->crcsum != expected->crcsum ) {
+      printf( "ERROR: %s meta info mismatch: got ( N=%d, E=%d, O=%d, partsz=%zd, versz=%zd, blocksz=%zd, crcsum=%lld, totsz=%zd )\n",
+              desc, got->N, got->E, got->O, got->partsz, got->versz, got->blocksz, got->crcsum, got->totsz );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+int test_binary( DAL dal, meta_info* minfo ) {
+   printf( "Testing binary meta info round-trip\n" );
+   if ( store_minfo( dal, minfo ) ) { return -1; }
+   unsigned char raw[BIN_LEN + 64];
+   ssize_t rawlen = fetch_meta( dal, (char*) raw, sizeof( raw ) );
+   if ( rawlen != BIN_LEN  ||  memcmp( raw, "NEMI", 4 ) ) {
+      printf( "ERROR: Stored meta info is not a %d byte binary record ( %zd bytes )!\n", BIN_LEN, rawlen );
+      return -1;
+   }
+   meta_info got;
+   int ret = fetch_minfo( dal, &got );
+   if ( ret ) {
+      printf( "ERROR: Failed to parse binary meta info ( ret = %d )!\n", ret );
+      return -1;
+   }
+   if ( check_minfo( &got, minfo, "binary" ) ) { return -1; }
+
+   // any single corrupted byte must be rejected, rather than producing bad values
+   printf( "Testing binary meta info CRC rejection\n" );
+   int offset;
+   for ( offset = 0; offset < BIN_LEN; offset++ ) {
+      unsigned char bad[BIN_LEN];
+      memcpy( bad, raw, BIN_LEN );
+      bad[offset] ^= 0x10;
+      if ( store_meta( dal, (char*) bad, BIN_LEN ) ) { return -1; }
+      if ( (ret = fetch_minfo( dal, &got )) >= 0 ) {
+         printf( "ERROR: Binary meta info with a corrupt byte at offset %d was accepted ( ret = %d )!\n", offset, ret );
+         return -1;
+      }
+   }
+   // as must a truncated record
+   if ( store_meta( dal, (char*) raw, BIN_LEN - 10 ) ) { return -1; }
+   if ( (ret = fetch_minfo( dal, &got )) >= 0 ) {
+      printf( "ERROR: Truncated binary meta info was accepted ( ret = %d )!\n", ret );
+      return -1;
+   }
+
+   // a record of some later version, with additional fields, must still be readable
+   printf( "Testing extended binary meta info\n" );
+   unsigned char ext[BIN_LEN + 32];
+   memcpy( ext, raw, BIN_LEN - CRC_BYTES );
+   memset( ext + BIN_LEN - CRC_BYTES, 0x5A, 32 );
+   put_le16( ext + BIN_VER_OFF, 3 );
+   put_le16( ext + BIN_SIZE_OFF, sizeof( ext ) );
+   put_le32( ext + sizeof( ext ) - CRC_BYTES, crc32_ieee( CRC_SEED, ext, sizeof( ext ) - CRC_BYTES ) );
+   if ( store_meta( dal, (char*) ext, sizeof( ext ) ) ) { return -1; }
+   if ( (ret = fetch_minfo( dal, &got )) ) {
+      printf( "ERROR: Failed to parse extended binary meta info ( ret = %d )!\n", ret );
+      return -1;
+   }
+   return check_minfo( &got, minfo, "extended binary" );
+}
+
+
+
+int test_text( DAL dal, meta_info* minfo ) {
+   char str[256];
+   meta_info got;
+   int ret;
+
+   // version 1 strings, as written prior to the binary format
+   printf( "Testing version 1 meta info strings\n" );
+   snprintf( str, sizeof( str ), "v1 %d %d %d %zd %zd %zd %llu %zd\n", minfo->N, minfo->E, minfo->O,
+             minfo->partsz, minfo->versz, minfo->blocksz, minfo->crcsum, minfo->totsz );
+   if ( store_meta( dal, str, strlen( str ) + 1 ) ) { return -1; }
+   if ( (ret = fetch_minfo( dal, &got )) ) {
+      printf( "ERROR: Failed to parse version 1 meta info ( ret = %d )!\n", ret );
+      return -1;
+   }
+   if ( check_minfo( &got, minfo, "version 1" ) ) { return -1; }
+
+   // untagged strings, which lack a distinct versz value
+   printf( "Testing untagged meta info strings\n" );
+   snprintf( str, sizeof( str ), "%d %d %d %zd %zd %zd %llu %zd\n", minfo->N, minfo->E, minfo->O,
+             minfo->partsz, minfo->partsz, minfo->blocksz, minfo->crcsum, minfo->totsz );
+   if ( store_meta( dal, str, strlen( str ) + 1 ) ) { return -1; }
+   if ( (ret = fetch_minfo( dal, &got )) ) {
+      printf( "ERROR: Failed to parse untagged meta info ( ret = %d )!\n", ret );
+      return -1;
+   }
+   meta_info untagged = *minfo;
+   untagged.versz = minfo->partsz;
+   if ( check_minfo( &got, &untagged, "untagged" ) ) { return -1; }
+
+   // partial strings report the number of values recovered
+   printf( "Testing partial meta info strings\n" );
+   snprintf( str, sizeof( str ), "v1 %d %d %d %zd\n", minfo->N, minfo->E, minfo->O, minfo->partsz );
+   if ( store_meta( dal, str, strlen( str ) + 1 ) ) { return -1; }
+   if ( (ret = fetch_minfo( dal, &got )) != 4  ||  got.N != minfo->N  ||  got.partsz != minfo->partsz  ||  got.totsz != -1 ) {
+      printf( "ERROR: Unexpected result of parsing partial meta info ( ret = %d, N = %d, partsz = %zd, totsz = %zd )!\n",
+              ret, got.N, got.partsz, got.totsz );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+int main( int argc, char** argv ) {
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return -1;
+   }
+   DAL dal = init_dal( xmlDocGetRootElement( config ), loc );
+   xmlFreeDoc( config );
+   xmlCleanupParser();
+   if ( dal == NULL ) {
+      printf( "ERROR: Failed to initialize DAL!\n" );
+      return -1;
+   }
+
+   // values exceeding 32 bits, to catch any truncation
+   meta_info minfo = { .N = 10, .E = 2, .O = 3, .partsz = 4096, .versz = 1048580, .blocksz = 5368730000,
+                       .crcsum = 3304199718723886772LL, .totsz = 53687091199 };
+   int ret = 0;
+   if ( test_binary( dal, &minfo )  ||  test_text( dal, &minfo ) ) { ret = -1; }
+
+   if ( dal->del( dal->ctxt, loc, TEST_OBJ ) ) {
+      printf( "ERROR: Failed to delete test object!\n" );
+      ret = -1;
+   }
+   dal->cleanup( dal );
+   return ret;
+}
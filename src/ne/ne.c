@@ -121,12 +121,101 @@ underlying skt_etc() functions.
 #include <limits.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <sched.h>
 #include <errno.h>
 #include <assert.h>
 #include <pthread.h>
+#include <time.h>
 
 // Some configurable values
 #define QDEPTH 4
+#define ENCODE_SLICE_MIN 65536 // minimum number of bytes per part handed to a single encoding thread
+#define DECODE_PLAN_CACHE 16    // maximum number of unreferenced decode plans retained by each context
+#define HEDGE_SAMPLES 32        // number of recent ioblock latencies used to compute a handle's median latency
+#define HEDGE_MIN_USEC 1000     // minimum latency ( in microseconds ) before any data block is hedged against
+#define RA_RANDOM_SEEKS 2       // consecutive reseeks, separated by small reads, before a handle is considered random
+#define RA_SEQUENTIAL_GENS 4    // ioblock generations read without a reseek before a handle is considered sequential
+#define PREAD_SPAN 1048576      // maximum bytes of each block fetched at once by a positional read
+#define BATCH_OBJECTS 4         // default number of objects rebuilt at once by ne_rebuild_batch()
+#ifndef REBUILD_CKPT_SPAN
+#define REBUILD_CKPT_SPAN 1073741824 // minimum data written to each rebuilt block between progress checkpoints
+#endif
+#define STAT_THREADS 16         // default number of threads probing block metadata for ne_stat()
+#define SHM_CACHE_MAGIC 0x4e454d43 // identifies a shared metadata cache file ( "NEMC" )
+#define SHM_CACHE_VER 2
+#define SHM_CACHE_BLOCKS 64     // maximum N+E of objects recorded in a shared metadata cache
+#define SHM_CACHE_KEYLEN 256    // maximum objID length ( including the terminator ) recorded in a shared metadata cache
+#define SHM_CACHE_PROBES 4      // number of slots of a shared metadata cache in which each object may reside
+#define SHM_CLAIM_SEC 10        // age at which an update of a shared metadata cache slot is presumed abandoned
+
+// Erasure encoding structures, shared ( read-only ) by all handles of a context with matching N/E values
+typedef struct encode_tables_struct
+{
+   int N;
+   int E;
+   int refcnt;                   // number of handles currently referencing these tables
+   unsigned char *encode_matrix; // (N+E) x N encoding matrix
+   unsigned char *g_tbls;        // expanded tables for generating all E erasure parts
+   struct encode_tables_struct *next;
+} encode_tables;
+
+// Erasure decoding structures for a specific error pattern, shared ( read-only ) by all handles of a context
+typedef struct decode_plan_struct
+{
+   int N;
+   int E;
+   int nerrs;
+   int refcnt;                  // number of handles currently referencing this plan
+   unsigned char *in_err;       // (N+E) error bitmap ( with N/E, this is the lookup key )
+   unsigned char *decode_index; // indicies of the N blocks used as sources for regeneration
+   unsigned char *g_tbls;       // expanded tables for regenerating all nerrs parts
+   struct decode_plan_struct *next;
+} decode_plan;
+
+// Header of a shared metadata cache file, followed by an array of slots
+typedef struct shm_cache_header_struct
+{
+   uint32_t magic;
+   uint32_t version;
+   uint32_t slots;
+   uint32_t slotsz; // size of each slot, guarding against mismatched builds
+} shm_cache_header;
+
+// Single slot of a shared metadata cache file
+// ( writers claim a slot by making its sequence odd, while readers retry or skip it if the sequence changes beneath them )
+typedef struct shm_cache_slot_struct
+{
+   uint64_t seq;        // sequence in the low 32 bits, CLOCK_MONOTONIC second of the latest claim in the high 32 bits
+   int32_t pod;
+   int32_t cap;
+   int32_t scatter;
+   uint64_t hash;       // hash of the objID and location ( zero for an empty slot )
+   int64_t stored_msec; // CLOCK_MONOTONIC time at which the slot was populated
+   int32_t N;
+   int32_t E;
+   int32_t O;
+   int64_t partsz;
+   int64_t versz;
+   int64_t blocksz;
+   int64_t totsz;
+   uint64_t meta_errs; // bitmap of blocks ( in handle order ) with bad metadata
+   uint64_t data_errs; // bitmap of blocks ( in handle order ) with missing data
+   int64_t crcsums[SHM_CACHE_BLOCKS];
+   char objID[SHM_CACHE_KEYLEN];
+} shm_cache_slot;
+
+// Consensus metadata of a single object, retained by a context to spare later read handles from fetching it
+typedef struct meta_cache_entry_struct
+{
+   char *objID;
+   ne_location loc;        // with objID, this is the lookup key
+   meta_info minfo;        // consensus values ( crcsum is unused )
+   long long *crcsums;     // CRC sum of each of the N+E blocks, in handle order
+   struct timespec stored; // time at which the entry was populated
+   struct meta_cache_entry_struct *next;
+} meta_cache_entry;
 
 // NE context
 typedef struct ne_ctxt_struct
@@ -135,8 +224,100 @@ typedef struct ne_ctxt_struct
    int max_block;
    // DAL definitions
    DAL dal;
+   // Number of erasure encoding threads for each write handle ( zero to encode inline )
+   int encode_threads;
+   // Number of erasure decoding threads for each read handle ( zero to decode inline )
+   int decode_threads;
+   // Cache of encoding structures and LRU cache of decoding structures ( most recently used first )
+   pthread_mutex_t tbl_lock; // lock for all of the following values
+   encode_tables *tables;
+   decode_plan *plans;
+   int plancnt;
+   int handles; // number of handles currently allocated against this context
+   ne_hedge_stats hstats;
+   // Hedging thresholds for read handles ( both zero to disable hedging )
+   unsigned int hedge_msec;
+   unsigned int hedge_mult;
+   // Shared pool of block I/O threads for all handles ( NULL for dedicated threads per block )
+   TQ_Pool io_pool;
+   // Optional LRU cache of object metadata ( most recently used first; protected by tbl_lock )
+   meta_cache_entry *mcache;
+   unsigned int mcache_cnt;
+   unsigned int mcache_max;  // maximum number of cached objects ( zero to disable caching )
+   unsigned int mcache_msec; // lifetime of each cached object ( zero for no expiry )
+   // Optional metadata cache, shared with other processes via a memory-mapped file ( NULL if none )
+   shm_cache_header *shm_cache;
+   size_t shm_size;
+   // Threads probing block metadata for ne_stat() ( started on first use, and protected by tbl_lock )
+   int stat_threads;
+   ThreadQueue stat_queue;
 } * ne_ctxt;
 
+// Erasure pool state, shared between a handle and its erasure threads
+// ( write handles use these to generate erasure, read handles to regenerate data and to copy out stripes )
+typedef struct encode_state_struct
+{
+   pthread_mutex_t lock;     // lock for all of the following values
+   pthread_cond_t complete;  // signaled once the current batch of stripes is fully encoded
+   int slices;               // number of slices of the current batch still being encoded
+   ioblock **staged;         // parity ioblocks waiting to be pushed until the current batch is complete
+   ThreadQueue *parity_queues; // thread_queues of the parity blocks
+   char error;               // set if any staged ioblock failed to be pushed
+   int threads;              // number of encoding threads
+   int N;
+   int E;
+   size_t partsz;
+} * encode_state;
+
+// Progress of a single ne_stat() call, shared with the threads probing its blocks
+// ( a probe which is still running once the call has what it needs keeps the state alive until it completes )
+typedef struct stat_state_struct
+{
+   pthread_mutex_t lock;     // lock for all of the following values
+   pthread_cond_t complete;  // signaled as each probe completes
+   int refs;                 // number of unfinished probes, plus one for the ne_stat() call itself
+   int maxblock;             // probes of blocks at or beyond this value are skipped
+   ne_ctxt ctxt;
+   char *objID;
+   ne_location loc;
+   char *meta_errs;
+   char *data_errs;
+   meta_info *minfo_list;
+   struct stat_probe_struct *probes; // two probes per block ( metadata, then data )
+} * stat_state;
+
+// Single metadata or data probe of one block
+typedef struct stat_probe_struct
+{
+   stat_state sstate;
+   int block;
+   char data; // probe for data, rather than for metadata
+   char done;
+} stat_probe;
+
+// Single slice of erasure work, covering the same byte range of every referenced block
+typedef struct encode_work_struct
+{
+   encode_state estate;
+   size_t len;
+   unsigned char *g_tbls; // tables to be applied to the N source references ( NULL to copy the sources out as
+                          //    complete stripes, to the single output reference )
+   int nout;              // number of output references
+   unsigned char *refs[]; // N source references, followed by nout output references
+} encode_work;
+
+// Block references and buffers used by a single positional read, retained by the handle for reuse by later reads
+typedef struct pread_state_struct
+{
+   BLOCK_CTXT *blocks;     // per-block DAL references ( opened only as needed )
+   unsigned char *buff;    // per-block fetch buffers, of bufsz bytes each
+   size_t bufsz;
+   unsigned char *in_err;  // erasure structs for the current span
+   unsigned char *err_list;
+   unsigned char **refs;   // N source references, followed by references for each regenerated block
+   struct pread_state_struct *next;
+} * pread_state;
+
 typedef struct ne_handle_struct
 {
    /* Reference back to our global context */
@@ -158,21 +339,44 @@ typedef struct ne_handle_struct
    off_t iob_datasz;
    off_t iob_offset;
    ssize_t sub_offset;
+   int regen_start; // range of stripes in the current ioblocks for which missing data has been regenerated
+   int regen_end;   //    ( only used by NE_RDONLY handles, which regenerate data as it is read )
 
    /* Threading fields */
    ThreadQueue *thread_queues;
    gthread_state *thread_states;
    unsigned int ethreads_running;
+   TQ_Group tq_group;   // group of all thread_queues, for retrieving ioblocks in completion order ( read handles only )
+   char *tq_pending;    // per-block indication of ioblocks still to be retrieved from the tq_group
+   ThreadQueue encode_queue;
+   encode_state estate;
 
    /* Erasure Manipulation Structures */
    unsigned char e_ready;
+   int e_pending;
    unsigned char *prev_in_err;
    unsigned int prev_err_cnt;
-   unsigned char *encode_matrix;
-   unsigned char *decode_matrix;
-   unsigned char *invert_matrix;
-   unsigned char *g_tbls;
-   unsigned char *decode_index;
+   encode_tables *etbls; // shared encoding structures ( acquired on first use )
+   decode_plan *dplan;   // shared decoding structures for the current error pattern ( if any )
+
+   /* Hedged Read Structures ( only allocated for NE_RDONLY handles with hedging enabled ) */
+   ioblock **hedge_iob;   // per-data-block ioblocks, standing in for ioblocks which were too slow to arrive
+   int *hedge_owed;       // per-data-block count of late ioblocks still to be received and discarded
+   unsigned int hedge_msec; // hedging thresholds ( see ne_set_hedging() )
+   unsigned int hedge_mult;
+   unsigned int lat_usec[HEDGE_SAMPLES]; // ring of recent data ioblock latencies
+   int lat_cnt;
+
+   /* Readahead Policy ( only used by read handles ) */
+   ne_advice advice;  // access pattern advice from the caller ( NE_ADV_NORMAL to detect the pattern )
+   int readahead;     // readahead currently applied to all ioqueues, in ioblocks
+   int seek_streak;   // number of consecutive reseeks separated by only small reads
+   size_t seq_bytes;  // bytes read since the most recent reseek
+
+   /* Positional Read Structures ( see ne_pread() ) */
+   pthread_mutex_t pread_lock; // lock for all of the following values
+   pread_state pread_idle;     // states not currently in use by any positional read
+   char *pread_bad;            // per-block flags, set once a positional read has found bad data for that block
 
 } * ne_handle;
 
@@ -284,10 +488,12 @@ int terminate_thread(ioblock **iobref, ThreadQueue tq, gthread_state *state, ne_
       // attempt to abort, ignoring errors
       tq_set_flags(tq, TQ_ABORT);
    }
-   if (mode == NE_RDONLY || mode == NE_RDALL)
+   if (mode == NE_RDONLY || mode == NE_RDALL || mode == NE_REBUILD)
    {
       // we need to empyt any remaining elements from the queue
-      while (tq_dequeue(tq, TQ_NONE, NULL) > 0)
+      // NOTE -- erasure threads of NE_RDONLY handles may have been left HALTED with elements still queued
+      // NOTE -- input threads of NE_REBUILD handles are left with elements queued by a failed rebuild
+      while (tq_dequeue(tq, TQ_HALT, NULL) > 0)
       {
          LOG(LOG_INFO, "Releasing unused queue element\n");
          release_ioblock(state->ioq);
@@ -297,779 +503,3463 @@ int terminate_thread(ioblock **iobref, ThreadQueue tq, gthread_state *state, ne_
 }
 
 /**
- * Allocate a new ne_handle structure
- * @param int max_block : Maximum block value
- * @return ne_handle : Allocated handle or NULL
+ * Acquire a reference to the shared encoding structs of the given context for the given N/E values,
+ * generating them if no handle has yet made use of them
+ * @param ne_ctxt ctxt : Context to acquire encoding structs from
+ * @param int N : Data width of the erasure stripe
+ * @param int E : Parity width of the erasure stripe
+ * @return encode_tables* : Reference to the encoding structs, or NULL on failure
  */
-ne_handle allocate_handle(ne_ctxt ctxt, const char *objID, ne_location loc, meta_info *consensus)
+static encode_tables *get_encode_tables(ne_ctxt ctxt, int N, int E)
 {
-   // create the handle structure itself
-   ne_handle handle = calloc(1, sizeof(struct ne_handle_struct));
-   if (handle == NULL)
+   if (pthread_mutex_lock(&ctxt->tbl_lock))
    {
-      LOG(LOG_ERR, "Failed to allocate space for a ne_handle structure!\n");
+      LOG(LOG_ERR, "Failed to acquire encoding table lock!\n");
       return NULL;
    }
-
-   // set erasure struct info
-   handle->epat.N = consensus->N;
-   handle->epat.E = consensus->E;
-   handle->epat.O = consensus->O;
-   handle->epat.partsz = consensus->partsz;
-   //   handle->epat.crcs = 0;
-   //   if ( consensus->versz > 0 ) { handle->epat.crcs = 1; }
-
-   // set data info values
-   handle->versz = consensus->versz;
-   handle->blocksz = consensus->blocksz;
-   handle->totsz = consensus->totsz;
-
-   // set some additional handle info
-   handle->ctxt = ctxt;
-   handle->objID = strdup(objID);
-   handle->loc.pod = loc.pod;
-   handle->loc.cap = loc.cap;
-   handle->loc.scatter = loc.scatter;
-
-   // allocate context elements
-   int num_blocks = consensus->N + consensus->E;
-   //   handle->meta_status = calloc( num_blocks, sizeof(char) );
-   //   if ( handle->meta_status == NULL ) {
-   //      LOG( LOG_ERR, "Failed to allocate space for a meta_status array!\n" );
-   //      free( handle );
-   //      return NULL;
-   //   }
-   //   handle->data_status = calloc( num_blocks, sizeof(char) );
-   //   if ( handle->data_status == NULL ) {
-   //      LOG( LOG_ERR, "Failed to allocate space for a data_status array!\n" );
-   //      free( handle.state.meta_status );
-   //      free( handle );
-   //      return NULL;
-   //   }
-   handle->iob = calloc(num_blocks, sizeof(ioblock *));
-   if (handle->iob == NULL)
+   encode_tables *tbls;
+   for (tbls = ctxt->tables; tbls != NULL; tbls = tbls->next)
    {
-      LOG(LOG_ERR, "Failed to allocate space for ioblock references!\n");
-      free(handle->objID);
-      free(handle);
-      return NULL;
+      if (tbls->N == N && tbls->E == E)
+      {
+         break;
+      }
    }
-   handle->thread_queues = calloc(num_blocks, sizeof(ThreadQueue));
-   if (handle->thread_queues == NULL)
+   if (tbls == NULL)
    {
-      LOG(LOG_ERR, "Failed to allocate space for thread_queues!\n");
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
-      return NULL;
+      // no match, so generate a new set of tables
+      tbls = calloc(1, sizeof(struct encode_tables_struct));
+      if (tbls == NULL)
+      {
+         LOG(LOG_ERR, "Failed to allocate space for an encode_tables struct!\n");
+         pthread_mutex_unlock(&ctxt->tbl_lock);
+         return NULL;
+      }
+      tbls->encode_matrix = calloc((N + E) * N, sizeof(unsigned char));
+      tbls->g_tbls = calloc(N * E * 32, sizeof(unsigned char));
+      if (tbls->encode_matrix == NULL || tbls->g_tbls == NULL)
+      {
+         LOG(LOG_ERR, "Failed to allocate space for encoding matricies!\n");
+         free(tbls->g_tbls);
+         free(tbls->encode_matrix);
+         free(tbls);
+         pthread_mutex_unlock(&ctxt->tbl_lock);
+         return NULL;
+      }
+      LOG(LOG_INFO, "Initializing erasure matricies for N=%d/E=%d...\n", N, E);
+      // Generate an encoding matrix
+      // NOTE: The matrix generated by gf_gen_rs_matrix is not always invertable for N>=6 and E>=5!
+      gf_gen_cauchy1_matrix(tbls->encode_matrix, N + E, N);
+      // Generate g_tbls from encode matrix
+      ec_init_tables(N, E, &(tbls->encode_matrix[N * N]), tbls->g_tbls);
+      tbls->N = N;
+      tbls->E = E;
+      tbls->next = ctxt->tables;
+      ctxt->tables = tbls;
    }
-   handle->thread_states = calloc(num_blocks, sizeof(struct global_state_struct));
-   if (handle->thread_states == NULL)
+   tbls->refcnt++;
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   return tbls;
+}
+
+/**
+ * Release a reference to shared encoding structs
+ * NOTE -- unreferenced structs are retained by the context, for reuse by later handles, until ne_term()
+ * @param ne_ctxt ctxt : Context the encoding structs were acquired from
+ * @param encode_tables* tbls : Reference to release ( may be NULL )
+ */
+static void release_encode_tables(ne_ctxt ctxt, encode_tables *tbls)
+{
+   if (tbls == NULL)
    {
-      LOG(LOG_ERR, "Failed to allocate space for global thread state structs!\n");
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
-      return NULL;
+      return;
    }
-   handle->prev_in_err = calloc(num_blocks, sizeof(char));
-   if (handle->prev_in_err == NULL)
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   tbls->refcnt--;
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+}
+
+/**
+ * Free a decode_plan struct
+ * @param decode_plan* plan : Plan to be freed
+ */
+static void free_decode_plan(decode_plan *plan)
+{
+   free(plan->g_tbls);
+   free(plan->decode_index);
+   free(plan->in_err);
+   free(plan);
+}
+
+/**
+ * Evict least recently used, unreferenced decode plans from the given context until it is within its cache limit
+ * NOTE -- the caller must hold the tbl_lock of the context
+ * @param ne_ctxt ctxt : Context to evict plans from
+ */
+static void trim_decode_plans(ne_ctxt ctxt)
+{
+   while (ctxt->plancnt > DECODE_PLAN_CACHE)
    {
-      LOG(LOG_ERR, "Failed to allocate space for a prev_error array!\n");
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
-      return NULL;
+      // locate the least recently used plan which is not currently in use
+      decode_plan **victim = NULL;
+      decode_plan **ref;
+      for (ref = &(ctxt->plans); *ref != NULL; ref = &((*ref)->next))
+      {
+         if ((*ref)->refcnt == 0)
+         {
+            victim = ref;
+         }
+      }
+      if (victim == NULL)
+      {
+         return; // every cached plan is in use
+      }
+      decode_plan *plan = *victim;
+      *victim = plan->next;
+      ctxt->plancnt--;
+      free_decode_plan(plan);
    }
-   handle->decode_index = calloc(num_blocks, sizeof(char));
-   if (handle->decode_index == NULL)
+}
+
+/**
+ * Generate a new decode_plan for the given error pattern
+ * @param encode_tables* etbls : Encoding structs for the N/E values of the stripe
+ * @param unsigned char* in_err : Array of N+E flags, indicating the blocks in error
+ * @param unsigned char* err_list : List of the indicies of all blocks in error
+ * @param int nerrs : Number of blocks in error
+ * @return decode_plan* : Reference to the new plan, or NULL on failure ( errno == ENODATA if the
+ *                        errors exceed erasure limits )
+ */
+static decode_plan *build_decode_plan(encode_tables *etbls, unsigned char *in_err, unsigned char *err_list, int nerrs)
+{
+   int N = etbls->N;
+   int E = etbls->E;
+   decode_plan *plan = calloc(1, sizeof(struct decode_plan_struct));
+   if (plan == NULL)
    {
-      LOG(LOG_ERR, "Failed to allocate space for a decode_index array!\n");
-      free(handle->prev_in_err);
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
+      LOG(LOG_ERR, "Failed to allocate space for a decode_plan struct!\n");
       return NULL;
    }
-   /* allocate matrices */
-   handle->encode_matrix = calloc(num_blocks * consensus->N, sizeof(char));
-   if (handle->encode_matrix == NULL)
+   plan->in_err = calloc(N + E, sizeof(unsigned char));
+   plan->decode_index = calloc(N + E, sizeof(unsigned char));
+   plan->g_tbls = calloc(N * nerrs * 32, sizeof(unsigned char));
+   // matricies only required while generating the plan
+   unsigned char *decode_matrix = calloc((N + E) * N, sizeof(unsigned char));
+   unsigned char *invert_matrix = calloc((N + E) * N, sizeof(unsigned char));
+   unsigned char *tmpmatrix = calloc((N + E) * (N + E), sizeof(unsigned char));
+   if (plan->in_err == NULL || plan->decode_index == NULL || plan->g_tbls == NULL ||
+       decode_matrix == NULL || invert_matrix == NULL || tmpmatrix == NULL)
    {
-      LOG(LOG_ERR, "Failed to allocate space for an encode_matrix!\n");
-      free(handle->decode_index);
-      free(handle->prev_in_err);
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
+      LOG(LOG_ERR, "Failed to allocate space for decoding matricies!\n");
+      free(tmpmatrix);
+      free(invert_matrix);
+      free(decode_matrix);
+      free_decode_plan(plan);
       return NULL;
    }
-   handle->decode_matrix = calloc(num_blocks * consensus->N, sizeof(char));
-   if (handle->decode_matrix == NULL)
+   int ret_code = gf_gen_decode_matrix_simple(etbls->encode_matrix, decode_matrix, invert_matrix, tmpmatrix,
+                                              plan->decode_index, err_list, nerrs, N, N + E);
+   free(tmpmatrix);
+   free(invert_matrix);
+   if (ret_code != 0)
    {
-      LOG(LOG_ERR, "Failed to allocate space for a decode_matrix!\n");
-      free(handle->encode_matrix);
-      free(handle->decode_index);
-      free(handle->prev_in_err);
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
+      LOG(LOG_ERR, "Failure to generate decode matrix, errors may exceed erasure limits (%d)!\n", nerrs);
+      free(decode_matrix);
+      free_decode_plan(plan);
+      errno = ENODATA;
       return NULL;
    }
-   handle->invert_matrix = calloc(num_blocks * consensus->N, sizeof(char));
-   if (handle->invert_matrix == NULL)
+   LOG(LOG_INFO, "Initializing erasure tables ( nstripe_errors = %d )\n", nerrs);
+   ec_init_tables(N, nerrs, decode_matrix, plan->g_tbls);
+   free(decode_matrix);
+   memcpy(plan->in_err, in_err, N + E);
+   plan->N = N;
+   plan->E = E;
+   plan->nerrs = nerrs;
+   return plan;
+}
+
+/**
+ * Acquire a reference to the decode_plan of the given context matching the given error pattern,
+ * generating it if no matching plan is cached
+ * @param ne_ctxt ctxt : Context to acquire the plan from
+ * @param encode_tables* etbls : Encoding structs for the N/E values of the stripe
+ * @param unsigned char* in_err : Array of N+E flags, indicating the blocks in error
+ * @param unsigned char* err_list : List of the indicies of all blocks in error
+ * @param int nerrs : Number of blocks in error
+ * @return decode_plan* : Reference to the plan, or NULL on failure ( errno == ENODATA if the
+ *                        errors exceed erasure limits )
+ */
+static decode_plan *get_decode_plan(ne_ctxt ctxt, encode_tables *etbls, unsigned char *in_err, unsigned char *err_list, int nerrs)
+{
+   int N = etbls->N;
+   int E = etbls->E;
+   decode_plan *newplan = NULL;
+   while (1)
    {
-      LOG(LOG_ERR, "Failed to allocate space for an invert_matrix!\n");
-      free(handle->decode_matrix);
-      free(handle->encode_matrix);
-      free(handle->decode_index);
-      free(handle->prev_in_err);
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
-      return NULL;
+      if (pthread_mutex_lock(&ctxt->tbl_lock))
+      {
+         LOG(LOG_ERR, "Failed to acquire encoding table lock!\n");
+         if (newplan)
+         {
+            free_decode_plan(newplan);
+         }
+         return NULL;
+      }
+      // search for a matching plan, remembering our predecessor so that we may move it to the front
+      decode_plan *prev = NULL;
+      decode_plan *plan;
+      for (plan = ctxt->plans; plan != NULL; prev = plan, plan = plan->next)
+      {
+         if (plan->N == N && plan->E == E && plan->nerrs == nerrs && memcmp(plan->in_err, in_err, N + E) == 0)
+         {
+            break;
+         }
+      }
+      if (plan)
+      {
+         if (prev)
+         {
+            prev->next = plan->next;
+            plan->next = ctxt->plans;
+            ctxt->plans = plan;
+         }
+         plan->refcnt++;
+         pthread_mutex_unlock(&ctxt->tbl_lock);
+         if (newplan)
+         {
+            // another handle beat us to it
+            free_decode_plan(newplan);
+         }
+         return plan;
+      }
+      if (newplan)
+      {
+         // insert our new plan as most recently used
+         newplan->refcnt = 1;
+         newplan->next = ctxt->plans;
+         ctxt->plans = newplan;
+         ctxt->plancnt++;
+         trim_decode_plans(ctxt);
+         pthread_mutex_unlock(&ctxt->tbl_lock);
+         return newplan;
+      }
+      pthread_mutex_unlock(&ctxt->tbl_lock);
+      // no match, so generate a new plan outside of the lock ( matrix inversion is comparatively expensive )
+      LOG(LOG_INFO, "Generating a new decode plan for %d errors\n", nerrs);
+      newplan = build_decode_plan(etbls, in_err, err_list, nerrs);
+      if (newplan == NULL)
+      {
+         return NULL;
+      }
    }
-   handle->g_tbls = calloc(consensus->N * consensus->E * 32, sizeof(char));
-   if (handle->g_tbls == NULL)
+}
+
+/**
+ * Release a reference to a decode_plan
+ * NOTE -- unreferenced plans are retained by the context, for reuse by later handles, until evicted
+ * @param ne_ctxt ctxt : Context the plan was acquired from
+ * @param decode_plan* plan : Reference to release ( may be NULL )
+ */
+static void release_decode_plan(ne_ctxt ctxt, decode_plan *plan)
+{
+   if (plan == NULL)
    {
-      LOG(LOG_ERR, "Failed to allocate space for g_tbls!\n");
-      free(handle->invert_matrix);
-      free(handle->decode_matrix);
-      free(handle->encode_matrix);
-      free(handle->decode_index);
-      free(handle->prev_in_err);
-      free(handle->thread_states);
-      free(handle->thread_queues);
-      free(handle->iob);
-      free(handle->objID);
-      free(handle);
-      return NULL;
+      return;
    }
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   plan->refcnt--;
+   trim_decode_plans(ctxt);
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+}
 
-   int i;
-   for (i = 0; i < num_blocks; i++)
+/**
+ * Produce the ( non-zero ) shared metadata cache hash of the given object
+ * @param const char* objID : ID of the object
+ * @param ne_location loc : Location of the object
+ * @return uint64_t : Hash value
+ */
+static uint64_t shm_cache_hash(const char *objID, ne_location loc)
+{
+   // FNV-1a, over the objID and then the location
+   uint64_t hash = 14695981039346656037ULL;
+   const unsigned char *c;
+   for (c = (const unsigned char *)objID; *c; c++)
    {
-      // assign values to thread states
-      // object attributes
-      handle->thread_states[i].objID = handle->objID;
-      handle->thread_states[i].location.pod = loc.pod;
-      handle->thread_states[i].location.block = (i + consensus->O) % num_blocks;
-      handle->thread_states[i].location.cap = loc.cap;
-      handle->thread_states[i].location.scatter = loc.scatter;
-      handle->thread_states[i].dal = ctxt->dal;
-      handle->thread_states[i].offset = 0;
-      // meta info values
-      handle->thread_states[i].minfo.N = consensus->N;
-      handle->thread_states[i].minfo.E = consensus->E;
-      handle->thread_states[i].minfo.O = consensus->O;
-      handle->thread_states[i].minfo.partsz = consensus->partsz;
-      handle->thread_states[i].minfo.versz = consensus->versz;
-      handle->thread_states[i].minfo.blocksz = consensus->blocksz;
-      handle->thread_states[i].minfo.crcsum = 0;
-      handle->thread_states[i].minfo.totsz = consensus->totsz;
-      handle->thread_states[i].meta_error = 0;
-      handle->thread_states[i].data_error = 0;
-      //      size_t iosz = consensus->versz;
-      //      if ( iosz <= 0 ) { iosz = handle->dal->io_size; }
-      //      handle->thread_states[i].ioq = create_ioqueue( iosz, consensus->partsz, mode );
-      //      if ( handle->thread_states[i].ioq == NULL ) {
-      //         LOG( LOG_ERR, "Failed to create an ioqueue for block %d!\n", i );
-      //         for ( i -= 1; i >= 0; i-- ) {
-      //            destroy_ioqueue( handle->thread_states[i].ioq );
-      //         }
-      //         free( handle->thread_states );
-      //         free( handle->thread_queues );
-      //         free( handle->iob );
-      //         free( handle.state.data_status );
-      //         free( handle.state.meta_status );
-      //         free( handle );
-      //         return NULL;
-      //      }
+      hash = (hash ^ *c) * 1099511628211ULL;
    }
-
-   // indicate that handle is ready for conversion
-   handle->mode = NE_STAT;
-
-   return handle;
+   int locvals[3] = {loc.pod, loc.cap, loc.scatter};
+   const unsigned char *end = (const unsigned char *)locvals + sizeof(locvals);
+   for (c = (const unsigned char *)locvals; c < end; c++)
+   {
+      hash = (hash ^ *c) * 1099511628211ULL;
+   }
+   return (hash) ? hash : 1;
 }
 
 /**
- * Free an allocated ne_handle structure
- * @param ne_handle handle : Handle to free
+ * Get the current time, as used to age entries of a shared metadata cache
+ * @return int64_t : Current CLOCK_MONOTONIC time, in milliseconds
  */
-void free_handle(ne_handle handle)
+static int64_t shm_cache_msec(void)
 {
-   //   int i;
-   //   for ( i = 0; i < handle->epat.N + handle->epat.E; i++ ) {
-   //      destroy_ioqueue( handle->thread_states[i].ioq );
-   //   }
-   free(handle->g_tbls);
-   free(handle->invert_matrix);
-   free(handle->decode_matrix);
-   free(handle->encode_matrix);
-   free(handle->decode_index);
-   free(handle->prev_in_err);
-   free(handle->thread_states);
-   free(handle->thread_queues);
-   free(handle->iob);
-   free(handle->objID);
-   free(handle);
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return ((int64_t)now.tv_sec * 1000) + (now.tv_nsec / 1000000);
 }
 
 /**
- * This helper function is intended to identify the most common sensible values amongst all meta_buffers
- * for a given number of read threads and return them in a provided read_meta_buffer struct.
- * If two numbers have the same number of instances, preference will be given to the first number ( the
- * one with a lower block number ).
- * @param BufferQueue blocks[ MAXPARTS ] : Array of buffer queues for all threads
- * @param int num_threads : Number of threads with meta_info ready
- * @param read_meta_buffer ret_buf : Buffer to be populated with return values
- * @return int : Lesser of the counts of matching N/E values
+ * Locate the given object in the shared metadata cache of the given context, regardless of its age
+ * NOTE -- this never blocks; slots being updated by other processes are simply treated as misses
+ * @param ne_ctxt ctxt : Context to search
+ * @param const char* objID : ID of the object
+ * @param ne_location loc : Location of the object
+ * @param shm_cache_slot* slot : Reference to be populated with a consistent copy of the matching slot
+ * @return int : One if a match was found, zero if not
  */
-int check_matches(meta_info **minfo_structs, int num_blocks, int max_blocks, meta_info *ret_buf)
+static int find_shared_meta(ne_ctxt ctxt, const char *objID, ne_location loc, shm_cache_slot *slot)
 {
-   // allocate space for ALL match arrays
-   int *N_match = calloc(7, sizeof(int) * num_blocks);
-   if (N_match == NULL)
-   {
-      LOG(LOG_ERR, "Failed to allocate space for match count arrays!\n");
-      return -1;
-   }
-   int *E_match = (N_match + num_blocks);
-   int *O_match = (E_match + num_blocks);
-   int *partsz_match = (O_match + num_blocks);
-   int *versz_match = (partsz_match + num_blocks);
-   int *blocksz_match = (versz_match + num_blocks);
-   int *totsz_match = (blocksz_match + num_blocks);
-
-   int i;
-   for (i = 0; i < num_blocks; i++)
+   if (ctxt->shm_cache == NULL || strlen(objID) >= SHM_CACHE_KEYLEN)
    {
-      int j;
-      meta_info *minfo = minfo_structs[i];
-// this macro is intended to produce counts of matching values at the index of their first appearance
-#define COUNT_MATCH_AT_INDEX(VAL, MATCH_LIST, MIN_VAL, MAX_VAL) \
-   if (minfo->VAL >= MIN_VAL && minfo->VAL <= MAX_VAL)          \
-   {                                                            \
-      for (j = 0; j < i; j++)                                   \
-      {                                                         \
-         if (minfo_structs[j]->VAL == minfo->VAL)               \
-         {                                                      \
-            break;                                              \
-         }                                                      \
-      }                                                         \
-      MATCH_LIST[j]++;                                          \
-   }
-      COUNT_MATCH_AT_INDEX(N, N_match, 1, max_blocks)
-      COUNT_MATCH_AT_INDEX(E, E_match, 0, max_blocks - 1)
-      COUNT_MATCH_AT_INDEX(O, O_match, 0, max_blocks - 1)
-      COUNT_MATCH_AT_INDEX(partsz, partsz_match, 1, minfo->partsz)    // no maximum
-      COUNT_MATCH_AT_INDEX(versz, versz_match, 0, minfo->versz)       // no maximum
-      COUNT_MATCH_AT_INDEX(blocksz, blocksz_match, 0, minfo->blocksz) // no maximum
-      COUNT_MATCH_AT_INDEX(totsz, totsz_match, 0, minfo->totsz)       //no maximum
+      return 0;
    }
-
-   // find the value with the most matches
-   int N_index = 0;
-   int E_index = 0;
-   int O_index = 0;
-   int partsz_index = 0;
-   int versz_index = 0;
-   int blocksz_index = 0;
-   int totsz_index = 0;
-   for (i = 1; i < num_blocks; i++)
+   shm_cache_slot *slots = (shm_cache_slot *)(ctxt->shm_cache + 1);
+   uint64_t hash = shm_cache_hash(objID, loc);
+   int probe;
+   for (probe = 0; probe < SHM_CACHE_PROBES; probe++)
    {
-      // For N/E: if two values are tied for matches, prefer the larger value (helps to avoid taking values from a single bad meta info)
-      if (N_match[i] > N_match[N_index] ||
-          (N_match[i] == N_match[N_index] &&
-           minfo_structs[i]->N > minfo_structs[N_index]->N))
-         N_index = i;
-      if (E_match[i] > E_match[E_index] ||
-          (E_match[i] == E_match[E_index] &&
-           minfo_structs[i]->E > minfo_structs[E_index]->E))
-         E_index = i;
-      // For other values: if two values are tied for matches, prefer the first
-      if (O_match[i] > O_match[O_index])
-         O_index = i;
-      if (partsz_match[i] > partsz_match[partsz_index])
-         partsz_index = i;
-      if (versz_match[i] > versz_match[versz_index])
-         versz_index = i;
-      if (blocksz_match[i] > blocksz_match[blocksz_index])
-         blocksz_index = i;
-      // For Totsz : if two values are tied for matches, prefer the smaller value (helps to avoid returning zero-fill as 'data')
-      if (totsz_match[i] > totsz_match[totsz_index] ||
-          (totsz_match[i] == totsz_match[totsz_index] &&
-           minfo_structs[i]->totsz < minfo_structs[totsz_index]->totsz))
-         totsz_index = i;
+      shm_cache_slot *cur = &(slots[(hash + probe) % ctxt->shm_cache->slots]);
+      uint64_t seq = __atomic_load_n(&(cur->seq), __ATOMIC_ACQUIRE);
+      if (seq & 1)
+      {
+         continue; // being updated
+      }
+      memcpy(slot, cur, sizeof(shm_cache_slot));
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (__atomic_load_n(&(cur->seq), __ATOMIC_RELAXED) != seq)
+      {
+         continue; // updated while we were copying
+      }
+      if (slot->hash != hash || slot->pod != loc.pod || slot->cap != loc.cap || slot->scatter != loc.scatter ||
+          strncmp(slot->objID, objID, SHM_CACHE_KEYLEN))
+      {
+         continue;
+      }
+      return 1;
    }
-
-   // assign appropriate values to our output struct
-   // Note: we have to do a sanity check on the match count, to make sure
-   // we don't return an out-of-bounds value.
-   if (N_match[N_index])
-      ret_buf->N = minfo_structs[N_index]->N;
-   else
-      ret_buf->N = 0;
-
-   if (E_match[E_index])
-      ret_buf->E = minfo_structs[E_index]->E;
-   else
-      ret_buf->E = -1;
-
-   if (O_match[O_index])
-      ret_buf->O = minfo_structs[O_index]->O;
-   else
-      ret_buf->O = -1;
-
-   if (partsz_match[partsz_index])
-      ret_buf->partsz = minfo_structs[partsz_index]->partsz;
-   else
-      ret_buf->partsz = 0;
-
-   if (versz_match[versz_index])
-      ret_buf->versz = minfo_structs[versz_index]->versz;
-   else
-      ret_buf->versz = -1;
-
-   if (blocksz_match[blocksz_index])
-      ret_buf->blocksz = minfo_structs[blocksz_index]->blocksz;
-   else
-      ret_buf->blocksz = -1;
-
-   if (totsz_match[totsz_index])
-      ret_buf->totsz = minfo_structs[totsz_index]->totsz;
-   else
-      ret_buf->totsz = -1;
-
-   int retval = (N_match[N_index] > E_match[E_index]) ? E_match[E_index] : N_match[N_index];
-   free(N_match);
-   return retval;
+   return 0;
 }
 
 /**
- *
- *
+ * Retrieve the given object from the shared metadata cache of the given context
+ * NOTE -- without a TTL, nothing is ever retrieved ( block health recorded by other processes would never be 
+ *         refreshed )
+ * @param ne_ctxt ctxt : Context to search
+ * @param const char* objID : ID of the object
+ * @param ne_location loc : Location of the object
+ * @param shm_cache_slot* slot : Reference to be populated with a consistent copy of the matching slot
+ * @return int : One if an unexpired match was found, zero if not
  */
-int read_stripes(ne_handle handle)
+static int read_shared_meta(ne_ctxt ctxt, const char *objID, ne_location loc, shm_cache_slot *slot)
 {
-
-   // get some useful reference values
-   int N = handle->epat.N;
-   int E = handle->epat.E;
-   ssize_t partsz = handle->epat.partsz;
-   size_t stripesz = partsz * N;
-#ifdef DEBUG
-   size_t offset = (handle->iob_offset * N) + handle->sub_offset;
-   unsigned int start_stripe = (unsigned int)(offset / stripesz); // get a stripe num based on offset
-#endif
-
-   // make sure our sub_offset is stripe aligned and at the end of our current ioblocks
-   if (handle->sub_offset % stripesz || handle->sub_offset != (handle->iob_datasz * N))
-   {
-      LOG(LOG_ERR, "Called on handle with an inappropriate sub_offset (%zd)!\n", handle->sub_offset);
-      return -1;
-   }
-
-   // update handle offset values
-   handle->iob_offset += handle->iob_datasz;
-   handle->sub_offset = 0;
-
-   // if we have previous block references, we'll need to release them
-   int i;
-   for (i = 0; i < handle->epat.N + handle->epat.E && handle->iob[i] != NULL; i++)
+   if (ctxt->mcache_msec == 0 || !find_shared_meta(ctxt, objID, loc, slot))
    {
-      if (release_ioblock(handle->thread_states[i].ioq))
-      {
-         LOG(LOG_ERR, "Failed to release ioblock reference for block %d!\n", i);
-         return -1;
-      }
-      handle->iob[i] = NULL; // NULL out this outdated reference
+      return 0;
    }
+   int64_t age = shm_cache_msec() - slot->stored_msec;
+   return (age >= 0 && age < ctxt->mcache_msec);
+}
 
-   // ---------------------- VERIFY INTEGRITY OF ALL BLOCKS IN STRIPE ----------------------
-
-   // First, loop through all data buffers in the stripe, looking for errors.
-   // Then, starup erasure threads as necessary to deal with errors.
-   // Technically, it would theoretically be more efficient to limit this to
-   // only the blocks we expect to need.  However, if we hit any error in those
-   // blocks, we'll suddenly need the whole stripe.  I am hoping the reduced
-   // complexity of just checking them all will be worth what will probably
-   // only be the slightest of performance hits.  Besides, in the expected
-   // use case of reading a file start to finish, we'll eventually need this
-   // entire stripe regardless.
-   int cur_block;
-   int stripecnt = 0;
-   int nstripe_errors = 0;
-   for (cur_block = 0; (cur_block < (N + nstripe_errors) || cur_block < (N + handle->ethreads_running)) && cur_block < (N + E); cur_block++)
+/**
+ * Claim exclusive access to a slot of a shared metadata cache, by making its sequence odd
+ * NOTE -- a slot which has been claimed for SHM_CLAIM_SEC or longer was abandoned by a writer which died during 
+ *         its update, and is reclaimed ( and emptied, as its values may be incomplete )
+ * @param shm_cache_slot* slot : Slot to be claimed
+ * @param char wait : Flag indicating whether to wait out any update by another process
+ * @param uint64_t* seq : Reference to be populated with the new ( odd ) sequence value
+ * @return int : Zero on success, -1 if the slot is in use by another process ( and we are not waiting )
+ */
+static int claim_shared_slot(shm_cache_slot *slot, char wait, uint64_t *seq)
+{
+   int spins = 0;
+   while (1)
    {
-      // check if we can even handle however many errors we've hit so far
-      if (nstripe_errors > E)
-      {
-         LOG(LOG_ERR, "Data beyond stripe %d has too many errors (%d) to be recovered\n", start_stripe, nstripe_errors);
-         errno = ENODATA;
-         return -1;
-      }
-      // if this thread isn't running, we need to start it
-      if (cur_block >= N + handle->ethreads_running)
+      uint64_t cur = __atomic_load_n(&(slot->seq), __ATOMIC_RELAXED);
+      uint32_t now = (uint32_t)(shm_cache_msec() / 1000);
+      // NOTE -- a claim from the 'future' must predate a reboot, and so is also abandoned
+      char abandoned = ((cur & 1) && (uint32_t)(now - (uint32_t)(cur >> 32)) >= SHM_CLAIM_SEC);
+      uint64_t next = ((uint64_t)now << 32) | (uint32_t)((uint32_t)cur + ((cur & 1) ? 2 : 1));
+      if ((!(cur & 1) || abandoned) &&
+          __atomic_compare_exchange_n(&(slot->seq), &cur, next, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
       {
-         LOG(LOG_INFO, "Starting up thread %d to cope with errors beyond stripe %d\n", cur_block, start_stripe);
-         // first, make sure to empty any ioblocks still on the queue
-         while (tq_dequeue(handle->thread_queues[cur_block], TQ_HALT, (void **)&(handle->iob[cur_block])) > 0)
-         {
-            LOG(LOG_INFO, "Releasing ioblock from queue %d, prior to reseek\n", cur_block);
-            if (release_ioblock(handle->thread_states[cur_block].ioq))
-            {
-               LOG(LOG_ERR, "Failed to release ioblock from queue %d\n", cur_block);
-               errno = EBADF;
-               return -1;
-            }
-         }
-         handle->thread_states[cur_block].offset = handle->iob_offset; // set offset for this read thread
-         if (tq_unset_flags(handle->thread_queues[cur_block], TQ_HALT))
+         // no slot values may be written before the sequence change becomes visible
+         __atomic_thread_fence(__ATOMIC_RELEASE);
+         if (abandoned)
          {
-            LOG(LOG_ERR, "Failed to clear PAUSE state for block %d!\n", cur_block);
-            errno = EBADF;
-            return -1;
+            LOG(LOG_WARNING, "Reclaiming a shared metadata cache slot abandoned mid-update\n");
+            slot->hash = 0;
          }
-         handle->ethreads_running++;
+         *seq = next;
+         return 0;
       }
-      // retrieve a new ioblock from this thread
-      if (tq_dequeue(handle->thread_queues[cur_block], TQ_HALT, (void **)&(handle->iob[cur_block])) < 0)
+      if (!wait)
       {
-         LOG(LOG_ERR, "Failed to retrieve new buffer for block %d!\n", cur_block);
-         errno = EBADF;
          return -1;
       }
-      LOG(LOG_INFO, "Dequeued ioblock at position %d\n", cur_block);
-      // check if this new ioblock will require a rebuild
-      ioblock *cur_iob = handle->iob[cur_block];
-      if (cur_iob->error_end > 0)
-      {
-         LOG(LOG_ERR, "Detected an error at offset %zu of ioblock %d\n", cur_iob->error_end, cur_block);
-         nstripe_errors++;
-      }
-      // make sure our stripecnt is logical
-      if (stripecnt)
+      // live writers finish quickly, while those which died are reclaimed after SHM_CLAIM_SEC
+      if (++spins > 1000)
       {
-         if ((cur_iob->data_size / partsz) != stripecnt)
-         {
-            LOG(LOG_ERR, "Detected a ioblock of size %zd from block %d which conflicts with stripe count of %d!\n",
-                cur_iob->data_size, cur_block, stripecnt);
-            errno = EBADF;
-            return -1;
-         }
+         usleep(1000);
       }
       else
       {
-         stripecnt = (cur_iob->data_size / partsz);
-         handle->iob_datasz = cur_iob->data_size;
-      } // or set it, if we haven't yet
+         sched_yield();
+      }
    }
+}
 
-   int block_cnt = cur_block;
+/**
+ * Release a slot of a shared metadata cache, claimed by claim_shared_slot()
+ * @param shm_cache_slot* slot : Slot to be released
+ * @param uint64_t seq : Sequence value produced by claim_shared_slot()
+ */
+static void release_shared_slot(shm_cache_slot *slot, uint64_t seq)
+{
+   // a slot reclaimed from us, after we stalled beyond SHM_CLAIM_SEC, now belongs to another writer
+   if (!__atomic_compare_exchange_n(&(slot->seq), &seq, seq + 1, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+   {
+      LOG(LOG_WARNING, "Shared metadata cache slot was reclaimed during our update\n");
+   }
+}
 
-   // if we'er trying to avoid unnecessary reads, halt excess erasure threads
-   if (handle->mode == NE_RDONLY)
+/**
+ * Record ( or discard ) the given object in the shared metadata cache of the given context
+ * NOTE -- an object may not be recorded if its slots are being updated by another process
+ * @param ne_ctxt ctxt : Context to update
+ * @param const char* objID : ID of the object
+ * @param ne_location loc : Location of the object
+ * @param shm_cache_slot* slot : Values to be recorded ( NULL to discard any record of the object )
+ */
+static void write_shared_meta(ne_ctxt ctxt, const char *objID, ne_location loc, shm_cache_slot *slot)
+{
+   if (ctxt->shm_cache == NULL || strlen(objID) >= SHM_CACHE_KEYLEN)
    {
-      // keep the greater of how many erasure threads we've needed in the last couple of stripes...
-      if (nstripe_errors > handle->prev_err_cnt)
-         handle->prev_err_cnt = nstripe_errors;
-      // ...and halt all others
-      for (cur_block = (N + nstripe_errors); cur_block < (N + handle->prev_err_cnt); cur_block++)
+      return;
+   }
+   shm_cache_slot *slots = (shm_cache_slot *)(ctxt->shm_cache + 1);
+   uint64_t hash = shm_cache_hash(objID, loc);
+   shm_cache_slot *target = NULL;
+   uint64_t seq;
+   int probe;
+   for (probe = 0; probe < SHM_CACHE_PROBES; probe++)
+   {
+      shm_cache_slot *cur = &(slots[(hash + probe) % ctxt->shm_cache->slots]);
+      // these unsynchronized reads only guide our choice of slot
+      char match = (cur->hash == hash && strncmp(cur->objID, objID, SHM_CACHE_KEYLEN) == 0);
+      if (slot == NULL)
       {
-         LOG(LOG_INFO, "Setting HALT state for unneded thread %d\n", cur_block);
-         if (tq_set_flags(handle->thread_queues[cur_block], TQ_HALT))
-         {
-            // nothing to do besides complain
-            LOG(LOG_ERR, "Failed to pause erasure thread for block %d!\n", cur_block);
-         }
-         else
+         // discard every match, waiting out any update in progress so that the object can no longer be read
+         if (match)
          {
-            handle->ethreads_running--;
+            if (claim_shared_slot(cur, 1, &seq))
+            {
+               LOG(LOG_WARNING, "Failed to discard shared metadata of object \"%s\"\n", objID);
+               continue;
+            }
+            cur->hash = 0;
+            release_shared_slot(cur, seq);
          }
+         continue;
       }
-      // need to reassign, in case the number of errors is decreasing
-      handle->prev_err_cnt = nstripe_errors;
+      // prefer the existing slot of the object, then an empty slot, then the least recently populated
+      if (match)
+      {
+         target = cur;
+         break;
+      }
+      if (target == NULL || (target->hash && (cur->hash == 0 || cur->stored_msec < target->stored_msec)))
+      {
+         target = cur;
+      }
+   }
+   if (target == NULL || claim_shared_slot(target, 0, &seq))
+   {
+      return;
    }
+   memcpy(((char *)target) + sizeof(target->seq), ((char *)slot) + sizeof(slot->seq), sizeof(shm_cache_slot) - sizeof(slot->seq));
+   release_shared_slot(target, seq);
+}
 
-   // If any errors were found, we need to try and reconstruct any missing data
-   if (nstripe_errors)
+/**
+ * Record the metadata and block status of the given handle in the shared metadata cache of its context
+ * @param ne_handle handle : Handle with fully populated meta_info values
+ */
+static void share_handle_meta(ne_handle handle)
+{
+   int blocks = handle->epat.N + handle->epat.E;
+   if (handle->ctxt->shm_cache == NULL || blocks > SHM_CACHE_BLOCKS || strlen(handle->objID) >= SHM_CACHE_KEYLEN)
+   {
+      return;
+   }
+   shm_cache_slot slot;
+   memset(&slot, 0, sizeof(slot));
+   slot.pod = handle->loc.pod;
+   slot.cap = handle->loc.cap;
+   slot.scatter = handle->loc.scatter;
+   slot.hash = shm_cache_hash(handle->objID, handle->loc);
+   slot.stored_msec = shm_cache_msec();
+   slot.N = handle->epat.N;
+   slot.E = handle->epat.E;
+   slot.O = handle->epat.O;
+   slot.partsz = handle->epat.partsz;
+   slot.versz = handle->versz;
+   slot.blocksz = handle->blocksz;
+   slot.totsz = handle->totsz;
+   int i;
+   for (i = 0; i < blocks; i++)
    {
-      // create some erasure structs
-      unsigned char *stripe_in_err = calloc(N + E, sizeof(unsigned char));
-      if (stripe_in_err == NULL)
+      if (handle->thread_states[i].meta_error)
       {
-         LOG(LOG_ERR, "Failed to allocate space for a stripe_in_err array!\n");
-         return -1;
+         slot.meta_errs |= (1ULL << i);
       }
-      unsigned char *stripe_err_list = calloc(N + E, sizeof(unsigned char));
-      if (stripe_err_list == NULL)
+      if (handle->thread_states[i].data_error)
       {
-         LOG(LOG_ERR, "Failed to allocate space for a stripe_err_list array!\n");
-         return -1;
+         slot.data_errs |= (1ULL << i);
       }
+      slot.crcsums[i] = handle->thread_states[i].minfo.crcsum;
+   }
+   strncpy(slot.objID, handle->objID, SHM_CACHE_KEYLEN - 1);
+   write_shared_meta(handle->ctxt, handle->objID, handle->loc, &slot);
+}
 
-      // loop over each stripe in reverse order, fixing the ends of the buffers first
-      // NOTE -- reconstructing in reverse allows us to continue using the error_end values appropriately
-      int cur_stripe;
-      for (cur_stripe = stripecnt - 1; cur_stripe >= 0; cur_stripe--)
-      {
-
-         // loop over the blocks of the stripe, establishing error counts/positions
-         off_t stripe_start = cur_stripe * partsz;
-         nstripe_errors = 0;
-         for (cur_block = 0; cur_block < block_cnt; cur_block++)
-         {
-            // reset our error state
-            stripe_err_list[cur_block] = 0; // as cur_block MUST be <= nstripe_errors at this point
-            stripe_in_err[cur_block] = 0;
-
-            // check for bad stripe data in this block
-            if (stripe_start < handle->iob[cur_block]->error_end)
+/**
+ * Map the given shared metadata cache file, creating and initializing it if necessary
+ * @param const char* path : Path of the cache file
+ * @param unsigned int slots : Number of slots to create the file with ( an existing file retains its own )
+ * @param size_t* size : Reference to be populated with the size of the mapping
+ * @return shm_cache_header* : Reference to the mapped file, or NULL on failure
+ */
+static shm_cache_header *map_shared_cache(const char *path, unsigned int slots, size_t *size)
+{
+   int fd = open(path, O_RDWR | O_CREAT, 0600);
+   if (fd < 0)
+   {
+      LOG(LOG_ERR, "Failed to open shared metadata cache \"%s\" (%s)\n", path, strerror(errno));
+      return NULL;
+   }
+   // serialize initialization against other processes
+   if (flock(fd, LOCK_EX))
+   {
+      LOG(LOG_ERR, "Failed to lock shared metadata cache \"%s\" (%s)\n", path, strerror(errno));
+      close(fd);
+      return NULL;
+   }
+   shm_cache_header header;
+   struct stat st;
+   if (fstat(fd, &st))
+   {
+      LOG(LOG_ERR, "Failed to stat shared metadata cache \"%s\" (%s)\n", path, strerror(errno));
+      close(fd);
+      return NULL;
+   }
+   char init = 0;
+   if (st.st_size == 0)
+   {
+      header.magic = SHM_CACHE_MAGIC;
+      header.version = SHM_CACHE_VER;
+      header.slots = slots;
+      header.slotsz = sizeof(shm_cache_slot);
+      *size = sizeof(shm_cache_header) + ((size_t)slots * sizeof(shm_cache_slot));
+      if (ftruncate(fd, *size))
+      {
+         LOG(LOG_ERR, "Failed to size shared metadata cache \"%s\" (%s)\n", path, strerror(errno));
+         close(fd);
+         return NULL;
+      }
+      init = 1;
+   }
+   else
+   {
+      if (pread(fd, &header, sizeof(header), 0) != sizeof(header) || header.magic != SHM_CACHE_MAGIC ||
+          header.version != SHM_CACHE_VER || header.slotsz != sizeof(shm_cache_slot) || header.slots == 0 ||
+          st.st_size != sizeof(shm_cache_header) + ((off_t)header.slots * sizeof(shm_cache_slot)))
+      {
+         LOG(LOG_ERR, "Existing file \"%s\" is not a compatible shared metadata cache\n", path);
+         close(fd);
+         errno = EINVAL;
+         return NULL;
+      }
+      *size = st.st_size;
+   }
+   shm_cache_header *cache = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (cache == MAP_FAILED)
+   {
+      LOG(LOG_ERR, "Failed to map shared metadata cache \"%s\" (%s)\n", path, strerror(errno));
+      close(fd);
+      return NULL;
+   }
+   if (init)
+   {
+      *cache = header; // slots are already zeroed, and so empty
+   }
+   // the mapping keeps the open file ( and so, any lock ) alive beyond close()
+   flock(fd, LOCK_UN);
+   close(fd);
+   return cache;
+}
+
+/**
+ * Free a meta_cache_entry struct
+ * @param meta_cache_entry* entry : Entry to be freed
+ */
+static void free_meta_cache_entry(meta_cache_entry *entry)
+{
+   free(entry->crcsums);
+   free(entry->objID);
+   free(entry);
+}
+
+/**
+ * Locate the cached metadata of the given object
+ * NOTE -- the caller must hold the tbl_lock of the context
+ * @param ne_ctxt ctxt : Context to search
+ * @param const char* objID : ID of the object
+ * @param ne_location loc : Location of the object
+ * @return meta_cache_entry** : Reference to the link to the matching entry ( *ref == NULL, if none exists )
+ */
+static meta_cache_entry **find_cached_meta(ne_ctxt ctxt, const char *objID, ne_location loc)
+{
+   meta_cache_entry **ref;
+   for (ref = &(ctxt->mcache); *ref != NULL; ref = &((*ref)->next))
+   {
+      meta_cache_entry *entry = *ref;
+      if (entry->loc.pod == loc.pod && entry->loc.cap == loc.cap && entry->loc.scatter == loc.scatter &&
+          strcmp(entry->objID, objID) == 0)
+      {
+         break;
+      }
+   }
+   return ref;
+}
+
+/**
+ * Evict least recently used metadata from the given context until it is within the given limit
+ * NOTE -- the caller must hold the tbl_lock of the context
+ * @param ne_ctxt ctxt : Context to evict metadata from
+ * @param unsigned int limit : Maximum number of entries to retain
+ */
+static void trim_cached_meta(ne_ctxt ctxt, unsigned int limit)
+{
+   while (ctxt->mcache_cnt > limit)
+   {
+      meta_cache_entry **victim = &(ctxt->mcache);
+      while ((*victim)->next)
+      {
+         victim = &((*victim)->next);
+      }
+      free_meta_cache_entry(*victim);
+      *victim = NULL;
+      ctxt->mcache_cnt--;
+   }
+}
+
+/**
+ * Discard any metadata of the given object cached by this process
+ * @param ne_ctxt ctxt : Context of the object
+ * @param const char* objID : ID of the object
+ * @param ne_location loc : Location of the object
+ */
+static void drop_local_meta(ne_ctxt ctxt, const char *objID, ne_location loc)
+{
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   meta_cache_entry **ref = find_cached_meta(ctxt, objID, loc);
+   meta_cache_entry *entry = *ref;
+   if (entry)
+   {
+      *ref = entry->next;
+      ctxt->mcache_cnt--;
+   }
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   if (entry)
+   {
+      free_meta_cache_entry(entry);
+   }
+}
+
+/**
+ * Discard any cached metadata of the given object ( including that shared with other processes )
+ * @param ne_ctxt ctxt : Context of the object
+ * @param const char* objID : ID of the object
+ * @param ne_location loc : Location of the object
+ */
+static void drop_cached_meta(ne_ctxt ctxt, const char *objID, ne_location loc)
+{
+   drop_local_meta(ctxt, objID, loc);
+   write_shared_meta(ctxt, objID, loc, NULL);
+}
+
+/**
+ * Discard cached metadata of the given object which is contradicted by errors found by the given read handle
+ * ( shared block status which already reflects every error is retained )
+ * @param ne_handle handle : Read handle which has encountered errors
+ */
+static void review_cached_meta(ne_handle handle)
+{
+   // only objects without errors are cached locally
+   drop_local_meta(handle->ctxt, handle->objID, handle->loc);
+   // other processes may still use a shared record which we would consider expired
+   shm_cache_slot slot;
+   if (!find_shared_meta(handle->ctxt, handle->objID, handle->loc, &slot))
+   {
+      return;
+   }
+   int i;
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      if ((handle->thread_states[i].meta_error && !((slot.meta_errs >> i) & 1)) ||
+          (handle->thread_states[i].data_error && !(((slot.meta_errs | slot.data_errs) >> i) & 1)))
+      {
+         write_shared_meta(handle->ctxt, handle->objID, handle->loc, NULL);
+         return;
+      }
+   }
+}
+
+/**
+ * Record the metadata of the given handle in the cache of its context ( and in any shared cache )
+ * NOTE -- only metadata agreed upon by every block is recorded locally
+ * @param ne_handle handle : Handle with fully populated meta_info values
+ */
+static void store_cached_meta(ne_handle handle)
+{
+   share_handle_meta(handle);
+   ne_ctxt ctxt = handle->ctxt;
+   if (ctxt->mcache_max == 0 || handle->totsz == 0)
+   {
+      return;
+   }
+   int i;
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      if (handle->thread_states[i].meta_error)
+      {
+         return;
+      }
+   }
+   meta_cache_entry *entry = calloc(1, sizeof(struct meta_cache_entry_struct));
+   if (entry == NULL)
+   {
+      LOG(LOG_WARNING, "Failed to allocate space for a meta_cache_entry struct\n");
+      return;
+   }
+   entry->objID = strdup(handle->objID);
+   entry->crcsums = calloc(handle->epat.N + handle->epat.E, sizeof(long long));
+   if (entry->objID == NULL || entry->crcsums == NULL)
+   {
+      LOG(LOG_WARNING, "Failed to allocate space for meta_cache_entry values\n");
+      free_meta_cache_entry(entry);
+      return;
+   }
+   entry->loc = handle->loc;
+   entry->minfo = handle->thread_states[0].minfo;
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      entry->crcsums[i] = handle->thread_states[i].minfo.crcsum;
+   }
+   clock_gettime(CLOCK_MONOTONIC, &(entry->stored));
+
+   // replace any previous entry, then insert ours as most recently used
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   meta_cache_entry **ref = find_cached_meta(ctxt, entry->objID, entry->loc);
+   meta_cache_entry *prev = *ref;
+   if (prev)
+   {
+      *ref = prev->next;
+      ctxt->mcache_cnt--;
+   }
+   entry->next = ctxt->mcache;
+   ctxt->mcache = entry;
+   ctxt->mcache_cnt++;
+   trim_cached_meta(ctxt, ctxt->mcache_max);
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   if (prev)
+   {
+      free_meta_cache_entry(prev);
+   }
+}
+
+/**
+ * Verify cached metadata of the given read handle against the metadata of one of its blocks
+ * NOTE -- this still spares the handle from fetching the metadata of every block, while catching cached values 
+ *         left stale by some change to the object which this context was not aware of
+ * @param ne_handle handle : Handle to be populated ( prior to starting any threads )
+ * @param meta_info* cached : Cached consensus values of the object
+ * @param long long* crcsums : Cached CRC sum of each block, in handle order
+ * @return int : Zero if a block confirmed the cached values, -1 if not
+ */
+static int verify_cached_meta(ne_handle handle, meta_info *cached, long long *crcsums)
+{
+   DAL dal = handle->ctxt->dal;
+   int i;
+   // any one block may be unavailable, so try each in turn until one can be read
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      BLOCK_CTXT block = dal->open(dal->ctxt, DAL_METAREAD, handle->thread_states[i].location, handle->objID);
+      if (block == NULL)
+      {
+         continue;
+      }
+      meta_info minfo;
+      int ret = dal_get_minfo(dal, block, &minfo);
+      dal->close(block);
+      if (ret)
+      {
+         continue;
+      }
+      if (minfo.N != cached->N || minfo.E != cached->E || minfo.O != cached->O ||
+          minfo.partsz != cached->partsz || minfo.versz != cached->versz || minfo.blocksz != cached->blocksz ||
+          minfo.totsz != cached->totsz || minfo.crcsum != crcsums[i])
+      {
+         LOG(LOG_INFO, "Cached metadata of object \"%s\" disagrees with block %d\n", handle->objID,
+             handle->thread_states[i].location.block);
+         return -1;
+      }
+      return 0;
+   }
+   LOG(LOG_INFO, "No block of object \"%s\" could confirm its cached metadata\n", handle->objID);
+   return -1;
+}
+
+/**
+ * Populate the meta_info values of the given read handle from the shared metadata cache of its context
+ * @param ne_handle handle : Handle to be populated ( prior to starting any threads )
+ * @return int : One if shared values were applied, zero if not
+ */
+static int seed_shared_meta(ne_handle handle)
+{
+   shm_cache_slot slot;
+   if (!read_shared_meta(handle->ctxt, handle->objID, handle->loc, &slot))
+   {
+      return 0;
+   }
+   // the CRC sums of blocks with bad metadata are unknown
+   if (slot.N != handle->epat.N || slot.E != handle->epat.E || slot.O != handle->epat.O ||
+       slot.partsz != handle->epat.partsz || slot.meta_errs || slot.totsz <= 0)
+   {
+      return 0;
+   }
+   meta_info cached = {.N = slot.N, .E = slot.E, .O = slot.O, .partsz = slot.partsz,
+                       .versz = slot.versz, .blocksz = slot.blocksz, .crcsum = 0, .totsz = slot.totsz};
+   long long crcsums[SHM_CACHE_BLOCKS];
+   int i;
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      crcsums[i] = slot.crcsums[i];
+   }
+   if (verify_cached_meta(handle, &cached, crcsums))
+   {
+      write_shared_meta(handle->ctxt, handle->objID, handle->loc, NULL);
+      return 0;
+   }
+   handle->versz = slot.versz;
+   handle->blocksz = slot.blocksz;
+   handle->totsz = slot.totsz;
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      handle->thread_states[i].minfo.versz = slot.versz;
+      handle->thread_states[i].minfo.blocksz = slot.blocksz;
+      handle->thread_states[i].minfo.totsz = slot.totsz;
+      handle->thread_states[i].minfo.crcsum = slot.crcsums[i];
+   }
+   LOG(LOG_INFO, "Using shared metadata of object \"%s\"\n", handle->objID);
+   return 1;
+}
+
+/**
+ * Populate the meta_info values of the given read handle from the cache of its context
+ * @param ne_handle handle : Handle to be populated ( prior to starting any threads )
+ * @return int : One if cached values were applied, zero if not
+ */
+static int seed_cached_meta(ne_handle handle)
+{
+   ne_ctxt ctxt = handle->ctxt;
+   if (ctxt->mcache_max == 0)
+   {
+      return seed_shared_meta(handle);
+   }
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   meta_cache_entry **ref = find_cached_meta(ctxt, handle->objID, handle->loc);
+   meta_cache_entry *entry = *ref;
+   if (entry == NULL)
+   {
+      pthread_mutex_unlock(&ctxt->tbl_lock);
+      return seed_shared_meta(handle);
+   }
+   *ref = entry->next;
+   if (ctxt->mcache_msec)
+   {
+      struct timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      long long age = ((long long)(now.tv_sec - entry->stored.tv_sec) * 1000) + ((now.tv_nsec - entry->stored.tv_nsec) / 1000000);
+      if (age >= ctxt->mcache_msec)
+      {
+         LOG(LOG_INFO, "Discarding expired metadata of object \"%s\"\n", entry->objID);
+         ctxt->mcache_cnt--;
+         pthread_mutex_unlock(&ctxt->tbl_lock);
+         free_meta_cache_entry(entry);
+         return seed_shared_meta(handle);
+      }
+   }
+   // move the entry to the front
+   entry->next = ctxt->mcache;
+   ctxt->mcache = entry;
+   meta_info minfo = entry->minfo;
+   if (minfo.N != handle->epat.N || minfo.E != handle->epat.E ||
+       minfo.O != handle->epat.O || minfo.partsz != handle->epat.partsz)
+   {
+      // leave it to the handle to report the disagreement
+      pthread_mutex_unlock(&ctxt->tbl_lock);
+      return 0;
+   }
+   long long *crcsums = malloc(sizeof(long long) * (handle->epat.N + handle->epat.E));
+   if (crcsums == NULL)
+   {
+      LOG(LOG_WARNING, "Failed to allocate space for cached CRC sums\n");
+      pthread_mutex_unlock(&ctxt->tbl_lock);
+      return 0;
+   }
+   memcpy(crcsums, entry->crcsums, sizeof(long long) * (handle->epat.N + handle->epat.E));
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   // the entry may be stale, if the object was altered by some other context
+   if (verify_cached_meta(handle, &minfo, crcsums))
+   {
+      free(crcsums);
+      drop_cached_meta(ctxt, handle->objID, handle->loc);
+      return 0;
+   }
+   handle->versz = minfo.versz;
+   handle->blocksz = minfo.blocksz;
+   handle->totsz = minfo.totsz;
+   int i;
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      handle->thread_states[i].minfo.versz = minfo.versz;
+      handle->thread_states[i].minfo.blocksz = minfo.blocksz;
+      handle->thread_states[i].minfo.totsz = minfo.totsz;
+      handle->thread_states[i].minfo.crcsum = crcsums[i];
+   }
+   free(crcsums);
+   LOG(LOG_INFO, "Using cached metadata of object \"%s\"\n", handle->objID);
+   return 1;
+}
+
+/**
+ * Free a pread_state struct, closing all of its block references
+ * @param ne_handle handle : Handle the state belongs to
+ * @param pread_state pstate : State to be freed
+ */
+static void free_pread_state(ne_handle handle, pread_state pstate)
+{
+   int i;
+   for (i = 0; i < (handle->epat.N + handle->epat.E); i++)
+   {
+      if (pstate->blocks[i] && handle->ctxt->dal->close(pstate->blocks[i]))
+      {
+         LOG(LOG_WARNING, "Failed to close positional read reference for block %d\n", i);
+      }
+   }
+   free(pstate->refs);
+   free(pstate->err_list);
+   free(pstate->in_err);
+   free(pstate->buff);
+   free(pstate->blocks);
+   free(pstate);
+}
+
+/**
+ * Allocate a new ne_handle structure
+ * @param int max_block : Maximum block value
+ * @return ne_handle : Allocated handle or NULL
+ */
+ne_handle allocate_handle(ne_ctxt ctxt, const char *objID, ne_location loc, meta_info *consensus)
+{
+   // create the handle structure itself
+   ne_handle handle = calloc(1, sizeof(struct ne_handle_struct));
+   if (handle == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a ne_handle structure!\n");
+      return NULL;
+   }
+
+   // set erasure struct info
+   handle->epat.N = consensus->N;
+   handle->epat.E = consensus->E;
+   handle->epat.O = consensus->O;
+   handle->epat.partsz = consensus->partsz;
+   //   handle->epat.crcs = 0;
+   //   if ( consensus->versz > 0 ) { handle->epat.crcs = 1; }
+
+   // set data info values
+   handle->versz = consensus->versz;
+   handle->blocksz = consensus->blocksz;
+   handle->totsz = consensus->totsz;
+
+   // set some additional handle info
+   handle->ctxt = ctxt;
+   handle->objID = strdup(objID);
+   handle->loc.pod = loc.pod;
+   handle->loc.cap = loc.cap;
+   handle->loc.scatter = loc.scatter;
+
+   // allocate context elements
+   int num_blocks = consensus->N + consensus->E;
+   //   handle->meta_status = calloc( num_blocks, sizeof(char) );
+   //   if ( handle->meta_status == NULL ) {
+   //      LOG( LOG_ERR, "Failed to allocate space for a meta_status array!\n" );
+   //      free( handle );
+   //      return NULL;
+   //   }
+   //   handle->data_status = calloc( num_blocks, sizeof(char) );
+   //   if ( handle->data_status == NULL ) {
+   //      LOG( LOG_ERR, "Failed to allocate space for a data_status array!\n" );
+   //      free( handle.state.meta_status );
+   //      free( handle );
+   //      return NULL;
+   //   }
+   handle->iob = calloc(num_blocks, sizeof(ioblock *));
+   if (handle->iob == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for ioblock references!\n");
+      free(handle->objID);
+      free(handle);
+      return NULL;
+   }
+   handle->thread_queues = calloc(num_blocks, sizeof(ThreadQueue));
+   if (handle->thread_queues == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for thread_queues!\n");
+      free(handle->iob);
+      free(handle->objID);
+      free(handle);
+      return NULL;
+   }
+   handle->thread_states = calloc(num_blocks, sizeof(struct global_state_struct));
+   if (handle->thread_states == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for global thread state structs!\n");
+      free(handle->thread_queues);
+      free(handle->iob);
+      free(handle->objID);
+      free(handle);
+      return NULL;
+   }
+   handle->prev_in_err = calloc(num_blocks, sizeof(char));
+   if (handle->prev_in_err == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a prev_error array!\n");
+      free(handle->thread_states);
+      free(handle->thread_queues);
+      free(handle->iob);
+      free(handle->objID);
+      free(handle);
+      return NULL;
+   }
+
+   int i;
+   for (i = 0; i < num_blocks; i++)
+   {
+      // assign values to thread states
+      // object attributes
+      handle->thread_states[i].objID = handle->objID;
+      handle->thread_states[i].location.pod = loc.pod;
+      handle->thread_states[i].location.block = (i + consensus->O) % num_blocks;
+      handle->thread_states[i].location.cap = loc.cap;
+      handle->thread_states[i].location.scatter = loc.scatter;
+      handle->thread_states[i].dal = ctxt->dal;
+      handle->thread_states[i].offset = 0;
+      // meta info values
+      handle->thread_states[i].minfo.N = consensus->N;
+      handle->thread_states[i].minfo.E = consensus->E;
+      handle->thread_states[i].minfo.O = consensus->O;
+      handle->thread_states[i].minfo.partsz = consensus->partsz;
+      handle->thread_states[i].minfo.versz = consensus->versz;
+      handle->thread_states[i].minfo.blocksz = consensus->blocksz;
+      handle->thread_states[i].minfo.crcsum = 0;
+      handle->thread_states[i].minfo.totsz = consensus->totsz;
+      handle->thread_states[i].meta_error = 0;
+      handle->thread_states[i].data_error = 0;
+      //      size_t iosz = consensus->versz;
+      //      if ( iosz <= 0 ) { iosz = handle->dal->io_size; }
+      //      handle->thread_states[i].ioq = create_ioqueue( iosz, consensus->partsz, mode );
+      //      if ( handle->thread_states[i].ioq == NULL ) {
+      //         LOG( LOG_ERR, "Failed to create an ioqueue for block %d!\n", i );
+      //         for ( i -= 1; i >= 0; i-- ) {
+      //            destroy_ioqueue( handle->thread_states[i].ioq );
+      //         }
+      //         free( handle->thread_states );
+      //         free( handle->thread_queues );
+      //         free( handle->iob );
+      //         free( handle.state.data_status );
+      //         free( handle.state.meta_status );
+      //         free( handle );
+      //         return NULL;
+      //      }
+   }
+
+   if (pthread_mutex_init(&handle->pread_lock, NULL))
+   {
+      LOG(LOG_ERR, "Failed to initialize positional read lock!\n");
+      free(handle->prev_in_err);
+      free(handle->thread_states);
+      free(handle->thread_queues);
+      free(handle->iob);
+      free(handle->objID);
+      free(handle);
+      return NULL;
+   }
+
+   // indicate that handle is ready for conversion
+   handle->mode = NE_STAT;
+
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   ctxt->handles++;
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   return handle;
+}
+
+/**
+ * Free an allocated ne_handle structure
+ * @param ne_handle handle : Handle to free
+ */
+void free_handle(ne_handle handle)
+{
+   //   int i;
+   //   for ( i = 0; i < handle->epat.N + handle->epat.E; i++ ) {
+   //      destroy_ioqueue( handle->thread_states[i].ioq );
+   //   }
+   release_decode_plan(handle->ctxt, handle->dplan);
+   release_encode_tables(handle->ctxt, handle->etbls);
+   if (handle->hedge_iob)
+   {
+      int i;
+      for (i = 0; i < handle->epat.N; i++)
+      {
+         if (handle->hedge_iob[i])
+         {
+            free(handle->hedge_iob[i]->buff);
+            free(handle->hedge_iob[i]);
+         }
+      }
+      free(handle->hedge_iob);
+   }
+   free(handle->hedge_owed);
+   while (handle->pread_idle)
+   {
+      pread_state pstate = handle->pread_idle;
+      handle->pread_idle = pstate->next;
+      free_pread_state(handle, pstate);
+   }
+   free(handle->pread_bad);
+   pthread_mutex_destroy(&handle->pread_lock);
+   if (handle->tq_group)
+   {
+      tq_group_term(handle->tq_group);
+   }
+   free(handle->tq_pending);
+   free(handle->prev_in_err);
+   free(handle->thread_states);
+   free(handle->thread_queues);
+   free(handle->iob);
+   free(handle->objID);
+   pthread_mutex_lock(&handle->ctxt->tbl_lock);
+   handle->ctxt->handles--;
+   pthread_mutex_unlock(&handle->ctxt->tbl_lock);
+   free(handle);
+}
+
+/**
+ * This helper function is intended to identify the most common sensible values amongst all meta_buffers
+ * for a given number of read threads and return them in a provided read_meta_buffer struct.
+ * If two numbers have the same number of instances, preference will be given to the first number ( the
+ * one with a lower block number ).
+ * @param BufferQueue blocks[ MAXPARTS ] : Array of buffer queues for all threads
+ * @param int num_threads : Number of threads with meta_info ready
+ * @param read_meta_buffer ret_buf : Buffer to be populated with return values
+ * @return int : Lesser of the counts of matching N/E values
+ */
+int check_matches(meta_info **minfo_structs, int num_blocks, int max_blocks, meta_info *ret_buf)
+{
+   // allocate space for ALL match arrays ( at least one, zeroed, count for each, should no block have meta info )
+   int *N_match = calloc(7, sizeof(int) * ((num_blocks > 0) ? num_blocks : 1));
+   if (N_match == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for match count arrays!\n");
+      return -1;
+   }
+   int *E_match = (N_match + num_blocks);
+   int *O_match = (E_match + num_blocks);
+   int *partsz_match = (O_match + num_blocks);
+   int *versz_match = (partsz_match + num_blocks);
+   int *blocksz_match = (versz_match + num_blocks);
+   int *totsz_match = (blocksz_match + num_blocks);
+
+   int i;
+   for (i = 0; i < num_blocks; i++)
+   {
+      int j;
+      meta_info *minfo = minfo_structs[i];
+// this macro is intended to produce counts of matching values at the index of their first appearance
+#define COUNT_MATCH_AT_INDEX(VAL, MATCH_LIST, MIN_VAL, MAX_VAL) \
+   if (minfo->VAL >= MIN_VAL && minfo->VAL <= MAX_VAL)          \
+   {                                                            \
+      for (j = 0; j < i; j++)                                   \
+      {                                                         \
+         if (minfo_structs[j]->VAL == minfo->VAL)               \
+         {                                                      \
+            break;                                              \
+         }                                                      \
+      }                                                         \
+      MATCH_LIST[j]++;                                          \
+   }
+      COUNT_MATCH_AT_INDEX(N, N_match, 1, max_blocks)
+      COUNT_MATCH_AT_INDEX(E, E_match, 0, max_blocks - 1)
+      COUNT_MATCH_AT_INDEX(O, O_match, 0, max_blocks - 1)
+      COUNT_MATCH_AT_INDEX(partsz, partsz_match, 1, minfo->partsz)    // no maximum
+      COUNT_MATCH_AT_INDEX(versz, versz_match, 0, minfo->versz)       // no maximum
+      COUNT_MATCH_AT_INDEX(blocksz, blocksz_match, 0, minfo->blocksz) // no maximum
+      COUNT_MATCH_AT_INDEX(totsz, totsz_match, 0, minfo->totsz)       //no maximum
+   }
+
+   // find the value with the most matches
+   int N_index = 0;
+   int E_index = 0;
+   int O_index = 0;
+   int partsz_index = 0;
+   int versz_index = 0;
+   int blocksz_index = 0;
+   int totsz_index = 0;
+   for (i = 1; i < num_blocks; i++)
+   {
+      // For N/E: if two values are tied for matches, prefer the larger value (helps to avoid taking values from a single bad meta info)
+      if (N_match[i] > N_match[N_index] ||
+          (N_match[i] == N_match[N_index] &&
+           minfo_structs[i]->N > minfo_structs[N_index]->N))
+         N_index = i;
+      if (E_match[i] > E_match[E_index] ||
+          (E_match[i] == E_match[E_index] &&
+           minfo_structs[i]->E > minfo_structs[E_index]->E))
+         E_index = i;
+      // For other values: if two values are tied for matches, prefer the first
+      if (O_match[i] > O_match[O_index])
+         O_index = i;
+      if (partsz_match[i] > partsz_match[partsz_index])
+         partsz_index = i;
+      if (versz_match[i] > versz_match[versz_index])
+         versz_index = i;
+      if (blocksz_match[i] > blocksz_match[blocksz_index])
+         blocksz_index = i;
+      // For Totsz : if two values are tied for matches, prefer the smaller value (helps to avoid returning zero-fill as 'data')
+      if (totsz_match[i] > totsz_match[totsz_index] ||
+          (totsz_match[i] == totsz_match[totsz_index] &&
+           minfo_structs[i]->totsz < minfo_structs[totsz_index]->totsz))
+         totsz_index = i;
+   }
+
+   // assign appropriate values to our output struct
+   // Note: we have to do a sanity check on the match count, to make sure
+   // we don't return an out-of-bounds value.
+   if (N_match[N_index])
+      ret_buf->N = minfo_structs[N_index]->N;
+   else
+      ret_buf->N = 0;
+
+   if (E_match[E_index])
+      ret_buf->E = minfo_structs[E_index]->E;
+   else
+      ret_buf->E = -1;
+
+   if (O_match[O_index])
+      ret_buf->O = minfo_structs[O_index]->O;
+   else
+      ret_buf->O = -1;
+
+   if (partsz_match[partsz_index])
+      ret_buf->partsz = minfo_structs[partsz_index]->partsz;
+   else
+      ret_buf->partsz = 0;
+
+   if (versz_match[versz_index])
+      ret_buf->versz = minfo_structs[versz_index]->versz;
+   else
+      ret_buf->versz = -1;
+
+   if (blocksz_match[blocksz_index])
+      ret_buf->blocksz = minfo_structs[blocksz_index]->blocksz;
+   else
+      ret_buf->blocksz = -1;
+
+   if (totsz_match[totsz_index])
+      ret_buf->totsz = minfo_structs[totsz_index]->totsz;
+   else
+      ret_buf->totsz = -1;
+
+   int retval = (N_match[N_index] > E_match[E_index]) ? E_match[E_index] : N_match[N_index];
+   free(N_match);
+   return retval;
+}
+
+/**
+ * Attach the shared erasure encoding structs of the handle's context to the given handle (if not already done)
+ * @param ne_handle handle : Handle to initialize encoding tables for
+ * @return int : Zero on success, -1 on failure
+ */
+static int init_encode_tables(ne_handle handle)
+{
+   if (handle->etbls == NULL)
+   {
+      handle->etbls = get_encode_tables(handle->ctxt, handle->epat.N, handle->epat.E);
+      if (handle->etbls == NULL)
+      {
+         LOG(LOG_ERR, "Failed to acquire encoding tables for N=%d/E=%d\n", handle->epat.N, handle->epat.E);
+         return -1;
+      }
+   }
+   return 0;
+}
+
+/**
+ * Determine the number of complete stripes which can still be stored in the current ioblocks of a write handle
+ * NOTE -- this assumes the handle is stripe-aligned, meaning all blocks have identical ioblock fill levels
+ * @param ne_handle handle : Handle to check
+ * @return int : Number of stripes which may be written to the current ioblocks
+ */
+static int stripe_write_space(ne_handle handle)
+{
+   ioqueue *ioq = handle->thread_states[0].ioq;
+   size_t fill = ioblock_get_fill(handle->iob[0]);
+   if (fill >= ioq->split_threshold)
+   {
+      return 0;
+   }
+   // a part can always be started below the split_threshold, as the ioblock has room for the overflow
+   return (int)(((ioq->split_threshold - fill) + (handle->epat.partsz - 1)) / handle->epat.partsz);
+}
+
+/**
+ * Generate erasure for all stripes which have been completed, but not yet encoded, in the current ioblocks of a write handle
+ * NOTE -- this must be called on a stripe-aligned handle, prior to pushing any ioblocks containing those stripes
+ * @param ne_handle handle : Handle to generate erasure for
+ * @return int : Zero on success, -1 on failure
+ */
+static int encode_pending_stripes(ne_handle handle)
+{
+   if (handle->e_pending == 0)
+   {
+      return 0;
+   }
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t pendsz = handle->e_pending * handle->epat.partsz;
+   // allocate space for our buffer references
+   unsigned char **tgt_refs = calloc(N + E, sizeof(char *));
+   if (tgt_refs == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a target buffer array!\n");
+      return -1;
+   }
+   // pending stripes always make up the tail of each ioblock
+   int block;
+   for (block = 0; block < (N + E); block++)
+   {
+      tgt_refs[block] = ioblock_write_target(handle->iob[block]) - pendsz;
+   }
+   LOG(LOG_INFO, "Generating erasure parts for %d stripes\n", handle->e_pending);
+   // stripe parts are contiguous within each ioblock, so all pending stripes can be encoded at once
+   if (init_encode_tables(handle))
+   {
+      free(tgt_refs);
+      return -1;
+   }
+   ec_encode_data(pendsz, N, E, handle->etbls->g_tbls, tgt_refs, &(tgt_refs[N]));
+   free(tgt_refs);
+   handle->e_pending = 0;
+   return 0;
+}
+
+/**
+ * Push all staged parity ioblocks to their threads
+ * NOTE -- the caller must hold the encode_state lock
+ * @param encode_state estate : Encoding pool state to push ioblocks for
+ */
+static void push_staged_parity(encode_state estate)
+{
+   int i;
+   for (i = 0; i < estate->E; i++)
+   {
+      if (estate->staged[i])
+      {
+         LOG(LOG_INFO, "Pushing encoded parity ioblock to thread %d\n", estate->N + i);
+         if (tq_enqueue(estate->parity_queues[i], TQ_NONE, (void *)estate->staged[i]))
+         {
+            LOG(LOG_ERR, "Failed to push ioblock to thread_queue %d\n", estate->N + i);
+            estate->error = 1;
+         }
+         estate->staged[i] = NULL;
+      }
+   }
+}
+
+/**
+ * Generate erasure for a single slice of a batch of stripes, pushing any staged parity ioblocks if this
+ * completes the batch
+ * @param encode_state estate : Encoding pool state the slice belongs to
+ * @param encode_work* work : Slice to be encoded ( freed by this function )
+ */
+static void encode_slice(encode_state estate, encode_work *work)
+{
+   if (work->g_tbls)
+   {
+      ec_encode_data(work->len, estate->N, work->nout, work->g_tbls, work->refs, &(work->refs[estate->N]));
+   }
+   else
+   {
+      // interleave the parts of each source block into the stripes of the output buffer
+      size_t stripesz = estate->partsz * estate->N;
+      size_t off;
+      for (off = 0; off < work->len; off += estate->partsz)
+      {
+         unsigned char *tgt = work->refs[estate->N] + ((off / estate->partsz) * stripesz);
+         int block;
+         for (block = 0; block < estate->N; block++)
+         {
+            memcpy(tgt + (block * estate->partsz), work->refs[block] + off, estate->partsz);
+         }
+      }
+   }
+   free(work);
+   pthread_mutex_lock(&estate->lock);
+   estate->slices--;
+   if (estate->slices == 0)
+   {
+      push_staged_parity(estate);
+      pthread_cond_broadcast(&estate->complete);
+   }
+   pthread_mutex_unlock(&estate->lock);
+}
+
+/**
+ * Initialize an encoding thread ( all threads simply share the global encode_state )
+ * @param unsigned int tID : The ID of this thread
+ * @param void* global_state : Reference to the encode_state of the write handle
+ * @param void** state : Reference to be populated with this thread's state info
+ * @return int : Zero on success
+ */
+static int encode_init(unsigned int tID, void *global_state, void **state)
+{
+   *state = global_state;
+   return 0;
+}
+
+/**
+ * Encode a slice of stripes
+ * @param void** state : Thread state reference
+ * @param void** work_todo : Reference to the encode_work package
+ * @return int : Zero on success
+ */
+static int encode_consume(void **state, void **work_todo)
+{
+   encode_slice((encode_state)(*state), (encode_work *)(*work_todo));
+   *work_todo = NULL;
+   return 0;
+}
+
+/**
+ * Free any unprocessed encode_work package
+ * @param void** state : Thread state reference
+ * @param void** prev_work : Reference to any unprocessed work package
+ */
+static void encode_term(void **state, void **prev_work)
+{
+   if (*prev_work)
+   {
+      free(*prev_work);
+   }
+}
+
+/**
+ * Startup an erasure encoding pool for the given write handle
+ * @param ne_handle handle : Handle to create the pool for
+ * @param int threads : Number of encoding threads to start
+ * @return int : Zero on success, -1 on failure
+ */
+static int start_encode_pool(ne_handle handle, int threads)
+{
+   // encoding threads reference the shared tables directly
+   if (init_encode_tables(handle))
+   {
+      return -1;
+   }
+   encode_state estate = calloc(1, sizeof(struct encode_state_struct));
+   if (estate == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for an encode_state struct!\n");
+      return -1;
+   }
+   estate->staged = calloc(handle->epat.E, sizeof(ioblock *));
+   if (estate->staged == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for staged ioblock references!\n");
+      free(estate);
+      return -1;
+   }
+   if (pthread_mutex_init(&estate->lock, NULL))
+   {
+      LOG(LOG_ERR, "Failed to initialize encode_state lock!\n");
+      free(estate->staged);
+      free(estate);
+      return -1;
+   }
+   if (pthread_cond_init(&estate->complete, NULL))
+   {
+      LOG(LOG_ERR, "Failed to initialize encode_state condition!\n");
+      pthread_mutex_destroy(&estate->lock);
+      free(estate->staged);
+      free(estate);
+      return -1;
+   }
+   estate->parity_queues = &(handle->thread_queues[handle->epat.N]);
+   estate->threads = threads;
+   estate->N = handle->epat.N;
+   estate->E = handle->epat.E;
+   estate->partsz = handle->epat.partsz;
+
+   TQ_Init_Opts tqopts;
+   tqopts.log_prefix = "EQ";
+   tqopts.init_flags = TQ_NONE;
+   tqopts.max_qdepth = threads;
+   tqopts.global_state = estate;
+   tqopts.num_threads = threads;
+   tqopts.num_prod_threads = 0;
+   tqopts.pool = NULL; // erasure threads compute rather than wait on I/O, so are never pooled
+   tqopts.spsc = 0;    // multiple consumers
+   tqopts.thread_init_func = encode_init;
+   tqopts.thread_consumer_func = encode_consume;
+   tqopts.thread_producer_func = NULL;
+   tqopts.thread_pause_func = NULL;
+   tqopts.thread_resume_func = NULL;
+   tqopts.thread_term_func = encode_term;
+   handle->encode_queue = tq_init(&tqopts);
+   if (handle->encode_queue == NULL)
+   {
+      LOG(LOG_ERR, "Failed to create encoding thread_queue!\n");
+      pthread_cond_destroy(&estate->complete);
+      pthread_mutex_destroy(&estate->lock);
+      free(estate->staged);
+      free(estate);
+      return -1;
+   }
+   handle->estate = estate;
+   return 0;
+}
+
+/**
+ * Terminate the erasure encoding pool of the given write handle ( if any )
+ * NOTE -- all encoding work must have been completed prior to this call
+ * @param ne_handle handle : Handle to terminate the pool of
+ * @return int : Zero on success, -1 on failure
+ */
+static int stop_encode_pool(ne_handle handle)
+{
+   encode_state estate = handle->estate;
+   if (estate == NULL)
+   {
+      return 0;
+   }
+   int ret_val = 0;
+   if (tq_set_flags(handle->encode_queue, TQ_FINISHED))
+   {
+      LOG(LOG_ERR, "Failed to set a FINISHED state for the encoding thread_queue!\n");
+      tq_set_flags(handle->encode_queue, TQ_ABORT);
+      ret_val = -1;
+   }
+   while (tq_next_thread_status(handle->encode_queue, NULL) > 0)
+   {
+   }
+   tq_close(handle->encode_queue);
+   handle->encode_queue = NULL;
+   if (estate->error)
+   {
+      ret_val = -1;
+   }
+   pthread_cond_destroy(&estate->complete);
+   pthread_mutex_destroy(&estate->lock);
+   free(estate->staged);
+   free(estate);
+   handle->estate = NULL;
+   return ret_val;
+}
+
+/**
+ * Wait for all stripes handed off to the encoding pool of a write handle ( if any ) to be encoded
+ * @param ne_handle handle : Handle to wait on
+ * @return int : Zero on success, -1 if any encoded ioblock could not be pushed
+ */
+static int wait_for_encode(ne_handle handle)
+{
+   encode_state estate = handle->estate;
+   if (estate == NULL)
+   {
+      return 0;
+   }
+   pthread_mutex_lock(&estate->lock);
+   while (estate->slices)
+   {
+      pthread_cond_wait(&estate->complete, &estate->lock);
+   }
+   char error = estate->error;
+   pthread_mutex_unlock(&estate->lock);
+   if (error)
+   {
+      LOG(LOG_ERR, "Detected a failure to push encoded ioblocks!\n");
+      return -1;
+   }
+   return 0;
+}
+
+/**
+ * Split a range of erasure work into roughly one slice per thread, and hand those off to the erasure pool of the given handle
+ * NOTE -- the caller must wait_for_encode() before reusing any of the referenced buffers
+ * @param ne_handle handle : Handle whose pool should process the work
+ * @param size_t len : Length of the range of each referenced block
+ * @param unsigned char* g_tbls : Tables to be applied to the N source references ( NULL to copy out stripes )
+ * @param int nout : Number of output references
+ * @param unsigned char** refs : N source references, followed by nout output references
+ * @return int : Zero on success, -1 on failure
+ */
+static int dispatch_erasure(ne_handle handle, size_t len, unsigned char *g_tbls, int nout, unsigned char **refs)
+{
+   encode_state estate = handle->estate;
+   int N = handle->epat.N;
+   size_t partsz = handle->epat.partsz;
+   size_t slicesz = ((len / estate->threads) + 63) & ~((size_t)63);
+   if (slicesz < ENCODE_SLICE_MIN)
+   {
+      slicesz = ENCODE_SLICE_MIN;
+   }
+   if (g_tbls == NULL)
+   {
+      // copies must operate on complete parts
+      slicesz = ((slicesz + (partsz - 1)) / partsz) * partsz;
+   }
+   int slicecnt = (int)((len + (slicesz - 1)) / slicesz);
+   encode_work **work = calloc(slicecnt, sizeof(encode_work *));
+   if (work == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for encode_work references!\n");
+      return -1;
+   }
+   int slice;
+   for (slice = 0; slice < slicecnt; slice++)
+   {
+      work[slice] = malloc(sizeof(encode_work) + ((N + nout) * sizeof(unsigned char *)));
+      if (work[slice] == NULL)
+      {
+         LOG(LOG_ERR, "Failed to allocate space for encode_work %d!\n", slice);
+         for (slice -= 1; slice >= 0; slice--)
+         {
+            free(work[slice]);
+         }
+         free(work);
+         return -1;
+      }
+      size_t offset = slice * slicesz;
+      work[slice]->estate = estate;
+      work[slice]->len = ((len - offset) < slicesz) ? (len - offset) : slicesz;
+      work[slice]->g_tbls = g_tbls;
+      work[slice]->nout = nout;
+      int ref;
+      for (ref = 0; ref < N; ref++)
+      {
+         work[slice]->refs[ref] = refs[ref] + offset;
+      }
+      for (; ref < (N + nout); ref++)
+      {
+         // copies write out complete stripes
+         work[slice]->refs[ref] = refs[ref] + ((g_tbls) ? offset : (offset / partsz) * (partsz * N));
+      }
+   }
+   LOG(LOG_INFO, "Handing off %zu bytes per block to the erasure pool as %d slices\n", len, slicecnt);
+   pthread_mutex_lock(&estate->lock);
+   estate->slices += slicecnt;
+   pthread_mutex_unlock(&estate->lock);
+   for (slice = 0; slice < slicecnt; slice++)
+   {
+      if (tq_enqueue(handle->encode_queue, TQ_NONE, (void *)work[slice]))
+      {
+         LOG(LOG_WARNING, "Failed to enqueue encode_work %d, processing it inline\n", slice);
+         encode_slice(estate, work[slice]);
+      }
+   }
+   free(work);
+   return 0;
+}
+
+/**
+ * Generate erasure for all pending stripes of a write handle, handing the work off to the encoding pool if one exists
+ * NOTE -- this must be called on a stripe-aligned handle, prior to pushing any ioblocks containing those stripes;
+ *         when a pool exists, parity ioblocks must then be pushed via push_ioblock()
+ * @param ne_handle handle : Handle to generate erasure for
+ * @return int : Zero on success, -1 on failure
+ */
+static int dispatch_pending_stripes(ne_handle handle)
+{
+   encode_state estate = handle->estate;
+   if (estate == NULL)
+   {
+      return encode_pending_stripes(handle);
+   }
+   // the previous batch must complete before any of its ioblocks can be reused
+   if (wait_for_encode(handle))
+   {
+      return -1;
+   }
+   int stripes = handle->e_pending;
+   if (stripes == 0)
+   {
+      return 0;
+   }
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t partsz = handle->epat.partsz;
+   // the overflow of a stripe crossing the split_threshold is copied to the next ioblock as soon as
+   // the current one is pushed, so that stripe must be encoded immediately
+   size_t tail = 0;
+   if (ioblock_get_fill(handle->iob[0]) > handle->thread_states[0].ioq->split_threshold)
+   {
+      handle->e_pending = 1;
+      if (encode_pending_stripes(handle))
+      {
+         return -1;
+      }
+      tail = partsz;
+      stripes--;
+   }
+   handle->e_pending = 0;
+   if (stripes == 0)
+   {
+      return 0;
+   }
+
+   // hand off the remaining stripes to the encoding pool
+   unsigned char **refs = calloc(N + E, sizeof(unsigned char *));
+   if (refs == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a target buffer array!\n");
+      return -1;
+   }
+   size_t len = stripes * partsz;
+   int block;
+   for (block = 0; block < (N + E); block++)
+   {
+      refs[block] = (unsigned char *)ioblock_write_target(handle->iob[block]) - tail - len;
+   }
+   LOG(LOG_INFO, "Handing off %d stripes to the encoding pool\n", stripes);
+   int ret_val = dispatch_erasure(handle, len, handle->etbls->g_tbls, E, refs);
+   free(refs);
+   return ret_val;
+}
+
+/**
+ * Push a full ioblock to the thread of the given block
+ * NOTE -- when an encoding pool is in use, parity ioblocks are held back until their erasure has been generated
+ * @param ne_handle handle : Handle the ioblock belongs to
+ * @param int block : Block index of the ioblock
+ * @param ioblock* push_block : Full ioblock to be pushed
+ * @return int : Zero on success, -1 on failure
+ */
+static int push_ioblock(ne_handle handle, int block, ioblock *push_block)
+{
+   encode_state estate = handle->estate;
+   if (estate == NULL || block < handle->epat.N)
+   {
+      return tq_enqueue(handle->thread_queues[block], TQ_NONE, (void *)push_block);
+   }
+   pthread_mutex_lock(&estate->lock);
+   estate->staged[block - handle->epat.N] = push_block;
+   if (estate->slices == 0)
+   {
+      push_staged_parity(estate);
+   }
+   char error = estate->error;
+   pthread_mutex_unlock(&estate->lock);
+   return (error) ? -1 : 0;
+}
+
+/**
+ * Check that a handle is writable and stripe-aligned, for use with the ne_get_write_buffers()/ne_write_stripes() interface
+ * @param ne_handle handle : Handle to check
+ * @return int : Zero if the handle is usable, -1 if not (with errno set)
+ */
+static int check_stripe_writable(ne_handle handle)
+{
+   if (!(handle))
+   {
+      LOG(LOG_ERR, "Received a NULL handle!\n");
+      errno = EINVAL;
+      return -1;
+   }
+
+   if (handle->mode != NE_WRONLY && handle->mode != NE_WRALL)
+   {
+      LOG(LOG_ERR, "Handle is in improper mode for writing! %d\n", handle->mode);
+      errno = EINVAL;
+      return -1;
+   }
+
+   size_t stripesz = handle->epat.N * handle->epat.partsz;
+   off_t offset = (handle->iob_offset * handle->epat.N) + handle->sub_offset;
+   if (offset % stripesz)
+   {
+      LOG(LOG_ERR, "Handle offset %zd is not aligned to a stripe boundary (stripesz=%zu)!\n", offset, stripesz);
+      errno = EINVAL;
+      return -1;
+   }
+   return 0;
+}
+
+/**
+ * Regenerate erroneous data within a range of stripes of the current ioblocks of a read handle
+ * @param ne_handle handle : Handle to regenerate data for
+ * @param int first_stripe : Index of the first stripe ( within the current ioblocks ) to be regenerated
+ * @param int end_stripe : Index of the stripe following the final stripe to be regenerated
+ * @param char data_only : If non-zero, only data parts will be regenerated ( erasure parts are left as-is )
+ * @return int : Zero on success, -1 on failure, or, if errors exceed erasure limits, the number of stripes
+ *               which could not be regenerated ( errno == ENODATA )
+ */
+static int regenerate_stripes(ne_handle handle, int first_stripe, int end_stripe, char data_only)
+{
+   // get some useful reference values
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   ssize_t partsz = handle->epat.partsz;
+   int stripecnt = (int)(handle->iob_datasz / partsz);
+#ifdef DEBUG
+   unsigned int start_stripe = (unsigned int)(handle->iob_offset / partsz);
+#endif
+   int cur_block;
+   int block_cnt = 0; // only blocks with current ioblocks are considered
+   while (block_cnt < (N + E) && handle->iob[block_cnt] != NULL)
+   {
+      block_cnt++;
+   }
+
+   // create some erasure structs
+   unsigned char *stripe_in_err = calloc(N + E, sizeof(unsigned char));
+   if (stripe_in_err == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a stripe_in_err array!\n");
+      return -1;
+   }
+   unsigned char *stripe_err_list = calloc(N + E, sizeof(unsigned char));
+   if (stripe_err_list == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a stripe_err_list array!\n");
+      free(stripe_in_err);
+      return -1;
+   }
+
+   // loop over each run of stripes sharing an error pattern in reverse order, fixing the ends of the buffers first
+   // NOTE -- reconstructing in reverse allows us to continue using the error_end values appropriately
+   int cur_stripe;
+   int run_start;
+   for (cur_stripe = end_stripe - 1; cur_stripe >= first_stripe; cur_stripe = run_start - 1)
+   {
+
+      // loop over the blocks of the stripe, establishing error counts/positions
+      off_t stripe_start = cur_stripe * partsz;
+      int nstripe_errors = 0;
+      int ndata_errors = 0;
+      run_start = first_stripe;
+      for (cur_block = 0; cur_block < block_cnt; cur_block++)
+      {
+         // reset our error state
+         stripe_err_list[cur_block] = 0; // as cur_block MUST be <= nstripe_errors at this point
+         stripe_in_err[cur_block] = 0;
+
+         // check for bad stripe data in this block
+         if (stripe_start < handle->iob[cur_block]->error_end)
+         {
+            LOG(LOG_WARNING, "Detected bad data for block %d of stripe %d\n", cur_block, cur_stripe + start_stripe);
+            stripe_err_list[nstripe_errors] = cur_block;
+            nstripe_errors++;
+            stripe_in_err[cur_block] = 1;
+            if (cur_block < N)
+            {
+               ndata_errors++;
+            }
+            // we just need to note the error, nothing to be done about it until we have all buffers ready
+         }
+         else
+         {
+            // as errors only extend from the start of each ioblock, the error pattern of this stripe continues
+            // down to the first stripe overlapping the error region of a currently good block
+            int err_bound = (handle->iob[cur_block]->error_end + (partsz - 1)) / partsz;
+            if (err_bound > run_start)
+            {
+               run_start = err_bound;
+            }
+         }
+
+         // check for any change in our error pattern, as that will require reinitializing erasure structs
+         if (handle->prev_in_err[cur_block] != stripe_in_err[cur_block])
+         {
+            handle->e_ready = 0;
+            handle->prev_in_err[cur_block] = stripe_in_err[cur_block];
+         }
+      }
+
+      // this entire run of stripes shares the current error pattern
+      stripe_start = run_start * partsz;
+      size_t run_len = ((cur_stripe - run_start) + 1) * partsz;
+      if (nstripe_errors == 0 || (data_only && ndata_errors == 0))
+      {
+         LOG(LOG_INFO, "No %serrors for stripes %d-%d\n", (data_only) ? "data " : "", run_start + start_stripe, cur_stripe + start_stripe);
+         continue;
+      }
+      // data errors always make up the head of our error list, and thus the initial rows of our decode tables
+      int nregen = (data_only) ? ndata_errors : nstripe_errors;
+
+      if (!(handle->e_ready) || handle->dplan == NULL)
+      {
+         // any runs still being regenerated by our erasure pool reference the current plan
+         wait_for_encode(handle);
+
+         // Reference the shared encoding matrix
+         LOG(LOG_INFO, "Initializing erasure structs...\n");
+         if (init_encode_tables(handle))
+         {
+            free(stripe_in_err);
+            free(stripe_err_list);
+            return -1;
+         }
+         // drop any plan for our previous error pattern, and find/generate one for the current pattern
+         release_decode_plan(handle->ctxt, handle->dplan);
+         handle->dplan = get_decode_plan(handle->ctxt, handle->etbls, stripe_in_err, stripe_err_list, nstripe_errors);
+         if (handle->dplan == NULL)
+         {
+            free(stripe_in_err);
+            free(stripe_err_list);
+            if (errno == ENODATA)
+            {
+               // this is the only error for which we will at least attempt to continue
+               // return the number of stripes we failed to regenerate
+               return cur_stripe + 1;
+            }
+            return -1;
+         }
+
+         handle->e_ready = 1; //indicate that rebuild structures are initialized
+      }
+
+      // as this struct will change depending on the head position of our queues, we must generate here
+      unsigned char **recov = calloc(N + E, sizeof(unsigned char *));
+      if (recov == NULL)
+      {
+         LOG(LOG_ERR, "Failed to allocate space for a recovery array!\n");
+         wait_for_encode(handle);
+         free(stripe_in_err);
+         free(stripe_err_list);
+         return -1;
+      }
+      //unsigned char* recov[ MAXPARTS ];
+      for (cur_block = 0; cur_block < N; cur_block++)
+      {
+         //BufferQueue* bq = &handle->blocks[handle->decode_index[cur_block]];
+         //recov[cur_block] = bq->buffers[ bq->head ];
+         recov[cur_block] = handle->iob[handle->dplan->decode_index[cur_block]]->buff + stripe_start;
+      }
+
+      unsigned char **temp_buffs = calloc(nregen, sizeof(unsigned char *));
+      if (temp_buffs == NULL)
+      {
+         LOG(LOG_ERR, "Failed to allocate space for a temp_buffs array!\n");
+         wait_for_encode(handle);
+         free(recov);
+         free(stripe_in_err);
+         free(stripe_err_list);
+         return -1;
+      }
+      //unsigned char* temp_buffs[ nstripe_errors ];
+      for (cur_block = 0; cur_block < nregen; cur_block++)
+      {
+         //BufferQueue* bq = &handle->blocks[stripe_err_list[ cur_block ]];
+         //temp_buffs[ cur_block ] = bq->buffers[ bq->head ];
+
+         // assign storage locations for the repaired buffers to be on top of the faulty buffers
+         temp_buffs[cur_block] = handle->iob[stripe_err_list[cur_block]]->buff + stripe_start;
+         // as we are regenerating over the bad buffer, mark it as usable from this point on
+         // NOTE -- a partial regeneration may leave bad data beyond this run, so the caller must track it instead
+         if (!(data_only) && end_stripe == stripecnt)
+         {
+            handle->iob[stripe_err_list[cur_block]]->error_end = stripe_start;
+         }
+
+         // as we are regenerating over the bad buffer, mark it as usable for future iterations
+         //*(u32*)( temp_buffs[ cur_block ] + bsz ) = 1;
+      }
+
+      LOG(LOG_INFO, "Performing regeneration of stripes %d-%d from erasure\n", run_start + start_stripe, cur_stripe + start_stripe);
+
+      // stripe parts are contiguous within each ioblock, so the entire run can be regenerated at once
+      // NOTE -- runs never overlap and only read from blocks which are valid across the entire run, so the erasure
+      //         pool may regenerate them concurrently
+      if (handle->estate && run_len >= (2 * ENCODE_SLICE_MIN))
+      {
+         memcpy(&(recov[N]), temp_buffs, nregen * sizeof(unsigned char *));
+         if (dispatch_erasure(handle, run_len, handle->dplan->g_tbls, nregen, recov))
+         {
+            LOG(LOG_WARNING, "Failed to hand off regeneration to the erasure pool, regenerating inline\n");
+            ec_encode_data(run_len, N, nregen, handle->dplan->g_tbls, recov, &temp_buffs[0]);
+         }
+      }
+      else
+      {
+         ec_encode_data(run_len, N, nregen, handle->dplan->g_tbls, recov, &temp_buffs[0]);
+      }
+
+      free(recov);
+      free(temp_buffs);
+   } // end of per-run loop
+
+   // wait for any runs handed off to the erasure pool
+   wait_for_encode(handle);
+
+   // free unneeded lists
+   free(stripe_in_err);
+   free(stripe_err_list);
+
+
+   // note the range of stripes now containing valid data
+   if (data_only)
+   {
+      if (end_stripe >= handle->regen_start && first_stripe <= handle->regen_end && handle->regen_start != handle->regen_end)
+      {
+         // merge with the existing range
+         if (first_stripe < handle->regen_start)
+         {
+            handle->regen_start = first_stripe;
+         }
+         if (end_stripe > handle->regen_end)
+         {
+            handle->regen_end = end_stripe;
+         }
+      }
+      else
+      {
+         handle->regen_start = first_stripe;
+         handle->regen_end = end_stripe;
+      }
+   }
+
+   return 0;
+}
+
+/**
+ * Copy a run of complete stripes of the current ioblocks of a read handle out to the given buffer, via the erasure pool
+ * NOTE -- NE_RDONLY handles will regenerate any missing data of those stripes first
+ * @param ne_handle handle : Handle to copy stripes from
+ * @param void* buffer : Buffer to be populated with the stripe data
+ * @param int first_stripe : Index of the first stripe ( within the current ioblocks ) to be copied
+ * @param int stripes : Number of stripes to be copied
+ * @return int : Zero on success, -1 on failure
+ */
+static int copy_stripes(ne_handle handle, void *buffer, int first_stripe, int stripes)
+{
+   int N = handle->epat.N;
+   ssize_t partsz = handle->epat.partsz;
+   int end_stripe = first_stripe + stripes;
+   // make sure that no data block has errors within these stripes
+   int block;
+   for (block = 0; block < N; block++)
+   {
+      if (handle->iob[block]->error_end > (first_stripe * partsz) &&
+          (first_stripe < handle->regen_start || end_stripe > handle->regen_end))
+      {
+         if (handle->mode != NE_RDONLY)
+         {
+            LOG(LOG_ERR, "Ioblock at position %d has an error within the requested stripes (error_end = %zu)!\n",
+                block, handle->iob[block]->error_end);
+            return -1;
+         }
+         if (regenerate_stripes(handle, first_stripe, end_stripe, 1))
+         {
+            LOG(LOG_ERR, "Failed to regenerate data for stripes %d-%d!\n", first_stripe, end_stripe - 1);
+            return -1;
+         }
+         break;
+      }
+   }
+   unsigned char **refs = calloc(N + 1, sizeof(unsigned char *));
+   if (refs == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a buffer reference array!\n");
+      return -1;
+   }
+   for (block = 0; block < N; block++)
+   {
+      refs[block] = (unsigned char *)handle->iob[block]->buff + (first_stripe * partsz);
+   }
+   refs[N] = buffer;
+   int ret_val = dispatch_erasure(handle, stripes * partsz, NULL, 1, refs);
+   free(refs);
+   if (wait_for_encode(handle))
+   {
+      ret_val = -1;
+   }
+   return ret_val;
+}
+
+/**
+ * Determine whether the handle's current reference for the given block is a stand-in for a hedged ioblock
+ * @param ne_handle handle : Handle to check
+ * @param int block : Index of the block to check
+ * @return char : 1 if the block was hedged, 0 if not
+ */
+static char is_hedged(ne_handle handle, int block)
+{
+   return (handle->hedge_iob && block < handle->epat.N && handle->iob[block] &&
+           handle->iob[block] == handle->hedge_iob[block]);
+}
+
+/**
+ * Record the latency of a newly arrived data ioblock
+ * @param ne_handle handle : Handle on which the ioblock arrived
+ * @param struct timespec* start : CLOCK_MONOTONIC time at which the handle began waiting for the ioblock
+ */
+static void record_latency(ne_handle handle, struct timespec *start)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   long usec = ((now.tv_sec - start->tv_sec) * 1000000L) + ((now.tv_nsec - start->tv_nsec) / 1000L);
+   handle->lat_usec[handle->lat_cnt % HEDGE_SAMPLES] = (unsigned int)usec;
+   handle->lat_cnt++;
+   if (handle->lat_cnt == 2 * HEDGE_SAMPLES)
+   {
+      handle->lat_cnt = HEDGE_SAMPLES;
+   } // avoid overflow, while preserving the ring position
+}
+
+/**
+ * Calculate the current hedging threshold of the given handle
+ * @param ne_handle handle : Handle for which to calculate the threshold
+ * @return long : Threshold in microseconds, or zero if the handle has no threshold ( yet )
+ */
+static long hedge_threshold(ne_handle handle)
+{
+   long thresh = handle->hedge_msec * 1000L;
+   if (handle->hedge_mult && handle->lat_cnt >= (HEDGE_SAMPLES / 2))
+   {
+      // insertion sort a copy of our latency samples, to find the median
+      unsigned int sorted[HEDGE_SAMPLES];
+      int count = (handle->lat_cnt < HEDGE_SAMPLES) ? handle->lat_cnt : HEDGE_SAMPLES;
+      int i;
+      for (i = 0; i < count; i++)
+      {
+         int pos = i;
+         while (pos > 0 && sorted[pos - 1] > handle->lat_usec[i])
+         {
+            sorted[pos] = sorted[pos - 1];
+            pos--;
+         }
+         sorted[pos] = handle->lat_usec[i];
+      }
+      long mthresh = (long)sorted[count / 2] * handle->hedge_mult;
+      if (mthresh > thresh)
+      {
+         thresh = mthresh;
+      }
+   }
+   if (thresh && thresh < HEDGE_MIN_USEC)
+   {
+      thresh = HEDGE_MIN_USEC;
+   }
+   return thresh;
+}
+
+/**
+ * Retrieve the next ioblock of a data block, giving up on it if it fails to arrive within the given threshold
+ * NOTE -- any late ioblocks previously given up on are discarded, as they arrive
+ * @param ne_handle handle : Handle to retrieve the ioblock for
+ * @param int block : Index of the data block
+ * @param long hedge_usec : Hedging threshold, in microseconds
+ * @return int : 1 if the block was hedged ( its reference now being a stand-in ioblock ), 0 if the ioblock
+ *               arrived in time, and -1 on failure
+ */
+static int hedged_dequeue(ne_handle handle, int block, long hedge_usec)
+{
+   // make sure we have a stand-in ioblock available for this block
+   ioqueue *ioq = handle->thread_states[block].ioq;
+   if (handle->hedge_iob[block] == NULL)
+   {
+      ioblock *standin = malloc(sizeof(struct ioblock_struct));
+      if (standin == NULL)
+      {
+         LOG(LOG_ERR, "Failed to allocate a stand-in ioblock for block %d\n", block);
+         return -1;
+      }
+      standin->buff = NULL;
+      if (posix_memalign(&standin->buff, IOBLOCK_ALIGN, ioq->blocksz))
+      {
+         LOG(LOG_ERR, "Failed to allocate a stand-in ioblock buffer for block %d\n", block);
+         free(standin);
+         return -1;
+      }
+      standin->data_size = 0;
+      standin->error_end = 0;
+      handle->hedge_iob[block] = standin;
+   }
+   // a CLOCK_MONOTONIC deadline, so that adjustments of the system time neither trigger nor suppress hedging
+   struct timespec start;
+   struct timespec deadline;
+   clock_gettime(CLOCK_MONOTONIC, &start);
+   deadline.tv_sec = start.tv_sec + (hedge_usec / 1000000L);
+   deadline.tv_nsec = start.tv_nsec + ((hedge_usec % 1000000L) * 1000L);
+   if (deadline.tv_nsec >= 1000000000L)
+   {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000L;
+   }
+   while (1)
+   {
+      ioblock *iob = NULL;
+      int ret = tq_timed_dequeue(handle->thread_queues[block], TQ_HALT, (void **)&iob, &deadline);
+      if (ret < 0 && errno == ETIMEDOUT)
+      {
+         LOG(LOG_INFO, "Hedging against slow ioblock of block %d\n", block);
+         handle->hedge_owed[block]++; // the late ioblock must be discarded, once it arrives
+         handle->iob[block] = handle->hedge_iob[block];
+         return 1;
+      }
+      // an empty queue with state flags set will never produce an ioblock
+      if (ret <= 0 || iob == NULL)
+      {
+         LOG(LOG_ERR, "Failed to retrieve new buffer for block %d!\n", block);
+         errno = EBADF;
+         return -1;
+      }
+      if (handle->hedge_owed[block] == 0)
+      {
+         record_latency(handle, &start);
+         handle->iob[block] = iob;
+         return 0;
+      }
+      LOG(LOG_INFO, "Discarding late ioblock of block %d\n", block);
+      handle->hedge_owed[block]--;
+      if (release_ioblock(ioq))
+      {
+         LOG(LOG_ERR, "Failed to release late ioblock of block %d\n", block);
+         errno = EBADF;
+         return -1;
+      }
+   }
+}
+
+/**
+ * Wait for all late ioblocks of a hedged data block to arrive
+ * @param ne_handle handle : Handle on which the block was hedged
+ * @param int block : Index of the data block
+ * @param char keep : If non-zero, the most recent ioblock is retained as the handle's reference for the block
+ *                    ( replacing the stand-in ), otherwise all are released
+ * @return int : Zero on success, and -1 on failure
+ */
+static int settle_hedged_block(ne_handle handle, int block, char keep)
+{
+   if (is_hedged(handle, block))
+   {
+      handle->iob[block] = NULL;
+   }
+   while (handle->hedge_owed[block] > 0)
+   {
+      ioblock *iob = NULL;
+      if (tq_dequeue(handle->thread_queues[block], TQ_HALT, (void **)&iob) <= 0 || iob == NULL)
+      {
+         LOG(LOG_ERR, "Failed to retrieve late ioblock of block %d\n", block);
+         errno = EBADF;
+         return -1;
+      }
+      handle->hedge_owed[block]--;
+      if (keep && handle->hedge_owed[block] == 0)
+      {
+         handle->iob[block] = iob;
+      }
+      else if (release_ioblock(handle->thread_states[block].ioq))
+      {
+         LOG(LOG_ERR, "Failed to release late ioblock of block %d\n", block);
+         errno = EBADF;
+         return -1;
+      }
+   }
+   return 0;
+}
+
+/**
+ * Wait on previously hedged data blocks of the current stripe, until its errors are once again recoverable
+ * @param ne_handle handle : Handle on which the blocks were hedged
+ * @param int* nstripe_errors : Reference to the number of errors ( including hedged blocks ) in the stripe
+ * @param int* nhedged : Reference to the number of hedged blocks in the stripe
+ * @param int stripecnt : Expected stripe count of each ioblock ( zero if not yet known )
+ * @return int : Zero on success, and -1 on failure
+ */
+static int reclaim_hedged_blocks(ne_handle handle, int *nstripe_errors, int *nhedged, int stripecnt)
+{
+   int i;
+   for (i = 0; *nstripe_errors > handle->epat.E && *nhedged && i < handle->epat.N; i++)
+   {
+      if (!is_hedged(handle, i))
+      {
+         continue;
+      }
+      LOG(LOG_INFO, "Waiting on previously hedged block %d\n", i);
+      if (settle_hedged_block(handle, i, 1))
+      {
+         return -1;
+      }
+      (*nhedged)--;
+      (*nstripe_errors)--;
+      ioblock *iob = handle->iob[i];
+      if (iob->error_end > 0)
+      {
+         LOG(LOG_ERR, "Detected an error at offset %zu of ioblock %d\n", iob->error_end, i);
+         (*nstripe_errors)++;
+      }
+      if (stripecnt && (iob->data_size / handle->epat.partsz) != stripecnt)
+      {
+         LOG(LOG_ERR, "Detected a ioblock of size %zd from block %d which conflicts with stripe count of %d!\n",
+             iob->data_size, i, stripecnt);
+         errno = EBADF;
+         return -1;
+      }
+   }
+   return 0;
+}
+
+/**
+ * Start up the next halted erasure thread of a read handle, at the handle's current ioblock offset
+ * @param ne_handle handle : Handle on which to start the thread
+ * @param int block : Index of the block to be started ( must be N + ethreads_running )
+ * @return int : Zero on success, and -1 on failure
+ */
+static int start_erasure_thread(ne_handle handle, int block)
+{
+   LOG(LOG_INFO, "Starting up thread %d to cope with errors beyond offset %zd\n", block, handle->iob_offset);
+   // first, make sure to empty any ioblocks still on the queue
+   while (tq_dequeue(handle->thread_queues[block], TQ_HALT, (void **)&(handle->iob[block])) > 0)
+   {
+      LOG(LOG_INFO, "Releasing ioblock from queue %d, prior to reseek\n", block);
+      if (release_ioblock(handle->thread_states[block].ioq))
+      {
+         LOG(LOG_ERR, "Failed to release ioblock from queue %d\n", block);
+         errno = EBADF;
+         return -1;
+      }
+   }
+   handle->thread_states[block].offset = handle->iob_offset; // set offset for this read thread
+   if (tq_unset_flags(handle->thread_queues[block], TQ_HALT))
+   {
+      LOG(LOG_ERR, "Failed to clear PAUSE state for block %d!\n", block);
+      errno = EBADF;
+      return -1;
+   }
+   handle->ethreads_running++;
+   return 0;
+}
+
+/**
+ * Check a newly retrieved ioblock of the current stripe for errors and for agreement with the stripe count
+ * @param ne_handle handle : Handle on which the ioblock was retrieved
+ * @param int block : Index of the block
+ * @param int* stripecnt : Reference to the stripe count of the current ioblocks ( set here, if still zero )
+ * @param int* nstripe_errors : Reference to the number of errors in the stripe ( incremented here, if necessary )
+ * @return int : Zero on success, and -1 on failure
+ */
+static int check_stripe_ioblock(ne_handle handle, int block, int *stripecnt, int *nstripe_errors)
+{
+   ioblock *cur_iob = handle->iob[block];
+   // check if this new ioblock will require a rebuild
+   if (cur_iob->error_end > 0)
+   {
+      LOG(LOG_ERR, "Detected an error at offset %zu of ioblock %d\n", cur_iob->error_end, block);
+      (*nstripe_errors)++;
+   }
+   // make sure our stripecnt is logical
+   if (*stripecnt)
+   {
+      if ((cur_iob->data_size / handle->epat.partsz) != *stripecnt)
+      {
+         LOG(LOG_ERR, "Detected a ioblock of size %zd from block %d which conflicts with stripe count of %d!\n",
+             cur_iob->data_size, block, *stripecnt);
+         errno = EBADF;
+         return -1;
+      }
+   }
+   else
+   {
+      *stripecnt = (cur_iob->data_size / handle->epat.partsz);
+      handle->iob_datasz = cur_iob->data_size;
+   } // or set it, if we haven't yet
+   return 0;
+}
+
+/**
+ * Retrieve the ioblocks of the current stripe from all running threads, in whatever order they arrive,
+ *  starting up additional erasure threads as errors are found
+ * NOTE -- hedged handles must instead wait on data blocks in order, to give up on them in turn
+ * @param ne_handle handle : Handle on which to retrieve ioblocks
+ * @param int* stripecnt : Reference to the stripe count of the current ioblocks
+ * @param int* nstripe_errors : Reference to the number of errors in the stripe
+ * @return int : Zero on success, and -1 on failure
+ */
+static int dequeue_stripe_any(ne_handle handle, int *stripecnt, int *nstripe_errors)
+{
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   // group all queues on first use
+   if (handle->tq_group == NULL)
+   {
+      if (handle->tq_pending == NULL)
+      {
+         handle->tq_pending = calloc(N + E, sizeof(char));
+         if (handle->tq_pending == NULL)
+         {
+            LOG(LOG_ERR, "Failed to allocate space for pending block references!\n");
+            return -1;
+         }
+      }
+      handle->tq_group = tq_group_init(handle->thread_queues, N + E);
+      if (handle->tq_group == NULL)
+      {
+         LOG(LOG_ERR, "Failed to group thread queues!\n");
+         return -1;
+      }
+   }
+   char *pending = handle->tq_pending;
+   int npending = 0;
+   int block;
+   for (block = 0; block < N + E; block++)
+   {
+      pending[block] = (block < N + handle->ethreads_running);
+      npending += pending[block];
+   }
+   while (npending)
+   {
+      unsigned int cur_block = 0;
+      ioblock *cur_iob = NULL;
+      if (tq_dequeue_any(handle->tq_group, TQ_HALT, pending, (void **)&cur_iob, &cur_block) < 0 || cur_iob == NULL)
+      {
+         LOG(LOG_ERR, "Failed to retrieve new buffer from any of %d pending blocks!\n", npending);
+         errno = EBADF;
+         return -1;
+      }
+      pending[cur_block] = 0;
+      npending--;
+      handle->iob[cur_block] = cur_iob;
+      LOG(LOG_INFO, "Dequeued ioblock at position %u\n", cur_block);
+      if (check_stripe_ioblock(handle, cur_block, stripecnt, nstripe_errors))
+      {
+         return -1;
+      }
+      // check if we can even handle however many errors we've hit so far
+      if (*nstripe_errors > E)
+      {
+         LOG(LOG_ERR, "Data beyond offset %zd has too many errors (%d) to be recovered\n", handle->iob_offset, *nstripe_errors);
+         errno = ENODATA;
+         return -1;
+      }
+      // start up an erasure thread to cover each new error
+      while (handle->ethreads_running < *nstripe_errors)
+      {
+         block = N + handle->ethreads_running;
+         if (start_erasure_thread(handle, block))
+         {
+            return -1;
+         }
+         pending[block] = 1;
+         npending++;
+      }
+   }
+   return 0;
+}
+
+/**
+ *
+ *
+ */
+int read_stripes(ne_handle handle)
+{
+
+   // get some useful reference values
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   ssize_t partsz = handle->epat.partsz;
+   size_t stripesz = partsz * N;
+#ifdef DEBUG
+   size_t offset = (handle->iob_offset * N) + handle->sub_offset;
+   unsigned int start_stripe = (unsigned int)(offset / stripesz); // get a stripe num based on offset
+#endif
+
+   // make sure our sub_offset is stripe aligned and at the end of our current ioblocks
+   // NOTE -- following a reseek, no ioblocks are populated and our sub_offset may fall anywhere within the first stripe
+   if (handle->iob_datasz == 0)
+   {
+      if (handle->sub_offset < 0 || handle->sub_offset >= stripesz)
+      {
+         LOG(LOG_ERR, "Called on unpopulated handle with an inappropriate sub_offset (%zd)!\n", handle->sub_offset);
+         return -1;
+      }
+   }
+   else if (handle->sub_offset % stripesz || handle->sub_offset != (handle->iob_datasz * N))
+   {
+      LOG(LOG_ERR, "Called on handle with an inappropriate sub_offset (%zd)!\n", handle->sub_offset);
+      return -1;
+   }
+   else
+   {
+      handle->sub_offset = 0;
+   }
+
+   // update handle offset values
+   handle->iob_offset += handle->iob_datasz;
+   handle->regen_start = 0;
+   handle->regen_end = 0;
+
+   // if we have previous block references, we'll need to release them
+   // NOTE -- a reseek only clears the references of running threads, so halted erasure threads may still
+   //         hold references beyond the first NULL
+   int i;
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      if (handle->iob[i] == NULL)
+      {
+         continue;
+      }
+      if (!is_hedged(handle, i) && release_shared_ioblock(handle->iob[i], handle->thread_states[i].ioq))
+      {
+         LOG(LOG_ERR, "Failed to release ioblock reference for block %d!\n", i);
+         return -1;
+      }
+      handle->iob[i] = NULL; // NULL out this outdated reference
+   }
+
+   // ---------------------- VERIFY INTEGRITY OF ALL BLOCKS IN STRIPE ----------------------
+
+   // First, loop through all data buffers in the stripe, looking for errors.
+   // Then, starup erasure threads as necessary to deal with errors.
+   // Technically, it would theoretically be more efficient to limit this to
+   // only the blocks we expect to need.  However, if we hit any error in those
+   // blocks, we'll suddenly need the whole stripe.  I am hoping the reduced
+   // complexity of just checking them all will be worth what will probably
+   // only be the slightest of performance hits.  Besides, in the expected
+   // use case of reading a file start to finish, we'll eventually need this
+   // entire stripe regardless.
+   int cur_block;
+   int stripecnt = 0;
+   int nstripe_errors = 0;
+   // hedged handles may give up on slow data blocks, treating them as errors instead
+   int nhedged = 0;
+   long hedge_usec = 0;
+   if (handle->hedge_iob)
+   {
+      hedge_usec = hedge_threshold(handle);
+   }
+   // without hedging, there is no reason to wait on blocks in order
+   else if (dequeue_stripe_any(handle, &stripecnt, &nstripe_errors))
+   {
+      return -1;
+   }
+   for (cur_block = 0; handle->hedge_iob && (cur_block < (N + nstripe_errors) || cur_block < (N + handle->ethreads_running)) && cur_block < (N + E); cur_block++)
+   {
+      // if real errors have left us short, we'll have to wait on hedged blocks after all
+      if (nstripe_errors > E && reclaim_hedged_blocks(handle, &nstripe_errors, &nhedged, stripecnt))
+      {
+         return -1;
+      }
+      // check if we can even handle however many errors we've hit so far
+      if (nstripe_errors > E)
+      {
+         LOG(LOG_ERR, "Data beyond stripe %d has too many errors (%d) to be recovered\n", start_stripe, nstripe_errors);
+         errno = ENODATA;
+         return -1;
+      }
+      // if this thread isn't running, we need to start it
+      if (cur_block >= N + handle->ethreads_running && start_erasure_thread(handle, cur_block))
+      {
+         return -1;
+      }
+      // retrieve a new ioblock from this thread, hedging against slow data blocks while erasure remains
+      if (hedge_usec && cur_block < N && nstripe_errors < E)
+      {
+         int hedged = hedged_dequeue(handle, cur_block, hedge_usec);
+         if (hedged < 0)
+         {
+            return -1;
+         }
+         if (hedged)
+         {
+            // treat this block as an error, its size will be set once the stripe count is known
+            nhedged++;
+            nstripe_errors++;
+            continue;
+         }
+      }
+      else
+      {
+         struct timespec start;
+         clock_gettime(CLOCK_MONOTONIC, &start);
+         if ((handle->hedge_iob && cur_block < N && settle_hedged_block(handle, cur_block, 0)) ||
+             tq_dequeue(handle->thread_queues[cur_block], TQ_HALT, (void **)&(handle->iob[cur_block])) < 0)
+         {
+            LOG(LOG_ERR, "Failed to retrieve new buffer for block %d!\n", cur_block);
+            errno = EBADF;
+            return -1;
+         }
+         if (handle->hedge_iob && cur_block < N)
+         {
+            record_latency(handle, &start);
+         }
+      }
+      LOG(LOG_INFO, "Dequeued ioblock at position %d\n", cur_block);
+      if (check_stripe_ioblock(handle, cur_block, &stripecnt, &nstripe_errors))
+      {
+         return -1;
+      }
+   }
+
+   if (nstripe_errors > E && reclaim_hedged_blocks(handle, &nstripe_errors, &nhedged, stripecnt))
+   {
+      return -1;
+   }
+   // stand-in ioblocks of hedged blocks consist entirely of missing data
+   if (nhedged)
+   {
+      for (i = 0; i < N; i++)
+      {
+         if (is_hedged(handle, i))
+         {
+            handle->hedge_iob[i]->data_size = handle->iob_datasz;
+            handle->hedge_iob[i]->error_end = handle->iob_datasz;
+         }
+      }
+      pthread_mutex_lock(&handle->ctxt->tbl_lock);
+      handle->ctxt->hstats.hedged_reads++;
+      handle->ctxt->hstats.hedged_blocks += nhedged;
+      pthread_mutex_unlock(&handle->ctxt->tbl_lock);
+   }
+
+   // if we'er trying to avoid unnecessary reads, halt excess erasure threads
+   if (handle->mode == NE_RDONLY)
+   {
+      // keep the greater of how many erasure threads we've needed in the last couple of stripes...
+      if (nstripe_errors > handle->prev_err_cnt)
+         handle->prev_err_cnt = nstripe_errors;
+      // ...and halt all others
+      for (cur_block = (N + nstripe_errors); cur_block < (N + handle->prev_err_cnt); cur_block++)
+      {
+         LOG(LOG_INFO, "Setting HALT state for unneded thread %d\n", cur_block);
+         if (tq_set_flags(handle->thread_queues[cur_block], TQ_HALT))
+         {
+            // nothing to do besides complain
+            LOG(LOG_ERR, "Failed to pause erasure thread for block %d!\n", cur_block);
+         }
+         else
+         {
+            handle->ethreads_running--;
+         }
+      }
+      // need to reassign, in case the number of errors is decreasing
+      handle->prev_err_cnt = nstripe_errors;
+   }
+
+   // NE_RDONLY handles defer regeneration until data is actually read
+   if (nstripe_errors && handle->mode != NE_RDONLY)
+   {
+      return regenerate_stripes(handle, 0, stripecnt, 0);
+   }
+
+   return 0;
+}
+
+/**
+ * Allocate the shared state of a single ne_stat() call
+ * @param ne_ctxt ctxt : Context of the object to be probed
+ * @param const char* objID : ID of the object to be probed
+ * @param ne_location loc : Location of the object to be probed
+ * @return stat_state : Newly allocated stat_state ( holding only the reference of the caller ), or NULL on failure
+ */
+static stat_state alloc_stat_state(ne_ctxt ctxt, const char *objID, ne_location loc)
+{
+   stat_state sstate = calloc(1, sizeof(struct stat_state_struct));
+   if (sstate == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a stat_state struct!\n");
+      return NULL;
+   }
+   sstate->objID = strdup(objID);
+   sstate->meta_errs = calloc(ctxt->max_block * 2, sizeof(char));
+   sstate->minfo_list = calloc(ctxt->max_block, sizeof(struct meta_info_struct));
+   sstate->probes = calloc(ctxt->max_block * 2, sizeof(struct stat_probe_struct));
+   if (sstate->objID == NULL || sstate->meta_errs == NULL || sstate->minfo_list == NULL || sstate->probes == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for stat_state values!\n");
+      free(sstate->objID);
+      free(sstate->meta_errs);
+      free(sstate->minfo_list);
+      free(sstate->probes);
+      free(sstate);
+      return NULL;
+   }
+   if (pthread_mutex_init(&sstate->lock, NULL))
+   {
+      LOG(LOG_ERR, "Failed to initialize stat_state lock!\n");
+      free(sstate->objID);
+      free(sstate->meta_errs);
+      free(sstate->minfo_list);
+      free(sstate->probes);
+      free(sstate);
+      return NULL;
+   }
+   if (pthread_cond_init(&sstate->complete, NULL))
+   {
+      LOG(LOG_ERR, "Failed to initialize stat_state condition!\n");
+      pthread_mutex_destroy(&sstate->lock);
+      free(sstate->objID);
+      free(sstate->meta_errs);
+      free(sstate->minfo_list);
+      free(sstate->probes);
+      free(sstate);
+      return NULL;
+   }
+   sstate->data_errs = sstate->meta_errs + ctxt->max_block;
+   sstate->refs = 1;
+   sstate->maxblock = ctxt->max_block;
+   sstate->ctxt = ctxt;
+   sstate->loc = loc;
+   int i;
+   for (i = 0; i < ctxt->max_block * 2; i++)
+   {
+      sstate->probes[i].sstate = sstate;
+      sstate->probes[i].block = i / 2;
+      sstate->probes[i].data = (char)(i % 2);
+   }
+   return sstate;
+}
+
+/**
+ * Drop a reference to the given stat_state, freeing it if no references remain
+ * @param stat_state sstate : Reference to the stat_state to be released
+ */
+static void release_stat_state(stat_state sstate)
+{
+   pthread_mutex_lock(&sstate->lock);
+   int refs = --(sstate->refs);
+   pthread_mutex_unlock(&sstate->lock);
+   if (refs)
+   {
+      return;
+   }
+   pthread_cond_destroy(&sstate->complete);
+   pthread_mutex_destroy(&sstate->lock);
+   free(sstate->objID);
+   free(sstate->meta_errs);
+   free(sstate->minfo_list);
+   free(sstate->probes);
+   free(sstate);
+}
+
+/**
+ * Probe a single block for either its metadata or the existence of its data, then record the result
+ * NOTE -- this releases the reference held by the probe
+ * @param stat_probe* probe : Reference to the probe to be performed
+ */
+static void run_stat_probe(stat_probe *probe)
+{
+   stat_state sstate = probe->sstate;
+   ne_ctxt ctxt = sstate->ctxt;
+   pthread_mutex_lock(&sstate->lock);
+   char skip = (probe->block >= sstate->maxblock);
+   pthread_mutex_unlock(&sstate->lock);
+
+   // skipped blocks are treated as erroneous, in case a later consensus extends to them
+   char error = 1;
+   meta_info minfo;
+   if (!skip)
+   {
+      DAL_location dloc = {.pod = sstate->loc.pod, .block = probe->block, .cap = sstate->loc.cap, .scatter = sstate->loc.scatter};
+      if (probe->data)
+      {
+         // verify that data exists for this block
+         error = (ctxt->dal->stat(ctxt->dal->ctxt, dloc, sstate->objID)) ? 1 : 0;
+      }
+      else
+      {
+         BLOCK_CTXT dblock = ctxt->dal->open(ctxt->dal->ctxt, DAL_METAREAD, dloc, sstate->objID);
+         if (dblock == NULL)
+         {
+            LOG(LOG_ERR, "Failed to open a DAL reference for block %d!\n", dloc.block);
+         }
+         else
+         {
+            if (dal_get_minfo(ctxt->dal, dblock, &minfo))
+            {
+               LOG(LOG_WARNING, "Detected a meta error for block %d\n", dloc.block);
+            }
+            else
             {
-               LOG(LOG_WARNING, "Detected bad data for block %d of stripe %d\n", cur_block, cur_stripe + start_stripe);
-               stripe_err_list[nstripe_errors] = cur_block;
-               nstripe_errors++;
-               stripe_in_err[cur_block] = 1;
-               // we just need to note the error, nothing to be done about it until we have all buffers ready
+               error = 0;
             }
+            ctxt->dal->close(dblock);
+         }
+      }
+   }
+
+   pthread_mutex_lock(&sstate->lock);
+   if (probe->data)
+   {
+      sstate->data_errs[probe->block] = error;
+   }
+   else
+   {
+      sstate->meta_errs[probe->block] = error;
+      if (!error)
+      {
+         sstate->minfo_list[probe->block] = minfo;
+      }
+   }
+   probe->done = 1;
+   pthread_cond_signal(&sstate->complete);
+   pthread_mutex_unlock(&sstate->lock);
+   release_stat_state(sstate);
+}
 
-            // check for any change in our error pattern, as that will require reinitializing erasure structs
-            if (handle->prev_in_err[cur_block] != stripe_in_err[cur_block])
-            {
-               handle->e_ready = 0;
-               handle->prev_in_err[cur_block] = stripe_in_err[cur_block];
-            }
-         }
+/**
+ * Recompute the metadata consensus of a ne_stat() call from all completed metadata probes, narrowing the
+ * range of blocks still to be probed once enough blocks agree
+ * NOTE -- the caller must hold the stat_state lock
+ * @param stat_state sstate : Reference to the stat_state of the call
+ * @param meta_info* consensus : Reference to the meta_info struct to be populated with consensus values
+ * @param meta_info** minfo_refs : Scratch list of at least max_block meta_info references
+ * @return int : One if every probe of a block within the current range has completed, zero if not
+ */
+static int update_stat_consensus(stat_state sstate, meta_info *consensus, meta_info **minfo_refs)
+{
+   int valid_meta = 0;
+   int block;
+   for (block = 0; block < sstate->ctxt->max_block; block++)
+   {
+      if (sstate->probes[block * 2].done && !(sstate->meta_errs[block]))
+      {
+         minfo_refs[valid_meta] = &(sstate->minfo_list[block]);
+         valid_meta++;
+      }
+   }
+   if (valid_meta)
+   {
+      int match_count = check_matches(minfo_refs, valid_meta, sstate->ctxt->max_block, consensus);
+      // if we have sufficient agreement, update our maxblock value and save us some time
+      if (match_count > MIN_MD_CONSENSUS && consensus->N + consensus->E <= sstate->ctxt->max_block)
+      {
+         sstate->maxblock = consensus->N + consensus->E;
+      }
+   }
+   for (block = 0; block < sstate->maxblock * 2; block++)
+   {
+      if (!(sstate->probes[block].done))
+      {
+         return 0;
+      }
+   }
+   return 1;
+}
 
-         if (!(handle->e_ready))
-         {
+/**
+ * Initialize a stat thread ( stat threads have no state of their own )
+ * @param unsigned int tID : The ID of this thread
+ * @param void* global_state : Unused
+ * @param void** state : Reference to be populated with this thread's state info
+ * @return int : Zero on success
+ */
+static int stat_init(unsigned int tID, void *global_state, void **state)
+{
+   *state = global_state;
+   return 0;
+}
 
-            // Generate an encoding matrix
-            LOG(LOG_INFO, "Initializing erasure structs...\n");
-            gf_gen_cauchy1_matrix(handle->encode_matrix, N + E, N);
+/**
+ * Perform a single block probe
+ * @param void** state : Thread state reference
+ * @param void** work_todo : Reference to the stat_probe
+ * @return int : Zero on success
+ */
+static int stat_consume(void **state, void **work_todo)
+{
+   run_stat_probe((stat_probe *)(*work_todo));
+   *work_todo = NULL;
+   return 0;
+}
 
-            // Generate g_tbls from encode matrix
-            ec_init_tables(N, E, &(handle->encode_matrix[N * N]), handle->g_tbls);
+/**
+ * Complete any unprocessed probe, so that its ne_stat() call is not left waiting on it
+ * @param void** state : Thread state reference
+ * @param void** prev_work : Reference to any unprocessed stat_probe
+ */
+static void stat_term(void **state, void **prev_work)
+{
+   if (*prev_work)
+   {
+      run_stat_probe((stat_probe *)(*prev_work));
+   }
+}
 
-            unsigned char *tmpmatrix = calloc((N + E) * (N + E), sizeof(unsigned char));
-            if (tmpmatrix == NULL)
-            {
-               LOG(LOG_ERR, "Failed to allocate space for a tmpmatrix!\n");
-               free(tmpmatrix);
-               free(stripe_in_err);
-               free(stripe_err_list);
-               return -1;
-            }
-            int ret_code = gf_gen_decode_matrix_simple(handle->encode_matrix, handle->decode_matrix,
-                                                       handle->invert_matrix, tmpmatrix, handle->decode_index, stripe_err_list,
-                                                       nstripe_errors, N, N + E);
+/**
+ * Retrieve the stat thread_queue of the given ne_ctxt, starting it if necessary
+ * @param ne_ctxt ctxt : Context to retrieve the thread_queue of
+ * @return ThreadQueue : The stat thread_queue, or NULL if blocks should be probed in turn by the caller
+ */
+static ThreadQueue get_stat_queue(ne_ctxt ctxt)
+{
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   if (ctxt->stat_queue == NULL && ctxt->stat_threads > 0)
+   {
+      // never start more threads than there are probes for a single object
+      int threads = ctxt->stat_threads;
+      if (threads > ctxt->max_block * 2)
+      {
+         threads = ctxt->max_block * 2;
+      }
+      TQ_Init_Opts tqopts;
+      tqopts.log_prefix = "SQ";
+      tqopts.init_flags = TQ_NONE;
+      tqopts.max_qdepth = ctxt->max_block * 2;
+      tqopts.global_state = NULL;
+      tqopts.num_threads = threads;
+      tqopts.num_prod_threads = 0;
+      tqopts.pool = NULL;
+      tqopts.spsc = 0; // multiple producers and consumers
+      tqopts.thread_init_func = stat_init;
+      tqopts.thread_consumer_func = stat_consume;
+      tqopts.thread_producer_func = NULL;
+      tqopts.thread_pause_func = NULL;
+      tqopts.thread_resume_func = NULL;
+      tqopts.thread_term_func = stat_term;
+      ctxt->stat_queue = tq_init(&tqopts);
+      if (ctxt->stat_queue == NULL)
+      {
+         LOG(LOG_WARNING, "Failed to start %d stat threads ( blocks will be probed in turn )\n", threads);
+         ctxt->stat_threads = 0;
+      }
+   }
+   ThreadQueue queue = ctxt->stat_queue;
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   return queue;
+}
 
-            free(tmpmatrix);
+/**
+ * Terminate the stat threads of the given ne_ctxt ( if any )
+ * NOTE -- no ne_stat() calls may be in progress for the context
+ * @param ne_ctxt ctxt : Context to terminate the stat threads of
+ * @return int : Zero on success, -1 on failure
+ */
+static int stop_stat_pool(ne_ctxt ctxt)
+{
+   if (ctxt->stat_queue == NULL)
+   {
+      return 0;
+   }
+   int ret_val = 0;
+   if (tq_set_flags(ctxt->stat_queue, TQ_FINISHED))
+   {
+      LOG(LOG_ERR, "Failed to set a FINISHED state for the stat thread_queue!\n");
+      tq_set_flags(ctxt->stat_queue, TQ_ABORT);
+      ret_val = -1;
+   }
+   while (tq_next_thread_status(ctxt->stat_queue, NULL) > 0)
+   {
+   }
+   tq_close(ctxt->stat_queue);
+   ctxt->stat_queue = NULL;
+   return ret_val;
+}
 
-            if (ret_code != 0)
-            {
-               // this is the only error for which we will at least attempt to continue
-               LOG(LOG_ERR, "Failure to generate decode matrix, errors may exceed erasure limits (%d)!\n", nstripe_errors);
-               errno = ENODATA;
-               free(stripe_in_err);
-               free(stripe_err_list);
-               // return the number of stripes we failed to regenerate
-               return cur_stripe + 1;
-            }
+// ---------------------- CONTEXT CREATION/DESTRUCTION ----------------------
 
-            LOG(LOG_INFO, "Initializing erasure tables ( nstripe_errors = %d )\n", nstripe_errors);
-            ec_init_tables(N, nstripe_errors, handle->decode_matrix, handle->g_tbls);
+/**
+ * Initializes an ne_ctxt with a default posix DAL configuration.
+ * This fucntion is intended primarily for use with test utilities and commandline tools.
+ * @param const char* path : The complete path template for the erasure stripe
+ * @param ne_location max_loc : The maximum pod/cap/scatter values for this context
+ * @return ne_ctxt : The initialized ne_ctxt or NULL if an error occurred
+ */
+ne_ctxt ne_path_init(const char *path, ne_location max_loc, int max_block)
+{
+   // create a stand-in XML config
+   char *configtemplate = "<DAL type=\"posix\"><dir_template>%s</dir_template><sec_root></sec_root></DAL>";
+   int len = strlen(path) + strlen(configtemplate);
+   char *xmlconfig = malloc(len);
+   if (xmlconfig == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate memory for the stand-in xml config!\n");
+      return NULL;
+   }
+   if ((len = snprintf(xmlconfig, len, configtemplate, path)) < 0)
+   {
+      free(xmlconfig);
+      return NULL;
+   }
+   xmlDoc *config = NULL;
+   xmlNode *root_elem = NULL;
 
-            handle->e_ready = 1; //indicate that rebuild structures are initialized
-         }
+   /* initialize libxml and check for potential version mismatches */
+   LIBXML_TEST_VERSION
 
-         // as this struct will change depending on the head position of our queues, we must generate here
-         unsigned char **recov = calloc(N + E, sizeof(unsigned char *));
-         if (recov == NULL)
-         {
-            LOG(LOG_ERR, "Failed to allocate space for a recovery array!\n");
-            free(stripe_in_err);
-            free(stripe_err_list);
-            return -1;
-         }
-         //unsigned char* recov[ MAXPARTS ];
-         for (cur_block = 0; cur_block < N; cur_block++)
-         {
-            //BufferQueue* bq = &handle->blocks[handle->decode_index[cur_block]];
-            //recov[cur_block] = bq->buffers[ bq->head ];
-            recov[cur_block] = handle->iob[handle->decode_index[cur_block]]->buff + stripe_start;
-         }
+   /* parse the stand-in XML config */
+   config = xmlReadMemory(xmlconfig, len + 1, "noname.xml", NULL, XML_PARSE_NOBLANKS);
+   if (config == NULL)
+   {
+      free(xmlconfig);
+      return NULL;
+   }
+   root_elem = xmlDocGetRootElement(config);
+   free(xmlconfig); // done with the stand-in xml config
 
-         unsigned char **temp_buffs = calloc(nstripe_errors, sizeof(unsigned char *));
-         if (temp_buffs == NULL)
-         {
-            LOG(LOG_ERR, "Failed to allocate space for a temp_buffs array!\n");
-            free(recov);
-            free(stripe_in_err);
-            free(stripe_err_list);
-            return -1;
-         }
-         //unsigned char* temp_buffs[ nstripe_errors ];
-         for (cur_block = 0; cur_block < nstripe_errors; cur_block++)
-         {
-            //BufferQueue* bq = &handle->blocks[stripe_err_list[ cur_block ]];
-            //temp_buffs[ cur_block ] = bq->buffers[ bq->head ];
+   // Initialize a posix dal instance
+   DAL_location maxloc = {.pod = 0, .block = max_block, .cap = 0, .scatter = 0};
+   DAL dal = init_dal(root_elem, maxloc);
+   // free the xmlDoc and any parser global vars
+   xmlFreeDoc(config);
+   xmlCleanupParser();
+   // verify that dal initialization was successful
+   if (dal == NULL)
+   {
+      return NULL;
+   }
 
-            // assign storage locations for the repaired buffers to be on top of the faulty buffers
-            temp_buffs[cur_block] = handle->iob[stripe_err_list[cur_block]]->buff + stripe_start;
-            // as we are regenerating over the bad buffer, mark it as usable from this point on
-            handle->iob[stripe_err_list[cur_block]]->error_end = stripe_start;
+   // allocate a context struct
+   ne_ctxt ctxt = malloc(sizeof(struct ne_ctxt_struct));
+   if (ctxt == NULL)
+   {
+      return NULL;
+   }
 
-            // as we are regenerating over the bad buffer, mark it as usable for future iterations
-            //*(u32*)( temp_buffs[ cur_block ] + bsz ) = 1;
-         }
+   // fill in context elements
+   ctxt->max_block = max_block;
+   ctxt->dal = dal;
+   ctxt->encode_threads = 0;
+   ctxt->decode_threads = 0;
+   ctxt->tables = NULL;
+   ctxt->plans = NULL;
+   ctxt->plancnt = 0;
+   ctxt->handles = 0;
+   ctxt->hstats.hedged_reads = 0;
+   ctxt->hstats.hedged_blocks = 0;
+   ctxt->hedge_msec = 0;
+   ctxt->hedge_mult = 0;
+   ctxt->io_pool = NULL;
+   ctxt->mcache = NULL;
+   ctxt->mcache_cnt = 0;
+   ctxt->mcache_max = 0;
+   ctxt->mcache_msec = 0;
+   ctxt->shm_cache = NULL;
+   ctxt->shm_size = 0;
+   ctxt->stat_threads = STAT_THREADS;
+   ctxt->stat_queue = NULL;
+   if (pthread_mutex_init(&ctxt->tbl_lock, NULL))
+   {
+      LOG(LOG_ERR, "failed to initialize encoding table lock!\n");
+      dal->cleanup(dal);
+      free(ctxt);
+      return NULL;
+   }
+
+   // return the new ne_ctxt
+   return ctxt;
+}
 
-         LOG(LOG_INFO, "Performing regeneration of stripe %d from erasure\n", cur_stripe + start_stripe);
+/**
+ * Initializes a new ne_ctxt
+ * @param xmlNode* dal_root : Root of a libxml2 DAL node describing data access
+ * @param ne_location max_loc : ne_location struct containing maximum allowable pod/cap/scatter
+ *                              values for this context
+ * @param int max_block : Integer maximum block value ( N + E ) for this context
+ * @return ne_ctxt : New ne_ctxt or NULL if an error was encountered
+ */
+ne_ctxt ne_init(xmlNode *dal_root, ne_location max_loc, int max_block)
+{
+   // Initialize a DAL instance
+   DAL_location maxdal = {.pod = max_loc.pod, .block = max_block, .cap = max_loc.cap, .scatter = max_loc.scatter};
+   DAL dal = init_dal(dal_root, maxdal);
+   // Verify that the dal intialized successfully
+   if (dal == NULL)
+   {
+      LOG(LOG_ERR, "DAL instance failed to properly initialize!\n");
+      return NULL;
+   }
 
-         ec_encode_data(partsz, N, nstripe_errors, handle->g_tbls, recov, &temp_buffs[0]);
+   // allocate a new context struct
+   ne_ctxt ctxt = malloc(sizeof(struct ne_ctxt_struct));
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate memory for a new ne_ctxt struct!\n");
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
+   }
 
-         free(recov);
-         free(temp_buffs);
-      } // end of per-stripe loop
+   // fill in context values and return
+   ctxt->max_block = max_block;
+   ctxt->dal = dal;
+   ctxt->encode_threads = 0;
+   ctxt->decode_threads = 0;
+   ctxt->tables = NULL;
+   ctxt->plans = NULL;
+   ctxt->plancnt = 0;
+   ctxt->handles = 0;
+   ctxt->hstats.hedged_reads = 0;
+   ctxt->hstats.hedged_blocks = 0;
+   ctxt->hedge_msec = 0;
+   ctxt->hedge_mult = 0;
+   ctxt->io_pool = NULL;
+   ctxt->mcache = NULL;
+   ctxt->mcache_cnt = 0;
+   ctxt->mcache_max = 0;
+   ctxt->mcache_msec = 0;
+   ctxt->shm_cache = NULL;
+   ctxt->shm_size = 0;
+   ctxt->stat_threads = STAT_THREADS;
+   ctxt->stat_queue = NULL;
+   if (pthread_mutex_init(&ctxt->tbl_lock, NULL))
+   {
+      LOG(LOG_ERR, "failed to initialize encoding table lock!\n");
+      dal->cleanup(dal);
+      free(ctxt);
+      return NULL;
+   }
 
-      // free unneeded lists
-      free(stripe_in_err);
-      free(stripe_err_list);
+   return ctxt;
+}
+
+/**
+ * Set the number of erasure encoding threads to be started for each write handle of the given ne_ctxt
+ * NOTE -- this only affects handles opened after the call
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param int threads : Number of encoding threads per write handle ( zero to encode on the calling thread )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_set_encode_threads(ne_ctxt ctxt, int threads)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (threads < 0)
+   {
+      LOG(LOG_ERR, "Received a negative encoding thread count: %d\n", threads);
+      errno = EINVAL;
+      return -1;
+   }
+   ctxt->encode_threads = threads;
+   return 0;
+}
+
+/**
+ * Set the number of erasure decoding threads to be started for each read handle of the given ne_ctxt
+ * NOTE -- this only affects handles opened after the call
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param int threads : Number of decoding threads per read handle ( zero to decode on the calling thread )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_set_decode_threads(ne_ctxt ctxt, int threads)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (threads < 0)
+   {
+      LOG(LOG_ERR, "Received a negative decoding thread count: %d\n", threads);
+      errno = EINVAL;
+      return -1;
+   }
+   ctxt->decode_threads = threads;
+   return 0;
+}
 
-   } // end of error regeneration logic
+/**
+ * Configure hedged reads for NE_RDONLY handles of the given ne_ctxt
+ * NOTE -- this only affects handles opened after the call
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param unsigned int threshold_ms : Fixed hedging threshold, in milliseconds ( zero for none )
+ * @param unsigned int median_mult : Multiple of the median ioblock latency to hedge beyond ( zero for none )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_set_hedging(ne_ctxt ctxt, unsigned int threshold_ms, unsigned int median_mult)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   ctxt->hedge_msec = threshold_ms;
+   ctxt->hedge_mult = median_mult;
+   return 0;
+}
 
+/**
+ * Set the number of threads in a pool shared by all handles of the given ne_ctxt to perform block I/O
+ * NOTE -- this only affects handles opened after the call, and will fail ( errno == EBUSY ) if any 
+ *         handles using a previously configured pool remain open
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param int threads : Number of shared I/O threads ( zero to start dedicated I/O threads for each block of each handle )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_set_io_threads(ne_ctxt ctxt, int threads)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (threads < 0)
+   {
+      LOG(LOG_ERR, "Received a negative I/O thread count: %d\n", threads);
+      errno = EINVAL;
+      return -1;
+   }
+   // terminate any existing pool ( fails if handles still depend on it )
+   if (ctxt->io_pool)
+   {
+      if (tq_pool_term(ctxt->io_pool))
+      {
+         LOG(LOG_ERR, "Failed to terminate the existing I/O pool\n");
+         return -1;
+      }
+      ctxt->io_pool = NULL;
+   }
+   if (threads)
+   {
+      ctxt->io_pool = tq_pool_init((unsigned int)threads, "IOPool");
+      if (ctxt->io_pool == NULL)
+      {
+         LOG(LOG_ERR, "Failed to start an I/O pool of %d threads\n", threads);
+         return -1;
+      }
+   }
    return 0;
 }
 
-// ---------------------- CONTEXT CREATION/DESTRUCTION ----------------------
-
 /**
- * Initializes an ne_ctxt with a default posix DAL configuration.
- * This fucntion is intended primarily for use with test utilities and commandline tools.
- * @param const char* path : The complete path template for the erasure stripe
- * @param ne_location max_loc : The maximum pod/cap/scatter values for this context
- * @return ne_ctxt : The initialized ne_ctxt or NULL if an error occurred
+ * Configure caching of object metadata by the given ne_ctxt
+ * NOTE -- only writes and deletions performed through this context invalidate cached metadata
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param unsigned int objects : Maximum number of objects to retain metadata for ( zero to disable caching )
+ * @param unsigned int ttl_msec : Time after which cached metadata is discarded ( zero for no expiry )
+ * @return int : Zero on a success, and -1 on a failure
  */
-ne_ctxt ne_path_init(const char *path, ne_location max_loc, int max_block)
+int ne_set_meta_cache(ne_ctxt ctxt, unsigned int objects, unsigned int ttl_msec)
 {
-   // create a stand-in XML config
-   char *configtemplate = "<DAL type=\"posix\"><dir_template>%s</dir_template><sec_root></sec_root></DAL>";
-   int len = strlen(path) + strlen(configtemplate);
-   char *xmlconfig = malloc(len);
-   if (xmlconfig == NULL)
+   if (ctxt == NULL)
    {
-      LOG(LOG_ERR, "failed to allocate memory for the stand-in xml config!\n");
-      return NULL;
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return -1;
    }
-   if ((len = snprintf(xmlconfig, len, configtemplate, path)) < 0)
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   ctxt->mcache_max = objects;
+   ctxt->mcache_msec = ttl_msec;
+   trim_cached_meta(ctxt, objects);
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   return 0;
+}
+
+/**
+ * Attach the given ne_ctxt to a metadata cache file shared with other processes ( replacing any previous file )
+ * NOTE -- this must not be called while any handles of the context are in use
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param const char* path : Path of the cache file, typically under /dev/shm ( NULL to detach from any file )
+ * @param unsigned int slots : Number of objects the file may hold, if it must be created
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_set_shared_meta_cache(ne_ctxt ctxt, const char *path, unsigned int slots)
+{
+   if (ctxt == NULL)
    {
-      free(xmlconfig);
-      return NULL;
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return -1;
    }
-   xmlDoc *config = NULL;
-   xmlNode *root_elem = NULL;
-
-   /* initialize libxml and check for potential version mismatches */
-   LIBXML_TEST_VERSION
-
-   /* parse the stand-in XML config */
-   config = xmlReadMemory(xmlconfig, len + 1, "noname.xml", NULL, XML_PARSE_NOBLANKS);
-   if (config == NULL)
+   if (path && slots == 0)
    {
-      free(xmlconfig);
-      return NULL;
+      LOG(LOG_ERR, "Received a zero slot count\n");
+      errno = EINVAL;
+      return -1;
    }
-   root_elem = xmlDocGetRootElement(config);
-   free(xmlconfig); // done with the stand-in xml config
-
-   // Initialize a posix dal instance
-   DAL_location maxloc = {.pod = 0, .block = max_block, .cap = 0, .scatter = 0};
-   DAL dal = init_dal(root_elem, maxloc);
-   // free the xmlDoc and any parser global vars
-   xmlFreeDoc(config);
-   xmlCleanupParser();
-   // verify that dal initialization was successful
-   if (dal == NULL)
+   shm_cache_header *cache = NULL;
+   size_t size = 0;
+   if (path)
    {
-      return NULL;
+      cache = map_shared_cache(path, slots, &size);
+      if (cache == NULL)
+      {
+         return -1;
+      }
    }
-
-   // allocate a context struct
-   ne_ctxt ctxt = malloc(sizeof(struct ne_ctxt_struct));
-   if (ctxt == NULL)
+   if (ctxt->shm_cache)
    {
-      return NULL;
+      munmap(ctxt->shm_cache, ctxt->shm_size);
    }
-
-   // fill in context elements
-   ctxt->max_block = max_block;
-   ctxt->dal = dal;
-
-   // return the new ne_ctxt
-   return ctxt;
+   ctxt->shm_cache = cache;
+   ctxt->shm_size = size;
+   return 0;
 }
 
 /**
- * Initializes a new ne_ctxt
- * @param xmlNode* dal_root : Root of a libxml2 DAL node describing data access
- * @param ne_location max_loc : ne_location struct containing maximum allowable pod/cap/scatter
- *                              values for this context
- * @param int max_block : Integer maximum block value ( N + E ) for this context
- * @return ne_ctxt : New ne_ctxt or NULL if an error was encountered
+ * Set the number of threads used by ne_stat() calls of the given ne_ctxt to probe block metadata concurrently
+ * NOTE -- this must not be called while any ne_stat() calls of the context are in progress
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param int threads : Number of stat threads ( zero to probe each block in turn )
+ * @return int : Zero on a success, and -1 on a failure
  */
-ne_ctxt ne_init(xmlNode *dal_root, ne_location max_loc, int max_block)
+int ne_set_stat_threads(ne_ctxt ctxt, int threads)
 {
-   // Initialize a DAL instance
-   DAL_location maxdal = {.pod = max_loc.pod, .block = max_block, .cap = max_loc.cap, .scatter = max_loc.scatter};
-   DAL dal = init_dal(dal_root, maxdal);
-   // Verify that the dal intialized successfully
-   if (dal == NULL)
+   if (ctxt == NULL)
    {
-      LOG(LOG_ERR, "DAL instance failed to properly initialize!\n");
-      return NULL;
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return -1;
    }
-
-   // allocate a new context struct
-   ne_ctxt ctxt = malloc(sizeof(struct ne_ctxt_struct));
-   if (ctxt == NULL)
+   if (threads < 0)
    {
-      LOG(LOG_ERR, "failed to allocate memory for a new ne_ctxt struct!\n");
-      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
-      return NULL;
+      LOG(LOG_ERR, "Received a negative stat thread count: %d\n", threads);
+      errno = EINVAL;
+      return -1;
    }
+   // terminate any existing threads ( a new set will be started by the next ne_stat() call )
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   int ret_val = stop_stat_pool(ctxt);
+   ctxt->stat_threads = threads;
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   if (ret_val)
+   {
+      LOG(LOG_ERR, "Failed to terminate the existing stat threads\n");
+   }
+   return ret_val;
+}
 
-   // fill in context values and return
-   ctxt->max_block = max_block;
-   ctxt->dal = dal;
-
-   return ctxt;
+/**
+ * Retrieve counters of all hedging performed by handles of the given ne_ctxt
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be queried
+ * @param ne_hedge_stats* stats : Reference to the ne_hedge_stats struct to be populated
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_get_hedge_stats(ne_ctxt ctxt, ne_hedge_stats *stats)
+{
+   if (ctxt == NULL || stats == NULL)
+   {
+      LOG(LOG_ERR, "Received a NULL argument!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   *stats = ctxt->hstats;
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   return 0;
 }
 
 /**
  * Destroys and existing ne_ctxt
+ * NOTE -- this will fail ( errno == EBUSY ) if any handles of the context remain open
  * @param ne_ctxt ctxt : Reference to the ne_ctxt to be destroyed
  * @return int : Zero on a success, and -1 on a failure
  */
 int ne_term(ne_ctxt ctxt)
 {
+   // Verify that no handles remain, and so that none are still referencing our encoding structs
+   pthread_mutex_lock(&ctxt->tbl_lock);
+   if (ctxt->handles)
+   {
+      LOG(LOG_ERR, "Context is still in use by %d handles!\n", ctxt->handles);
+      pthread_mutex_unlock(&ctxt->tbl_lock);
+      errno = EBUSY;
+      return -1;
+   }
+   encode_tables *tbls;
+   for (tbls = ctxt->tables; tbls != NULL; tbls = tbls->next)
+   {
+      if (tbls->refcnt)
+      {
+         LOG(LOG_ERR, "Encoding tables for N=%d/E=%d are still referenced by %d handles!\n", tbls->N, tbls->E, tbls->refcnt);
+         pthread_mutex_unlock(&ctxt->tbl_lock);
+         errno = EBUSY;
+         return -1;
+      }
+   }
+   decode_plan *plan;
+   for (plan = ctxt->plans; plan != NULL; plan = plan->next)
+   {
+      if (plan->refcnt)
+      {
+         LOG(LOG_ERR, "A decode plan for N=%d/E=%d is still referenced by %d handles!\n", plan->N, plan->E, plan->refcnt);
+         pthread_mutex_unlock(&ctxt->tbl_lock);
+         errno = EBUSY;
+         return -1;
+      }
+   }
+   pthread_mutex_unlock(&ctxt->tbl_lock);
+   // Stop any shared I/O threads ( fails if any handles are still using them )
+   if (ctxt->io_pool)
+   {
+      if (tq_pool_term(ctxt->io_pool))
+      {
+         LOG(LOG_ERR, "failed to terminate the shared I/O pool!\n");
+         return -1;
+      }
+      ctxt->io_pool = NULL;
+   }
+   // Stop any stat threads, which may still reference the DAL
+   if (stop_stat_pool(ctxt))
+   {
+      LOG(LOG_ERR, "failed to terminate stat threads!\n");
+      return -1;
+   }
    // Cleanup the DAL context
    if (ctxt->dal->cleanup(ctxt->dal) != 0)
    {
       LOG(LOG_ERR, "failed to cleanup DAL context!\n");
       return -1;
    }
+   while (ctxt->tables)
+   {
+      tbls = ctxt->tables;
+      ctxt->tables = tbls->next;
+      free(tbls->g_tbls);
+      free(tbls->encode_matrix);
+      free(tbls);
+   }
+   while (ctxt->plans)
+   {
+      plan = ctxt->plans;
+      ctxt->plans = plan->next;
+      free_decode_plan(plan);
+   }
+   trim_cached_meta(ctxt, 0);
+   if (ctxt->shm_cache)
+   {
+      munmap(ctxt->shm_cache, ctxt->shm_size);
+   }
+   pthread_mutex_destroy(&ctxt->tbl_lock);
    free(ctxt);
    return 0;
 }
@@ -1094,6 +3984,7 @@ int ne_delete(ne_ctxt ctxt, const char *objID, ne_location loc)
    int retval = 0;
    DAL_location dalloc = {.pod = loc.pod, .cap = loc.cap, .scatter = loc.scatter};
    LOG(LOG_INFO, "Deleting object %s (%d blocks)\n", objID, ctxt->max_block);
+   drop_cached_meta(ctxt, objID, loc);
 
    // loop through and delete all blocks
    int i;
@@ -1113,13 +4004,47 @@ int ne_delete(ne_ctxt ctxt, const char *objID, ne_location loc)
 // ---------------------- HANDLE CREATION FUNCTIONS ----------------------
 
 /**
- * Determine the erasure structure of a given object and (optionally) produce a generic handle for it
+ * Produce a generic handle for the given object from its entry in a shared metadata cache
+ * @param ne_ctxt ctxt : The ne_ctxt used to access this data stripe
+ * @param const char* objID : ID of the object
+ * @param ne_location loc : Location of the object
+ * @param shm_cache_slot* slot : Shared metadata of the object
+ * @return ne_handle : Newly created ne_handle, or NULL if the entry could not be used
+ */
+static ne_handle stat_shared_meta(ne_ctxt ctxt, const char *objID, ne_location loc, shm_cache_slot *slot)
+{
+   if (slot->N <= 0 || slot->E < 0 || slot->N + slot->E > ctxt->max_block)
+   {
+      return NULL;
+   }
+   meta_info consensus = {.N = slot->N, .E = slot->E, .O = slot->O, .partsz = slot->partsz,
+                          .versz = slot->versz, .blocksz = slot->blocksz, .crcsum = 0, .totsz = slot->totsz};
+   ne_handle handle = allocate_handle(ctxt, objID, loc, &consensus);
+   if (handle == NULL)
+   {
+      return NULL;
+   }
+   int i;
+   for (i = 0; i < slot->N + slot->E; i++)
+   {
+      handle->thread_states[i].meta_error = (slot->meta_errs >> i) & 1;
+      handle->thread_states[i].data_error = (slot->data_errs >> i) & 1;
+      handle->thread_states[i].minfo.crcsum = slot->crcsums[i];
+   }
+   handle->mode = NE_STAT;
+   LOG(LOG_INFO, "Using shared metadata of object \"%s\"\n", objID);
+   return handle;
+}
+
+/**
+ * Determine the erasure structure and block health of a given object by probing every block, and produce a 
+ *  generic handle for it
  * @param ne_ctxt ctxt : The ne_ctxt used to access this data stripe
  * @param const char* objID : ID of the object to stat
  * @param ne_location loc : Location of the object to stat
  * @return ne_handle : Newly created ne_handle, or NULL if an error occured
  */
-ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc)
+static ne_handle probe_object(ne_ctxt ctxt, const char *objID, ne_location loc)
 {
    // allocate space for temporary error arrays
    char *tmp_meta_errs = calloc(ctxt->max_block * 2, sizeof(char));
@@ -1131,7 +4056,7 @@ ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc)
    char *tmp_data_errs = tmp_meta_errs + ctxt->max_block;
 
    // allocate space for a full set of meta_info structs
-   meta_info consensus;
+   meta_info consensus = {.N = 0, .E = -1, .O = -1, .partsz = 0, .versz = -1, .blocksz = -1, .totsz = -1};
    meta_info *minfo_list = calloc(ctxt->max_block, sizeof(struct meta_info_struct));
    if (minfo_list == NULL)
    {
@@ -1147,58 +4072,61 @@ ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc)
       free(minfo_list);
       return NULL;
    }
-
-   // loop through all blocks, getting meta_info for each
-   int curblock = 0;
-   int valid_meta = 0;
-   int maxblock = ctxt->max_block;
-   for (; curblock < maxblock; curblock++)
+   stat_state sstate = alloc_stat_state(ctxt, objID, loc);
+   if (sstate == NULL)
    {
+      free(tmp_meta_errs);
+      free(minfo_list);
+      free(minfo_refs);
+      return NULL;
+   }
 
-      DAL_location dloc = {.pod = loc.pod, .block = curblock, .cap = loc.cap, .scatter = loc.scatter};
-
-      // first, we need to get a block reference
-      BLOCK_CTXT dblock = ctxt->dal->open(ctxt->dal->ctxt, DAL_METAREAD, dloc, objID);
-      if (dblock == NULL)
-      {
-         LOG(LOG_ERR, "Failed to open a DAL reference for block %d!\n", dloc.block);
-         tmp_meta_errs[curblock] = 1;
-      }
-      else
+   // issue metadata and data probes of every block, either to our stat threads or in turn
+   ThreadQueue stat_queue = get_stat_queue(ctxt);
+   int probe;
+   for (probe = 0; probe < ctxt->max_block * 2; probe++)
+   {
+      pthread_mutex_lock(&sstate->lock);
+      sstate->refs++;
+      pthread_mutex_unlock(&sstate->lock);
+      if (stat_queue == NULL || tq_enqueue(stat_queue, TQ_NONE, (void *)&(sstate->probes[probe])))
       {
-         // attempt to retrive meta info
-         if (dal_get_minfo(ctxt->dal, dblock, &(minfo_list[curblock])))
+         if (stat_queue)
          {
-            LOG(LOG_WARNING, "Detected a meta error for block %d\n", curblock);
-            tmp_meta_errs[curblock] = 1;
-         }
-         else
-         {
-            // set a reference to the retrieved meta info
-            minfo_refs[valid_meta] = &(minfo_list[curblock]);
-            valid_meta++;
-            // get new consensus values, including this info
-            int match_count = check_matches(minfo_refs, valid_meta, ctxt->max_block, &consensus);
-            // if we have sufficient agreement, update our maxblock value and save us some time
-            if (match_count > MIN_MD_CONSENSUS)
-            {
-               maxblock = consensus.N + consensus.E;
-            }
+            LOG(LOG_WARNING, "Failed to enqueue probe of block %d ( performing it directly )\n", probe / 2);
          }
-         // close our block reference
-         ctxt->dal->close(dblock);
+         run_stat_probe(&(sstate->probes[probe]));
+         // as each block's metadata arrives, determine if further blocks are relevant
+         pthread_mutex_lock(&sstate->lock);
+         update_stat_consensus(sstate, &consensus, minfo_refs);
+         pthread_mutex_unlock(&sstate->lock);
       }
+   }
 
-      // verify that data exists for this block
-      if (ctxt->dal->stat(ctxt->dal->ctxt, dloc, objID))
-      {
-         tmp_data_errs[curblock] = 1;
-      }
+   // wait for every probe of a block within the object, ignoring any beyond the consensus width
+   pthread_mutex_lock(&sstate->lock);
+   while (!update_stat_consensus(sstate, &consensus, minfo_refs))
+   {
+      pthread_cond_wait(&sstate->complete, &sstate->lock);
    }
+   memcpy(tmp_meta_errs, sstate->meta_errs, ctxt->max_block * 2 * sizeof(char));
+   memcpy(minfo_list, sstate->minfo_list, ctxt->max_block * sizeof(struct meta_info_struct));
+   pthread_mutex_unlock(&sstate->lock);
+   release_stat_state(sstate);
 
    // we're done with our minfo_refs
    free(minfo_refs);
 
+   // without any sensible N/E values, there is no handle to describe
+   if (consensus.N <= 0 || consensus.E < 0)
+   {
+      LOG(LOG_ERR, "Failed to identify N/E values for object \"%s\"\n", objID);
+      free(tmp_meta_errs);
+      free(minfo_list);
+      errno = ENOENT;
+      return NULL;
+   }
+
    // create a handle structure
    ne_handle handle = allocate_handle(ctxt, objID, loc, &consensus);
    if (handle == NULL)
@@ -1223,11 +4151,15 @@ ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc)
       consensus.O = -1;
       modeval = NE_ERR;
    }
+   if (consensus.N + consensus.E > ctxt->max_block)
+   {
+      modeval = NE_ERR;
+   }
    // at this point, if we have all valid N/E/O values, we need to rearange our errors based on offset
    int i;
    if (modeval == NE_STAT)
    {
-      for (i = 0; i < curblock; i++)
+      for (i = 0; i < (consensus.N + consensus.E); i++)
       {
          int translation = (i + consensus.O) % (consensus.N + consensus.E);
          if (tmp_meta_errs[translation])
@@ -1266,7 +4198,7 @@ ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc)
    // if we have successfully identified all meta values, try to set crcs appropriately
    if (modeval)
    {
-      for (i = 0; i < curblock; i++)
+      for (i = 0; i < (consensus.N + consensus.E); i++)
       {
          if (handle->thread_states[i].meta_error == 0)
          {
@@ -1274,6 +4206,10 @@ ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc)
          }
       }
    }
+   if (modeval == NE_STAT)
+   {
+      store_cached_meta(handle);
+   }
 
    // indicate whether the handle appears usable or not
    handle->mode = modeval;
@@ -1282,6 +4218,41 @@ ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc)
    return handle;
 }
 
+/**
+ * Determine the erasure structure of a given object and (optionally) produce a generic handle for it
+ * @param ne_ctxt ctxt : The ne_ctxt used to access this data stripe
+ * @param const char* objID : ID of the object to stat
+ * @param ne_location loc : Location of the object to stat
+ * @return ne_handle : Newly created ne_handle, or NULL if an error occured
+ */
+ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc)
+{
+   // another process may have recently determined the state of this object
+   shm_cache_slot slot;
+   if (read_shared_meta(ctxt, objID, loc, &slot))
+   {
+      ne_handle handle = stat_shared_meta(ctxt, objID, loc, &slot);
+      if (handle)
+      {
+         return handle;
+      }
+   }
+   return probe_object(ctxt, objID, loc);
+}
+
+/**
+ * Wake the pooled reader of a block, once its ioqueue has room for it to proceed ( see ioqueue_set_nonblocking() )
+ * @param void* arg : Reference to the ThreadQueue entry of the block ( stable across restarts of the queue )
+ */
+static void wake_pooled_reader(void *arg)
+{
+   ThreadQueue tq = *((ThreadQueue *)arg);
+   if (tq && tq_notify(tq))
+   {
+      LOG(LOG_WARNING, "Failed to notify pooled reader, which will only be retried by polling\n");
+   }
+}
+
 /**
  * Converts a generic handle (produced by ne_stat()) into a handle for a specific operation
  * @param ne_handle handle : Reference to a generic handle (produced by ne_stat())
@@ -1327,6 +4298,8 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode)
    tqopts.max_qdepth = QDEPTH;
    tqopts.num_threads = 1;
    tqopts.num_prod_threads = (mode == NE_WRONLY || mode == NE_WRALL) ? 0 : 1;
+   tqopts.pool = handle->ctxt->io_pool;
+   tqopts.spsc = 1; // each block thread exchanges ioblocks only with this handle
    DAL_MODE dmode = DAL_READ;
    if (mode == NE_WRONLY || mode == NE_WRALL)
    {
@@ -1451,6 +4424,7 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode)
             cpy_minfo(&(handle->thread_states[i].minfo), &(consensus));
          }
       }
+      store_cached_meta(handle);
    }
 
    // start with zero erasure threads running only for NE_RDONLY
@@ -1477,6 +4451,19 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode)
          LOG(LOG_ERR, "Failed to create ioqueue for thread %d!\n", i);
          break;
       }
+      // pooled readers must yield their thread, rather than wait for us to release ioblocks
+      if (tqopts.pool && dmode == DAL_READ &&
+          ioqueue_set_nonblocking(handle->thread_states[i].ioq, 1, wake_pooled_reader, &(handle->thread_queues[i])))
+      {
+         LOG(LOG_ERR, "Failed to set ioqueue of thread %d to nonblocking!\n", i);
+         break;
+      }
+      // writers to an asynchronous DAL keep a put in flight while we fill the next ioblock, which needs an extra one
+      if (dmode != DAL_READ && handle->ctxt->dal->submit_put && ioqueue_set_readahead(handle->thread_states[i].ioq, SUPER_BLOCK_CNT))
+      {
+         LOG(LOG_ERR, "Failed to extend ioqueue of thread %d for asynchronous writes!\n", i);
+         break;
+      }
       // remove the PAUSE flag, allowing thread to begin processing
       if (i < handle->epat.N + handle->ethreads_running)
       {
@@ -1506,6 +4493,44 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode)
       return NULL;
    }
 
+   // write handles may hand erasure generation off to a pool of encoding threads
+   if ((mode == NE_WRONLY || mode == NE_WRALL) && handle->ctxt->encode_threads > 0)
+   {
+      if (start_encode_pool(handle, handle->ctxt->encode_threads))
+      {
+         LOG(LOG_WARNING, "Failed to start an encoding pool, erasure will be generated inline\n");
+      }
+   }
+   // similarly, read handles may hand data regeneration and large copies off to a pool of decoding threads
+   else if (mode != NE_WRONLY && mode != NE_WRALL && handle->ctxt->decode_threads > 0)
+   {
+      if (start_encode_pool(handle, handle->ctxt->decode_threads))
+      {
+         LOG(LOG_WARNING, "Failed to start a decoding pool, data will be regenerated inline\n");
+      }
+   }
+   // NE_RDONLY handles may also hedge against slow data blocks
+   if (mode == NE_RDONLY && (handle->ctxt->hedge_msec || handle->ctxt->hedge_mult))
+   {
+      handle->hedge_iob = calloc(handle->epat.N, sizeof(ioblock *));
+      handle->hedge_owed = calloc(handle->epat.N, sizeof(int));
+      if (handle->hedge_iob == NULL || handle->hedge_owed == NULL)
+      {
+         LOG(LOG_WARNING, "Failed to allocate hedging structures, reads will not be hedged\n");
+         free(handle->hedge_iob);
+         free(handle->hedge_owed);
+         handle->hedge_iob = NULL;
+         handle->hedge_owed = NULL;
+      }
+      handle->hedge_msec = handle->ctxt->hedge_msec;
+      handle->hedge_mult = handle->ctxt->hedge_mult;
+   }
+   // read handles begin with the default ioqueue readahead, adjusted as the access pattern becomes clear
+   handle->advice = NE_ADV_NORMAL;
+   handle->readahead = SUPER_BLOCK_CNT - 1;
+   handle->seek_streak = 0;
+   handle->seq_bytes = 0;
+
    // set our mode to the new value
    handle->mode = mode;
 
@@ -1533,8 +4558,14 @@ ne_handle ne_open(ne_ctxt ctxt, const char *objID, ne_location loc, ne_erasure e
    // verify that our mode argument makes sense
    if (mode != NE_RDONLY && mode != NE_RDALL && mode != NE_WRONLY && mode != NE_WRALL && mode != NE_REBUILD)
    {
-      LOG(LOG_ERR, "Recieved an inappropriate mode argument!\n");
-      return NULL;
+      LOG(LOG_ERR, "Recieved an inappropriate mode argument!\n");
+      return NULL;
+   }
+
+   // any metadata cached for an object being rewritten is about to become stale
+   if (mode == NE_WRONLY || mode == NE_WRALL)
+   {
+      drop_cached_meta(ctxt, objID, loc);
    }
 
    // create a meta_info struct to pass for handle creation
@@ -1555,6 +4586,11 @@ ne_handle ne_open(ne_ctxt ctxt, const char *objID, ne_location loc, ne_erasure e
       LOG(LOG_ERR, "Failed to create an ne_handle!\n");
       return NULL;
    }
+   // read handles may skip fetching metadata which is already cached
+   if (mode == NE_RDONLY || mode == NE_RDALL)
+   {
+      seed_cached_meta(handle);
+   }
 
    // convert our handle to the approprate mode and start threads
    ne_handle converted_handle = ne_convert_handle(handle, mode);
@@ -1618,6 +4654,23 @@ int ne_close(ne_handle handle, ne_erasure *epat, ne_state *sref)
          handle->totsz -= (stripesz - partstripe);
          free(zerobuff);
       }
+      // generate erasure for any remaining stripes, prior to the final ioblocks being pushed
+      if (wait_for_encode(handle) || encode_pending_stripes(handle))
+      {
+         LOG(LOG_ERR, "Failed to generate erasure for final stripes!\n");
+         return -1;
+      }
+      // all erasure has been generated, so the encoding pool is no longer needed
+      if (stop_encode_pool(handle))
+      {
+         LOG(LOG_ERR, "Failed to cleanly terminate the encoding pool!\n");
+         return -1;
+      }
+   }
+   else if (stop_encode_pool(handle))
+   {
+      // decoding work never outlives the call which generated it, so this pool is idle
+      LOG(LOG_WARNING, "Failed to cleanly terminate the decoding pool!\n");
    }
 
    int ret_val = 0;
@@ -1665,6 +4718,22 @@ int ne_close(ne_handle handle, ne_erasure *epat, ne_state *sref)
 
    if (handle->mode != NE_STAT)
    {
+      // wait out any late ioblocks of hedged data blocks
+      for (i = 0; handle->hedge_iob && i < handle->epat.N; i++)
+      {
+         if (settle_hedged_block(handle, i, 0))
+         {
+            LOG(LOG_ERR, "Failed to settle hedged block %d\n", i);
+            ret_val = -1;
+         }
+      }
+      // queues cannot be closed while grouped
+      if (handle->tq_group && tq_group_term(handle->tq_group))
+      {
+         LOG(LOG_ERR, "Failed to terminate the queue group\n");
+         ret_val = -1;
+      }
+      handle->tq_group = NULL;
       // set a FINISHED state for all threads
       for (i = 0; i < handle->epat.N + handle->epat.E; i++)
       {
@@ -1684,6 +4753,15 @@ int ne_close(ne_handle handle, ne_erasure *epat, ne_state *sref)
       }
    }
 
+   // include any bad blocks found by positional reads
+   for (i = 0; handle->pread_bad && i < handle->epat.N + handle->epat.E; i++)
+   {
+      if (handle->pread_bad[i])
+      {
+         handle->thread_states[i].data_error = 1;
+      }
+   }
+
    int numerrs = 0; // for checking write safety
    // check the status of all blocks
    for (i = 0; i < handle->epat.N + handle->epat.E; i++)
@@ -1694,6 +4772,15 @@ int ne_close(ne_handle handle, ne_erasure *epat, ne_state *sref)
          numerrs++;
       }
    }
+   // discard anything cached while the object was being rewritten or repaired, or found to be wrong
+   if (handle->mode == NE_WRONLY || handle->mode == NE_WRALL || handle->mode == NE_REBUILD)
+   {
+      drop_cached_meta(handle->ctxt, handle->objID, handle->loc);
+   }
+   else if (handle->mode != NE_STAT && numerrs)
+   {
+      review_cached_meta(handle);
+   }
    if (handle->mode == NE_WRONLY || handle->mode == NE_WRALL)
    {
       // verify that our data meets safetly thresholds
@@ -1871,8 +4958,241 @@ int ne_seed_status(ne_handle handle, ne_state *sref)
 
 // ---------------------- READ/WRITE/REBUILD FUNCTIONS ----------------------
 
+/**
+ * Halt all read threads of a handle, discard their ioblocks, and restart them at the given stripe
+ * @param ne_handle handle : Handle to be reseeked
+ * @param unsigned int tgt_stripe : Stripe at which all threads should resume reading
+ * @return int : Zero on success, or -1 on a failure ( the handle is then unusable )
+ */
+static int reseek_stripes(ne_handle handle, unsigned int tgt_stripe)
+{
+   int N = handle->epat.N;
+   ssize_t partsz = handle->epat.partsz;
+   //      off_t new_iob_off = -1;
+   int i;
+   for (i = 0; i < (N + handle->ethreads_running); i++)
+   {
+      // first, pause this thread
+      if (tq_set_flags(handle->thread_queues[i], TQ_HALT))
+      {
+         LOG(LOG_ERR, "Failed to set HALT state for block %d!\n", i);
+         break;
+      }
+      // next, release any unneeded ioblock reference
+      if (handle->iob[i] != NULL)
+      {
+         if (!is_hedged(handle, i) && release_shared_ioblock(handle->iob[i], handle->thread_states[i].ioq))
+         {
+            LOG(LOG_ERR, "Failed to release ioblock ref for block %d!\n", i);
+            break;
+         }
+         handle->iob[i] = NULL;
+      }
+      // make sure that the thread isn't stuck waiting for ioqueue elements
+      if (tq_dequeue(handle->thread_queues[i], TQ_HALT, (void **)&(handle->iob[i])) > 0)
+      {
+         if (handle->iob[i] != NULL)
+         {
+            release_ioblock(handle->thread_states[i].ioq);
+            handle->iob[i] = NULL;
+         }
+      }
+      // wait for the thread to pause
+      if (tq_wait_for_pause(handle->thread_queues[i]))
+      {
+         LOG(LOG_ERR, "Failed to detect thread pause for block %d!\n", i);
+         break;
+      }
+      // empty all remaining queue elements
+      int depth = tq_depth(handle->thread_queues[i]);
+      while (depth > 0)
+      {
+         depth = tq_dequeue(handle->thread_queues[i], TQ_HALT, (void **)&(handle->iob[i]));
+         if (depth < 0)
+         {
+            LOG(LOG_ERR, "Failed to dequeue from HALTED thread_queue %d!\n", i);
+            break;
+         }
+         if (handle->iob[i] != NULL)
+         {
+            release_ioblock(handle->thread_states[i].ioq);
+            handle->iob[i] = NULL;
+         }
+         depth--; // decrement, as dequeue depth includes the returned element
+      }
+      if (depth != 0)
+      {
+         break;
+      } // catch any previous error
+      // any late ioblocks of hedged blocks have now been discarded
+      if (handle->hedge_owed && i < N)
+      {
+         handle->hedge_owed[i] = 0;
+      }
+      // set the thread to our target offset
+      handle->thread_states[i].offset = (tgt_stripe * partsz);
+      // unpause the thread
+      if (tq_unset_flags(handle->thread_queues[i], TQ_HALT))
+      {
+         LOG(LOG_ERR, "Failed to unset HALT state for block %d!\n", i);
+         break;
+      }
+      //         // retrieve a new ioblock
+      //         if ( tq_dequeue( handle->thread_queues[i], TQ_HALT, (void**)&(handle->iob[i]) ) < 0 ) {
+      //            LOG( LOG_ERR, "Failed to retrieve ioblock for block %d after seek!\n", i );
+      //            break;
+      //         }
+      //         // by now, the thread must have updated our offset
+      //         off_t real_iob_off = handle->thread_states[i].offset;
+      //         // sanity check this value
+      //         if ( real_iob_off < 0  ||  real_iob_off > (tgt_stripe * partsz) ) {
+      //            LOG( LOG_ERR, "Real offset of block %d (%zd) is not in expected range!\n", i, real_iob_off );
+      //            break;
+      //         }
+      //         // if this is our first block, remember this value and set ioblock data size
+      //         if( new_iob_off < 0 ) {
+      //            new_iob_off = real_iob_off;
+      //            handle->iob_datasz = handle->iob[i]->data_size;
+      //         }
+      //         else if ( new_iob_off != real_iob_off ) { //otherwise, further sanity check
+      //            LOG( LOG_ERR, "Real offset of block %d (%zd) does not match previous value of %zd!\n", i, real_iob_off, new_iob_off );
+      //            break;
+      //         }
+      //         else if ( handle->iob[i]->data_size != handle->iob_datasz ) {
+      //            LOG( LOG_ERR, "Data size of ioblock for position %d (%zd) does not match that of previous ioblocks (%zd)!\n",
+      //                           handle->iob[i]->data_size, handle->iob_datasz );
+      //            break;
+      //         }
+   }
+   // catch any error conditions by checking our index
+   if (i != (N + handle->ethreads_running))
+   {
+      handle->mode = NE_ERR; // make sure that no one tries to reuse this broken handle!
+      errno = EBADF;
+      return -1;
+   }
+
+   handle->iob_datasz = 0;                           // indicate we have to repopulate all ioblocks
+   handle->iob_offset = (tgt_stripe * partsz);       //new_iob_off;
+   return 0;
+}
+
+/**
+ * Identify the version of the object being rebuilt, by combining the CRC sums of all intact blocks
+ * NOTE -- the same value results only if the object still has the same intact blocks, holding the same data
+ * @param ne_handle handle : Handle being rebuilt
+ * @return long long : Identity of the object
+ */
+static long long rebuild_identity(ne_handle handle)
+{
+   unsigned long long objsum = 14695981039346656037ULL; // FNV-1a offset basis
+   int i;
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++)
+   {
+      unsigned long long crcsum = 0;
+      if (!(handle->thread_states[i].data_error || handle->thread_states[i].meta_error))
+      {
+         crcsum = (unsigned long long)handle->thread_states[i].minfo.crcsum;
+      }
+      objsum = (objsum ^ crcsum) * 1099511628211ULL; // FNV-1a prime
+   }
+   return (long long)objsum;
+}
+
+/**
+ * Select the point at which a rebuild should resume, based on the checkpoints left behind by an interrupted 
+ *  rebuild of the same blocks, and prepare each output thread to resume there
+ * NOTE -- output threads may have been interrupted on either side of any one checkpoint, so each block must 
+ *         have reached the selected point as of either its latest or previous checkpoint
+ * @param ne_handle handle : Handle being rebuilt
+ * @param ThreadQueue* OutTQs : Array of output ThreadQueues ( NULL for blocks without an output thread )
+ * @param gthread_state* outstates : Array of output thread states ( with checkpoints populated by write_init() )
+ * @param long long objsum : Identity of the object being rebuilt ( see rebuild_identity() )
+ * @return size_t : Number of IOs of each block which may be skipped ( zero, to rebuild from the start )
+ */
+static size_t select_resume_point(ne_handle handle, ThreadQueue *OutTQs, gthread_state *outstates, long long objsum)
+{
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t versz = handle->versz;
+   size_t resume_ios = 0;
+   char first = 1;
+   int i;
+   for (i = 0; i < N + E; i++)
+   {
+      if (OutTQs[i] == NULL)
+      {
+         continue;
+      }
+      rebuild_ckpt *ckpt = &(outstates[i].ckpt);
+      // a checkpoint of some other version of this object is of no use
+      if (ckpt->objsum != objsum || ckpt->minfo.N != N || ckpt->minfo.E != E || ckpt->minfo.O != handle->epat.O ||
+          ckpt->minfo.partsz != handle->epat.partsz || ckpt->minfo.versz != versz ||
+          ckpt->minfo.totsz != handle->totsz || ckpt->minfo.blocksz % versz || ckpt->prevsz % versz)
+      {
+         LOG(LOG_INFO, "No usable checkpoint for block %d\n", i);
+         return 0;
+      }
+      if (first || (ckpt->minfo.blocksz / versz) < resume_ios)
+      {
+         resume_ios = ckpt->minfo.blocksz / versz;
+         first = 0;
+      }
+   }
+   for (i = 0; resume_ios && i < N + E; i++)
+   {
+      if (OutTQs[i] == NULL)
+      {
+         continue;
+      }
+      rebuild_ckpt *ckpt = &(outstates[i].ckpt);
+      if ((ckpt->minfo.blocksz / versz) != resume_ios)
+      {
+         if ((ckpt->prevsz / versz) != resume_ios)
+         {
+            LOG(LOG_WARNING, "Checkpoints of block %d do not include IO %zu\n", i, resume_ios);
+            return 0;
+         }
+         ckpt->minfo.blocksz = ckpt->prevsz;
+         ckpt->minfo.crcsum = ckpt->prevcrc;
+      }
+      ckpt->prevsz = 0;
+      ckpt->prevcrc = 0;
+   }
+   return resume_ios;
+}
+
+/**
+ * Abort all output threads of a rebuild, dropping any ioblocks shared with them which they never consumed
+ * @param ThreadQueue* OutTQs : Array of output ThreadQueues ( NULL for blocks without an output thread )
+ * @param gthread_state* outstates : Array of output thread states
+ * @param int count : Number of output thread references
+ */
+static void abort_output_threads(ThreadQueue *OutTQs, gthread_state *outstates, int count)
+{
+   int i;
+   for (i = 0; i < count; i++)
+   {
+      if (OutTQs[i] != NULL)
+      {
+         tq_set_flags(OutTQs[i], TQ_ABORT);
+         tq_next_thread_status(OutTQs[i], NULL);
+         ioblock *iob = NULL;
+         while (tq_dequeue(OutTQs[i], TQ_ABORT, (void **)&iob) > 0)
+         {
+            release_shared_ioblock(iob, outstates[i].ioq);
+         }
+         tq_close(OutTQs[i]);
+      }
+   }
+   free(OutTQs);
+   free(outstates);
+}
+
 /**
  * Verify a given erasure striped object and reconstruct any damaged data, if possible
+ * NOTE -- if the DAL supports checkpoints, reconstruction progress is periodically recorded, allowing 
+ *         a rebuild which was interrupted ( by a crash, for example ) to be resumed by the next call
  * @param ne_handle handle : Handle on which to perform a rebuild
  * @param ne_erasure* epat : Erasure pattern of the object to be rebuilt
  * @param ne_state* sref : Address of an ne_state struct to be populated (ignored, if NULL)
@@ -1931,14 +5251,21 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
       free(OutTQs);
       return -1;
    }
-   // allocate space for ioblock references
-   ioblock **outblocks = calloc(N + E, sizeof(ioblock *));
-   if (outblocks == NULL)
+   // if the DAL allows, output threads periodically checkpoint their progress ( so that an interrupted rebuild 
+   // can later resume from that point )
+   DAL dal = handle->ctxt->dal;
+   char resumable = (dal->checkpoint != NULL && dal->resume != NULL);
+   size_t iodata = handle->versz - CRC_BYTES;
+   unsigned int ckpt_ios = 0;
+   if (resumable)
    {
-      LOG(LOG_ERR, "Failed to allocate space for ioblock references!\n");
-      free(OutTQs);
-      free(outstates);
-      return -1;
+      // output threads may drift apart by the data of every ioblock of an ioqueue, which must not span a checkpoint
+      ckpt_ios = (unsigned int)((REBUILD_CKPT_SPAN + iodata - 1) / iodata);
+      if (ckpt_ios < SUPER_BLOCK_MAX * ((partsz / iodata) + 1))
+      {
+         ckpt_ios = SUPER_BLOCK_MAX * ((partsz / iodata) + 1);
+      }
+      LOG(LOG_INFO, "Checkpointing rebuilt blocks every %u IOs\n", ckpt_ios);
    }
 
    LOG(LOG_INFO, "Initializing output thread states\n");
@@ -1962,9 +5289,13 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
       outstates[i].minfo.versz = handle->versz;
       outstates[i].minfo.blocksz = handle->blocksz;
       outstates[i].minfo.crcsum = 0;
-      outstates[i].minfo.totsz = 0;
+      outstates[i].minfo.totsz = handle->totsz;
       outstates[i].meta_error = 0;
       outstates[i].data_error = 0;
+      // output threads write out the regenerated ioblocks of the matching input thread, rather than copies
+      outstates[i].ioq = handle->thread_states[i].ioq;
+      outstates[i].shared_iob = 1;
+      outstates[i].ckpt_ios = ckpt_ios;
    }
 
    TQ_Init_Opts tqopts;
@@ -1980,6 +5311,8 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
    tqopts.max_qdepth = QDEPTH;
    tqopts.num_threads = 1;
    tqopts.num_prod_threads = 0;
+   tqopts.pool = handle->ctxt->io_pool;
+   tqopts.spsc = 1;
    tqopts.thread_init_func = write_init;
    tqopts.thread_consumer_func = write_consume;
    tqopts.thread_producer_func = NULL;
@@ -1989,7 +5322,7 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
    // finally, startup the output threads for each in-error block
    for (i = 0; i < handle->epat.N + handle->epat.E; i++)
    {
-      outstates[i].dmode = DAL_REBUILD;
+      outstates[i].dmode = (resumable) ? DAL_RESUME : DAL_REBUILD;
       tqopts.global_state = &(outstates[i]);
       // only initialize threads for blocks with errors
       if (handle->thread_states[i].data_error || handle->thread_states[i].meta_error)
@@ -2020,6 +5353,47 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
    }
    free(lprefstr);
 
+   // pick up where any interrupted rebuild of these blocks left off
+   size_t rebuilt = 0;
+   if (resumable)
+   {
+      long long objsum = rebuild_identity(handle);
+      size_t resume_ios = select_resume_point(handle, OutTQs, outstates, objsum);
+      for (i = 0; i < N + E; i++)
+      {
+         // new checkpoints identify the object they belong to
+         outstates[i].ckpt.objsum = objsum;
+         // every block resumes from the same offset ( or starts over, if resume_ios is zero )
+         if (resume_ios == 0)
+         {
+            outstates[i].ckpt.minfo.blocksz = 0;
+            outstates[i].ckpt.minfo.crcsum = 0;
+            outstates[i].ckpt.prevsz = 0;
+            outstates[i].ckpt.prevcrc = 0;
+         }
+         long long crcsum = outstates[i].ckpt.minfo.crcsum;
+         ssize_t blocksz = outstates[i].ckpt.minfo.blocksz;
+         cpy_minfo(&(outstates[i].ckpt.minfo), &(outstates[i].minfo));
+         outstates[i].ckpt.minfo.blocksz = blocksz;
+         outstates[i].ckpt.minfo.crcsum = crcsum;
+      }
+      if (resume_ios)
+      {
+         // reading resumes at the start of the stripe containing the resume point
+         // NOTE -- output threads discard any leading data of that stripe themselves
+         unsigned int resume_stripe = (unsigned int)((resume_ios * iodata) / partsz);
+         LOG(LOG_INFO, "Resuming rebuild at IO %zu of each block ( stripe %u )\n", resume_ios, resume_stripe);
+         if (reseek_stripes(handle, resume_stripe))
+         {
+            LOG(LOG_ERR, "Failed to reseek handle to the resume point!\n");
+            abort_output_threads(OutTQs, outstates, N + E);
+            return -1;
+         }
+         handle->sub_offset = 0;
+         rebuilt = resume_stripe * partsz * N;
+      }
+   }
+
    // unpause threads
    for (i = 0; i < N + E; i++)
    {
@@ -2027,13 +5401,6 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
       if (OutTQs[i] != NULL)
       {
          LOG(LOG_INFO, "Prepping block %d for output\n", i);
-         // initialize ioqueues
-         outstates[i].ioq = create_ioqueue(handle->versz, handle->epat.partsz, DAL_REBUILD);
-         if (outstates[i].ioq == NULL)
-         {
-            LOG(LOG_ERR, "Failed to create ioqueue for thread %d!\n", i);
-            break;
-         }
          // remove the PAUSE flag, allowing thread to begin processing
          if (tq_unset_flags(OutTQs[i], TQ_HALT))
          {
@@ -2045,27 +5412,11 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
    // abort if any errors occurred
    if (i != N + E)
    { // any 'break' condition should trigger this
-      for (; i >= 0; i--)
-      {
-         if (OutTQs[i] != NULL && outstates[i].ioq)
-         {
-            destroy_ioqueue(outstates[i].ioq);
-         }
-      }
-      for (i = 0; i < N + E; i++)
-      {
-         if (OutTQs[i] != NULL)
-         {
-            tq_set_flags(OutTQs[i], TQ_ABORT);
-            tq_next_thread_status(OutTQs[i], NULL);
-            tq_close(OutTQs[i]);
-         }
-      }
+      abort_output_threads(OutTQs, outstates, N + E);
       return -1;
    }
 
    // actually perform the rebuild
-   size_t rebuilt = 0;
    while (rebuilt < handle->totsz)
    {
       LOG(LOG_INFO, "Performing rebuild of stripes %d - %d\n", (int)(rebuilt / stripesz), (int)((rebuilt + handle->iob_datasz) / stripesz));
@@ -2076,76 +5427,27 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
          if (read_stripes(handle))
          {
             LOG(LOG_ERR, "Failed to read in additional stripes!\n");
-            for (i = 0; i < N + E; i++)
-            {
-               if (OutTQs[i] != NULL)
-               {
-                  tq_set_flags(OutTQs[i], TQ_ABORT);
-                  tq_next_thread_status(OutTQs[i], NULL);
-                  tq_close(OutTQs[i]);
-               }
-            }
+            abort_output_threads(OutTQs, outstates, N + E);
             return -1;
          }
       }
 
-      // copy ioblock data off to our writer threads
+      // hand ioblocks off to our writer threads
       for (i = 0; i < N + E; i++)
       {
-         // only copy to running output threads
+         // only hand off to running output threads
          if (OutTQs[i] != NULL)
          {
-            size_t block_cpy = 0;
-            while (block_cpy < handle->iob_datasz)
+            // the ioblock remains ours as well, until the next read_stripes() call releases it
+            LOG(LOG_INFO, "Sharing %zd bytes out to block %d\n", handle->iob_datasz, i);
+            ioblock_share(handle->iob[i]);
+            if (tq_enqueue(OutTQs[i], TQ_NONE, (void *)handle->iob[i]))
             {
-
-               // check that the current ioblock has room for our data
-               int reserved;
-               ioblock *push_block;
-               if ((reserved = reserve_ioblock(&(outblocks[i]), &(push_block), outstates[i].ioq)) == 0)
-               {
-                  void *tgt = ioblock_write_target(outblocks[i]);
-                  // copy caller data into our ioblock
-                  LOG(LOG_INFO, "Copying %zu bytes out to block %d\n", partsz, i);
-                  memcpy(tgt, handle->iob[i]->buff + block_cpy, partsz); // no error check, SEGFAULT or nothing
-                  block_cpy += partsz;
-                  ioblock_update_fill(outblocks[i], partsz, 0);
-               }
-               else if (reserved > 0)
-               {
-                  LOG(LOG_INFO, "Pushing full ioblock to block %d\n", i);
-                  // the block is full and must be pushed to our iothread
-                  if (tq_enqueue(OutTQs[i], TQ_NONE, (void *)push_block))
-                  {
-                     LOG(LOG_ERR, "Failed to push ioblock to thread_queue %d\n", i);
-                     for (i = 0; i < N + E; i++)
-                     {
-                        if (OutTQs[i] != NULL)
-                        {
-                           tq_set_flags(OutTQs[i], TQ_ABORT);
-                           tq_next_thread_status(OutTQs[i], NULL);
-                           tq_close(OutTQs[i]);
-                        }
-                     }
-                     errno = EBADF;
-                     return -1;
-                  }
-               }
-               else
-               {
-                  LOG(LOG_ERR, "Failed to reserve ioblock for position %d!\n", i);
-                  for (i = 0; i < N + E; i++)
-                  {
-                     if (OutTQs[i] != NULL)
-                     {
-                        tq_set_flags(OutTQs[i], TQ_ABORT);
-                        tq_next_thread_status(OutTQs[i], NULL);
-                        tq_close(OutTQs[i]);
-                     }
-                  }
-                  errno = EBADF;
-                  return -1;
-               }
+               LOG(LOG_ERR, "Failed to push ioblock to thread_queue %d\n", i);
+               release_shared_ioblock(handle->iob[i], handle->thread_states[i].ioq); // drop the unused share
+               abort_output_threads(OutTQs, outstates, N + E);
+               errno = EBADF;
+               return -1;
             }
          }
       } // end of per-block for-loop
@@ -2166,7 +5468,8 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
    for (i = 0; i < N + E; i++)
    {
       LOG(LOG_INFO, "Terminating output thread %d\n", i);
-      if (OutTQs[i] && terminate_thread(&(outblocks[i]), OutTQs[i], &(outstates[i]), NE_WRALL))
+      ioblock *outblock = NULL; // output threads only ever receive shared ioblocks, so we hold none of our own
+      if (OutTQs[i] && terminate_thread(&(outblock), OutTQs[i], &(outstates[i]), NE_WRALL))
       {
          LOG(LOG_ERR, "Failed to properly terminate output thread %d!\n", i);
          numerrs++;
@@ -2209,6 +5512,14 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
    }
 
    int newerrs = 0; // for checking uncorrected errors
+   // repaired input threads are restarted below, so their queues cannot remain grouped
+   if (handle->tq_group && tq_group_term(handle->tq_group))
+   {
+      LOG(LOG_ERR, "Failed to terminate the queue group\n");
+      numerrs++;
+      handle->mode = NE_ERR;
+   }
+   handle->tq_group = NULL;
    // verify thread termination and close all queues
    for (i = 0; i < N + E; i++)
    {
@@ -2217,7 +5528,6 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
          LOG(LOG_INFO, "Terminating queue %d\n", i);
          tq_next_thread_status(OutTQs[i], NULL);
          tq_close(OutTQs[i]);
-         destroy_ioqueue(outstates[i].ioq);
          // check for any output errors
          if (outstates[i].meta_error || outstates[i].data_error)
          {
@@ -2279,26 +5589,270 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref)
       }
       else if (handle->thread_states[i].meta_error || handle->thread_states[i].data_error)
       {
-         // if errors exist for which we never started output threads, record them
-         LOG(LOG_INFO, "Detected errors in block %d during rebuild\n", i);
-         newerrs++;
+         // if errors exist for which we never started output threads, record them
+         LOG(LOG_INFO, "Detected errors in block %d during rebuild\n", i);
+         newerrs++;
+      }
+   }
+   free(OutTQs);
+   free(outstates);
+
+   // any output error is a failure
+   if (numerrs > 0)
+   {
+      LOG(LOG_ERR, "Rebuild failure occurred!\n");
+      return -1;
+   }
+
+   LOG(LOG_INFO, "Rebuild completed with %d errors remaining\n", newerrs);
+
+   // indicate if uncorrected errors remain
+   return newerrs;
+}
+
+typedef struct rebuild_batch_struct
+{
+   pthread_mutex_t lock;      // lock for all of the following values
+   pthread_cond_t budget;     // signaled whenever an object releases its buffer memory
+   ne_ctxt ctxt;
+   ne_rebuild_target *targets;
+   size_t count;
+   size_t next;               // index of the next target to be claimed by a batch thread
+   size_t max_inflight;       // limit on the estimated buffer memory of all objects being rebuilt ( zero for none )
+   size_t inflight;           // estimated buffer memory of all objects currently being rebuilt
+   size_t failures;           // number of objects which could not be rebuilt
+   size_t bytes;              // total data size of all objects successfully rebuilt
+} rebuild_batch;
+
+/**
+ * Rebuild a single object of an ne_rebuild_batch() call, recording its result
+ * @param rebuild_batch* batch : Batch the object belongs to
+ * @param ne_rebuild_target* target : Object to be rebuilt
+ */
+static void rebuild_batch_target(rebuild_batch *batch, ne_rebuild_target *target)
+{
+   target->result = -1;
+   target->err = 0;
+   target->bytes = 0;
+   size_t footprint = 0;
+   // block health must be current, so any shared metadata of the object is ignored
+   ne_handle handle = probe_object(batch->ctxt, target->objID, target->loc);
+   if (handle == NULL)
+   {
+      LOG(LOG_ERR, "Failed to stat object \"%s\" for rebuild\n", target->objID);
+      target->err = (errno) ? errno : ENOENT;
+   }
+   else
+   {
+      // wait for our estimated buffer memory to fit within the limit, unless nothing else is in flight
+      // NOTE -- every block may grow to the maximum ioqueue depth, as rebuilds read sequentially
+      footprint = (size_t)(handle->epat.N + handle->epat.E) * SUPER_BLOCK_MAX * (handle->versz + handle->epat.partsz);
+      pthread_mutex_lock(&batch->lock);
+      while (batch->max_inflight && batch->inflight && batch->inflight + footprint > batch->max_inflight)
+      {
+         LOG(LOG_INFO, "Object \"%s\" awaiting buffer memory ( %zu bytes in flight )\n", target->objID, batch->inflight);
+         pthread_cond_wait(&batch->budget, &batch->lock);
+      }
+      batch->inflight += footprint;
+      pthread_mutex_unlock(&batch->lock);
+
+      if (ne_convert_handle(handle, NE_REBUILD) == NULL)
+      {
+         LOG(LOG_ERR, "Failed to convert handle of object \"%s\" for rebuild\n", target->objID);
+         target->err = (errno) ? errno : EIO;
+         free_handle(handle);
+      }
+      else
+      {
+         size_t totsz = handle->totsz;
+         errno = 0;
+         int result = ne_rebuild(handle, NULL, NULL);
+         if (result < 0)
+         {
+            LOG(LOG_ERR, "Failed to rebuild object \"%s\"\n", target->objID);
+            target->err = (errno) ? errno : EIO;
+         }
+         if (ne_close(handle, NULL, NULL) < 0 && result >= 0)
+         {
+            LOG(LOG_ERR, "Failed to close rebuilt object \"%s\"\n", target->objID);
+            target->err = (errno) ? errno : EIO;
+            result = -1;
+         }
+         target->result = result;
+         // objects which could not be rebuilt contribute nothing to the batch throughput
+         if (result >= 0)
+         {
+            target->bytes = totsz;
+         }
+      }
+   }
+
+   pthread_mutex_lock(&batch->lock);
+   batch->inflight -= footprint;
+   batch->bytes += target->bytes;
+   if (target->result < 0)
+   {
+      batch->failures++;
+   }
+   pthread_cond_broadcast(&batch->budget);
+   pthread_mutex_unlock(&batch->lock);
+}
+
+/**
+ * Rebuild objects of an ne_rebuild_batch() call, until none remain
+ * @param void* arg : Reference to the rebuild_batch
+ * @return void* : NULL
+ */
+static void *rebuild_batch_thread(void *arg)
+{
+   rebuild_batch *batch = (rebuild_batch *)arg;
+   while (1)
+   {
+      pthread_mutex_lock(&batch->lock);
+      if (batch->next >= batch->count)
+      {
+         pthread_mutex_unlock(&batch->lock);
+         break;
+      }
+      ne_rebuild_target *target = &(batch->targets[batch->next]);
+      batch->next++;
+      pthread_mutex_unlock(&batch->lock);
+      rebuild_batch_target(batch, target);
+   }
+   return NULL;
+}
+
+/**
+ * Verify and reconstruct a list of objects, several at once, overlapping the stat / read / decode / write work
+ * of each with that of the others ( equivalent to ne_stat(), ne_convert_handle(), ne_rebuild(), and ne_close() 
+ * for each object )
+ * @param ne_ctxt ctxt : Context of all objects
+ * @param ne_rebuild_target* targets : Array of objects to be rebuilt ( result values are populated for each )
+ * @param size_t count : Number of objects in the array
+ * @param ne_batch_opts* opts : Limits on concurrent rebuilds ( NULL for defaults )
+ * @param ne_batch_stats* stats : Address of an ne_batch_stats struct to be populated (ignored, if NULL)
+ * @return int : The number of objects which could not be rebuilt, or -1 on a failure of the batch itself
+ */
+int ne_rebuild_batch(ne_ctxt ctxt, ne_rebuild_target *targets, size_t count, ne_batch_opts *opts, ne_batch_stats *stats)
+{
+   if (ctxt == NULL || (targets == NULL && count))
+   {
+      LOG(LOG_ERR, "Received a NULL context or target list!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   rebuild_batch batch;
+   if (pthread_mutex_init(&batch.lock, NULL))
+   {
+      LOG(LOG_ERR, "Failed to initialize batch lock!\n");
+      return -1;
+   }
+   if (pthread_cond_init(&batch.budget, NULL))
+   {
+      LOG(LOG_ERR, "Failed to initialize batch condition variable!\n");
+      pthread_mutex_destroy(&batch.lock);
+      return -1;
+   }
+   batch.ctxt = ctxt;
+   batch.targets = targets;
+   batch.count = count;
+   batch.next = 0;
+   batch.max_inflight = (opts) ? opts->max_inflight : 0;
+   batch.inflight = 0;
+   batch.failures = 0;
+   batch.bytes = 0;
+
+   unsigned int nthreads = (opts && opts->max_objects) ? opts->max_objects : BATCH_OBJECTS;
+   if (nthreads > count)
+   {
+      nthreads = count;
+   }
+   pthread_t *threads = calloc(nthreads + 1, sizeof(pthread_t));
+   if (threads == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for batch threads!\n");
+      pthread_cond_destroy(&batch.budget);
+      pthread_mutex_destroy(&batch.lock);
+      return -1;
+   }
+   struct timespec start;
+   struct timespec end;
+   clock_gettime(CLOCK_MONOTONIC, &start);
+   LOG(LOG_INFO, "Rebuilding %zu objects, %u at a time\n", count, nthreads);
+   unsigned int started;
+   for (started = 0; started < nthreads; started++)
+   {
+      if (pthread_create(&(threads[started]), NULL, rebuild_batch_thread, &batch))
+      {
+         LOG(LOG_WARNING, "Failed to start batch thread %u, continuing with fewer threads\n", started);
+         break;
       }
    }
-   free(outblocks);
-   free(OutTQs);
-   free(outstates);
+   if (started == 0)
+   {
+      rebuild_batch_thread(&batch); // no choice but to process everything ourself
+   }
+   unsigned int i;
+   for (i = 0; i < started; i++)
+   {
+      pthread_join(threads[i], NULL);
+   }
+   clock_gettime(CLOCK_MONOTONIC, &end);
+   free(threads);
+   pthread_cond_destroy(&batch.budget);
+   pthread_mutex_destroy(&batch.lock);
 
-   // any output error is a failure
-   if (numerrs > 0)
+   LOG(LOG_INFO, "Batch rebuild completed with %zu failures\n", batch.failures);
+   if (stats)
    {
-      LOG(LOG_ERR, "Rebuild failure occurred!\n");
-      return -1;
+      stats->objects = count;
+      stats->failures = batch.failures;
+      stats->bytes = batch.bytes;
+      stats->seconds = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1000000000.0);
+      stats->throughput = (stats->seconds > 0) ? ((double)batch.bytes / stats->seconds) : 0;
    }
+   return (int)batch.failures;
+}
 
-   LOG(LOG_INFO, "Rebuild completed with %d errors remaining\n", newerrs);
+/**
+ * Adjust the readahead of all ioqueues of a read handle to suit its apparent access pattern
+ * @param ne_handle handle : Handle to be adjusted
+ */
+static void update_readahead(ne_handle handle)
+{
+   int readahead = SUPER_BLOCK_CNT - 1;
+   size_t generation = handle->thread_states[0].ioq->split_threshold * handle->epat.N;
+   if (handle->advice == NE_ADV_SEQUENTIAL)
+   {
+      readahead = SUPER_BLOCK_MAX - 1;
+   }
+   else if (handle->advice == NE_ADV_RANDOM)
+   {
+      readahead = 0;
+   }
+   else if (handle->seek_streak >= RA_RANDOM_SEEKS && handle->seq_bytes < generation)
+   {
+      readahead = 0;
+   } // repeated reseeks with only small reads between them will just waste any readahead
+   else if (handle->seq_bytes >= (RA_SEQUENTIAL_GENS * generation))
+   {
+      readahead = SUPER_BLOCK_MAX - 1;
+   } // long sequential runs can make use of deeper readahead
 
-   // indicate if uncorrected errors remain
-   return newerrs;
+   if (readahead == handle->readahead)
+   {
+      return;
+   }
+   LOG(LOG_INFO, "Adjusting readahead from %d to %d ioblocks\n", handle->readahead, readahead);
+   int i;
+   for (i = 0; i < (handle->epat.N + handle->epat.E); i++)
+   {
+      if (handle->thread_states[i].ioq && ioqueue_set_readahead(handle->thread_states[i].ioq, readahead))
+      {
+         LOG(LOG_WARNING, "Failed to set readahead of block %d to %d\n", i, readahead);
+      }
+   }
+   handle->readahead = readahead;
 }
 
 /**
@@ -2350,160 +5904,433 @@ off_t ne_seek(ne_handle handle, off_t offset)
        ((handle->iob_offset + max_data) < (tgt_stripe * partsz)))
    {
       LOG(LOG_INFO, "New offset of %zd will require threads to reseek\n", offset);
-      //      off_t new_iob_off = -1;
-      int i;
-      for (i = 0; i < (N + handle->ethreads_running); i++)
+      // track reseeks, so that random access patterns can avoid readahead
+      // NOTE -- this must precede the reseek itself, so that threads resume at the new readahead
+      size_t generation = handle->thread_states[0].ioq->split_threshold * N;
+      if (handle->seq_bytes < generation)
+      {
+         handle->seek_streak++;
+      }
+      else
+      {
+         handle->seek_streak = 1;
+      }
+      handle->seq_bytes = 0;
+      update_readahead(handle);
+      if (reseek_stripes(handle, tgt_stripe))
+      {
+         return -1;
+      }
+      handle->sub_offset = offset - (handle->iob_offset * N); //( iob_stripe * stripesz );
+   }
+   else
+   {
+      // make sure our current ioblocks are populated, as we will be skipping through them
+      if (handle->iob_datasz == 0 && offset)
       {
-         // first, pause this thread
-         if (tq_set_flags(handle->thread_queues[i], TQ_HALT))
+         if (read_stripes(handle))
          {
-            LOG(LOG_ERR, "Failed to set HALT state for block %d!\n", i);
-            break;
+            LOG(LOG_ERR, "Failed to populate initial stripes!\n");
+            return -1;
          }
-         // next, release any unneeded ioblock reference
-         if (handle->iob[i] != NULL)
+      }
+      // reset out sub_offset to the start of the ioblock data
+      handle->sub_offset = 0;
+      LOG(LOG_INFO, "Offset of %zd is within readable bounds (tgt_stripe=%d / cur_stripe=%d)\n", offset, tgt_stripe, cur_stripe);
+      // we may still be many stripes behind the given offset.  Calculate how many.
+      unsigned int munch_stripes = tgt_stripe - cur_stripe;
+      // if we're at all behind...
+      if (munch_stripes)
+      {
+         LOG(LOG_INFO, "Attempting to 'munch' %d stripes to reach offset of %zu\n", munch_stripes, offset);
+
+         // first, skip our sub_offset ahead to the next stripe boundary
+         handle->sub_offset = ((cur_stripe + 1) * stripesz) - (handle->iob_offset * N);
+
+         // just chuck buffers off of each queue until we hit the right stripe
+         unsigned int thread_munched = 1;
+         for (; thread_munched < munch_stripes; thread_munched++)
          {
-            if (release_ioblock(handle->thread_states[i].ioq))
+
+            if (handle->sub_offset >= (handle->iob_datasz * N))
             {
-               LOG(LOG_ERR, "Failed to release ioblock ref for block %d!\n", i);
-               break;
+               if (read_stripes(handle))
+               {
+                  LOG(LOG_ERR, "Failed to read additional stripes!\n");
+                  return -1;
+               }
             }
-            handle->iob[i] = NULL;
+
+            // skip to the start of the next stripe
+            handle->sub_offset += stripesz;
+         }
+         LOG(LOG_INFO, "Finished buffer 'munching'\n");
+      }
+      // add any sub-stripe offset which remains
+      handle->sub_offset += offset - (tgt_stripe * stripesz);
+   }
+   LOG(LOG_INFO, "Post seek: IOBlock_Offset=%zd, Sub_Offset=%zd\n", handle->iob_offset, handle->sub_offset);
+   return (handle->iob_offset * N) + handle->sub_offset; // should equal our target offset
+}
+
+/**
+ * Advise a read ne_handle of its expected access pattern, overriding its own detection of that pattern
+ * @param ne_handle handle : Handle to be advised (must be open for read)
+ * @param ne_advice advice : Expected access pattern ( NE_ADV_NORMAL to resume automatic detection )
+ * @return int : Zero on success, or -1 on a failure
+ */
+int ne_advise(ne_handle handle, ne_advice advice)
+{
+   // check error conditions
+   if (!(handle))
+   {
+      LOG(LOG_ERR, "Received a NULL handle!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (advice != NE_ADV_NORMAL && advice != NE_ADV_SEQUENTIAL && advice != NE_ADV_RANDOM)
+   {
+      LOG(LOG_ERR, "Received an unrecognized advice value: %d\n", (int)advice);
+      errno = EINVAL;
+      return -1;
+   }
+   if (handle->mode != NE_RDONLY && handle->mode != NE_RDALL)
+   {
+      LOG(LOG_ERR, "Handle is in improper mode for reading!\n");
+      errno = EPERM;
+      return -1;
+   }
+
+   handle->advice = advice;
+   handle->seek_streak = 0;
+   update_readahead(handle);
+   return 0;
+}
+
+/**
+ * Read from a given NE_RDONLY or NE_RDALL handle
+ * @param ne_handle handle : The ne_handle reference to read from
+ * @param off_t offset : Offset at which to read
+ * @param void* buffer : Reference to a buffer to be filled with read data
+ * @param size_t bytes : Number of bytes to be read
+ * @return ssize_t : The number of bytes successfully read, or -1 on a failure
+ */
+ssize_t ne_read(ne_handle handle, void *buffer, size_t bytes)
+{
+   // check boundary and invalid call conditions
+   if (!(handle))
+   {
+      LOG(LOG_ERR, "Received a NULL handle!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (bytes > UINT_MAX)
+   {
+      LOG(LOG_ERR, "Not yet validated for write-sizes above %lu\n", UINT_MAX);
+      errno = EFBIG; /* sort of */
+      return -1;
+   }
+   if (handle->mode != NE_RDONLY && handle->mode != NE_RDALL)
+   {
+      LOG(LOG_ERR, "Handle is in improper mode for reading!\n");
+      errno = EPERM;
+      return -1;
+   }
+   size_t offset = (handle->iob_offset * handle->epat.N) + handle->sub_offset;
+   LOG(LOG_INFO, "Called to retrieve %zu bytes at offset %zu\n", bytes, offset);
+   if ((offset + bytes) > handle->totsz)
+   {
+      if (offset >= handle->totsz)
+      {
+         LOG(LOG_WARNING, "Read is at EOF, returning 0\n");
+         return 0; //EOF
+      }
+      bytes = handle->totsz - offset;
+      LOG(LOG_WARNING, "Read would extend beyond EOF, resizing read request to %zu\n", bytes);
+   }
+
+   // get some useful reference values
+   int N = handle->epat.N;
+   ssize_t partsz = handle->epat.partsz;
+   size_t stripesz = partsz * N;
+
+   LOG(LOG_INFO, "Stripe: ( N = %d, E = %d, partsz = %zu )\n", N, handle->epat.E, partsz);
+
+   // ---------------------- BEGIN MAIN READ LOOP ----------------------
+
+   // time to start actually filling this read request
+   size_t bytes_read = 0;
+   while (bytes_read < bytes)
+   { // while data still remains to be read, loop over each stripe
+      // first, check if we need to populate additional data
+      if (handle->sub_offset >= (handle->iob_datasz * N))
+      {
+         LOG(LOG_INFO, "Reading in additional stripes (datasz=%zu/sub_offset=%zu)\n", handle->iob_datasz, handle->sub_offset);
+         if (read_stripes(handle) < 0)
+         {
+            LOG(LOG_ERR, "Failed to populate stripes beyond offset %zu!\n", offset);
+            return -1;
+         }
+      }
+
+#ifdef DEBUG
+      int iob_stripe = (int)(handle->iob_offset / stripesz);
+#endif
+      int cur_stripe = (int)(handle->sub_offset / stripesz);
+      off_t off_in_stripe = handle->sub_offset % stripesz;
+      size_t to_read_in_stripe = bytes - bytes_read;
+      if (to_read_in_stripe > (stripesz - off_in_stripe))
+      {
+         to_read_in_stripe = stripesz - off_in_stripe;
+      }
+      LOG(LOG_INFO, "Reading %zu bytes from offset %zd of stripe %d (%zu read)\n", to_read_in_stripe, off_in_stripe, cur_stripe + iob_stripe, bytes_read);
+
+      // hand large runs of complete stripes off to our erasure pool, if we have one
+      if (handle->estate && buffer && off_in_stripe == 0)
+      {
+         int stripes = (int)((bytes - bytes_read) / stripesz);
+         if (stripes > (int)(handle->iob_datasz / partsz) - cur_stripe)
+         {
+            stripes = (int)(handle->iob_datasz / partsz) - cur_stripe;
          }
-         // make sure that the thread isn't stuck waiting for ioqueue elements
-         if (tq_dequeue(handle->thread_queues[i], TQ_HALT, (void **)&(handle->iob[i])) > 0)
+         if ((stripes * partsz) >= (2 * ENCODE_SLICE_MIN))
          {
-            if (handle->iob[i] != NULL)
+            LOG(LOG_INFO, "Copying out %d stripes via the erasure pool\n", stripes);
+            if (copy_stripes(handle, buffer + bytes_read, cur_stripe, stripes))
             {
-               release_ioblock(handle->thread_states[i].ioq);
-               handle->iob[i] = NULL;
+               LOG(LOG_ERR, "Failed to copy out stripes %d-%d!\n", cur_stripe + iob_stripe, (cur_stripe + stripes - 1) + iob_stripe);
+               return -1;
             }
+            bytes_read += stripes * stripesz;
+            handle->sub_offset += stripes * stripesz;
+            continue;
          }
-         // wait for the thread to pause
-         if (tq_wait_for_pause(handle->thread_queues[i]))
+      }
+
+      // copy buffers from each block
+      int cur_block = off_in_stripe / partsz;
+      for (; cur_block < N; cur_block++)
+      {
+         ioblock *cur_iob = handle->iob[cur_block];
+         // make sure the ioblock has sufficient data
+         if ((cur_iob->data_size - (cur_stripe * partsz)) < partsz)
          {
-            LOG(LOG_ERR, "Failed to detect thread pause for block %d!\n", i);
-            break;
+            LOG(LOG_ERR, "Ioblock at position %d of stripe %d is subsized (%zu)!\n", cur_block, cur_stripe + iob_stripe, cur_iob->data_size);
+            return -1;
          }
-         // empty all remaining queue elements
-         int depth = tq_depth(handle->thread_queues[i]);
-         while (depth > 0)
+         // make sure the ioblock has no errors in this stripe
+         if (cur_iob->error_end > (cur_stripe * partsz) &&
+             (cur_stripe < handle->regen_start || cur_stripe >= handle->regen_end))
          {
-            depth = tq_dequeue(handle->thread_queues[i], TQ_HALT, (void **)&(handle->iob[i]));
-            if (depth < 0)
+            if (handle->mode != NE_RDONLY)
             {
-               LOG(LOG_ERR, "Failed to dequeue from HALTED thread_queue %d!\n", i);
-               break;
+               LOG(LOG_ERR, "Ioblock at position %d of stripe %d has an error beyond requested stripe (error_end = %zu)!\n",
+                   cur_block, cur_stripe + iob_stripe, cur_iob->error_end);
+               return -1;
+            }
+            // regenerate missing data, but only for those stripes overlapping the remainder of this read
+            int stripecnt = (int)(handle->iob_datasz / partsz);
+            int end_stripe = (int)((handle->sub_offset + (bytes - bytes_read) + (stripesz - 1)) / stripesz);
+            if (end_stripe > stripecnt)
+            {
+               end_stripe = stripecnt;
             }
-            if (handle->iob[i] != NULL)
+            LOG(LOG_INFO, "Regenerating data of stripes %d-%d\n", cur_stripe + iob_stripe, (end_stripe - 1) + iob_stripe);
+            if (regenerate_stripes(handle, cur_stripe, end_stripe, 1))
             {
-               release_ioblock(handle->thread_states[i].ioq);
-               handle->iob[i] = NULL;
+               LOG(LOG_ERR, "Failed to regenerate data for stripes %d-%d!\n", cur_stripe + iob_stripe, (end_stripe - 1) + iob_stripe);
+               return -1;
             }
-            depth--; // decrement, as dequeue depth includes the returned element
          }
-         if (depth != 0)
+         // otherwise, copy this data off to our caller's buffer
+         off_t block_off = (off_in_stripe % partsz);
+         size_t block_read = (to_read_in_stripe > (partsz - block_off)) ? (partsz - block_off) : to_read_in_stripe;
+         if (block_read == 0)
          {
             break;
-         } // catch any previous error
-         // set the thread to our target offset
-         handle->thread_states[i].offset = (tgt_stripe * partsz);
-         // unpause the thread
-         if (tq_unset_flags(handle->thread_queues[i], TQ_HALT))
+         } // if we've completed our reads, stop here
+         // check for NULL target buffer
+         if (buffer)
          {
-            LOG(LOG_ERR, "Failed to unset HALT state for block %d!\n", i);
-            break;
+            LOG(LOG_INFO, "   Reading %zu bytes from block %d\n", block_read, cur_block);
+            memcpy(buffer + bytes_read, cur_iob->buff + (cur_stripe * partsz) + block_off, block_read);
          }
-         //         // retrieve a new ioblock
-         //         if ( tq_dequeue( handle->thread_queues[i], TQ_HALT, (void**)&(handle->iob[i]) ) < 0 ) {
-         //            LOG( LOG_ERR, "Failed to retrieve ioblock for block %d after seek!\n", i );
-         //            break;
-         //         }
-         //         // by now, the thread must have updated our offset
-         //         off_t real_iob_off = handle->thread_states[i].offset;
-         //         // sanity check this value
-         //         if ( real_iob_off < 0  ||  real_iob_off > (tgt_stripe * partsz) ) {
-         //            LOG( LOG_ERR, "Real offset of block %d (%zd) is not in expected range!\n", i, real_iob_off );
-         //            break;
-         //         }
-         //         // if this is our first block, remember this value and set ioblock data size
-         //         if( new_iob_off < 0 ) {
-         //            new_iob_off = real_iob_off;
-         //            handle->iob_datasz = handle->iob[i]->data_size;
-         //         }
-         //         else if ( new_iob_off != real_iob_off ) { //otherwise, further sanity check
-         //            LOG( LOG_ERR, "Real offset of block %d (%zd) does not match previous value of %zd!\n", i, real_iob_off, new_iob_off );
-         //            break;
-         //         }
-         //         else if ( handle->iob[i]->data_size != handle->iob_datasz ) {
-         //            LOG( LOG_ERR, "Data size of ioblock for position %d (%zd) does not match that of previous ioblocks (%zd)!\n",
-         //                           handle->iob[i]->data_size, handle->iob_datasz );
-         //            break;
-         //         }
-      }
-      // catch any error conditions by checking our index
-      if (i != (N + handle->ethreads_running))
-      {
-         handle->mode = NE_ERR; // make sure that no one tries to reuse this broken handle!
-         errno = EBADF;
-         return -1;
+         else
+         {
+            LOG(LOG_INFO, "   Dropping %zu bytes from block %d\n", block_read, cur_block);
+         }
+         // update all values
+         bytes_read += block_read;
+         handle->sub_offset += block_read;
+         off_in_stripe += block_read;
+         to_read_in_stripe -= block_read;
       }
+   }
+
+   LOG(LOG_INFO, "Completed read of %zd bytes\n", bytes_read);
+
+   // long sequential runs may warrant deeper readahead
+   handle->seq_bytes += bytes_read;
+   update_readahead(handle);
+
+   return bytes_read;
+}
 
-      handle->iob_datasz = 0;                           // indicate we have to repopulate all ioblocks
-      handle->iob_offset = (tgt_stripe * partsz);       //new_iob_off;
-                                                        //      int iob_stripe = (int)( new_iob_off / partsz );
-      handle->sub_offset = offset - handle->iob_offset; //( iob_stripe * stripesz );
+/**
+ * Acquire an idle pread_state of the given handle, allocating a new one if none are available
+ * @param ne_handle handle : Handle to acquire a state from
+ * @return pread_state : Reference to the state, or NULL on failure
+ */
+static pread_state acquire_pread_state(ne_handle handle)
+{
+   if (pthread_mutex_lock(&handle->pread_lock))
+   {
+      LOG(LOG_ERR, "Failed to acquire positional read lock!\n");
+      return NULL;
    }
-   else
+   int num_blocks = handle->epat.N + handle->epat.E;
+   if (handle->pread_bad == NULL)
    {
-      // reset out sub_offset to the start of the ioblock data
-      handle->sub_offset = 0;
-      LOG(LOG_INFO, "Offset of %zd is within readable bounds (tgt_stripe=%d / cur_stripe=%d)\n", offset, tgt_stripe, cur_stripe);
-      // we may still be many stripes behind the given offset.  Calculate how many.
-      unsigned int munch_stripes = tgt_stripe - cur_stripe;
-      // if we're at all behind...
-      if (munch_stripes)
+      handle->pread_bad = calloc(num_blocks, sizeof(char));
+      if (handle->pread_bad == NULL)
       {
-         LOG(LOG_INFO, "Attempting to 'munch' %d stripes to reach offset of %zu\n", munch_stripes, offset);
+         LOG(LOG_ERR, "Failed to allocate space for a pread_bad array!\n");
+         pthread_mutex_unlock(&handle->pread_lock);
+         return NULL;
+      }
+   }
+   pread_state pstate = handle->pread_idle;
+   if (pstate)
+   {
+      handle->pread_idle = pstate->next;
+      pthread_mutex_unlock(&handle->pread_lock);
+      pstate->next = NULL;
+      return pstate;
+   }
+   pthread_mutex_unlock(&handle->pread_lock);
 
-         // first, skip our sub_offset ahead to the next stripe boundary
-         handle->sub_offset = ((cur_stripe + 1) * stripesz) - (handle->iob_offset * N);
+   // no idle states, so create a new one
+   pstate = calloc(1, sizeof(struct pread_state_struct));
+   if (pstate == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for a pread_state struct!\n");
+      return NULL;
+   }
+   pstate->blocks = calloc(num_blocks, sizeof(BLOCK_CTXT));
+   pstate->in_err = calloc(num_blocks, sizeof(unsigned char));
+   pstate->err_list = calloc(num_blocks, sizeof(unsigned char));
+   pstate->refs = calloc(handle->epat.N + num_blocks, sizeof(unsigned char *));
+   if (pstate->blocks == NULL || pstate->in_err == NULL || pstate->err_list == NULL || pstate->refs == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate space for pread_state elements!\n");
+      free_pread_state(handle, pstate);
+      return NULL;
+   }
+   return pstate;
+}
 
-         // just chuck buffers off of each queue until we hit the right stripe
-         unsigned int thread_munched = 1;
-         for (; thread_munched < munch_stripes; thread_munched++)
-         {
+/**
+ * Return a pread_state to the idle list of the given handle
+ * @param ne_handle handle : Handle to return the state to
+ * @param pread_state pstate : State to be returned
+ */
+static void release_pread_state(ne_handle handle, pread_state pstate)
+{
+   if (pthread_mutex_lock(&handle->pread_lock))
+   {
+      LOG(LOG_WARNING, "Failed to acquire positional read lock, freeing pread_state\n");
+      free_pread_state(handle, pstate);
+      return;
+   }
+   pstate->next = handle->pread_idle;
+   handle->pread_idle = pstate;
+   pthread_mutex_unlock(&handle->pread_lock);
+}
 
-            if (handle->sub_offset >= (handle->iob_datasz * N))
-            {
-               if (read_stripes(handle))
-               {
-                  LOG(LOG_ERR, "Failed to read additional stripes!\n");
-                  return -1;
-               }
-            }
+/**
+ * Check whether a previous positional read of the given handle has found bad data for the given block
+ * @param ne_handle handle : Handle to check
+ * @param int block : Index of the block to check
+ * @param char mark : If non-zero, the block will be flagged as bad for all future positional reads
+ * @return char : Non-zero if the block was already flagged as bad
+ */
+static char pread_block_bad(ne_handle handle, int block, char mark)
+{
+   pthread_mutex_lock(&handle->pread_lock);
+   char bad = handle->pread_bad[block];
+   if (mark)
+   {
+      handle->pread_bad[block] = 1;
+   }
+   pthread_mutex_unlock(&handle->pread_lock);
+   return bad;
+}
 
-            // skip to the start of the next stripe
-            handle->sub_offset += stripesz;
-         }
-         LOG(LOG_INFO, "Finished buffer 'munching'\n");
+/**
+ * Fetch and verify a span of data from a single block into the buffer of the given pread_state
+ * @param ne_handle handle : Handle to read from
+ * @param pread_state pstate : State to fetch data via
+ * @param int block : Index of the block to fetch data from
+ * @param size_t first_unit : Index of the first CRC protected unit of the block to be fetched
+ * @param size_t units : Number of units to be fetched
+ * @return int : Zero on success, or -1 if the block could not be read or failed CRC verification
+ */
+static int fetch_block_span(ne_handle handle, pread_state pstate, int block, size_t first_unit, size_t units)
+{
+   DAL dal = handle->ctxt->dal;
+   gthread_state *gstate = &(handle->thread_states[block]);
+   if (pstate->blocks[block] == NULL)
+   {
+      pstate->blocks[block] = dal->open(dal->ctxt, DAL_READ, gstate->location, handle->objID);
+      if (pstate->blocks[block] == NULL)
+      {
+         LOG(LOG_ERR, "Failed to open positional read reference for block %d!\n", block);
+         return -1;
       }
-      // add any sub-stripe offset which remains
-      handle->sub_offset += offset - (tgt_stripe * stripesz);
    }
-   LOG(LOG_INFO, "Post seek: IOBlock_Offset=%zd, Sub_Offset=%zd\n", handle->iob_offset, handle->sub_offset);
-   return (handle->iob_offset * N) + handle->sub_offset; // should equal our target offset
+   size_t unitsz = handle->versz - CRC_BYTES;
+   unsigned char *tgt = pstate->buff + (block * pstate->bufsz);
+   size_t unit;
+   // each unit is stored immediately after the data of the previous one, overwriting its already verified CRC
+   for (unit = first_unit; unit < first_unit + units; unit++, tgt += unitsz)
+   {
+      off_t unit_off = unit * handle->versz;
+      if (unit_off + CRC_BYTES >= handle->blocksz)
+      {
+         LOG(LOG_ERR, "Block %d does not contain unit %zu (blocksz=%zu)!\n", block, unit, handle->blocksz);
+         return -1;
+      }
+      ssize_t to_read = ((handle->blocksz - unit_off) < handle->versz) ? (handle->blocksz - unit_off) : handle->versz;
+      ssize_t read_data = dal->get(pstate->blocks[block], tgt, to_read, unit_off);
+      if (read_data < to_read)
+      {
+         LOG(LOG_ERR, "Expected read return value of %zd for unit %zu of block %d, but received: %zd\n",
+             to_read, unit, block, read_data);
+         return -1;
+      }
+      to_read -= CRC_BYTES;
+      uint32_t crc = crc32_ieee(CRC_SEED, tgt, to_read);
+      uint32_t scrc = *((uint32_t *)(tgt + to_read));
+      if (crc != scrc)
+      {
+         LOG(LOG_ERR, "Calculated CRC of unit %zu of block %d (%u) does not match stored CRC: %u\n", unit, block, crc, scrc);
+         return -1;
+      }
+   }
+   return 0;
 }
 
 /**
- * Read from a given NE_RDONLY or NE_RDALL handle
+ * Read from a given offset of a NE_RDONLY or NE_RDALL handle, without altering the offset of the handle.
+ * Unlike ne_read(), this may be called concurrently from any number of threads ( though not concurrently
+ * with ne_close() ), each reading directly from the blocks of the object.
  * @param ne_handle handle : The ne_handle reference to read from
- * @param off_t offset : Offset at which to read
  * @param void* buffer : Reference to a buffer to be filled with read data
  * @param size_t bytes : Number of bytes to be read
+ * @param off_t offset : Offset at which to read
  * @return ssize_t : The number of bytes successfully read, or -1 on a failure
  */
-ssize_t ne_read(ne_handle handle, void *buffer, size_t bytes)
+ssize_t ne_pread(ne_handle handle, void *buffer, size_t bytes, off_t offset)
 {
    // check boundary and invalid call conditions
    if (!(handle))
@@ -2512,9 +6339,15 @@ ssize_t ne_read(ne_handle handle, void *buffer, size_t bytes)
       errno = EINVAL;
       return -1;
    }
+   if (offset < 0)
+   {
+      LOG(LOG_ERR, "Received a negative offset: %zd\n", offset);
+      errno = EINVAL;
+      return -1;
+   }
    if (bytes > UINT_MAX)
    {
-      LOG(LOG_ERR, "Not yet validated for write-sizes above %lu\n", UINT_MAX);
+      LOG(LOG_ERR, "Not yet validated for read-sizes above %lu\n", UINT_MAX);
       errno = EFBIG; /* sort of */
       return -1;
    }
@@ -2524,8 +6357,7 @@ ssize_t ne_read(ne_handle handle, void *buffer, size_t bytes)
       errno = EPERM;
       return -1;
    }
-   size_t offset = (handle->iob_offset * handle->epat.N) + handle->sub_offset;
-   LOG(LOG_INFO, "Called to retrieve %zu bytes at offset %zu\n", bytes, offset);
+   LOG(LOG_INFO, "Called to retrieve %zu bytes at offset %zd\n", bytes, offset);
    if ((offset + bytes) > handle->totsz)
    {
       if (offset >= handle->totsz)
@@ -2536,88 +6368,160 @@ ssize_t ne_read(ne_handle handle, void *buffer, size_t bytes)
       bytes = handle->totsz - offset;
       LOG(LOG_WARNING, "Read would extend beyond EOF, resizing read request to %zu\n", bytes);
    }
+   if (bytes == 0)
+   {
+      return 0;
+   }
 
    // get some useful reference values
    int N = handle->epat.N;
-   ssize_t partsz = handle->epat.partsz;
+   int E = handle->epat.E;
+   size_t partsz = handle->epat.partsz;
    size_t stripesz = partsz * N;
+   size_t unitsz = handle->versz - CRC_BYTES;
+   size_t span_stripes = PREAD_SPAN / partsz;
+   if (span_stripes == 0)
+   {
+      span_stripes = 1;
+   }
 
-   LOG(LOG_INFO, "Stripe: ( N = %d, E = %d, partsz = %zu )\n", N, handle->epat.E, partsz);
-
-   // ---------------------- BEGIN MAIN READ LOOP ----------------------
+   pread_state pstate = acquire_pread_state(handle);
+   if (pstate == NULL)
+   {
+      LOG(LOG_ERR, "Failed to acquire a pread_state!\n");
+      return -1;
+   }
 
-   // time to start actually filling this read request
    size_t bytes_read = 0;
+   size_t last_stripe = ((offset + bytes) - 1) / stripesz;
    while (bytes_read < bytes)
-   { // while data still remains to be read, loop over each stripe
-      // first, check if we need to populate additional data
-      if (handle->sub_offset >= (handle->iob_datasz * N))
+   {
+      // determine the span of stripes to be fetched, and the units of each block covering them
+      size_t first_stripe = (offset + bytes_read) / stripesz;
+      size_t end_stripe = last_stripe + 1;
+      if ((end_stripe - first_stripe) > span_stripes)
       {
-         LOG(LOG_INFO, "Reading in additional stripes (datasz=%zu/sub_offset=%zu)\n", handle->iob_datasz, handle->sub_offset);
-         if (read_stripes(handle) < 0)
+         end_stripe = first_stripe + span_stripes;
+      }
+      size_t span_start = first_stripe * partsz;
+      size_t span_len = (end_stripe - first_stripe) * partsz;
+      size_t first_unit = span_start / unitsz;
+      size_t units = (((span_start + span_len) + (unitsz - 1)) / unitsz) - first_unit;
+      size_t lead = span_start - (first_unit * unitsz); // offset of the first stripe within each fetched span
+      // make sure our buffers can hold every unit, plus the trailing CRC of the final unit
+      size_t bufsz = (units * unitsz) + CRC_BYTES;
+      if (bufsz > pstate->bufsz)
+      {
+         free(pstate->buff);
+         pstate->buff = malloc((N + E) * bufsz);
+         if (pstate->buff == NULL)
          {
-            LOG(LOG_ERR, "Failed to populate stripes beyond offset %zu!\n", offset);
-            return -1;
+            LOG(LOG_ERR, "Failed to allocate %zu bytes of positional read buffers!\n", (N + E) * bufsz);
+            pstate->bufsz = 0;
+            break;
          }
+         pstate->bufsz = bufsz;
       }
 
-#ifdef DEBUG
-      int iob_stripe = (int)(handle->iob_offset / stripesz);
-#endif
-      int cur_stripe = (int)(handle->sub_offset / stripesz);
-      off_t off_in_stripe = handle->sub_offset % stripesz;
-      size_t to_read_in_stripe = bytes - bytes_read;
-      if (to_read_in_stripe > (stripesz - off_in_stripe))
+      // fetch all data blocks, then as many erasure blocks as are needed to replace any in error
+      int nerrs = 0;
+      int ndata_errs = 0;
+      int good = 0;
+      int block;
+      for (block = 0; block < (N + E); block++)
       {
-         to_read_in_stripe = stripesz - off_in_stripe;
+         pstate->in_err[block] = 0;
+         if (good == N)
+         {
+            continue;
+         } // no further blocks required
+         if (pread_block_bad(handle, block, 0) || fetch_block_span(handle, pstate, block, first_unit, units))
+         {
+            if (!(pread_block_bad(handle, block, 1)))
+            {
+               LOG(LOG_WARNING, "Detected bad data for block %d, which future positional reads will skip\n", block);
+            }
+            pstate->in_err[block] = 1;
+            pstate->err_list[nerrs] = block;
+            nerrs++;
+            if (block < N)
+            {
+               ndata_errs++;
+            }
+            continue;
+         }
+         good++;
+      }
+      if (good < N)
+      {
+         LOG(LOG_ERR, "Errors exceed erasure limits for stripes %zu-%zu!\n", first_stripe, end_stripe - 1);
+         errno = ENODATA;
+         break;
       }
-      LOG(LOG_INFO, "Reading %zu bytes from offset %zd of stripe %d (%zu read)\n", to_read_in_stripe, off_in_stripe, cur_stripe + iob_stripe, bytes_read);
 
-      // copy buffers from each block
-      int cur_block = off_in_stripe / partsz;
-      for (; cur_block < N; cur_block++)
+      // regenerate any missing data
+      if (ndata_errs)
       {
-         ioblock *cur_iob = handle->iob[cur_block];
-         // make sure the ioblock has sufficient data
-         if ((cur_iob->data_size - (cur_stripe * partsz)) < partsz)
+         encode_tables *etbls = get_encode_tables(handle->ctxt, N, E);
+         decode_plan *plan = NULL;
+         if (etbls)
          {
-            LOG(LOG_ERR, "Ioblock at position %d of stripe %d is subsized (%zu)!\n", cur_block, cur_stripe + iob_stripe, cur_iob->data_size);
-            return -1;
+            plan = get_decode_plan(handle->ctxt, etbls, pstate->in_err, pstate->err_list, nerrs);
          }
-         // make sure the ioblock has no errors in this stripe
-         if (cur_iob->error_end > (cur_stripe * partsz))
+         if (plan == NULL)
          {
-            LOG(LOG_ERR, "Ioblock at position %d of stripe %d has an error beyond requested stripe (error_end = %zu)!\n",
-                cur_block, cur_stripe + iob_stripe, cur_iob->error_end);
-            return -1;
+            LOG(LOG_ERR, "Failed to acquire a decode plan for stripes %zu-%zu!\n", first_stripe, end_stripe - 1);
+            release_encode_tables(handle->ctxt, etbls);
+            break;
          }
-         // otherwise, copy this data off to our caller's buffer
-         off_t block_off = (off_in_stripe % partsz);
-         size_t block_read = (to_read_in_stripe > (partsz - block_off)) ? (partsz - block_off) : to_read_in_stripe;
-         if (block_read == 0)
+         // data errors always make up the head of our error list, and thus the initial rows of our decode tables
+         for (block = 0; block < N; block++)
+         {
+            pstate->refs[block] = pstate->buff + (plan->decode_index[block] * pstate->bufsz) + lead;
+         }
+         for (block = 0; block < ndata_errs; block++)
+         {
+            pstate->refs[N + block] = pstate->buff + (pstate->err_list[block] * pstate->bufsz) + lead;
+         }
+         LOG(LOG_INFO, "Regenerating data of stripes %zu-%zu from erasure\n", first_stripe, end_stripe - 1);
+         ec_encode_data(span_len, N, ndata_errs, plan->g_tbls, pstate->refs, &(pstate->refs[N]));
+         release_decode_plan(handle->ctxt, plan);
+         release_encode_tables(handle->ctxt, etbls);
+      }
+
+      // copy the requested portion of each part out to our caller's buffer
+      while (bytes_read < bytes)
+      {
+         size_t cur_off = offset + bytes_read;
+         size_t cur_stripe = cur_off / stripesz;
+         if (cur_stripe >= end_stripe)
          {
             break;
-         } // if we've completed our reads, stop here
-         // check for NULL target buffer
-         if (buffer)
+         }
+         int cur_block = (int)((cur_off % stripesz) / partsz);
+         size_t block_off = cur_off % partsz;
+         size_t block_read = partsz - block_off;
+         if (block_read > (bytes - bytes_read))
          {
-            LOG(LOG_INFO, "   Reading %zu bytes from block %d\n", block_read, cur_block);
-            memcpy(buffer + bytes_read, cur_iob->buff + (cur_stripe * partsz) + block_off, block_read);
+            block_read = bytes - bytes_read;
          }
-         else
+         if (buffer)
          {
-            LOG(LOG_INFO, "   Dropping %zu bytes from block %d\n", block_read, cur_block);
+            memcpy(buffer + bytes_read,
+                   pstate->buff + (cur_block * pstate->bufsz) + lead + ((cur_stripe - first_stripe) * partsz) + block_off,
+                   block_read);
          }
-         // update all values
          bytes_read += block_read;
-         handle->sub_offset += block_read;
-         off_in_stripe += block_read;
-         to_read_in_stripe -= block_read;
       }
    }
 
-   LOG(LOG_INFO, "Completed read of %zd bytes\n", bytes_read);
-
+   release_pread_state(handle, pstate);
+   if (bytes_read < bytes)
+   {
+      LOG(LOG_ERR, "Failed to complete positional read of %zu bytes at offset %zd!\n", bytes, offset);
+      return -1;
+   }
+   LOG(LOG_INFO, "Completed positional read of %zu bytes\n", bytes_read);
    return bytes_read;
 }
 
@@ -2662,26 +6566,6 @@ ssize_t ne_write(ne_handle handle, const void *buffer, size_t bytes)
    unsigned int stripenum = offset / stripesz;
 #endif
 
-   // initialize erasure structs (these never change for writes, so we can just check here)
-   if (handle->e_ready == 0)
-   {
-      LOG(LOG_INFO, "Initializing erasure matricies...\n");
-      // Generate an encoding matrix
-      // NOTE: The matrix generated by gf_gen_rs_matrix is not always invertable for N>=6 and E>=5!
-      gf_gen_cauchy1_matrix(handle->encode_matrix, N + E, N);
-      // Generate g_tbls from encode matrix
-      ec_init_tables(N, E, &(handle->encode_matrix[N * N]), handle->g_tbls);
-
-      handle->e_ready = 1;
-   }
-   // allocate space for our buffer references
-   void **tgt_refs = calloc(N + E, sizeof(char *));
-   if (tgt_refs == NULL)
-   {
-      LOG(LOG_ERR, "Failed to allocate space for a target buffer array!\n");
-      return -1;
-   }
-
    int outblock = (offset % stripesz) / partsz;  //determine what block we're filling
    size_t to_write = partsz - (offset % partsz); //determine if we need to finish writing a data part
 
@@ -2696,6 +6580,15 @@ ssize_t ne_write(ne_handle handle, const void *buffer, size_t bytes)
    {
       ioblock *push_block = NULL;
       int reserved;
+      // if we are about to push full ioblocks, first generate erasure for all of their stripes
+      if (outblock == 0 && to_write == partsz && handle->e_pending && stripe_write_space(handle) == 0)
+      {
+         if (dispatch_pending_stripes(handle))
+         {
+            errno = EBADF;
+            return -1;
+         }
+      }
       // check that the current ioblock has room for our data
       if ((to_write < partsz) ||
           (reserved = reserve_ioblock(&(handle->iob[outblock]), &(push_block), handle->thread_states[outblock].ioq)) == 0)
@@ -2736,18 +6629,9 @@ ssize_t ne_write(ne_handle handle, const void *buffer, size_t bytes)
          // check if we have completed a stripe
          if (outblock == (N + E))
          {
-            LOG(LOG_INFO, "Generating erasure parts for stripe %u\n", stripenum);
-            // build an array of data/erasure references while reseting outblock to zero
-            for (outblock -= 1; outblock >= 0; outblock--)
-            {
-               // previously written data will be one partsz behind
-               tgt_refs[outblock] = ioblock_write_target(handle->iob[outblock]) - partsz;
-            }
-            // generate erasure parts
-            ec_encode_data(partsz, N, E, handle->g_tbls,
-                           (unsigned char **)tgt_refs,
-                           (unsigned char **)&(tgt_refs[N]));
-            // reset outblock
+            // erasure generation is deferred until the ioblocks are full
+            LOG(LOG_INFO, "Completed stripe %u\n", stripenum);
+            handle->e_pending++;
             outblock = 0;
          }
       }
@@ -2755,11 +6639,10 @@ ssize_t ne_write(ne_handle handle, const void *buffer, size_t bytes)
       {
          LOG(LOG_INFO, "Pushing full ioblock to thread %d\n", outblock);
          // the block is full and must be pushed to our iothread
-         if (tq_enqueue(handle->thread_queues[outblock], TQ_NONE, (void *)push_block))
+         if (push_ioblock(handle, outblock, push_block))
          {
             LOG(LOG_ERR, "Failed to push ioblock to thread_queue %d\n", outblock);
             errno = EBADF;
-            free(tgt_refs);
             return -1;
          }
          //NOOOOOOOOO!!!!! outblock++;
@@ -2768,7 +6651,6 @@ ssize_t ne_write(ne_handle handle, const void *buffer, size_t bytes)
       {
          LOG(LOG_ERR, "Failed to reserve ioblock for position %d!\n", outblock);
          errno = EBADF;
-         free(tgt_refs);
          return -1;
       }
 
@@ -2780,7 +6662,108 @@ ssize_t ne_write(ne_handle handle, const void *buffer, size_t bytes)
    }
 
    // we have output all data
-   free(tgt_refs);
+   return written;
+}
+
+/**
+ * Retrieve references to the handle's internal data part buffers, allowing the caller to fill
+ * complete stripes in place ( avoiding the memcpy of ne_write() )
+ * NOTE -- the handle must be stripe-aligned ( i.e. all previous writes must have totaled a multiple of N * partsz )
+ * @param ne_handle handle : The NE_WRONLY or NE_WRALL ne_handle reference to retrieve buffers from
+ * @param void** parts : Array of (at least) N buffer references, to be populated such that stripe 's' of
+ *                       data part 'i' may be filled at ( parts[i] + (s * partsz) )
+ * @return int : The number of complete stripes the buffers have room for, or -1 on a failure
+ */
+int ne_get_write_buffers(ne_handle handle, void **parts)
+{
+   if (check_stripe_writable(handle))
+   {
+      return -1;
+   }
+   if (parts == NULL)
+   {
+      LOG(LOG_ERR, "Received a NULL parts reference!\n");
+      errno = EINVAL;
+      return -1;
+   }
+
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   // encode any stripes in ioblocks which are about to be pushed
+   if (handle->iob[0] != NULL && stripe_write_space(handle) == 0 && dispatch_pending_stripes(handle))
+   {
+      errno = EBADF;
+      return -1;
+   }
+   int block;
+   // make sure every block has an ioblock with room for at least one more part
+   for (block = 0; block < (N + E); block++)
+   {
+      ioblock *push_block = NULL;
+      int reserved;
+      while ((reserved = reserve_ioblock(&(handle->iob[block]), &(push_block), handle->thread_states[block].ioq)) > 0)
+      {
+         LOG(LOG_INFO, "Pushing full ioblock to thread %d\n", block);
+         if (push_ioblock(handle, block, push_block))
+         {
+            LOG(LOG_ERR, "Failed to push ioblock to thread_queue %d\n", block);
+            errno = EBADF;
+            return -1;
+         }
+      }
+      if (reserved < 0)
+      {
+         LOG(LOG_ERR, "Failed to reserve ioblock for position %d!\n", block);
+         errno = EBADF;
+         return -1;
+      }
+      if (block < N)
+      {
+         parts[block] = ioblock_write_target(handle->iob[block]);
+      }
+   }
+
+   int stripes = stripe_write_space(handle);
+   LOG(LOG_INFO, "Provided buffers for %d stripes at offset %zd\n", stripes, handle->sub_offset);
+   return stripes;
+}
+
+/**
+ * Commit stripes previously filled via the buffers of ne_get_write_buffers() to the given handle
+ * @param ne_handle handle : The ne_handle reference to write to
+ * @param int stripes : Number of complete stripes which have been filled ( must not exceed the
+ *                      count returned by the preceding ne_get_write_buffers() call )
+ * @return ssize_t : The number of bytes successfully written, or -1 on a failure
+ */
+ssize_t ne_write_stripes(ne_handle handle, int stripes)
+{
+   if (check_stripe_writable(handle))
+   {
+      return -1;
+   }
+
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t partsz = handle->epat.partsz;
+   if (handle->iob[0] == NULL || stripes < 0 || stripes > stripe_write_space(handle))
+   {
+      LOG(LOG_ERR, "Stripe count of %d exceeds the space provided by ne_get_write_buffers()!\n", stripes);
+      errno = EINVAL;
+      return -1;
+   }
+
+   // erasure generation is deferred until the ioblocks are full
+   handle->e_pending += stripes;
+
+   // include the new stripes in each ioblock
+   int block;
+   for (block = 0; block < (N + E); block++)
+   {
+      ioblock_update_fill(handle->iob[block], stripes * partsz, 0);
+   }
+   size_t written = stripes * N * partsz;
+   handle->sub_offset += written;
+   handle->totsz += written;
    return written;
 }
 
@@ -124,6 +124,13 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
       NE_REBUILD            //5  -- rebuild an existing object
    } ne_mode;
 
+   typedef enum
+   {
+      NE_ADV_NORMAL = 0, // detect the access pattern of the handle, adjusting readahead to suit
+      NE_ADV_SEQUENTIAL, // expect reads to stream through the object, maximizing readahead
+      NE_ADV_RANDOM      // expect seeks followed by small reads, only fetching data as it is needed
+   } ne_advice;
+
 #define MAX_QDEPTH 2
 #define MAX_RD_QDEPTH 3 /* (unused) */
 
@@ -158,6 +165,38 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
       int scatter;
    } ne_location;
 
+   typedef struct ne_hedge_stats_struct
+   {
+      size_t hedged_reads;  // number of read_stripes() calls which hedged around at least one slow data block
+      size_t hedged_blocks; // total number of data ioblocks regenerated from erasure, rather than waited for
+   } ne_hedge_stats;
+
+   typedef struct ne_rebuild_target_struct
+   {
+      const char *objID; // object to be rebuilt
+      ne_location loc;   // location of the object
+      int result;        // populated with the ne_rebuild() result for the object ( negative, if it could not be rebuilt )
+      int err;           // populated with the errno value of any failure
+      size_t bytes;      // populated with the data size of the object, once rebuilt ( zero, if it could not be )
+   } ne_rebuild_target;
+
+   typedef struct ne_batch_opts_struct
+   {
+      unsigned int max_objects; // maximum number of objects rebuilt at once, each by its own thread 
+                                //    ( zero for the default; see ne_set_io_threads() to also bound I/O threads )
+      size_t max_inflight;      // maximum estimated buffer memory of all objects being rebuilt at once, in bytes
+                                //    ( zero for no limit; a single object is always admitted, regardless of size )
+   } ne_batch_opts;
+
+   typedef struct ne_batch_stats_struct
+   {
+      size_t objects;    // number of objects processed
+      size_t failures;   // number of objects which could not be rebuilt
+      size_t bytes;      // total data size of all objects successfully rebuilt
+      double seconds;    // elapsed time of the batch
+      double throughput; // aggregate rate at which object data was rebuilt, in bytes per second
+   } ne_batch_stats;
+
    /*
  ---  Initialization/Termination functions, to produce and destroy a ne_ctxt  ---
 */
@@ -184,8 +223,110 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
  */
    ne_ctxt ne_path_init(const char *path, ne_location max_loc, int max_block);
 
+   /**
+ * Set the number of erasure encoding threads to be started for each write handle of the given ne_ctxt.
+ * With encoding threads, parity generation for filled ioblocks overlaps with further ne_write() calls.
+ * NOTE -- this only affects handles opened after the call
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param int threads : Number of encoding threads per write handle ( zero to encode on the calling thread )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+   int ne_set_encode_threads(ne_ctxt ctxt, int threads);
+
+   /**
+ * Set the number of erasure decoding threads to be started for each read handle of the given ne_ctxt.
+ * With decoding threads, regeneration of missing data and large ne_read() copies are split across threads.
+ * NOTE -- this only affects handles opened after the call
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param int threads : Number of decoding threads per read handle ( zero to decode on the calling thread )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+   int ne_set_decode_threads(ne_ctxt ctxt, int threads);
+
+   /**
+ * Configure hedged reads for NE_RDONLY handles of the given ne_ctxt
+ * When the next ioblock of a data block is slower to arrive than the hedging threshold, erasure threads
+ * are started and that block is regenerated from the first N blocks to arrive, instead.
+ * The threshold is the greater of 'threshold_ms' and 'median_mult' times the rolling median latency of
+ * that handle's data blocks ( never less than one millisecond ).  Passing zero for both disables hedging.
+ * NOTE -- this only affects handles opened after the call
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param unsigned int threshold_ms : Fixed hedging threshold, in milliseconds ( zero for none )
+ * @param unsigned int median_mult : Multiple of the median ioblock latency to hedge beyond ( zero for none )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+   int ne_set_hedging(ne_ctxt ctxt, unsigned int threshold_ms, unsigned int median_mult);
+
+   /**
+ * Set the number of threads in a pool shared by all handles of the given ne_ctxt to perform block I/O.
+ * By default, every handle starts a dedicated I/O thread for each of its N+E blocks.  With a shared pool, 
+ * the block I/O of all handles is instead serviced by a fixed number of threads, which may be far fewer 
+ * than the total number of open blocks.
+ * NOTE -- this only affects handles opened after the call, and will fail ( errno == EBUSY ) if any 
+ *         handles using a previously configured pool remain open
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param int threads : Number of shared I/O threads ( zero to start dedicated I/O threads for each block of each handle )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+   int ne_set_io_threads(ne_ctxt ctxt, int threads);
+
+   /**
+ * Set the number of threads used by ne_stat() calls of the given ne_ctxt to probe block metadata.
+ * By default, the metadata and data of all blocks are probed concurrently by a small set of threads, 
+ * started on first use and shared by all ne_stat() calls of the context.  Blocks beyond the width agreed 
+ * upon by MIN_MD_CONSENSUS blocks are not waited for.
+ * NOTE -- this must not be called while any ne_stat() calls of the context are in progress
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param int threads : Number of stat threads ( zero to probe each block in turn )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+   int ne_set_stat_threads(ne_ctxt ctxt, int threads);
+
+   /**
+ * Configure caching of object metadata by the given ne_ctxt.  Once enabled, the consensus metadata of 
+ * each object opened or stat'd through the context is retained ( for objects whose blocks all agree ), 
+ * allowing later NE_RDONLY / NE_RDALL handles of that object to read the metadata of only a single block, 
+ * rather than that of every block.  Cached metadata which that block disagrees with is discarded.
+ * NOTE -- only writes and deletions performed through this context invalidate cached metadata outright; if 
+ *         other processes may rewrite objects, a TTL should be set accordingly
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param unsigned int objects : Maximum number of objects to retain metadata for ( zero to disable caching )
+ * @param unsigned int ttl_msec : Time after which cached metadata is discarded ( zero for no expiry )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+   int ne_set_meta_cache(ne_ctxt ctxt, unsigned int objects, unsigned int ttl_msec);
+
+   /**
+ * Attach the given ne_ctxt to a metadata cache file shared with other processes ( typically under /dev/shm ).  
+ * The file holds a fixed number of slots, each recording the consensus metadata, block CRC sums, and known 
+ * bad blocks of an object, as determined by any attached process.  ne_stat() calls of attached contexts then 
+ * use a recorded object without probing any blocks, and read handles verify it against the metadata of a 
+ * single block, rather than reading that of every block.  Readers never lock the file, and objects whose 
+ * slots are being updated are simply treated as uncached.
+ * NOTE -- writes, rebuilds, and deletions through any attached context discard the recorded object
+ * NOTE -- recorded objects are only used once ne_set_meta_cache() has configured a non-zero TTL, and are 
+ *         ignored once older than that, so that blocks failing after an object was recorded are eventually 
+ *         reported; ne_rebuild_batch() always probes every block
+ * NOTE -- objects of more than 64 blocks are never recorded, nor are objects with IDs of 256 or more characters
+ * NOTE -- this must not be called while any handles of the context are in use
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param const char* path : Path of the cache file ( NULL to detach from any file )
+ * @param unsigned int slots : Number of objects the file may hold, if it must be created
+ * @return int : Zero on a success, and -1 on a failure
+ */
+   int ne_set_shared_meta_cache(ne_ctxt ctxt, const char *path, unsigned int slots);
+
+   /**
+ * Retrieve counters of all hedging performed by handles of the given ne_ctxt
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be queried
+ * @param ne_hedge_stats* stats : Reference to the ne_hedge_stats struct to be populated
+ * @return int : Zero on a success, and -1 on a failure
+ */
+   int ne_get_hedge_stats(ne_ctxt ctxt, ne_hedge_stats *stats);
+
    /**
  * Destroys an existing ne_ctxt
+ * NOTE -- this will fail ( errno == EBUSY ) if any handles of the context remain open
  * @param ne_ctxt ctxt : Reference to the ne_ctxt to be destroyed
  * @return int : Zero on a success, and -1 on a failure
  */
@@ -276,6 +417,8 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 
    /**
  * Verify a given erasure striped object and reconstruct any damaged data, if possible
+ * NOTE -- if the DAL supports checkpoints, reconstruction progress is periodically recorded, allowing 
+ *         a rebuild which was interrupted ( by a crash, for example ) to be resumed by the next call
  * @param ne_handle handle : Handle on which to perform a rebuild
  * @param ne_erasure* epat : Erasure pattern of the object to be rebuilt
  * @param ne_state* sref : Address of an ne_state struct to be populated (ignored, if NULL)
@@ -284,6 +427,19 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
  */
    int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref);
 
+   /**
+ * Verify and reconstruct a list of objects, several at once, overlapping the stat / read / decode / write work
+ * of each with that of the others ( equivalent to ne_stat(), ne_convert_handle(), ne_rebuild(), and ne_close() 
+ * for each object )
+ * @param ne_ctxt ctxt : Context of all objects
+ * @param ne_rebuild_target* targets : Array of objects to be rebuilt ( result values are populated for each )
+ * @param size_t count : Number of objects in the array
+ * @param ne_batch_opts* opts : Limits on concurrent rebuilds ( NULL for defaults )
+ * @param ne_batch_stats* stats : Address of an ne_batch_stats struct to be populated (ignored, if NULL)
+ * @return int : The number of objects which could not be rebuilt, or -1 on a failure of the batch itself
+ */
+   int ne_rebuild_batch(ne_ctxt ctxt, ne_rebuild_target *targets, size_t count, ne_batch_opts *opts, ne_batch_stats *stats);
+
    /**
  * Seek to a new offset on a read ne_handle
  * @param ne_handle handle : Handle on which to seek (must be open for read)
@@ -292,6 +448,14 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
  */
    off_t ne_seek(ne_handle handle, off_t offset);
 
+   /**
+ * Advise a read ne_handle of its expected access pattern, overriding its own detection of that pattern
+ * @param ne_handle handle : Handle to be advised (must be open for read)
+ * @param ne_advice advice : Expected access pattern ( NE_ADV_NORMAL to resume automatic detection )
+ * @return int : Zero on success, or -1 on a failure
+ */
+   int ne_advise(ne_handle handle, ne_advice advice);
+
    /**
  * Read from a given NE_RDONLY or NE_RDALL handle
  * @param ne_handle handle : The ne_handle reference to read from
@@ -301,6 +465,18 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
  */
    ssize_t ne_read(ne_handle handle, void *buffer, size_t bytes);
 
+   /**
+ * Read from a given offset of a NE_RDONLY or NE_RDALL handle, without altering the offset of the handle.
+ * Unlike ne_read(), this may be called concurrently from any number of threads ( though not concurrently
+ * with ne_close() ), each reading directly from the blocks of the object.
+ * @param ne_handle handle : The ne_handle reference to read from
+ * @param void* buffer : Reference to a buffer to be filled with read data
+ * @param size_t bytes : Number of bytes to be read
+ * @param off_t offset : Offset at which to read
+ * @return ssize_t : The number of bytes successfully read, or -1 on a failure
+ */
+   ssize_t ne_pread(ne_handle handle, void *buffer, size_t bytes, off_t offset);
+
    /**
  * Write to a given NE_WRONLY or NE_WRALL handle
  * @param ne_handle handle : The ne_handle reference to write to
@@ -310,6 +486,26 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
  */
    ssize_t ne_write(ne_handle handle, const void *buffer, size_t nbytes);
 
+   /**
+ * Retrieve references to the handle's internal data part buffers, allowing the caller to fill
+ * complete stripes in place ( avoiding the memcpy of ne_write() )
+ * NOTE -- the handle must be stripe-aligned ( i.e. all previous writes must have totaled a multiple of N * partsz )
+ * @param ne_handle handle : The NE_WRONLY or NE_WRALL ne_handle reference to retrieve buffers from
+ * @param void** parts : Array of (at least) N buffer references, to be populated such that stripe 's' of
+ *                       data part 'i' may be filled at ( parts[i] + (s * partsz) )
+ * @return int : The number of complete stripes the buffers have room for, or -1 on a failure
+ */
+   int ne_get_write_buffers(ne_handle handle, void **parts);
+
+   /**
+ * Commit stripes previously filled via the buffers of ne_get_write_buffers() to the given handle
+ * @param ne_handle handle : The ne_handle reference to write to
+ * @param int stripes : Number of complete stripes which have been filled ( must not exceed the
+ *                      count returned by the preceding ne_get_write_buffers() call )
+ * @return ssize_t : The number of bytes successfully written, or -1 on a failure
+ */
+   ssize_t ne_write_stripes(ne_handle handle, int stripes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,276 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#define _GNU_SOURCE // for RTLD_NEXT
+#include "ne/ne.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+#include <sys/uio.h>
+
+
+#define TEST_N 4
+#define TEST_E 2
+#define TEST_WIDTH ( TEST_N + TEST_E )
+#define TEST_PARTSZ 4096
+#define TEST_TOTSZ ( TEST_N * TEST_PARTSZ * 40 )  // ten 4-part ioblocks per block
+#define READ_SIZE 50000   // deliberately misaligned with both parts and stripes
+#define SLOW_BLOCK 1      // data block whose reads are delayed
+#define SLOW_USEC 200000  // delay of each slowed read, well beyond HEDGE_MSEC
+#define HEDGE_MSEC 20
+
+char* dal_config = "<DAL type=\"posix\"><dir_template>./test_libne_hedge.block{b}</dir_template>"
+                   "<sec_root></sec_root><io_size>16384</io_size></DAL>";
+char* objID = "hedge";
+ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+ne_erasure epat = { .N = TEST_N, .E = TEST_E, .O = 0, .partsz = TEST_PARTSZ };
+
+
+// the posix DAL reads blocks via preadv(), which we intercept to delay reads of SLOW_BLOCK
+ssize_t (*real_preadv)( int fd, const struct iovec* iov, int iovcnt, off_t offset ) = NULL;
+char slow_name[64];  // trailing portion of the path of the data file of SLOW_BLOCK
+int slow_left = 0;   // number of reads of SLOW_BLOCK still to be delayed
+int slowed = 0;      // number of reads of SLOW_BLOCK delayed so far
+
+char is_slow_fd( int fd ) {
+   char fdpath[64];
+   char path[4096];
+   snprintf( fdpath, sizeof(fdpath), "/proc/self/fd/%d", fd );
+   ssize_t len = readlink( fdpath, path, sizeof(path) - 1 );
+   if ( len < 0 ) { return 0; }
+   path[len] = '\0';
+   size_t namelen = strlen( slow_name );
+   return ( len >= namelen  &&  strcmp( path + ( len - namelen ), slow_name ) == 0 );
+}
+
+ssize_t preadv( int fd, const struct iovec* iov, int iovcnt, off_t offset ) {
+   if ( __atomic_load_n( &slow_left, __ATOMIC_SEQ_CST ) > 0  &&  is_slow_fd( fd )  &&
+        __atomic_sub_fetch( &slow_left, 1, __ATOMIC_SEQ_CST ) >= 0 ) {
+      usleep( SLOW_USEC );
+      __atomic_add_fetch( &slowed, 1, __ATOMIC_SEQ_CST );
+   }
+   return real_preadv( fd, iov, iovcnt, offset );
+}
+
+
+
+// every byte of the object identifies its own offset, so that data of any other stripe is never mistaken for it
+char pattern_byte( size_t offset ) {
+   return (char)( ( offset / 4 ) >> ( ( offset % 4 ) * 8 ) );
+}
+
+int write_object( ne_ctxt ctxt ) {
+   char* data = malloc( TEST_TOTSZ );
+   if ( data == NULL ) {
+      printf( "ERROR: Failed to allocate object data!\n" );
+      return -1;
+   }
+   size_t pos;
+   for ( pos = 0; pos < TEST_TOTSZ; pos++ ) { data[pos] = pattern_byte( pos ); }
+   ne_handle handle = ne_open( ctxt, objID, loc, epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open object for write!\n" );
+      free( data );
+      return -1;
+   }
+   ssize_t written = ne_write( handle, data, TEST_TOTSZ );
+   free( data );
+   if ( written != TEST_TOTSZ ) {
+      printf( "ERROR: Failed to write object ( %zd bytes written )!\n", written );
+      ne_close( handle, NULL, NULL );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failed to close object after write!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+// read and verify the object from the given offset up to 'endoff'
+int read_range( ne_handle handle, char* buff, size_t offset, size_t endoff ) {
+   if ( ne_seek( handle, offset ) != offset ) {
+      printf( "ERROR: Failed to seek to offset %zu!\n", offset );
+      return -1;
+   }
+   while ( offset < endoff ) {
+      size_t readsz = ( endoff - offset < READ_SIZE ) ? endoff - offset : READ_SIZE;
+      ssize_t res = ne_read( handle, buff, readsz );
+      if ( res != readsz ) {
+         printf( "ERROR: Unexpected return value from ne_read at offset %zu: %zd\n", offset, res );
+         return -1;
+      }
+      size_t pos;
+      for ( pos = 0; pos < readsz; pos++ ) {
+         if ( buff[pos] != pattern_byte( offset + pos ) ) {
+            printf( "ERROR: Read data mismatch at offset %zu!\n", offset + pos );
+            return -1;
+         }
+      }
+      offset += readsz;
+   }
+   return 0;
+}
+
+// read the object with the given number of slowed reads of SLOW_BLOCK, re-reading from the start after 'seekoff'
+int hedged_read( ne_ctxt ctxt, int slowcnt, size_t seekoff ) {
+   char* buff = malloc( READ_SIZE );
+   if ( buff == NULL ) {
+      printf( "ERROR: Failed to allocate read buffer!\n" );
+      return -1;
+   }
+   ne_handle handle = ne_open( ctxt, objID, loc, epat, NE_RDONLY );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open object for read!\n" );
+      free( buff );
+      return -1;
+   }
+   __atomic_store_n( &slowed, 0, __ATOMIC_SEQ_CST );
+   __atomic_store_n( &slow_left, slowcnt, __ATOMIC_SEQ_CST );
+   // once the slowed reads are exhausted, SLOW_BLOCK is read promptly again, and the late ioblocks given up on 
+   //  are still to arrive ahead of those we now want.  Correct data beyond that point means they were dropped.
+   int ret = 0;
+   if ( read_range( handle, buff, 0, seekoff )  ||  read_range( handle, buff, 0, TEST_TOTSZ ) ) { ret = -1; }
+   free( buff );
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failed to close object after a hedged read!\n" );
+      ret = -1;
+   }
+   __atomic_store_n( &slow_left, 0, __ATOMIC_SEQ_CST );
+   if ( ret == 0  &&  __atomic_load_n( &slowed, __ATOMIC_SEQ_CST ) != slowcnt ) {
+      printf( "ERROR: Expected %d slowed reads of block %d, but only %d occurred!\n", slowcnt, SLOW_BLOCK, slowed );
+      ret = -1;
+   }
+   return ret;
+}
+
+int check_hedge_stats( ne_ctxt ctxt, size_t* prevblocks ) {
+   ne_hedge_stats hstats;
+   if ( ne_get_hedge_stats( ctxt, &hstats ) ) {
+      printf( "ERROR: Failed to retrieve hedging stats!\n" );
+      return -1;
+   }
+   printf( "...hedged %zu data blocks across %zu reads...\n", hstats.hedged_blocks, hstats.hedged_reads );
+   if ( hstats.hedged_blocks <= *prevblocks  ||  hstats.hedged_reads == 0  ||  hstats.hedged_reads > hstats.hedged_blocks ) {
+      printf( "ERROR: Slow reads of block %d were not hedged against!\n", SLOW_BLOCK );
+      return -1;
+   }
+   *prevblocks = hstats.hedged_blocks;
+   return 0;
+}
+
+
+
+int main( int argc, char** argv ) {
+   setvbuf( stdout, NULL, _IONBF, 0 );
+   real_preadv = dlsym( RTLD_NEXT, "preadv" );
+   if ( real_preadv == NULL ) {
+      printf( "ERROR: Failed to locate preadv()!\n" );
+      return -1;
+   }
+   snprintf( slow_name, sizeof(slow_name), "/test_libne_hedge.block%d%s", SLOW_BLOCK, objID );
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return -1;
+   }
+   ne_ctxt ctxt = ne_init( xmlDocGetRootElement( config ), loc, TEST_WIDTH );
+   xmlFreeDoc( config );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+   int ret = 0;
+   size_t hedged = 0;
+   if ( write_object( ctxt ) ) { ret = -1; }
+   else if ( ne_set_hedging( ctxt, HEDGE_MSEC, 0 ) ) {
+      printf( "ERROR: Failed to configure hedged reads!\n" );
+      ret = -1;
+   }
+   else {
+      // a couple of slow reads, followed by prompt ones
+      printf( "Reading with a transiently slow data block...\n" );
+      if ( hedged_read( ctxt, 2, 0 )  ||  check_hedge_stats( ctxt, &hedged ) ) { ret = -1; }
+      // slow reads outstanding across a seek, which must also discard the late ioblocks
+      printf( "Re-reading after a seek, with late ioblocks outstanding...\n" );
+      if ( ret == 0  &&  ( hedged_read( ctxt, 3, TEST_TOTSZ / 3 )  ||  check_hedge_stats( ctxt, &hedged ) ) ) { ret = -1; }
+   }
+   // without hedging, slow reads are simply waited upon
+   if ( ret == 0 ) {
+      printf( "Reading a slow data block without hedging...\n" );
+      ne_hedge_stats hstats;
+      if ( ne_set_hedging( ctxt, 0, 0 )  ||  hedged_read( ctxt, 1, 0 )  ||
+           ne_get_hedge_stats( ctxt, &hstats )  ||  hstats.hedged_blocks != hedged ) {
+         printf( "ERROR: Unexpected hedging of a read with hedging disabled!\n" );
+         ret = -1;
+      }
+   }
+   if ( ne_delete( ctxt, objID, loc ) ) {
+      printf( "ERROR: Failed to delete object!\n" );
+      ret = -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failed to terminate ne_ctxt!\n" );
+      ret = -1;
+   }
+   xmlCleanupParser();
+   return ret;
+}
@@ -63,12 +63,49 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <unistd.h>
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
 
 
 // sentinel values to ensure good data transfer
 char tail_sent = 'T';
 unsigned int crc_sent = UINT_MAX;
 
+// DAL configurations to test against
+#define DIR_CACHE_ROOT "./test_libne_io.pod0"
+char* dal_configs[] = {
+   // plain posix
+   "<DAL type=\"posix\"><dir_template>./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}</dir_template>"
+   "<sec_root></sec_root></DAL>",
+   // io_uring, with registered buffers
+   "<DAL type=\"posix_uring\"><dir_template>./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}</dir_template>"
+   "<sec_root></sec_root><reg_buffers>16</reg_buffers></DAL>",
+   // O_DIRECT, with the default I/O size
+   "<DAL type=\"posix\"><dir_template>./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}</dir_template>"
+   "<sec_root></sec_root><direct_io/></DAL>",
+   // O_DIRECT, with an I/O size which is not sector aligned
+   "<DAL type=\"posix\"><dir_template>./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}</dir_template>"
+   "<sec_root></sec_root><direct_io/><io_size>100003</io_size></DAL>",
+   // cached directory handles
+   "<DAL type=\"posix\"><dir_template>" DIR_CACHE_ROOT "/block{b}.cap{c}.scatter{s}</dir_template>"
+   "<sec_root></sec_root><dir_cache>4</dir_cache></DAL>"
+};
+char* dal_config = NULL; // configuration of the current pass
+
+
+ne_ctxt init_ctxt( int max_block ) {
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return NULL;
+   }
+   ne_location max_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_init( xmlDocGetRootElement( config ), max_loc, max_block );
+   xmlFreeDoc( config );
+   return ctxt;
+}
+
 
 size_t fill_buffer( size_t prev_data, size_t iosz, size_t partsz, void* buffer ) {
    size_t to_write = iosz;
@@ -202,8 +239,8 @@ size_t verify_data( size_t prev_ver, size_t partsz, size_t buffsz, void* buffer
 
 
 
-int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
-   printf( "\nTesting basic libne capabilities with iosz=%zu / partsz=%zu\n", iosz, partsz );
+int test_values( ne_erasure* epat, size_t iosz, size_t partsz, int ethreads ) {
+   printf( "\nTesting basic libne capabilities with iosz=%zu / partsz=%zu / ethreads=%d\n", iosz, partsz, ethreads );
 
    void* iobuff = malloc( iosz );
    if ( iobuff == NULL ) {
@@ -213,11 +250,24 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
 
    // create a new libne ctxt
    ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
-   ne_ctxt ctxt = ne_path_init ( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E );
+   ne_ctxt ctxt = init_ctxt( epat->N + epat->E );
    if ( ctxt == NULL ) {
       printf( "ERROR: Failed to initialize ne_ctxt!\n" );
       return -1;
    }
+   if ( ne_set_encode_threads( ctxt, ethreads ) ) {
+      printf( "ERROR: Failed to set encoding thread count!\n" );
+      return -1;
+   }
+   if ( ne_set_decode_threads( ctxt, ethreads ) ) {
+      printf( "ERROR: Failed to set decoding thread count!\n" );
+      return -1;
+   }
+   // with erasure threads, also service all block I/O from a shared pool smaller than N+E
+   if ( ethreads  &&  ne_set_io_threads( ctxt, ethreads + 1 ) ) {
+      printf( "ERROR: Failed to set I/O thread count!\n" );
+      return -1;
+   }
 
    // open a write handle
    printf( "Writing out data stripe...\n" );
@@ -249,6 +299,13 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
    printf( "...write handle closed...\n" );
 
 
+   // hedge aggressively against slow data blocks, to exercise that logic as well
+   //  ( test_libne_hedge verifies hedging itself, against a deterministically slow block )
+   if ( ne_set_hedging( ctxt, 1, 4 ) ) {
+      printf( "ERROR: Failed to configure hedged reads!\n" );
+      return -1;
+   }
+
    // open a read handle to verify our data
    printf( "...Verifying written data (RDONLY)...\n" );
    ne_handle read_handle = ne_open( ctxt, "", cur_loc, *epat, NE_RDONLY );
@@ -290,11 +347,56 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
          return -1;
       }
    }
+   // seek backwards to a part ( but not stripe ) aligned offset, and re-read from there
+   size_t totsz = iosz * iocnt;
+   off_t seekoff = ( ( totsz / 3 ) / partsz ) * partsz + partsz;
+   if ( seekoff < totsz ) {
+      size_t seeksz = ( totsz - seekoff < iosz ) ? totsz - seekoff : iosz;
+      printf( "...seeking to offset %zd to re-read, with random access advice...\n", seekoff );
+      if ( ne_advise( read_handle, NE_ADV_RANDOM ) ) {
+         printf( "ERROR: Failed to advise handle of random access!\n" );
+         return -1;
+      }
+      if ( ne_seek( read_handle, seekoff ) != seekoff ) {
+         printf( "ERROR: Failed to seek to offset %zd!\n", seekoff );
+         return -1;
+      }
+      ssize_t readsz = 0;
+      if ( (readsz = ne_read( read_handle, iobuff, seeksz )) != seeksz ) {
+         printf( "ERROR: Unexpected return value from ne_read following seek: %zd\n", readsz );
+         return -1;
+      }
+      if ( seeksz != verify_data( seekoff, partsz, seeksz, iobuff ) ) {
+         printf( "ERROR: Failed to verify data buffer following seek!\n" );
+         return -1;
+      }
+   }
+   // perform a positional read from an unaligned offset, which should not disturb the handle offset
+   off_t preadoff = ( totsz / 2 ) + 7;
+   if ( preadoff < totsz ) {
+      size_t preadsz = ( totsz - preadoff < iosz ) ? totsz - preadoff : iosz;
+      printf( "...positional read of %zu bytes at offset %zd...\n", preadsz, preadoff );
+      ssize_t readsz = 0;
+      if ( (readsz = ne_pread( read_handle, iobuff, preadsz, preadoff )) != preadsz ) {
+         printf( "ERROR: Unexpected return value from ne_pread: %zd\n", readsz );
+         return -1;
+      }
+      if ( preadsz != verify_data( preadoff, partsz, preadsz, iobuff ) ) {
+         printf( "ERROR: Failed to verify data buffer following positional read!\n" );
+         return -1;
+      }
+   }
    // close our handle
    if ( ne_close( read_handle, NULL, NULL ) ) {
       printf( "ERROR: Failure of ne_close!\n" );
       return -1;
    }
+   ne_hedge_stats hstats;
+   if ( ne_get_hedge_stats( ctxt, &hstats ) ) {
+      printf( "ERROR: Failed to retrieve hedging stats!\n" );
+      return -1;
+   }
+   printf( "...hedged %zu data blocks across %zu reads...\n", hstats.hedged_blocks, hstats.hedged_reads );
 
 
    // open a read handle to verify our data
@@ -330,6 +432,12 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
       printf( "ERROR: Failed to open a ne_stat handle!\n" );
       return -1;
    }
+   // the context cannot be terminated while any handle remains open ( even one referencing no erasure structs )
+   errno = 0;
+   if ( ne_term( ctxt ) == 0  ||  errno != EBUSY ) {
+      printf( "ERROR: ne_term did not fail with EBUSY while a handle remained open!\n" );
+      return -1;
+   }
    // convert to a RD_ONLY handle
    read_handle = ne_convert_handle( stat_handle, NE_RDONLY );
    if ( read_handle == NULL ) {
@@ -374,17 +482,275 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
 
 
 
-int main( int argc, char** argv ) {
+int test_stripe_write( ne_erasure* epat, int stripecnt ) {
+   size_t partsz = epat->partsz;
+   size_t stripesz = epat->N * partsz;
+   printf( "\nTesting libne stripe writes with partsz=%zu / stripes=%d\n", partsz, stripecnt );
+
+   void* iobuff = malloc( stripesz );
+   void** parts = calloc( epat->N, sizeof( void* ) );
+   if ( iobuff == NULL  ||  parts == NULL ) {
+      printf( "ERROR: Failed to allocate space for test buffers!\n" );
+      return -1;
+   }
+
+   // create a new libne ctxt
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = init_ctxt( epat->N + epat->E );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+
+   // open a write handle
+   ne_handle write_handle = ne_open( ctxt, "", cur_loc, *epat, NE_WRALL );
+   if ( write_handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle!\n" );
+      return -1;
+   }
+   // fill stripes directly into the handle's buffers
+   int stripe = 0;
+   while ( stripe < stripecnt ) {
+      int avail = ne_get_write_buffers( write_handle, parts );
+      if ( avail <= 0 ) {
+         printf( "ERROR: Unexpected return value from ne_get_write_buffers: %d\n", avail );
+         return -1;
+      }
+      if ( avail > (stripecnt - stripe) ) { avail = stripecnt - stripe; }
+      int s;
+      for ( s = 0; s < avail; s++ ) {
+         int i;
+         for ( i = 0; i < epat->N; i++ ) {
+            size_t prev_data = ((stripe + s) * stripesz) + (i * partsz);
+            if ( partsz != fill_buffer( prev_data, partsz, partsz, parts[i] + (s * partsz) ) ) {
+               printf( "ERROR: Failed to populate part buffer!\n" );
+               return -1;
+            }
+         }
+      }
+      if ( ne_write_stripes( write_handle, avail ) != (avail * stripesz) ) {
+         printf( "ERROR: Unexpected return value from ne_write_stripes!\n" );
+         return -1;
+      }
+      stripe += avail;
+   }
+   if ( ne_close( write_handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // read back and verify our data
+   ne_handle read_handle = ne_open( ctxt, "", cur_loc, *epat, NE_RDALL );
+   if ( read_handle == NULL ) {
+      printf( "ERROR: Failed to open a read handle!\n" );
+      return -1;
+   }
+   for ( stripe = 0; stripe < stripecnt; stripe++ ) {
+      if ( stripesz != ne_read( read_handle, iobuff, stripesz ) ) {
+         printf( "ERROR: Unexpected return value from ne_read!\n" );
+         return -1;
+      }
+      if ( stripesz != verify_data( stripe * stripesz, partsz, stripesz, iobuff ) ) {
+         printf( "ERROR: Failed to verify data buffer!\n" );
+         return -1;
+      }
+   }
+   if ( ne_close( read_handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // delete our test object
+   if ( ne_delete( ctxt, "", cur_loc ) ) {
+      printf( "ERROR: Failed to delete written object!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( parts );
+   free( iobuff );
+
+   return 0;
+}
+
+
+
+// state shared by all threads reading from a single handle
+#define PREAD_THREADS 4
+#define PREAD_COUNT 12
+typedef struct pread_state_struct {
+   ne_handle handle;
+   unsigned char* source;
+   size_t totsz;
+   unsigned int seed;
+   int errors;
+} pread_state;
+
+
+// issue reads of varying sizes at pseudo-random offsets, verifying each against the source data
+void* pread_thread( void* arg ) {
+   pread_state* state = (pread_state*)arg;
+   unsigned char* buffer = malloc( state->totsz );
+   if ( buffer == NULL ) {
+      printf( "ERROR: Failed to allocate space for a pread buffer!\n" );
+      state->errors++;
+      return NULL;
+   }
+   int i;
+   for ( i = 0; i < PREAD_COUNT; i++ ) {
+      size_t offset = rand_r( &state->seed ) % state->totsz;
+      // mostly small reads, with occasional large ones spanning many stripes
+      size_t bytes = 1 + ( rand_r( &state->seed ) % ( ( i % 5 ) ? 70000 : 600000 ) );
+      // and some reads near, or beyond, the end of the object
+      if ( ( i % 7 ) == 0 ) { offset = state->totsz - 1 - ( rand_r( &state->seed ) % 5000 ); }
+      size_t expected = ( offset + bytes > state->totsz ) ? state->totsz - offset : bytes;
+      ssize_t result = ne_pread( state->handle, buffer, bytes, offset );
+      if ( result != expected ) {
+         printf( "ERROR: Unexpected return value from ne_pread of %zu bytes at offset %zu: %zd\n", bytes, offset, result );
+         state->errors++;
+         break;
+      }
+      if ( memcmp( buffer, state->source + offset, expected ) ) {
+         printf( "ERROR: Failed to verify ne_pread of %zu bytes at offset %zu!\n", bytes, offset );
+         state->errors++;
+         break;
+      }
+   }
+   free( buffer );
+   return NULL;
+}
+
+
+
+int test_pread( ne_erasure* epat ) {
+   size_t totsz = ( 3 * 1048576 ) + 4321;
+   printf( "\nTesting concurrent libne preads with partsz=%zu / totsz=%zu\n", epat->partsz, totsz );
+   unsigned char* source = malloc( totsz );
+   unsigned char* iobuff = malloc( totsz );
+   if ( source == NULL  ||  iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for test buffers!\n" );
+      return -1;
+   }
+   unsigned int seed = (unsigned int)epat->partsz;
+   size_t i;
+   for ( i = 0; i < totsz; i++ ) { source[i] = (unsigned char) rand_r( &seed ); }
+
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = init_ctxt( epat->N + epat->E );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+   ne_handle handle = ne_open( ctxt, "", cur_loc, *epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle!\n" );
+      return -1;
+   }
+   if ( ne_write( handle, source, totsz ) != totsz ) {
+      printf( "ERROR: Unexpected return value from ne_write!\n" );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // many threads issue preads against a single handle, while the master streams through it sequentially
+   handle = ne_open( ctxt, "", cur_loc, *epat, NE_RDONLY );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a read handle!\n" );
+      return -1;
+   }
+   pthread_t threads[PREAD_THREADS];
+   pread_state states[PREAD_THREADS];
+   int t;
+   for ( t = 0; t < PREAD_THREADS; t++ ) {
+      states[t] = (pread_state){ .handle = handle, .source = source, .totsz = totsz, .seed = t + 1, .errors = 0 };
+      if ( pthread_create( &threads[t], NULL, pread_thread, &states[t] ) ) {
+         printf( "ERROR: Failed to create pread thread %d!\n", t );
+         return -1;
+      }
+   }
+   size_t readsz = 0;
+   ssize_t result;
+   while ( ( result = ne_read( handle, iobuff + readsz, 1000000 ) ) > 0 ) { readsz += result; }
+   int errors = 0;
+   for ( t = 0; t < PREAD_THREADS; t++ ) {
+      pthread_join( threads[t], NULL );
+      errors += states[t].errors;
+   }
+   if ( result < 0  ||  readsz != totsz  ||  memcmp( source, iobuff, totsz ) ) {
+      printf( "ERROR: Failed to verify sequential ne_read of %zu bytes, concurrent with preads!\n", readsz );
+      return -1;
+   }
+   if ( errors ) {
+      printf( "ERROR: %d pread threads failed to verify their data!\n", errors );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   if ( ne_delete( ctxt, "", cur_loc ) ) {
+      printf( "ERROR: Failed to delete written object!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( iobuff );
+   free( source );
+   return 0;
+}
+
+
+
+int test_config( void ) {
+   printf( "\nTesting DAL configuration: %s\n", dal_config );
    // Test with a small partsz and larger, aligned iosz
    size_t iosz = 8196;
    size_t partsz = 4096;
    ne_erasure epat = { .N = 10, .E = 2, .O = 1, .partsz = 1024 };
-   if ( test_values( &epat, iosz, partsz ) ) { return -1; }
+   if ( test_values( &epat, iosz, partsz, 0 ) ) { return -1; }
    // Test with a larger partsz and much larger iosz
    partsz = 524288;
    iosz = 1048576;
    epat.partsz = partsz;
-   if ( test_values( &epat, iosz, partsz ) ) { return -1; }
+   if ( test_values( &epat, iosz, partsz, 0 ) ) { return -1; }
+   // Test with erasure generated ( and regenerated ) by pools of erasure threads
+   if ( test_values( &epat, iosz, partsz, 4 ) ) { return -1; }
+   epat.partsz = 4096;
+   if ( test_values( &epat, iosz, 4096, 2 ) ) { return -1; }
+   // Test filling stripes directly into libne buffers
+   epat.partsz = 1024;
+   if ( test_stripe_write( &epat, 25 ) ) { return -1; }
+   // Test concurrent preads from a single handle, with parts both smaller and larger than the I/O size
+   epat.partsz = 4096;
+   if ( test_pread( &epat ) ) { return -1; }
+   epat.partsz = 524288;
+   if ( test_pread( &epat ) ) { return -1; }
+
+   return 0;
+}
+
+
+
+int main( int argc, char** argv ) {
+   if ( mkdir( DIR_CACHE_ROOT, 0755 )  &&  errno != EEXIST ) {
+      printf( "ERROR: Failed to create directory \"%s\"!\n", DIR_CACHE_ROOT );
+      return -1;
+   }
+   int config;
+   for ( config = 0; config < sizeof( dal_configs ) / sizeof( char* ); config++ ) {
+      dal_config = dal_configs[config];
+      if ( test_config() ) { return -1; }
+   }
+   rmdir( DIR_CACHE_ROOT );
+   xmlCleanupParser();
 
    return 0;
 }
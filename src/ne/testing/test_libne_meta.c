@@ -0,0 +1,490 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#include "ne/ne.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/wait.h>
+
+
+#define TEST_N 8
+#define TEST_E 2
+#define TEST_O 3
+#define TEST_WIDTH ( TEST_N + TEST_E )
+#define KEEP_BLOCK 0   // block whose meta info remains visible while that of all others is hidden
+#define STAT_LEN 256
+
+char* dal_config = "<DAL type=\"posix\"><dir_template>./test_libne_meta.block{b}</dir_template>"
+                   "<sec_root></sec_root></DAL>";
+char* shm_path = "./test_libne_meta.shm";
+ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+ne_erasure epat = { .N = TEST_N, .E = TEST_E, .O = TEST_O, .partsz = 4096 };
+
+
+ne_ctxt init_ctxt( void ) {
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return NULL;
+   }
+   ne_ctxt ctxt = ne_init( xmlDocGetRootElement( config ), loc, TEST_WIDTH );
+   xmlFreeDoc( config );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+   }
+   return ctxt;
+}
+
+
+
+// path of the data ( or, with a non-NULL suffix, the meta ) file of the given block of an object
+void block_path( char* path, int block, const char* objID, const char* suffix ) {
+   sprintf( path, "./test_libne_meta.block%d%s%s", block, objID, ( suffix ) ? suffix : "" );
+}
+
+
+
+int write_object( ne_ctxt ctxt, const char* objID, char fill, size_t totsz ) {
+   char* data = malloc( totsz );
+   if ( data == NULL ) {
+      printf( "ERROR: Failed to allocate data of object \"%s\"!\n", objID );
+      return -1;
+   }
+   memset( data, fill, totsz );
+   ne_handle handle = ne_open( ctxt, objID, loc, epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open object \"%s\" for write!\n", objID );
+      free( data );
+      return -1;
+   }
+   ssize_t written = ne_write( handle, data, totsz );
+   free( data );
+   if ( written != totsz ) {
+      printf( "ERROR: Failed to write object \"%s\" ( %zd bytes written )!\n", objID, written );
+      ne_close( handle, NULL, NULL );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failed to close object \"%s\" after write!\n", objID );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+// read the given object, returning zero only if it holds exactly the expected data and no damaged blocks were found
+int read_object( ne_ctxt ctxt, const char* objID, char fill, size_t totsz, ne_mode mode ) {
+   ne_handle handle = ne_open( ctxt, objID, loc, epat, mode );
+   if ( handle == NULL ) { return -1; }
+   char* data = malloc( totsz + 4096 );
+   if ( data == NULL ) {
+      printf( "ERROR: Failed to allocate read buffer for object \"%s\"!\n", objID );
+      ne_close( handle, NULL, NULL );
+      return -1;
+   }
+   size_t got = 0;
+   ssize_t readsz;
+   while ( (readsz = ne_read( handle, data + got, ( totsz + 4096 ) - got )) > 0 ) { got += readsz; }
+   int ret = ( readsz < 0  ||  got != totsz ) ? -1 : 0;
+   size_t pos;
+   for ( pos = 0; ret == 0  &&  pos < got; pos++ ) {
+      if ( data[pos] != fill ) { ret = -1; }
+   }
+   free( data );
+   int closeret = ne_close( handle, NULL, NULL );
+   if ( ret == 0 ) { ret = closeret; } // positive, if any blocks were found to be damaged
+   return ret;
+}
+
+
+
+// summarize the ne_stat() result for the given object as a string, returning -1 if the stat fails
+int stat_object( ne_ctxt ctxt, const char* objID, char* summary ) {
+   ne_handle handle = ne_stat( ctxt, objID, loc );
+   if ( handle == NULL ) { return -1; }
+   ne_erasure stat_epat;
+   char meta_status[TEST_WIDTH];
+   char data_status[TEST_WIDTH];
+   ne_state state = { .meta_status = meta_status, .data_status = data_status, .csum = NULL };
+   int ret = ne_get_info( handle, &stat_epat, &state );
+   int len = sprintf( summary, "ret=%d N=%d E=%d O=%d partsz=%zu totsz=%zu meta=", ret, stat_epat.N, stat_epat.E, 
+                      stat_epat.O, stat_epat.partsz, state.totsz );
+   int block;
+   for ( block = 0; block < TEST_WIDTH; block++ ) { len += sprintf( summary + len, "%d", meta_status[block] ); }
+   len += sprintf( summary + len, " data=" );
+   for ( block = 0; block < TEST_WIDTH; block++ ) { len += sprintf( summary + len, "%d", data_status[block] ); }
+   ne_close( handle, NULL, NULL );
+   return 0;
+}
+
+
+
+// hide ( or restore ) the meta info of every block of an object, except that of KEEP_BLOCK ( unless 'all' is set )
+void hide_meta( const char* objID, int hide, int all ) {
+   int block;
+   for ( block = 0; block < TEST_WIDTH; block++ ) {
+      if ( block == KEEP_BLOCK  &&  !(all) ) { continue; }
+      char meta[256];
+      char hidden[256];
+      block_path( meta, block, objID, ".meta" );
+      block_path( hidden, block, objID, ".meta.hidden" );
+      if ( hide ) { rename( meta, hidden ); }
+      else { rename( hidden, meta ); }
+   }
+}
+
+
+
+int test_stat_threads( ne_ctxt ctxt ) {
+   char* objs[] = { "stat_clean", "stat_nodata", "stat_nometa", "stat_badmeta", "stat_missing" };
+   int objcnt = sizeof( objs ) / sizeof( char* );
+   int obj;
+   for ( obj = 0; obj < objcnt - 1; obj++ ) {
+      if ( write_object( ctxt, objs[obj], 'S', 777777 ) ) { return -1; }
+   }
+   // damage all but the first object
+   char path[256];
+   block_path( path, 4, objs[1], NULL );
+   unlink( path );
+   block_path( path, 4, objs[1], ".meta" );
+   unlink( path );
+   int block;
+   for ( block = 0; block < 3; block++ ) {
+      block_path( path, block, objs[2], ".meta" );
+      unlink( path );
+   }
+   block_path( path, 5, objs[3], ".meta" );
+   FILE* badmeta = fopen( path, "w" );
+   if ( badmeta == NULL ) {
+      printf( "ERROR: Failed to overwrite meta info of object \"%s\"!\n", objs[3] );
+      return -1;
+   }
+   fprintf( badmeta, "garbage\n" );
+   fclose( badmeta );
+
+   // every object must be reported identically, whether blocks are probed in turn or concurrently
+   int ret = 0;
+   for ( obj = 0; obj < objcnt; obj++ ) {
+      char serial[STAT_LEN];
+      char threaded[STAT_LEN];
+      ne_set_stat_threads( ctxt, 0 );
+      int serialret = stat_object( ctxt, objs[obj], serial );
+      if ( ne_set_stat_threads( ctxt, 3 ) ) {
+         printf( "ERROR: Failed to set stat threads!\n" );
+         return -1;
+      }
+      int threadedret = stat_object( ctxt, objs[obj], threaded );
+      printf( "Stat of \"%s\": %s\n", objs[obj], ( serialret ) ? "failed" : serial );
+      if ( serialret != threadedret  ||  ( serialret == 0  &&  strcmp( serial, threaded ) ) ) {
+         printf( "ERROR: Threaded stat of \"%s\" differs: %s\n", objs[obj], ( threadedret ) ? "failed" : threaded );
+         ret = -1;
+      }
+      if ( ( serialret != 0 ) != ( obj == objcnt - 1 ) ) {
+         printf( "ERROR: Unexpected stat result for object \"%s\"!\n", objs[obj] );
+         ret = -1;
+      }
+   }
+   for ( obj = 0; obj < objcnt - 1; obj++ ) {
+      if ( ne_delete( ctxt, objs[obj], loc ) ) {
+         printf( "ERROR: Failed to delete object \"%s\"!\n", objs[obj] );
+         ret = -1;
+      }
+   }
+   return ret;
+}
+
+
+
+int test_meta_cache( ne_ctxt ctxt ) {
+   // without a cache, a read reports the blocks lacking meta info
+   if ( write_object( ctxt, "cache", 'A', 500000 ) ) { return -1; }
+   hide_meta( "cache", 1, 0 );
+   int ret = read_object( ctxt, "cache", 'A', 500000, NE_RDALL );
+   hide_meta( "cache", 0, 0 );
+   if ( ret == 0 ) {
+      printf( "ERROR: Blocks lacking meta info were not reported!\n" );
+      return -1;
+   }
+   if ( ne_set_meta_cache( ctxt, 4, 0 ) ) {
+      printf( "ERROR: Failed to enable the meta info cache!\n" );
+      return -1;
+   }
+   // once cached, that of a single block is sufficient
+   if ( read_object( ctxt, "cache", 'A', 500000, NE_RDALL ) ) {
+      printf( "ERROR: Failed to read object with an empty cache!\n" );
+      return -1;
+   }
+   hide_meta( "cache", 1, 0 );
+   if ( read_object( ctxt, "cache", 'A', 500000, NE_RDALL )  ||  read_object( ctxt, "cache", 'A', 500000, NE_RDONLY ) ) {
+      printf( "ERROR: Failed to read object from cached meta info!\n" );
+      hide_meta( "cache", 0, 0 );
+      return -1;
+   }
+   hide_meta( "cache", 0, 0 );
+
+   // writes through this context replace the cached meta info
+   if ( write_object( ctxt, "cache", 'B', 300000 ) ) { return -1; }
+   if ( read_object( ctxt, "cache", 'B', 300000, NE_RDALL ) ) {
+      printf( "ERROR: Failed to read object after overwriting it!\n" );
+      return -1;
+   }
+
+   // writes through any other context leave stale meta info, which must be detected
+   ne_ctxt other = init_ctxt();
+   if ( other == NULL ) { return -1; }
+   ret = write_object( other, "cache", 'C', 250000 );
+   if ( ne_term( other ) ) {
+      printf( "ERROR: Failed to terminate second ne_ctxt!\n" );
+      ret = -1;
+   }
+   if ( ret ) { return -1; }
+   if ( read_object( ctxt, "cache", 'C', 250000, NE_RDALL )  ||  read_object( ctxt, "cache", 'C', 250000, NE_RDONLY ) ) {
+      printf( "ERROR: Stale cached meta info was used!\n" );
+      return -1;
+   }
+
+   // deletions discard cached meta info
+   if ( ne_delete( ctxt, "cache", loc ) ) {
+      printf( "ERROR: Failed to delete cached object!\n" );
+      return -1;
+   }
+   hide_meta( "cache", 1, 0 );
+   ret = read_object( ctxt, "cache", 'C', 250000, NE_RDALL );
+   hide_meta( "cache", 0, 0 );
+   if ( ret == 0 ) {
+      printf( "ERROR: Deleted object was read from cached meta info!\n" );
+      return -1;
+   }
+
+   // cached meta info expires after the TTL
+   if ( ne_set_meta_cache( ctxt, 4, 200 ) ) {
+      printf( "ERROR: Failed to set a meta info cache TTL!\n" );
+      return -1;
+   }
+   if ( write_object( ctxt, "cache", 'D', 100000 )  ||  read_object( ctxt, "cache", 'D', 100000, NE_RDALL ) ) { return -1; }
+   hide_meta( "cache", 1, 0 );
+   ret = read_object( ctxt, "cache", 'D', 100000, NE_RDALL );
+   usleep( 300000 );
+   int expired = read_object( ctxt, "cache", 'D', 100000, NE_RDALL );
+   hide_meta( "cache", 0, 0 );
+   if ( ret  ||  expired == 0 ) {
+      printf( "ERROR: Cached meta info was not used until its TTL ( %d / %d )!\n", ret, expired );
+      return -1;
+   }
+   if ( ne_delete( ctxt, "cache", loc )  ||  ne_set_meta_cache( ctxt, 0, 0 ) ) {
+      printf( "ERROR: Failed to clean up after meta info cache test!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+// stat an object through a fresh context attached to the shared cache, with the meta info of all blocks hidden
+int shared_stat( const char* objID, char* summary ) {
+   ne_ctxt ctxt = init_ctxt();
+   if ( ctxt == NULL ) { return -1; }
+   if ( ne_set_meta_cache( ctxt, 0, 60000 )  ||  ne_set_shared_meta_cache( ctxt, shm_path, 8 ) ) {
+      printf( "ERROR: Failed to attach to the shared meta info cache!\n" );
+      ne_term( ctxt );
+      return -1;
+   }
+   hide_meta( objID, 1, 1 );
+   int ret = stat_object( ctxt, objID, summary );
+   hide_meta( objID, 0, 1 );
+   if ( ne_term( ctxt ) ) { ret = -1; }
+   return ret;
+}
+
+
+
+// read an object through a fresh context attached to the shared cache, optionally hiding the meta info of most blocks
+int shared_read( const char* objID, char fill, size_t totsz, int hide ) {
+   ne_ctxt ctxt = init_ctxt();
+   if ( ctxt == NULL ) { return -1; }
+   if ( ne_set_meta_cache( ctxt, 0, 60000 )  ||  ne_set_shared_meta_cache( ctxt, shm_path, 8 ) ) {
+      printf( "ERROR: Failed to attach to the shared meta info cache!\n" );
+      ne_term( ctxt );
+      return -1;
+   }
+   if ( hide ) { hide_meta( objID, 1, 0 ); }
+   int ret = read_object( ctxt, objID, fill, totsz, NE_RDALL );
+   if ( hide ) { hide_meta( objID, 0, 0 ); }
+   if ( ne_term( ctxt ) ) { ret = -1; }
+   return ret;
+}
+
+
+
+int test_shared_cache( ne_ctxt ctxt ) {
+   unlink( shm_path );
+   if ( ne_set_meta_cache( ctxt, 0, 60000 )  ||  ne_set_shared_meta_cache( ctxt, shm_path, 8 ) ) {
+      printf( "ERROR: Failed to attach to the shared meta info cache!\n" );
+      return -1;
+   }
+   if ( write_object( ctxt, "shared", 'E', 500000 ) ) { return -1; }
+   char recorded[STAT_LEN];
+   if ( stat_object( ctxt, "shared", recorded ) ) {
+      printf( "ERROR: Failed to stat object \"shared\"!\n" );
+      return -1;
+   }
+
+   // another process should use the recorded object, without probing any block
+   pid_t child = fork();
+   if ( child == 0 ) {
+      char summary[STAT_LEN];
+      if ( shared_stat( "shared", summary ) ) { _exit( 1 ); }
+      if ( strcmp( summary, recorded ) ) {
+         printf( "ERROR: Shared stat result \"%s\" differs from \"%s\"!\n", summary, recorded );
+         _exit( 1 );
+      }
+      _exit( shared_read( "shared", 'E', 500000, 1 ) ? 1 : 0 );
+   }
+   int status;
+   if ( child < 0  ||  waitpid( child, &status, 0 ) != child  ||  !WIFEXITED( status )  ||  WEXITSTATUS( status ) ) {
+      printf( "ERROR: Failed to use shared meta info from another process!\n" );
+      return -1;
+   }
+
+   // objects rewritten by unattached processes must be detected by readers ( which then read the meta info of every block )
+   ne_ctxt other = init_ctxt();
+   if ( other == NULL ) { return -1; }
+   int ret = write_object( other, "shared", 'F', 333333 );
+   if ( ne_term( other ) ) {
+      printf( "ERROR: Failed to terminate second ne_ctxt!\n" );
+      ret = -1;
+   }
+   if ( ret ) { return -1; }
+   if ( shared_read( "shared", 'F', 333333, 0 ) ) {
+      printf( "ERROR: Stale shared meta info was used!\n" );
+      return -1;
+   }
+
+   // recorded objects are ignored once older than the TTL, so that newly failed blocks are reported
+   if ( ne_set_meta_cache( ctxt, 0, 200 ) ) {
+      printf( "ERROR: Failed to set a meta info cache TTL!\n" );
+      return -1;
+   }
+   if ( stat_object( ctxt, "shared", recorded ) ) {
+      printf( "ERROR: Failed to stat object \"shared\"!\n" );
+      return -1;
+   }
+   char path[256];
+   block_path( path, 6, "shared", NULL );
+   unlink( path );
+   usleep( 300000 );
+   char summary[STAT_LEN];
+   if ( stat_object( ctxt, "shared", summary )  ||  strcmp( summary, recorded ) == 0 ) {
+      printf( "ERROR: Expired shared meta info was used ( \"%s\" )!\n", summary );
+      return -1;
+   }
+
+   // deletions through any attached context discard the recorded object
+   if ( ne_set_meta_cache( ctxt, 0, 60000 )  ||  stat_object( ctxt, "shared", recorded ) ) {
+      printf( "ERROR: Failed to stat object \"shared\"!\n" );
+      return -1;
+   }
+   if ( ne_delete( ctxt, "shared", loc ) ) {
+      printf( "ERROR: Failed to delete object \"shared\"!\n" );
+      return -1;
+   }
+   if ( shared_stat( "shared", summary ) == 0 ) {
+      printf( "ERROR: Deleted object was reported from shared meta info!\n" );
+      return -1;
+   }
+
+   // files of any other format are refused
+   FILE* badfile = fopen( shm_path, "w" );
+   if ( badfile == NULL ) {
+      printf( "ERROR: Failed to overwrite shared meta info cache file!\n" );
+      return -1;
+   }
+   fprintf( badfile, "junk\n" );
+   fclose( badfile );
+   if ( ne_set_shared_meta_cache( ctxt, NULL, 0 ) ) {
+      printf( "ERROR: Failed to detach from the shared meta info cache!\n" );
+      return -1;
+   }
+   if ( ne_set_shared_meta_cache( ctxt, shm_path, 8 ) == 0 ) {
+      printf( "ERROR: Attached to an incompatible shared meta info cache file!\n" );
+      return -1;
+   }
+   unlink( shm_path );
+   return ne_set_meta_cache( ctxt, 0, 0 );
+}
+
+
+
+int main( int argc, char** argv ) {
+   setvbuf( stdout, NULL, _IONBF, 0 );
+   ne_ctxt ctxt = init_ctxt();
+   if ( ctxt == NULL ) { return -1; }
+   int ret = 0;
+   if ( test_stat_threads( ctxt )  ||  test_meta_cache( ctxt )  ||  test_shared_cache( ctxt ) ) { ret = -1; }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failed to terminate ne_ctxt!\n" );
+      ret = -1;
+   }
+   xmlCleanupParser();
+   return ret;
+}
@@ -0,0 +1,277 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+#define _GNU_SOURCE // for RTLD_NEXT
+#include "ne/ne.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+#include <sys/uio.h>
+
+
+#define TEST_N 4
+#define TEST_E 2
+#define TEST_WIDTH ( TEST_N + TEST_E )
+#define TEST_PARTSZ 4096
+#define IOB_PARTS 4                                   // parts per ioblock, as set by the io_size of the DAL
+#define GENERATION ( TEST_N * TEST_PARTSZ * IOB_PARTS ) // object data spanned by one ioblock of each data block
+#define TEST_TOTSZ ( GENERATION * 64 )
+#define WATCH_BLOCK 0       // data block whose reads are tracked
+#define SETTLE_USEC 200000  // time without further reads, after which the readahead is considered complete
+#define DEFAULT_RA 1        // readahead of a handle with no advice, or pattern yet detected ( SUPER_BLOCK_CNT - 1 )
+#define MAX_RA 3            // readahead of a sequential handle ( SUPER_BLOCK_MAX - 1 )
+
+char* dal_config = "<DAL type=\"posix\"><dir_template>./test_libne_readahead.block{b}</dir_template>"
+                   "<sec_root></sec_root><io_size>16388</io_size></DAL>"; // four parts, plus a CRC
+char* objID = "readahead";
+ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+ne_erasure epat = { .N = TEST_N, .E = TEST_E, .O = 0, .partsz = TEST_PARTSZ };
+
+
+// the posix DAL reads blocks via preadv(), which we intercept to track how far ahead WATCH_BLOCK is read
+ssize_t (*real_preadv)( int fd, const struct iovec* iov, int iovcnt, off_t offset ) = NULL;
+char watch_name[64];  // trailing portion of the path of the data file of WATCH_BLOCK
+off_t read_end = 0;   // furthest offset of WATCH_BLOCK read ( the test only ever seeks forward )
+off_t read_span = 0;  // block file bytes read per ioblock
+
+char is_watched_fd( int fd ) {
+   char fdpath[64];
+   char path[4096];
+   snprintf( fdpath, sizeof(fdpath), "/proc/self/fd/%d", fd );
+   ssize_t len = readlink( fdpath, path, sizeof(path) - 1 );
+   if ( len < 0 ) { return 0; }
+   path[len] = '\0';
+   size_t namelen = strlen( watch_name );
+   return ( len >= namelen  &&  strcmp( path + ( len - namelen ), watch_name ) == 0 );
+}
+
+ssize_t preadv( int fd, const struct iovec* iov, int iovcnt, off_t offset ) {
+   ssize_t res = real_preadv( fd, iov, iovcnt, offset );
+   if ( res > 0  &&  is_watched_fd( fd ) ) {
+      off_t end = offset + res;
+      off_t prev = __atomic_load_n( &read_end, __ATOMIC_SEQ_CST );
+      while ( end > prev  &&  !__atomic_compare_exchange_n( &read_end, &prev, end, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) ) {}
+      __atomic_store_n( &read_span, res, __ATOMIC_SEQ_CST );
+   }
+   return res;
+}
+
+
+
+int write_object( ne_ctxt ctxt ) {
+   char* data = malloc( TEST_TOTSZ );
+   if ( data == NULL ) {
+      printf( "ERROR: Failed to allocate object data!\n" );
+      return -1;
+   }
+   memset( data, 'R', TEST_TOTSZ );
+   ne_handle handle = ne_open( ctxt, objID, loc, epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open object for write!\n" );
+      free( data );
+      return -1;
+   }
+   ssize_t written = ne_write( handle, data, TEST_TOTSZ );
+   free( data );
+   if ( written != TEST_TOTSZ ) {
+      printf( "ERROR: Failed to write object ( %zd bytes written )!\n", written );
+      ne_close( handle, NULL, NULL );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failed to close object after write!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+// read the given number of bytes from the given ioblock generation ( seeking there, if 'seekgen' is non-negative, 
+//  and otherwise continuing from the handle offset ), then determine how many ioblocks beyond the one holding the 
+//  final byte have been read ahead
+int read_ahead( ne_handle handle, off_t* offset, int seekgen, size_t bytes ) {
+   if ( seekgen >= 0 ) {
+      *offset = (off_t)seekgen * GENERATION;
+      if ( ne_seek( handle, *offset ) != *offset ) {
+         printf( "ERROR: Failed to seek to ioblock generation %d!\n", seekgen );
+         return -1;
+      }
+   }
+   char* buff = malloc( bytes );
+   if ( buff == NULL ) {
+      printf( "ERROR: Failed to allocate read buffer!\n" );
+      return -1;
+   }
+   ssize_t res = ne_read( handle, buff, bytes );
+   free( buff );
+   if ( res != bytes ) {
+      printf( "ERROR: Unexpected return value from ne_read: %zd\n", res );
+      return -1;
+   }
+   *offset += bytes;
+   // wait for the reads of the watched block to stop
+   off_t end = __atomic_load_n( &read_end, __ATOMIC_SEQ_CST );
+   while ( 1 ) {
+      usleep( SETTLE_USEC );
+      off_t newend = __atomic_load_n( &read_end, __ATOMIC_SEQ_CST );
+      if ( newend == end ) { break; }
+      end = newend;
+   }
+   off_t span = __atomic_load_n( &read_span, __ATOMIC_SEQ_CST );
+   if ( span <= 0 ) {
+      printf( "ERROR: No reads of block %d were observed!\n", WATCH_BLOCK );
+      return -1;
+   }
+   int heldgen = (int)( ( *offset - 1 ) / GENERATION );
+   int readahead = (int)( ( end + span - 1 ) / span ) - ( heldgen + 1 );
+   if ( readahead < 0 ) {
+      printf( "ERROR: Reads of block %d ended at offset %zd, short of ioblock generation %d!\n", WATCH_BLOCK, end, heldgen );
+      return -1;
+   }
+   return readahead;
+}
+
+int expect_readahead( ne_handle handle, off_t* offset, const char* desc, int seekgen, size_t bytes, int expected ) {
+   int readahead = read_ahead( handle, offset, seekgen, bytes );
+   if ( readahead < 0 ) { return -1; }
+   printf( "...%s: read %d ioblocks ahead...\n", desc, readahead );
+   if ( readahead != expected ) {
+      printf( "ERROR: Expected a readahead of %d ioblocks ( %s ), but found %d!\n", expected, desc, readahead );
+      return -1;
+   }
+   return 0;
+}
+
+int test_readahead( ne_ctxt ctxt ) {
+   ne_handle handle = ne_open( ctxt, objID, loc, epat, NE_RDONLY );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open object for read!\n" );
+      return -1;
+   }
+   off_t offset = 0;
+   int ret = 0;
+   // a new handle uses the default readahead
+   if ( expect_readahead( handle, &offset, "new handle", -1, 1, DEFAULT_RA ) ) { ret = -1; }
+   // explicit advice overrides any detected pattern
+   else if ( ne_advise( handle, NE_ADV_SEQUENTIAL )  ||
+             expect_readahead( handle, &offset, "sequential advice", 8, 1, MAX_RA ) ) { ret = -1; }
+   else if ( ne_advise( handle, NE_ADV_RANDOM )  ||
+             expect_readahead( handle, &offset, "random advice", 16, 1, 0 ) ) { ret = -1; }
+   // withdrawn advice restores the default readahead, until a new pattern is detected
+   else if ( ne_advise( handle, NE_ADV_NORMAL )  ||
+             expect_readahead( handle, &offset, "advice withdrawn", 24, 1, DEFAULT_RA ) ) { ret = -1; }
+   // repeated reseeks separated by small reads are detected as random access...
+   else if ( expect_readahead( handle, &offset, "repeated reseeks", 32, 1, 0 ) ) { ret = -1; }
+   // ...and long runs of sequential reads as sequential access ( deeper readahead only takes effect as the
+   //    producer wraps around its ioqueue, so continue reading a while before checking )
+   else if ( read_ahead( handle, &offset, -1, 4 * GENERATION ) < 0  ||
+             expect_readahead( handle, &offset, "sequential run", -1, 2 * GENERATION, MAX_RA ) ) { ret = -1; }
+   // a single reseek, following a long run, returns the handle to the default readahead
+   else if ( expect_readahead( handle, &offset, "reseek after a run", 46, 1, DEFAULT_RA ) ) { ret = -1; }
+   // as does an end to explicit sequential advice
+   else if ( ne_advise( handle, NE_ADV_SEQUENTIAL )  ||
+             expect_readahead( handle, &offset, "renewed sequential advice", 52, 1, MAX_RA )  ||
+             ne_advise( handle, NE_ADV_NORMAL )  ||
+             expect_readahead( handle, &offset, "sequential advice withdrawn", 60, 1, DEFAULT_RA ) ) { ret = -1; }
+   if ( ne_advise( handle, 7 ) == 0 ) {
+      printf( "ERROR: Invalid advice was accepted!\n" );
+      ret = -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failed to close read handle!\n" );
+      ret = -1;
+   }
+   return ret;
+}
+
+
+
+int main( int argc, char** argv ) {
+   setvbuf( stdout, NULL, _IONBF, 0 );
+   real_preadv = dlsym( RTLD_NEXT, "preadv" );
+   if ( real_preadv == NULL ) {
+      printf( "ERROR: Failed to locate preadv()!\n" );
+      return -1;
+   }
+   snprintf( watch_name, sizeof(watch_name), "/test_libne_readahead.block%d%s", WATCH_BLOCK, objID );
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return -1;
+   }
+   ne_ctxt ctxt = ne_init( xmlDocGetRootElement( config ), loc, TEST_WIDTH );
+   xmlFreeDoc( config );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+   int ret = 0;
+   if ( write_object( ctxt )  ||  test_readahead( ctxt ) ) { ret = -1; }
+   if ( ne_delete( ctxt, objID, loc ) ) {
+      printf( "ERROR: Failed to delete object!\n" );
+      ret = -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failed to terminate ne_ctxt!\n" );
+      ret = -1;
+   }
+   xmlCleanupParser();
+   return ret;
+}
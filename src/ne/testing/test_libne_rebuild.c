@@ -0,0 +1,593 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+
+#include "ne/ne.h"
+
+
+#include "ne/ne.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// NOTE -- this test relies upon libne having been built with a small REBUILD_CKPT_SPAN ( see Makefile.am ), 
+//         so that rebuilt blocks are checkpointed well before the interruption limit below
+
+
+#define TEST_N 10
+#define TEST_E 2
+#define TEST_IOSZ 65536                   // matches the io_size of dal_config
+#define TEST_BLOCKSZ ( 2 * 1048576 )       // approximate data size of each block
+// size limit of any file written by an interrupted rebuild
+// NOTE -- this must be IO aligned, so that the rebuild is killed by its first write beyond the limit, 
+//         rather than failing a short write ( and cleanly aborting )
+#define INTERRUPT_SIZE ( 24 * TEST_IOSZ )
+#define DAMAGED_BLOCKS 2
+#define BATCH_OBJECTS 7
+
+char* dal_config = "<DAL type=\"posix\"><dir_template>./test_libne_rebuild.block{b}</dir_template>"
+                   "<sec_root></sec_root><io_size>65536</io_size></DAL>";
+int damaged[DAMAGED_BLOCKS] = { 1, 8 };
+
+
+ne_ctxt init_ctxt( void ) {
+   xmlDoc* config = xmlReadMemory( dal_config, strlen( dal_config ), "noname.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( config == NULL ) {
+      printf( "ERROR: Failed to parse DAL config!\n" );
+      return NULL;
+   }
+   ne_location max_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_init( xmlDocGetRootElement( config ), max_loc, TEST_N + TEST_E );
+   xmlFreeDoc( config );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+   }
+   return ctxt;
+}
+
+
+
+int file_exists( char* path ) {
+   return ( access( path, F_OK ) == 0 );
+}
+
+
+
+int copy_file( char* src, char* dst ) {
+   FILE* in = fopen( src, "r" );
+   if ( in == NULL ) {
+      printf( "ERROR: Failed to open \"%s\" for copying!\n", src );
+      return -1;
+   }
+   FILE* out = fopen( dst, "w" );
+   if ( out == NULL ) {
+      printf( "ERROR: Failed to open copy destination \"%s\"!\n", dst );
+      fclose( in );
+      return -1;
+   }
+   char buf[4096];
+   size_t len;
+   while ( (len = fread( buf, 1, sizeof( buf ), in )) > 0 ) {
+      if ( fwrite( buf, 1, len, out ) != len ) {
+         printf( "ERROR: Failed to copy \"%s\" to \"%s\"!\n", src, dst );
+         fclose( in );
+         fclose( out );
+         return -1;
+      }
+   }
+   fclose( in );
+   if ( fclose( out ) ) { return -1; }
+   return 0;
+}
+
+
+
+int files_match( char* first, char* second ) {
+   FILE* a = fopen( first, "r" );
+   FILE* b = fopen( second, "r" );
+   int match = ( a != NULL  &&  b != NULL );
+   while ( match ) {
+      int ca = fgetc( a );
+      int cb = fgetc( b );
+      if ( ca != cb ) { match = 0; }
+      else if ( ca == EOF ) { break; }
+   }
+   if ( a ) { fclose( a ); }
+   if ( b ) { fclose( b ); }
+   return match;
+}
+
+
+
+// write out an object of pseudo-random content, generated from the given seed
+int write_named_object( const char* objID, ne_erasure* epat, size_t totsz, unsigned int seed ) {
+   unsigned char* data = malloc( totsz );
+   if ( data == NULL ) {
+      printf( "ERROR: Failed to allocate space for object data!\n" );
+      return -1;
+   }
+   srand( seed );
+   size_t i;
+   for ( i = 0; i < totsz; i++ ) { data[i] = (unsigned char) rand(); }
+   ne_ctxt ctxt = init_ctxt();
+   if ( ctxt == NULL ) { free( data ); return -1; }
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_handle handle = ne_open( ctxt, objID, loc, *epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle!\n" );
+      return -1;
+   }
+   if ( ne_write( handle, data, totsz ) != totsz ) {
+      printf( "ERROR: Unexpected return value from ne_write!\n" );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( data );
+   return 0;
+}
+
+
+
+int write_object( ne_erasure* epat, size_t totsz, unsigned int seed ) {
+   return write_named_object( "", epat, totsz, seed );
+}
+
+
+
+// preserve the original content of the damaged blocks, then remove them
+int damage_object( void ) {
+   int i;
+   for ( i = 0; i < DAMAGED_BLOCKS; i++ ) {
+      char path[128];
+      char orig[128];
+      snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d", damaged[i] );
+      snprintf( orig, sizeof( orig ), "./test_libne_rebuild.orig%d", damaged[i] );
+      if ( copy_file( path, orig ) ) { return -1; }
+      if ( unlink( path ) ) {
+         printf( "ERROR: Failed to remove block %d!\n", damaged[i] );
+         return -1;
+      }
+   }
+   return 0;
+}
+
+
+
+// start a rebuild in a child process, which is killed ( by SIGXFSZ ) once any rebuilt block exceeds INTERRUPT_SIZE
+int interrupt_rebuild( ne_erasure* epat ) {
+   printf( "...interrupting a rebuild...\n" );
+   fflush( stdout );
+   pid_t pid = fork();
+   if ( pid < 0 ) {
+      printf( "ERROR: Failed to fork a rebuild process!\n" );
+      return -1;
+   }
+   if ( pid == 0 ) {
+      struct rlimit lim = { .rlim_cur = 0, .rlim_max = 0 };
+      setrlimit( RLIMIT_CORE, &lim );
+      lim.rlim_cur = INTERRUPT_SIZE;
+      lim.rlim_max = INTERRUPT_SIZE;
+      if ( setrlimit( RLIMIT_FSIZE, &lim ) ) { _exit( 1 ); }
+      signal( SIGXFSZ, SIG_DFL );
+      ne_ctxt ctxt = init_ctxt();
+      if ( ctxt == NULL ) { _exit( 1 ); }
+      ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+      ne_handle handle = ne_open( ctxt, "", loc, *epat, NE_REBUILD );
+      if ( handle == NULL ) { _exit( 1 ); }
+      ne_rebuild( handle, NULL, NULL );
+      _exit( 0 ); // we should never get this far
+   }
+   int status = 0;
+   if ( waitpid( pid, &status, 0 ) != pid ) {
+      printf( "ERROR: Failed to wait on the rebuild process!\n" );
+      return -1;
+   }
+   if ( !(WIFSIGNALED( status ))  ||  WTERMSIG( status ) != SIGXFSZ ) {
+      printf( "ERROR: Rebuild process was not interrupted as expected ( status = %d )!\n", status );
+      return -1;
+   }
+   // the interrupted rebuild should have left checkpointed progress behind
+   int i;
+   for ( i = 0; i < DAMAGED_BLOCKS; i++ ) {
+      char path[128];
+      snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d.meta.rebuild", damaged[i] );
+      FILE* meta = fopen( path, "r" );
+      if ( meta == NULL ) {
+         printf( "ERROR: Interrupted rebuild left no checkpoint for block %d!\n", damaged[i] );
+         return -1;
+      }
+      ssize_t ckptsz = 0;
+      int fields = fscanf( meta, "c%*d %*d %*d %*d %*d %*d %zd", &ckptsz );
+      fclose( meta );
+      if ( fields != 1 ) {
+         printf( "ERROR: Interrupted rebuild left an unexpected meta file for block %d!\n", damaged[i] );
+         return -1;
+      }
+      if ( ckptsz <= 0 ) {
+         printf( "ERROR: Interrupted rebuild checkpointed no progress for block %d!\n", damaged[i] );
+         return -1;
+      }
+   }
+   return 0;
+}
+
+
+
+// check for any working files left behind by an interrupted rebuild
+int rebuild_files_remain( void ) {
+   int i;
+   for ( i = 0; i < DAMAGED_BLOCKS; i++ ) {
+      char path[128];
+      snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d.rebuild", damaged[i] );
+      if ( file_exists( path ) ) { return 1; }
+      snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d.meta.rebuild", damaged[i] );
+      if ( file_exists( path ) ) { return 1; }
+   }
+   return 0;
+}
+
+
+
+// preserve ( stash != 0 ) or restore ( stash == 0 ) the working files of an interrupted rebuild
+int stash_rebuild_files( int stash ) {
+   int i;
+   for ( i = 0; i < DAMAGED_BLOCKS; i++ ) {
+      char path[128];
+      char saved[128];
+      snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d.rebuild", damaged[i] );
+      snprintf( saved, sizeof( saved ), "./test_libne_rebuild.stale%d", damaged[i] );
+      if ( copy_file( stash ? path : saved, stash ? saved : path ) ) { return -1; }
+      snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d.meta.rebuild", damaged[i] );
+      snprintf( saved, sizeof( saved ), "./test_libne_rebuild.stalemeta%d", damaged[i] );
+      if ( copy_file( stash ? path : saved, stash ? saved : path ) ) { return -1; }
+      if ( !(stash) ) {
+         unlink( saved );
+         snprintf( saved, sizeof( saved ), "./test_libne_rebuild.stale%d", damaged[i] );
+         unlink( saved );
+      }
+   }
+   return 0;
+}
+
+
+
+// rebuild the object to completion, and verify that the damaged blocks are restored exactly
+int complete_rebuild( ne_erasure* epat, size_t totsz, unsigned int seed ) {
+   printf( "...completing the rebuild...\n" );
+   ne_ctxt ctxt = init_ctxt();
+   if ( ctxt == NULL ) { return -1; }
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_handle handle = ne_open( ctxt, "", loc, *epat, NE_REBUILD );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a rebuild handle!\n" );
+      return -1;
+   }
+   int ret = ne_rebuild( handle, NULL, NULL );
+   if ( ret < 0 ) {
+      printf( "ERROR: Failure of ne_rebuild: %d\n", ret );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) < 0 ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+   if ( rebuild_files_remain() ) {
+      printf( "ERROR: Rebuild working files remain after a completed rebuild!\n" );
+      return -1;
+   }
+   int i;
+   for ( i = 0; i < DAMAGED_BLOCKS; i++ ) {
+      char path[128];
+      char orig[128];
+      snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d", damaged[i] );
+      snprintf( orig, sizeof( orig ), "./test_libne_rebuild.orig%d", damaged[i] );
+      if ( !(files_match( path, orig )) ) {
+         printf( "ERROR: Rebuilt block %d does not match the original!\n", damaged[i] );
+         return -1;
+      }
+      unlink( orig );
+   }
+   // the object should now read back cleanly
+   unsigned char* data = malloc( totsz );
+   if ( data == NULL ) {
+      printf( "ERROR: Failed to allocate space for object data!\n" );
+      return -1;
+   }
+   handle = ne_open( ctxt, "", loc, *epat, NE_RDALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a read handle!\n" );
+      return -1;
+   }
+   if ( ne_read( handle, data, totsz ) != totsz ) {
+      printf( "ERROR: Unexpected return value from ne_read!\n" );
+      return -1;
+   }
+   srand( seed );
+   size_t b;
+   for ( b = 0; b < totsz; b++ ) {
+      if ( data[b] != (unsigned char) rand() ) {
+         printf( "ERROR: Rebuilt object differs from the original at offset %zu!\n", b );
+         return -1;
+      }
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Rebuilt object still reports errors!\n" );
+      return -1;
+   }
+   free( data );
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+int delete_object( void ) {
+   ne_ctxt ctxt = init_ctxt();
+   if ( ctxt == NULL ) { return -1; }
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   if ( ne_delete( ctxt, "", loc ) ) {
+      printf( "ERROR: Failed to delete object!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+int test_resume( ne_erasure* epat, size_t totsz ) {
+   printf( "\nTesting resumption of an interrupted rebuild with partsz=%zu / totsz=%zu\n", epat->partsz, totsz );
+   if ( write_object( epat, totsz, 1 ) ) { return -1; }
+   if ( damage_object() ) { return -1; }
+   if ( interrupt_rebuild( epat ) ) { return -1; }
+   if ( complete_rebuild( epat, totsz, 1 ) ) { return -1; }
+   return delete_object();
+}
+
+
+
+int test_deleted( ne_erasure* epat, size_t totsz ) {
+   printf( "\nTesting rebuild of an object re-created after an interrupted rebuild with partsz=%zu / totsz=%zu\n",
+           epat->partsz, totsz );
+   if ( write_object( epat, totsz, 2 ) ) { return -1; }
+   if ( damage_object() ) { return -1; }
+   if ( interrupt_rebuild( epat ) ) { return -1; }
+   // deletion should clean up after the interrupted rebuild
+   if ( delete_object() ) { return -1; }
+   if ( rebuild_files_remain() ) {
+      printf( "ERROR: Rebuild working files remain after object deletion!\n" );
+      return -1;
+   }
+   // a new object of the same size must be rebuilt from its own data
+   if ( write_object( epat, totsz, 3 ) ) { return -1; }
+   if ( damage_object() ) { return -1; }
+   if ( complete_rebuild( epat, totsz, 3 ) ) { return -1; }
+   return delete_object();
+}
+
+
+
+int test_rewritten( ne_erasure* epat, size_t totsz ) {
+   printf( "\nTesting rebuild of an object overwritten after an interrupted rebuild with partsz=%zu / totsz=%zu\n",
+           epat->partsz, totsz );
+   if ( write_object( epat, totsz, 4 ) ) { return -1; }
+   if ( damage_object() ) { return -1; }
+   if ( interrupt_rebuild( epat ) ) { return -1; }
+   if ( stash_rebuild_files( 1 ) ) { return -1; }
+   // overwriting the object should clean up after the interrupted rebuild
+   if ( write_object( epat, totsz, 5 ) ) { return -1; }
+   if ( rebuild_files_remain() ) {
+      printf( "ERROR: Rebuild working files remain after the object was overwritten!\n" );
+      return -1;
+   }
+   if ( damage_object() ) { return -1; }
+   // even if stale checkpoints of the prior version are present, they must not be resumed
+   if ( stash_rebuild_files( 0 ) ) { return -1; }
+   if ( complete_rebuild( epat, totsz, 5 ) ) { return -1; }
+   return delete_object();
+}
+
+
+
+// rebuild several damaged objects of varying layouts as a single batch, along with one nonexistent object and 
+//  one which has lost too many blocks to be rebuilt
+int test_batch( void ) {
+   printf( "\nTesting a batch rebuild of %d damaged objects\n", BATCH_OBJECTS );
+   char names[BATCH_OBJECTS][32];
+   ne_rebuild_target targets[BATCH_OBJECTS + 2];
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   size_t totbytes = 0;
+   int obj;
+   for ( obj = 0; obj < BATCH_OBJECTS; obj++ ) {
+      ne_erasure epat = { .N = 4 + ( obj % 3 ) * 3, .E = 2, .O = 0, .partsz = 4096 << ( obj % 3 ) };
+      epat.O = obj % ( epat.N + epat.E );
+      size_t totsz = ( 1048576 * ( obj + 1 ) ) + ( 333 * obj );
+      snprintf( names[obj], sizeof( names[obj] ), "batch%d", obj );
+      if ( write_named_object( names[obj], &epat, totsz, 10 + obj ) ) { return -1; }
+      // damage one block of each object, and a second block of every other object
+      int damage;
+      for ( damage = 0; damage <= ( obj % 2 ); damage++ ) {
+         int block = ( obj + ( damage * 3 ) ) % ( epat.N + epat.E );
+         char path[128];
+         char orig[128];
+         snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d%s", block, names[obj] );
+         snprintf( orig, sizeof( orig ), "./test_libne_rebuild.orig%d%s", block, names[obj] );
+         if ( copy_file( path, orig ) ) { return -1; }
+         if ( unlink( path ) ) {
+            printf( "ERROR: Failed to remove block %d of object \"%s\"!\n", block, names[obj] );
+            return -1;
+         }
+      }
+      targets[obj].objID = names[obj];
+      targets[obj].loc = loc;
+      totbytes += totsz;
+   }
+   targets[BATCH_OBJECTS].objID = "batch_missing";
+   targets[BATCH_OBJECTS].loc = loc;
+   ne_erasure lost_epat = { .N = 4, .E = 2, .O = 0, .partsz = 4096 };
+   if ( write_named_object( "batch_lost", &lost_epat, 1048576, 3 ) ) { return -1; }
+   int block;
+   for ( block = 0; block <= lost_epat.E; block++ ) {
+      char path[128];
+      snprintf( path, sizeof( path ), "./test_libne_rebuild.block%dbatch_lost", block );
+      if ( unlink( path ) ) {
+         printf( "ERROR: Failed to remove block %d of object \"batch_lost\"!\n", block );
+         return -1;
+      }
+   }
+   targets[BATCH_OBJECTS + 1].objID = "batch_lost";
+   targets[BATCH_OBJECTS + 1].loc = loc;
+
+   ne_ctxt ctxt = init_ctxt();
+   if ( ctxt == NULL ) { return -1; }
+   // admit only a few objects at once, with the memory limit forcing further serialization
+   ne_batch_opts opts = { .max_objects = 3, .max_inflight = 8 * 1048576 };
+   ne_batch_stats stats;
+   int failures = ne_rebuild_batch( ctxt, targets, BATCH_OBJECTS + 2, &opts, &stats );
+   if ( failures != 2  ||  stats.failures != 2  ||  stats.objects != BATCH_OBJECTS + 2 ) {
+      printf( "ERROR: Batch rebuild returned %d ( %zu of %zu objects failed ), rather than two failures!\n",
+              failures, stats.failures, stats.objects );
+      return -1;
+   }
+   if ( targets[BATCH_OBJECTS].result >= 0  ||  targets[BATCH_OBJECTS].err == 0 ) {
+      printf( "ERROR: Batch rebuild of a nonexistent object did not fail ( result = %d )!\n",
+              targets[BATCH_OBJECTS].result );
+      return -1;
+   }
+   // the unrecoverable object must not count towards the rebuilt bytes
+   if ( targets[BATCH_OBJECTS + 1].result >= 0  ||  targets[BATCH_OBJECTS + 1].err == 0  ||
+        targets[BATCH_OBJECTS + 1].bytes != 0 ) {
+      printf( "ERROR: Batch rebuild of an unrecoverable object did not fail ( result = %d, bytes = %zu )!\n",
+              targets[BATCH_OBJECTS + 1].result, targets[BATCH_OBJECTS + 1].bytes );
+      return -1;
+   }
+   if ( stats.bytes != totbytes ) {
+      printf( "ERROR: Batch rebuild reported %zu bytes, rather than %zu!\n", stats.bytes, totbytes );
+      return -1;
+   }
+
+   // every damaged block must be restored to its original content
+   for ( obj = 0; obj < BATCH_OBJECTS; obj++ ) {
+      if ( targets[obj].result < 0 ) {
+         printf( "ERROR: Batch rebuild of object \"%s\" failed ( result = %d, errno = %d )!\n",
+                 names[obj], targets[obj].result, targets[obj].err );
+         return -1;
+      }
+      int N = 4 + ( obj % 3 ) * 3;
+      int damage;
+      for ( damage = 0; damage <= ( obj % 2 ); damage++ ) {
+         int block = ( obj + ( damage * 3 ) ) % ( N + 2 );
+         char path[128];
+         char orig[128];
+         snprintf( path, sizeof( path ), "./test_libne_rebuild.block%d%s", block, names[obj] );
+         snprintf( orig, sizeof( orig ), "./test_libne_rebuild.orig%d%s", block, names[obj] );
+         if ( !(files_match( path, orig )) ) {
+            printf( "ERROR: Rebuilt block %d of object \"%s\" does not match the original!\n", block, names[obj] );
+            return -1;
+         }
+         unlink( orig );
+      }
+      if ( ne_delete( ctxt, names[obj], loc ) ) {
+         printf( "ERROR: Failed to delete object \"%s\"!\n", names[obj] );
+         return -1;
+      }
+   }
+   ne_delete( ctxt, "batch_lost", loc ); // some blocks are already gone
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+int main( int argc, char** argv ) {
+   ne_erasure epat = { .N = TEST_N, .E = TEST_E, .O = 3, .partsz = 4096 };
+   size_t totsz = ( TEST_N * TEST_BLOCKSZ ) + 777;
+   if ( test_resume( &epat, totsz ) ) { return -1; }
+   if ( test_deleted( &epat, totsz ) ) { return -1; }
+   if ( test_rewritten( &epat, totsz ) ) { return -1; }
+   // repeat with parts spanning exactly two IOs of each block ( each holding a CRC, in addition to data )
+   epat.partsz = 2 * ( TEST_IOSZ - sizeof( unsigned int ) );
+   if ( test_resume( &epat, totsz ) ) { return -1; }
+   if ( test_rewritten( &epat, totsz ) ) { return -1; }
+   if ( test_batch() ) { return -1; }
+
+   xmlCleanupParser();
+   return 0;
+}
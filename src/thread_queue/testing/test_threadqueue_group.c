@@ -0,0 +1,253 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under
+the MarFS copyright and
+license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer
+Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+
+-----
+
+Additionally, redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the following
+conditions are
+met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+Copyright 2015.  Los Alamos National Security, LLC.
+This software was produced under U.S. Government contract
+DE-AC52-06NA25396 for Los Alamos National Laboratory (LANL), which is
+operated by Los Alamos National Security, LLC for the U.S. Department of
+Energy. The U.S. Government has rights to use, reproduce, and distribute
+this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL SECURITY,
+LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY FOR
+THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to
+confuse it with the version available from
+LANL.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+
+#include "thread_queue/thread_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+
+#define NUM_QUEUES 4
+#define MAX_PRODS 2
+#define ITEMS 5000
+#define ENCODE( tID, seq ) (void*)( ( (uintptr_t)(tID) << 32 ) | (uintptr_t)(seq) )
+
+// per-queue global state, defining how rapidly that queue's producers generate work
+typedef struct test_global_struct {
+   useconds_t delay;
+} test_global;
+
+// per-thread state, tracking the sequence of produced work elements
+typedef struct test_state_struct {
+   unsigned int tID;
+   uintptr_t count;
+   useconds_t delay;
+} test_state;
+
+
+int my_thread_init( unsigned int tID, void* global_state, void** state ) {
+   test_state* tstate = calloc( 1, sizeof( test_state ) );
+   if ( tstate == NULL ) { return -1; }
+   tstate->tID = tID;
+   tstate->delay = ( (test_global*)global_state )->delay;
+   *state = tstate;
+   return 0;
+}
+
+// produce ITEMS work elements, each encoding the producing thread and sequence number
+int my_producer( void** state, void** work_tofill ) {
+   test_state* tstate = (test_state*)( *state );
+   if ( tstate->count == ITEMS ) {
+      *work_tofill = NULL;
+      return 1;
+   }
+   if ( tstate->delay  &&  ( tstate->count % 16 ) == 0 ) { usleep( tstate->delay ); }
+   tstate->count++;
+   *work_tofill = ENCODE( tstate->tID, tstate->count );
+   return 0;
+}
+
+void my_thread_term( void** state, void** prev_work ) {
+   // state is collected ( and freed ) by the master proc
+}
+
+
+
+int main( int argc, char** argv ) {
+   // an SPSC queue, fed by a single rapid producer, followed by queues with several producers of varying speeds
+   test_global gstate[NUM_QUEUES] = { { 0 }, { 0 }, { 200 }, { 2000 } };
+   unsigned int prods[NUM_QUEUES] = { 1, MAX_PRODS, MAX_PRODS, 1 };
+   ThreadQueue queues[NUM_QUEUES];
+   int i;
+   for ( i = 0; i < NUM_QUEUES; i++ ) {
+      TQ_Init_Opts opts = {
+         .log_prefix = "GROUP", .init_flags = 0, .max_qdepth = 8, .global_state = &gstate[i],
+         .num_threads = prods[i], .num_prod_threads = prods[i], .pool = NULL, .spsc = ( i == 0 ),
+         .thread_init_func = my_thread_init, .thread_consumer_func = NULL, .thread_producer_func = my_producer,
+         .thread_pause_func = NULL, .thread_resume_func = NULL, .thread_term_func = my_thread_term
+      };
+      queues[i] = tq_init( &opts );
+      if ( queues[i] == NULL ) {
+         printf( "ERROR: Failed to initialize queue %d!\n", i );
+         return -1;
+      }
+   }
+
+   TQ_Group group = tq_group_init( queues, NUM_QUEUES );
+   if ( group == NULL ) {
+      printf( "ERROR: Failed to initialize queue group!\n" );
+      return -1;
+   }
+   // a queue may only belong to a single group
+   errno = 0;
+   if ( tq_group_init( queues + 2, 1 ) != NULL  ||  errno != EBUSY ) {
+      printf( "ERROR: Expected EBUSY from a second group including a member queue!\n" );
+      return -1;
+   }
+
+   // dequeue from any queue which has not yet finished, verifying the sequence of each producer
+   char select[NUM_QUEUES];
+   memset( select, 1, sizeof( select ) );
+   uintptr_t expected[NUM_QUEUES][MAX_PRODS] = { { 0 } };
+   unsigned int hits[NUM_QUEUES] = { 0 };
+   int remaining = NUM_QUEUES;
+   int retval = 0;
+   while ( remaining ) {
+      void* work = NULL;
+      unsigned int index = NUM_QUEUES;
+      int depth = tq_dequeue_any( group, 0, select, &work, &index );
+      if ( index >= NUM_QUEUES ) {
+         printf( "ERROR: Dequeue returned an invalid queue index of %u ( depth = %d )!\n", index, depth );
+         return -1;
+      }
+      if ( depth < 0 ) {
+         printf( "ERROR: Failed to dequeue from queue %u!\n", index );
+         return -1;
+      }
+      if ( depth == 0  &&  work == NULL ) {
+         // this queue has finished, and should no longer be considered
+         TQ_Control_Flags flags = 0;
+         if ( tq_get_flags( queues[index], &flags )  ||  !(flags & TQ_FINISHED) ) {
+            printf( "ERROR: Queue %u returned no work, without being FINISHED!\n", index );
+            return -1;
+         }
+         select[index] = 0;
+         remaining--;
+         continue;
+      }
+      unsigned int tID = (unsigned int)( (uintptr_t)work >> 32 );
+      uintptr_t seq = (uintptr_t)work & 0xFFFFFFFF;
+      if ( tID >= prods[index]  ||  seq != expected[index][tID] + 1 ) {
+         printf( "ERROR: Received element %zu of thread %u from queue %u, expecting element %zu!\n",
+                 (size_t)seq, tID, index, (size_t)( ( tID < prods[index] ) ? expected[index][tID] + 1 : 0 ) );
+         retval = -1;
+         break;
+      }
+      expected[index][tID] = seq;
+      hits[index]++;
+   }
+
+   // no selected queues is an error
+   if ( retval == 0 ) {
+      void* work = NULL;
+      unsigned int index;
+      errno = 0;
+      if ( tq_dequeue_any( group, 0, select, &work, &index ) != -1  ||  errno != EINVAL ) {
+         printf( "ERROR: Expected EINVAL from a dequeue without any selected queues!\n" );
+         retval = -1;
+      }
+   }
+   if ( tq_group_term( group ) ) {
+      printf( "ERROR: Failed to terminate queue group!\n" );
+      retval = -1;
+   }
+
+   // collect all thread states and close each queue
+   //  NOTE -- the first producer to finish FINISHES its queue, so other producers of that queue may
+   //          stop early, possibly after generating one last element which was never enqueued
+   for ( i = 0; i < NUM_QUEUES; i++ ) {
+      if ( retval ) { tq_set_flags( queues[i], TQ_ABORT ); }
+      char completed = 0;
+      void* tstate = NULL;
+      int threads = 0;
+      while ( tq_next_thread_status( queues[i], &tstate ) > 0 ) {
+         if ( tstate != NULL ) {
+            test_state* state = (test_state*)tstate;
+            uintptr_t received = ( state->tID < prods[i] ) ? expected[i][state->tID] : 0;
+            if ( received != state->count  &&  received + 1 != state->count  &&  retval == 0 ) {
+               printf( "ERROR: Received %zu of %zu elements produced by thread %u of queue %d!\n",
+                       (size_t)received, (size_t)state->count, state->tID, i );
+               retval = -1;
+            }
+            if ( received == ITEMS ) { completed = 1; }
+            free( tstate );
+         }
+         threads++;
+      }
+      if ( threads != prods[i] ) {
+         printf( "ERROR: Collected the status of %d of %u threads from queue %d!\n", threads, prods[i], i );
+         retval = -1;
+      }
+      if ( !(completed)  &&  retval == 0 ) {
+         printf( "ERROR: No producer of queue %d completed its work ( received %u elements )!\n", i, hits[i] );
+         retval = -1;
+      }
+      if ( tq_close( queues[i] ) ) {
+         printf( "ERROR: Failed to close queue %d!\n", i );
+         retval = -1;
+      }
+   }
+   return retval;
+}
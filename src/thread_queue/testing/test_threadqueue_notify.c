@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under
+the MarFS copyright and
+license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer
+Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+
+-----
+
+Additionally, redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the following
+conditions are
+met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+Copyright 2015.  Los Alamos National Security, LLC.
+This software was produced under U.S. Government contract
+DE-AC52-06NA25396 for Los Alamos National Laboratory (LANL), which is
+operated by Los Alamos National Security, LLC for the U.S. Department of
+Energy. The U.S. Government has rights to use, reproduce, and distribute
+this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL SECURITY,
+LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY FOR
+THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to
+confuse it with the version available from
+LANL.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+
+#include "thread_queue/thread_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <sched.h>
+
+
+#define ITEMS 500
+// pooled queues which yield are polled every 5ms, so every item would take at least that long without tq_notify()
+#define TIME_LIMIT_NSEC ( ITEMS * 1000000LL )
+
+// state shared between the master proc and the pooled producer
+typedef struct test_global_struct {
+   int credits;     // number of items the producer may generate before yielding
+   uintptr_t count; // number of items generated so far
+   int yields;      // number of times the producer yielded without work
+} test_global;
+
+
+int my_thread_init( unsigned int tID, void* global_state, void** state ) {
+   *state = global_state;
+   return 0;
+}
+
+// generate an item for each credit granted by the master, yielding whenever none remain
+int my_producer( void** state, void** work_tofill ) {
+   test_global* gstate = (test_global*)( *state );
+   if ( gstate->count == ITEMS ) {
+      *work_tofill = NULL;
+      return 1;
+   }
+   if ( __atomic_load_n( &gstate->credits, __ATOMIC_SEQ_CST ) == 0 ) {
+      gstate->yields++;
+      *work_tofill = NULL;
+      return 0;
+   }
+   __atomic_sub_fetch( &gstate->credits, 1, __ATOMIC_SEQ_CST );
+   *work_tofill = (void*)( __atomic_add_fetch( &gstate->count, 1, __ATOMIC_SEQ_CST ) );
+   return 0;
+}
+
+void my_thread_term( void** state, void** prev_work ) {
+   // state is owned by the master proc
+}
+
+
+
+int main( int argc, char** argv ) {
+   TQ_Pool pool = tq_pool_init( 2, "NOTIFY_POOL" );
+   if ( pool == NULL ) {
+      printf( "ERROR: Failed to initialize pool!\n" );
+      return -1;
+   }
+   test_global gstate = { .credits = 0, .count = 0, .yields = 0 };
+   TQ_Init_Opts opts = {
+      .log_prefix = "NOTIFY", .init_flags = 0, .max_qdepth = 4, .global_state = &gstate,
+      .num_threads = 1, .num_prod_threads = 1, .pool = pool, .spsc = 0,
+      .thread_init_func = my_thread_init, .thread_consumer_func = NULL, .thread_producer_func = my_producer,
+      .thread_pause_func = NULL, .thread_resume_func = NULL, .thread_term_func = my_thread_term
+   };
+   ThreadQueue tq = tq_init( &opts );
+   if ( tq == NULL ) {
+      printf( "ERROR: Failed to initialize queue!\n" );
+      return -1;
+   }
+
+   // grant a single credit at a time, only once the previous item has been received
+   //  NOTE -- the master waits for each item without calling into the queue, as any queue operation would itself 
+   //          wake the pooled producer, so that only tq_notify() ( or polling ) can resume it
+   struct timespec start;
+   struct timespec end;
+   clock_gettime( CLOCK_MONOTONIC, &start );
+   int retval = 0;
+   uintptr_t expected;
+   for ( expected = 1; expected <= ITEMS; expected++ ) {
+      __atomic_add_fetch( &gstate.credits, 1, __ATOMIC_SEQ_CST );
+      if ( tq_notify( tq ) ) {
+         printf( "ERROR: Failed to notify queue!\n" );
+         retval = -1;
+         break;
+      }
+      while ( __atomic_load_n( &gstate.count, __ATOMIC_SEQ_CST ) < expected ) { sched_yield(); }
+      void* work = NULL;
+      if ( tq_dequeue( tq, TQ_FINISHED, &work ) <= 0  ||  (uintptr_t)work != expected ) {
+         printf( "ERROR: Failed to dequeue item %zu!\n", (size_t)expected );
+         retval = -1;
+         break;
+      }
+   }
+   clock_gettime( CLOCK_MONOTONIC, &end );
+   long long elapsed = ( (long long)( end.tv_sec - start.tv_sec ) * 1000000000LL ) + ( end.tv_nsec - start.tv_nsec );
+   if ( retval == 0  &&  elapsed > TIME_LIMIT_NSEC ) {
+      printf( "ERROR: Producing %d items took %lld ms, suggesting notifications were ignored ( %d yields )!\n",
+              ITEMS, elapsed / 1000000LL, gstate.yields );
+      retval = -1;
+   }
+
+   // the producer FINISHES the queue once all items are generated
+   void* work = NULL;
+   if ( retval  ||  tq_dequeue( tq, TQ_FINISHED, &work ) != 0 ) {
+      if ( retval == 0 ) { printf( "ERROR: Queue produced more than %d items!\n", ITEMS ); }
+      tq_set_flags( tq, TQ_ABORT );
+      retval = -1;
+   }
+   void* tstate = NULL;
+   while ( tq_next_thread_status( tq, &tstate ) > 0 ) {}
+   if ( tq_close( tq )  ||  tq_pool_term( pool ) ) {
+      printf( "ERROR: Failed to close queue or pool!\n" );
+      return -1;
+   }
+   return retval;
+}
@@ -0,0 +1,231 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under
+the MarFS copyright and
+license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer
+Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+
+-----
+
+Additionally, redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the following
+conditions are
+met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+Copyright 2015.  Los Alamos National Security, LLC.
+This software was produced under U.S. Government contract
+DE-AC52-06NA25396 for Los Alamos National Laboratory (LANL), which is
+operated by Los Alamos National Security, LLC for the U.S. Department of
+Energy. The U.S. Government has rights to use, reproduce, and distribute
+this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL SECURITY,
+LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY FOR
+THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to
+confuse it with the version available from
+LANL.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+
+#include "thread_queue/thread_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+
+
+#define ITEMS 200000
+
+// per-thread state, counting the work elements produced or consumed
+typedef struct test_state_struct {
+   uintptr_t count;
+   uintptr_t errors;
+} test_state;
+
+
+int my_thread_init( unsigned int tID, void* global_state, void** state ) {
+   *state = calloc( 1, sizeof( test_state ) );
+   return ( *state == NULL ) ? -1 : 0;
+}
+
+// produce ITEMS sequentially numbered work elements, then FINISH the queue
+int my_producer( void** state, void** work_tofill ) {
+   test_state* tstate = (test_state*)( *state );
+   if ( tstate->count == ITEMS ) {
+      *work_tofill = NULL;
+      return 1;
+   }
+   tstate->count++;
+   *work_tofill = (void*)( tstate->count );
+   return 0;
+}
+
+// verify that work elements arrive in sequence
+int my_consumer( void** state, void** work_todo ) {
+   test_state* tstate = (test_state*)( *state );
+   tstate->count++;
+   if ( (uintptr_t)( *work_todo ) != tstate->count ) { tstate->errors++; }
+   *work_todo = NULL;
+   return 0;
+}
+
+void my_thread_term( void** state, void** prev_work ) {
+   // state is collected ( and freed ) by the master proc
+}
+
+
+
+// collect the state of the single thread of a FINISHED queue, then close it
+int finish_queue( ThreadQueue tq, test_state* result ) {
+   void* tstate = NULL;
+   if ( tq_next_thread_status( tq, &tstate ) != 1  ||  tstate == NULL ) {
+      printf( "ERROR: Failed to collect thread state!\n" );
+      return -1;
+   }
+   *result = *( (test_state*)tstate );
+   free( tstate );
+   if ( tq_close( tq ) ) {
+      printf( "ERROR: Failed to close queue!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+// a producer thread, with the master proc consuming ( alternating between blocking and timed dequeues )
+int test_master_consumer( unsigned int qdepth ) {
+   printf( "Testing SPSC master consumer with a queue depth of %u\n", qdepth );
+   TQ_Init_Opts opts = {
+      .log_prefix = "SPSC_CONS", .init_flags = 0, .max_qdepth = qdepth, .global_state = NULL,
+      .num_threads = 1, .num_prod_threads = 1, .pool = NULL, .spsc = 1,
+      .thread_init_func = my_thread_init, .thread_consumer_func = NULL, .thread_producer_func = my_producer,
+      .thread_pause_func = NULL, .thread_resume_func = NULL, .thread_term_func = my_thread_term
+   };
+   ThreadQueue tq = tq_init( &opts );
+   if ( tq == NULL ) {
+      printf( "ERROR: Failed to initialize queue!\n" );
+      return -1;
+   }
+   uintptr_t expected = 1;
+   int ret;
+   void* work = NULL;
+   while ( 1 ) {
+      if ( expected % 2 ) { ret = tq_dequeue( tq, TQ_FINISHED, &work ); }
+      else {
+         struct timespec deadline;
+         clock_gettime( CLOCK_MONOTONIC, &deadline );
+         deadline.tv_sec += 60;
+         ret = tq_timed_dequeue( tq, TQ_FINISHED, &work, &deadline );
+      }
+      if ( ret <= 0 ) { break; }
+      if ( (uintptr_t)work != expected ) {
+         printf( "ERROR: Dequeued element %zu, rather than %zu!\n", (size_t)(uintptr_t)work, (size_t)expected );
+         tq_set_flags( tq, TQ_ABORT );
+         break;
+      }
+      expected++;
+   }
+   if ( ret < 0 ) { printf( "ERROR: Failed to dequeue element %zu!\n", (size_t)expected ); }
+   test_state result;
+   if ( finish_queue( tq, &result ) ) { return -1; }
+   if ( ret  ||  expected != ITEMS + 1  ||  result.count != ITEMS ) {
+      printf( "ERROR: Dequeued %zu of %zu produced elements!\n", (size_t)( expected - 1 ), (size_t)result.count );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+// a consumer thread, with the master proc producing
+int test_master_producer( unsigned int qdepth ) {
+   printf( "Testing SPSC master producer with a queue depth of %u\n", qdepth );
+   TQ_Init_Opts opts = {
+      .log_prefix = "SPSC_PROD", .init_flags = 0, .max_qdepth = qdepth, .global_state = NULL,
+      .num_threads = 1, .num_prod_threads = 0, .pool = NULL, .spsc = 1,
+      .thread_init_func = my_thread_init, .thread_consumer_func = my_consumer, .thread_producer_func = NULL,
+      .thread_pause_func = NULL, .thread_resume_func = NULL, .thread_term_func = my_thread_term
+   };
+   ThreadQueue tq = tq_init( &opts );
+   if ( tq == NULL ) {
+      printf( "ERROR: Failed to initialize queue!\n" );
+      return -1;
+   }
+   int ret = 0;
+   uintptr_t item;
+   for ( item = 1; item <= ITEMS; item++ ) {
+      if ( tq_enqueue( tq, 0, (void*)item ) ) {
+         printf( "ERROR: Failed to enqueue element %zu!\n", (size_t)item );
+         ret = -1;
+         break;
+      }
+   }
+   if ( tq_set_flags( tq, ( ret ) ? TQ_ABORT : TQ_FINISHED ) ) {
+      printf( "ERROR: Failed to set queue flags!\n" );
+      return -1;
+   }
+   test_state result;
+   if ( finish_queue( tq, &result ) ) { return -1; }
+   if ( ret  ||  result.count != ITEMS  ||  result.errors ) {
+      printf( "ERROR: Consumed %zu of %d elements, %zu of which were out of sequence!\n",
+              (size_t)result.count, ITEMS, (size_t)result.errors );
+      return -1;
+   }
+   return 0;
+}
+
+
+
+int main( int argc, char** argv ) {
+   // tiny queues, constantly switching between full and empty, as well as a deep one
+   unsigned int qdepths[] = { 1, 2, 3, 64 };
+   int i;
+   for ( i = 0; i < sizeof( qdepths ) / sizeof( unsigned int ); i++ ) {
+      if ( test_master_consumer( qdepths[i] )  ||  test_master_producer( qdepths[i] ) ) { return -1; }
+   }
+   return 0;
+}
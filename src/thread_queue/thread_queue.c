@@ -81,8 +81,21 @@ OF SUCH DAMAGE.
 #include <stdlib.h>
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 
 #define def_queue_pref "ThreadQueue"
+#define def_pool_pref "TQPool"
+#define POOL_POLL_NSEC 5000000 // interval at which pooled queues that yielded without work are retried
+#define SPSC_SPINS 64 // number of times the lockless path of an SPSC queue will retry before falling back to a wait
+
+// queue depth and control flags may be accessed without the queue lock by the lockless path of an SPSC queue, 
+//  so they are always accessed atomically ( flags are still only ever modified while holding the lock )
+#define TQ_DEPTH( TQ )          __atomic_load_n( &((TQ)->qdepth), __ATOMIC_SEQ_CST )
+#define TQ_DEPTH_INC( TQ )      __atomic_add_fetch( &((TQ)->qdepth), 1, __ATOMIC_SEQ_CST )
+#define TQ_DEPTH_DEC( TQ )      __atomic_sub_fetch( &((TQ)->qdepth), 1, __ATOMIC_SEQ_CST )
+#define TQ_FLAGS( TQ )          __atomic_load_n( &((TQ)->con_flags), __ATOMIC_SEQ_CST )
+#define TQ_SET_FLAGS( TQ, F )   __atomic_or_fetch( &((TQ)->con_flags), (F), __ATOMIC_SEQ_CST )
+#define TQ_UNSET_FLAGS( TQ, F ) __atomic_and_fetch( &((TQ)->con_flags), ~(F), __ATOMIC_SEQ_CST )
 
 
 /* -------------------------------------------------------  INTERNAL TYPES  ------------------------------------------------------- */
@@ -93,6 +106,18 @@ typedef enum {
    TQ_HALTED   = 0x01 << 2  // indicates that this thread is 'paused'
 } TQ_State_Flags;
 
+typedef enum {
+   TQ_STAGE_INIT = 0, // pooled thread has yet to run its thread_init_func
+   TQ_STAGE_RUN,      // pooled thread is processing work
+   TQ_STAGE_DONE      // pooled thread has terminated ( equivalent to a dedicated thread exiting )
+} TQ_Pool_Stage;
+
+typedef enum {
+   TQ_STEP_IDLE = 0, // pooled thread cannot progress until notified of a queue change
+   TQ_STEP_AGAIN,    // pooled thread may have more work to do immediately
+   TQ_STEP_POLL      // pooled thread yielded without work, and should be retried shortly
+} TQ_Step_Result;
+
 typedef struct thread_queue_worker_pool_struct {
    // Loggging name
    const char* pname;
@@ -130,14 +155,62 @@ typedef struct thread_queue_struct {
    unsigned int       max_qdepth;       /* maximum number of elements in the queue */
    int                head;             /* next full position */  
    int                tail;             /* next empty position */
+   char               spsc;             /* master procs use the lockless path ( single producer / single consumer ) */
+   unsigned int       spsc_waiters;     /* number of threads which may be waiting on the lockless path of the master */
 
    // Thread Definitions
    unsigned int uncoll_thrds; /* number of threads that have initialized and not yet returned state info */
    pthread_t*   threads;      /* thread instances */
    TQWorkerPool prod_pool;    /* reference to producer thread pool */
    TQWorkerPool cons_pool;    /* reference to consumer thread pool */
+
+   // Shared Pool Definitions ( only used if this queue has no dedicated thread )
+   TQ_Pool       pool;         /* shared pool running the single thread of this queue */
+   void*         global_state; /* global state, retained for the pooled thread_init_func */
+   void*         pstate;       /* state of the pooled thread */
+   void*         pwork;        /* work package held by the pooled thread between iterations */
+   TQ_Pool_Stage pstage;       /* current stage of the pooled thread ( protected by qlock ) */
+   char          pclaimed;     /* pool worker is currently running an iteration ( protected by plock ) */
+   char          ppending;     /* queue has changed since the last iteration ( protected by plock ) */
+   char          ppoll;        /* pooled thread yielded without work ( protected by plock ) */
+   struct thread_queue_struct* pnext; /* next queue attached to the same pool ( protected by plock ) */
+
+   // Group Definitions
+   TQ_Group      group;        /* group of queues which this queue belongs to ( protected by qlock ) */
 }* ThreadQueue;
 
+struct thread_queue_pool_struct {
+   // Logging Prefix
+   char*            log_prefix;
+
+   // Synchronization Mechanisms
+   pthread_mutex_t  plock;       /* lock protecting the list of attached queues and their pool values */
+   pthread_cond_t   work_avail;  /* cv signals idle workers that some queue requires an iteration */
+   pthread_cond_t   released;    /* cv signals that a worker has finished an iteration of some queue */
+   char             shutdown;    /* indicates that all workers should exit */
+
+   // Attached Queues
+   ThreadQueue      queues;      /* list of all queues serviced by this pool ( in order of next service ) */
+   unsigned int     pollcnt;     /* number of attached queues awaiting a retry */
+   struct timespec  lastpoll;    /* CLOCK_MONOTONIC time at which yielded queues were last retried */
+
+   // Thread Definitions
+   unsigned int     num_thrds;   /* number of worker threads */
+   pthread_t*       threads;     /* worker thread instances */
+};
+
+struct thread_queue_group_struct {
+   // Synchronization Mechanisms
+   pthread_mutex_t  glock;       /* lock protecting the change count */
+   pthread_cond_t   ready;       /* cv signals a master proc that some member queue has changed */
+   unsigned long    changes;     /* number of member queue changes ( enqueued work or control flags ) */
+
+   // Member Queues
+   unsigned int     count;       /* number of member queues */
+   unsigned int     next;        /* index of the queue to be checked first by the next tq_dequeue_any() */
+   ThreadQueue*     queues;      /* array of member queues */
+};
+
 typedef struct thread_arg_struct {
    ThreadQueue     tq;  /* thread queue for this set of threads */
    unsigned int   tID; /* unique integer ID for this thread */
@@ -148,6 +221,67 @@ typedef struct thread_arg_struct {
 
 /* -------------------------------------------------------  INTERNAL FUNCTIONS  ------------------------------------------------------- */
 
+// flag a pooled queue as requiring another iteration and wake a pool worker ( no-op for dedicated threads )
+// NOTE -- the queue lock MUST be held by the caller, as the pool lock is always acquired second
+static void tq_pool_notify( ThreadQueue tq ) {
+   if ( tq->pool == NULL ) { return; }
+   TQ_Pool pool = tq->pool;
+   if ( pthread_mutex_lock( &pool->plock ) ) {
+      LOG( LOG_ERR, "%s Failed to acquire pool lock!\n", tq->log_prefix );
+      return;
+   }
+   if ( !(tq->ppending) ) {
+      tq->ppending = 1;
+      pthread_cond_signal( &pool->work_avail );
+   }
+   pthread_mutex_unlock( &pool->plock );
+}
+
+
+// note a change to a queue which could allow a master proc to dequeue, and wake any master waiting on its group
+// NOTE -- the queue lock should be held by the caller, as the group lock is always acquired second
+static void tq_group_notify( ThreadQueue tq ) {
+   TQ_Group group = tq->group;
+   if ( group == NULL ) { return; }
+   if ( pthread_mutex_lock( &group->glock ) ) {
+      LOG( LOG_ERR, "%s Failed to acquire group lock!\n", tq->log_prefix );
+      return;
+   }
+   group->changes++;
+   pthread_cond_broadcast( &group->ready );
+   pthread_mutex_unlock( &group->glock );
+}
+
+
+// note that a thread ( holding the queue lock ) may wait for the master to act, so that the lockless path of an 
+//  SPSC queue knows to signal it ( must precede the first check of the wait condition )
+static void spsc_wait_begin( ThreadQueue tq ) {
+   if ( tq->spsc ) { __atomic_add_fetch( &tq->spsc_waiters, 1, __ATOMIC_SEQ_CST ); }
+}
+
+
+// note that a thread is no longer waiting on the master of an SPSC queue
+static void spsc_wait_end( ThreadQueue tq ) {
+   if ( tq->spsc ) { __atomic_sub_fetch( &tq->spsc_waiters, 1, __ATOMIC_SEQ_CST ); }
+}
+
+
+// wake any thread waiting on the master, following a lockless operation on an SPSC queue
+// NOTE -- the queue lock MUST NOT be held by the caller
+static void spsc_wake( ThreadQueue tq ) {
+   // a waiter announces itself before checking the queue depth, so if we see no waiters here, 
+   //  any later waiter is guaranteed to see the depth we just updated
+   if ( __atomic_load_n( &tq->spsc_waiters, __ATOMIC_SEQ_CST ) == 0 ) { return; }
+   if ( pthread_mutex_lock( &tq->qlock ) ) {
+      LOG( LOG_ERR, "%s Failed to acquire queue lock to wake waiting thread!\n", tq->log_prefix );
+      return;
+   }
+   pthread_cond_broadcast( &tq->consumer_resume );
+   pthread_cond_broadcast( &tq->producer_resume );
+   pthread_mutex_unlock( &tq->qlock );
+}
+
+
 // set a TQ control signal and wake all threads
 int tq_signal(ThreadQueue tq, TQ_Control_Flags sig) {
    LOG( LOG_INFO, "%s Signalling with %s\n", tq->log_prefix, 
@@ -156,11 +290,13 @@ int tq_signal(ThreadQueue tq, TQ_Control_Flags sig) {
       LOG( LOG_ERR, "%s Failed to acquire queue lock!\n", tq->log_prefix );
       return -1;
    }
-   tq->con_flags |= sig;
+   TQ_SET_FLAGS( tq, sig );
    // wake ALL threads
    pthread_cond_broadcast(&tq->consumer_resume);
    pthread_cond_broadcast(&tq->producer_resume);
    pthread_cond_broadcast( &tq->state_resume );
+   tq_pool_notify( tq );
+   tq_group_notify( tq );
    pthread_mutex_unlock(&tq->qlock);  
    return 0;
 }
@@ -202,9 +338,10 @@ int general_thread_init_behavior( ThreadQueue tq, TQWorkerPool wp, unsigned int
       // failed to initialize thread state
       LOG( LOG_ERR, "%s %s Thread[%u]: Failed to initialize thread state!\n", tq->log_prefix, wp->pname, tID );
       tq->state_flags[tID] |= TQ_ERROR;
-      tq->con_flags |= TQ_ABORT; // holding the queue lock, so this should be safe
+      TQ_SET_FLAGS( tq, TQ_ABORT ); // holding the queue lock, so this should be safe
       pthread_cond_broadcast( &tq->producer_resume ); // so other threads check for the ABORT signal
       pthread_cond_broadcast( &tq->consumer_resume ); // so other threads check for the ABORT signal
+      tq_group_notify( tq );
       pthread_cond_signal( &tq->state_resume ); // so our state gets rechecked
       pthread_mutex_unlock( &tq->qlock ); // drop the lock
       return -1;
@@ -227,10 +364,11 @@ int general_thread_pause_behavior( ThreadQueue tq, TQWorkerPool wp, unsigned int
          if ( wp->thread_pause_func( tstate, prev_work ) != 0 ) {
             // pause func indicates we should abort
             LOG( LOG_ERR, "%s %s Thread[%u]: setting ABORT state due to pause func result\n", tq->log_prefix, wp->pname, tID );
-            tq->con_flags |= TQ_ABORT;
+            TQ_SET_FLAGS( tq, TQ_ABORT );
             tq->state_flags[tID] |= TQ_ERROR;
             pthread_cond_broadcast( &tq->producer_resume );
             pthread_cond_broadcast( &tq->consumer_resume );
+            tq_group_notify( tq );
             pthread_cond_broadcast( &tq->state_resume );
             return -1; // still holding lock
          }
@@ -262,10 +400,11 @@ int general_thread_resume_behavior( ThreadQueue tq, TQWorkerPool wp, unsigned in
          if ( wp->thread_resume_func( tstate, prev_work ) != 0 ) {
             // resume func indicates we should abort
             LOG( LOG_ERR, "%s %s Thread[%u]: setting ABORT state due to resume func result\n", tq->log_prefix, wp->pname, tID );
-            tq->con_flags |= TQ_ABORT;
+            TQ_SET_FLAGS( tq, TQ_ABORT );
             tq->state_flags[tID] |= TQ_ERROR;
             pthread_cond_broadcast( &tq->producer_resume );
             pthread_cond_broadcast( &tq->consumer_resume );
+            tq_group_notify( tq );
             pthread_cond_broadcast( &tq->state_resume );
             return -1; // still holding lock
          }
@@ -285,30 +424,32 @@ int general_thread_post_work_behavior( ThreadQueue tq, TQWorkerPool wp, unsigned
       // this is an extraordinary case; try to clean up as best we can, even without the lock
       tq->state_flags[tID] |= TQ_ERROR;
       tq->state_flags[tID] &= (~TQ_READY);
-      tq->con_flags |= TQ_ABORT;
+      TQ_SET_FLAGS( tq, TQ_ABORT );
       wp->act_thrds--;
       wp->thread_term_func( tstate, cur_work ); // give the thread a chance to clean up after itself
       pthread_cond_broadcast( &tq->producer_resume );
       pthread_cond_broadcast( &tq->consumer_resume );
+      tq_group_notify( tq );
       pthread_cond_broadcast( &tq->state_resume ); // should be safe with no lock (also, not much choice)
       return -1; // not holding lock
    }
    if ( work_res != 0 ) {
       if ( work_res > 1 ) {
          LOG( LOG_INFO, "%s %s Thread[%u]: Setting HALT state\n", tq->log_prefix, wp->pname, tID );
-         tq->con_flags |= TQ_HALT;
+         TQ_SET_FLAGS( tq, TQ_HALT );
       }
       else if ( work_res == 1 ) {
          LOG( LOG_INFO, "%s %s Thread[%u]: Setting FINISHED state\n", tq->log_prefix, wp->pname, tID );
-         tq->con_flags |= TQ_FINISHED;
+         TQ_SET_FLAGS( tq, TQ_FINISHED );
       }
       else if ( work_res < 0 ) {
          LOG( LOG_ERR, "%s %s Thread[%u]: Setting ABORT state\n", tq->log_prefix, wp->pname, tID );
-         tq->con_flags |= TQ_ABORT;
+         TQ_SET_FLAGS( tq, TQ_ABORT );
          tq->state_flags[tID] |= TQ_ERROR;
       }
       pthread_cond_broadcast( &tq->producer_resume );
       pthread_cond_broadcast( &tq->consumer_resume ); 
+      tq_group_notify( tq );
       pthread_cond_broadcast( &tq->state_resume );
    }
    return 0; // still holding lock
@@ -353,39 +494,41 @@ void* consumer_thread( void* arg ) {
       // Wait while there is no work available on a un-FINISHED queue
       //      while the queue is HALTED
       //  but NOT while the queue is ABORTed
-      while ( ( ( tq->qdepth == 0  &&  !(tq->con_flags & TQ_FINISHED) )  ||  
+      spsc_wait_begin( tq );
+      while ( ( ( TQ_DEPTH( tq ) == 0  &&  !(tq->con_flags & TQ_FINISHED) )  ||  
                 (tq->con_flags & TQ_HALT) )
                &&  !(tq->con_flags & TQ_ABORT) ) {
 
          if ( general_thread_pause_behavior( tq, wp, tID, &tstate, &cur_work ) < 0 ) { break; } // hit standard abort logic
          // if our queue is empty, make sure we have all producers running
-         if ( tq->qdepth == 0 ) { pthread_cond_broadcast( &tq->producer_resume ); }
+         if ( TQ_DEPTH( tq ) == 0 ) { pthread_cond_broadcast( &tq->producer_resume ); }
          pthread_cond_wait( &tq->consumer_resume, &tq->qlock );
          if ( general_thread_resume_behavior( tq, wp, tID, &tstate, &cur_work ) < 0 ) { break; } // hit standard abort logic
          
       } // end of holding pattern -- this thread has some action to take
+      spsc_wait_end( tq );
 
       // First, check if we should be quitting
-      if( (tq->con_flags & TQ_ABORT)  ||  ( (tq->qdepth == 0) && (tq->con_flags & TQ_FINISHED) ) ) {
+      if( (tq->con_flags & TQ_ABORT)  ||  ( (TQ_DEPTH( tq ) == 0) && (tq->con_flags & TQ_FINISHED) ) ) {
          break;
       }
 
       // If not, then we should have work to do...
-      LOG( LOG_INFO, "%s %s Thread[%u]: Retrieving work package ( pos = %u, depth = %u )\n", tq->log_prefix, wp->pname, tID, tq->head, tq->qdepth );
+      LOG( LOG_INFO, "%s %s Thread[%u]: Retrieving work package ( pos = %u, depth = %u )\n", tq->log_prefix, wp->pname, tID, tq->head, TQ_DEPTH( tq ) );
       cur_work = tq->workpkg[ tq->head ]; // get a pointer to our work pkg
       tq->workpkg[ tq->head ] = NULL;     // clear that queue entry
       tq->head = ( tq->head + 1 ) % tq->max_qdepth; // adjust the head position to the next work pkg
-      tq->qdepth--;                                 // finally, decrement the queue depth
+      TQ_DEPTH_DEC( tq );                                 // finally, decrement the queue depth
 
       // if the number of empty queue positions exceeds the number of producers, tell a thread to resume
       if ( tq->prod_pool != NULL ) {
-         if ( (tq->max_qdepth - tq->qdepth) > tq->prod_pool->act_thrds   &&  tq->prod_pool->act_thrds < tq->prod_pool->num_thrds ) {
+         if ( (tq->max_qdepth - TQ_DEPTH( tq )) > tq->prod_pool->act_thrds   &&  tq->prod_pool->act_thrds < tq->prod_pool->num_thrds ) {
             LOG( LOG_INFO, "%s %s Thread[%u]: signaling %s thread ( running=%u, depth=%u )\n", 
-                           tq->log_prefix, wp->pname, tID, tq->prod_pool->pname, tq->prod_pool->act_thrds, tq->qdepth );
+                           tq->log_prefix, wp->pname, tID, tq->prod_pool->pname, tq->prod_pool->act_thrds, TQ_DEPTH( tq ) );
             pthread_cond_signal( &tq->producer_resume );
          }
       }
-      else if ( tq->qdepth == (tq->max_qdepth - 1) ) { // no producer threads and the queue was full, signal
+      else if ( TQ_DEPTH( tq ) == (tq->max_qdepth - 1) ) { // no producer threads and the queue was full, signal
          LOG( LOG_INFO, "%s %s Thread[%u]: blindly signaling a producer\n", tq->log_prefix, wp->pname, tID );
          pthread_cond_signal( &tq->producer_resume );
       }
@@ -449,17 +592,19 @@ void* producer_thread( void* arg ) {
       // Wait while there is no space available
       //      while the queue is halted
       //  but NOT while the queue is ABORTed OR FINISHED
-      while ( ( tq->qdepth == tq->max_qdepth  ||
+      spsc_wait_begin( tq );
+      while ( ( TQ_DEPTH( tq ) == tq->max_qdepth  ||
                 (tq->con_flags & TQ_HALT) )
                 &&  !( (tq->con_flags & TQ_ABORT)  ||  (tq->con_flags & TQ_FINISHED) ) ) {
 
          if ( general_thread_pause_behavior( tq, wp, tID, &tstate, &cur_work ) < 0 ) { break; } // hit standard abort logic
          // if our queue is full, make sure we have all consumers running
-         if ( tq->qdepth == tq->max_qdepth ) { pthread_cond_broadcast( &tq->consumer_resume ); }
+         if ( TQ_DEPTH( tq ) == tq->max_qdepth ) { pthread_cond_broadcast( &tq->consumer_resume ); }
          pthread_cond_wait( &tq->producer_resume, &tq->qlock );
          if ( general_thread_resume_behavior( tq, wp, tID, &tstate, &cur_work ) < 0 ) { break; } // hit standard abort logic
          
       } // end of holding pattern -- this thread has some action to take
+      spsc_wait_end( tq );
 
       // First, check if we should be quitting
       if( (tq->con_flags & TQ_ABORT)  ||  (tq->con_flags & TQ_FINISHED) ) {
@@ -469,23 +614,24 @@ void* producer_thread( void* arg ) {
       // check if we have a work package to enqueue
       if ( cur_work != NULL ) {
          // If we got this far, then we have space to enqueue...
-         LOG( LOG_INFO, "%s %s Thread[%u]: Storing work package (pos = %d, depth = %d)\n", tq->log_prefix, wp->pname, tID, tq->tail, tq->qdepth );
+         LOG( LOG_INFO, "%s %s Thread[%u]: Storing work package (pos = %d, depth = %d)\n", tq->log_prefix, wp->pname, tID, tq->tail, TQ_DEPTH( tq ) );
          tq->workpkg[ tq->tail ] = cur_work; // insert our work pkg at the tail
          tq->tail = ( tq->tail + 1 ) % tq->max_qdepth; // adjust the tail position to the next slot
-         tq->qdepth++;                       // finally, increment the queue depth
+         TQ_DEPTH_INC( tq );                       // finally, increment the queue depth
 
          // if the queue length exceeds the work being processed, tell a thread to resume
          if ( tq->cons_pool != NULL ) {
-            if ( tq->qdepth > tq->cons_pool->act_thrds   &&  tq->cons_pool->act_thrds < tq->cons_pool->num_thrds ) {
+            if ( TQ_DEPTH( tq ) > tq->cons_pool->act_thrds   &&  tq->cons_pool->act_thrds < tq->cons_pool->num_thrds ) {
                LOG( LOG_INFO, "%s %s Thread[%u]: signaling %s Thread ( running=%u, depth=%u )\n", 
-                              tq->log_prefix, wp->pname, tID, tq->cons_pool->pname, tq->cons_pool->act_thrds, tq->qdepth );
+                              tq->log_prefix, wp->pname, tID, tq->cons_pool->pname, tq->cons_pool->act_thrds, TQ_DEPTH( tq ) );
                pthread_cond_signal( &tq->consumer_resume );
             }
          }
-         else if ( tq->qdepth == 1 ) { // no consumer threads and the queue was empty, signal
+         else if ( TQ_DEPTH( tq ) == 1 ) { // no consumer threads and the queue was empty, signal
             LOG( LOG_INFO, "%s %s Thread[%u]: blindly signaling a consumer\n", tq->log_prefix, wp->pname, tID );
             pthread_cond_signal( &tq->consumer_resume );
          }
+         tq_group_notify( tq );
 
          cur_work = NULL; // clear this value to avoid confusion if we exit
       }
@@ -499,11 +645,433 @@ void* producer_thread( void* arg ) {
 }
 
 
+// call the thread_pause_func (if supplied) and set the HALTED state of a pooled thread, if not already done
+static int pooled_pause_behavior( ThreadQueue tq, TQWorkerPool wp ) {
+   // Queue lock MUST be held at this point
+   // NOTE -- unlike dedicated threads, a pooled thread is stepped on every queue change, so only pause once
+   if ( (tq->con_flags & TQ_HALT)  &&  !(tq->state_flags[0] & TQ_HALTED) ) {
+      if ( wp->thread_pause_func != NULL ) {
+         if ( wp->thread_pause_func( &tq->pstate, &tq->pwork ) != 0 ) {
+            LOG( LOG_ERR, "%s %s Pooled Thread: setting ABORT state due to pause func result\n", tq->log_prefix, wp->pname );
+            TQ_SET_FLAGS( tq, TQ_ABORT );
+            tq->state_flags[0] |= TQ_ERROR;
+            pthread_cond_broadcast( &tq->producer_resume );
+            pthread_cond_broadcast( &tq->consumer_resume );
+            tq_group_notify( tq );
+            pthread_cond_broadcast( &tq->state_resume );
+            return -1; // still holding lock
+         }
+      }
+      LOG( LOG_INFO, "%s %s Pooled Thread: Entering HALTED state\n", tq->log_prefix, wp->pname );
+      tq->state_flags[0] |= TQ_HALTED;
+      pthread_cond_broadcast( &tq->state_resume );
+   }
+   return 0; // still holding lock
+}
+
+
+// clear the HALTED state of a pooled thread and call the thread_resume_func (if supplied), if the HALT flag is gone
+static int pooled_resume_behavior( ThreadQueue tq, TQWorkerPool wp ) {
+   // Queue lock MUST be held at this point
+   if ( (tq->state_flags[0] & TQ_HALTED)  &&  !(tq->con_flags & TQ_HALT) ) {
+      LOG( LOG_INFO, "%s %s Pooled Thread: Clearing HALTED state\n", tq->log_prefix, wp->pname );
+      tq->state_flags[0] &= ~(TQ_HALTED);
+      if ( wp->thread_resume_func != NULL ) {
+         if ( wp->thread_resume_func( &tq->pstate, &tq->pwork ) != 0 ) {
+            LOG( LOG_ERR, "%s %s Pooled Thread: setting ABORT state due to resume func result\n", tq->log_prefix, wp->pname );
+            TQ_SET_FLAGS( tq, TQ_ABORT );
+            tq->state_flags[0] |= TQ_ERROR;
+            pthread_cond_broadcast( &tq->producer_resume );
+            pthread_cond_broadcast( &tq->consumer_resume );
+            tq_group_notify( tq );
+            pthread_cond_broadcast( &tq->state_resume );
+            return -1; // still holding lock
+         }
+      }
+   }
+   return 0; // still holding lock
+}
+
+
+// mark a pooled thread as having terminated ( equivalent to a dedicated thread exiting )
+static void pooled_thread_done( ThreadQueue tq ) {
+   // Queue lock MUST NOT be held at this point
+   if ( pthread_mutex_lock( &tq->qlock ) ) {
+      LOG( LOG_ERR, "%s Failed to acquire queue lock for pooled thread termination!\n", tq->log_prefix );
+      tq->pstage = TQ_STAGE_DONE; // no choice but to proceed without the lock
+      pthread_cond_broadcast( &tq->state_resume );
+      return;
+   }
+   tq->pstage = TQ_STAGE_DONE;
+   pthread_cond_broadcast( &tq->state_resume ); // master proc may be waiting to collect our state
+   pthread_mutex_unlock( &tq->qlock );
+}
+
+
+// run a single iteration of the pooled thread of a queue ( the equivalent of one pass through the main loop of 
+//  producer_thread() / consumer_thread() ), returning rather than waiting whenever no progress is possible
+static TQ_Step_Result pooled_thread_iteration( ThreadQueue tq ) {
+   char producer = ( tq->prod_pool != NULL );
+   TQWorkerPool wp = ( producer ) ? tq->prod_pool : tq->cons_pool;
+
+   if ( pthread_mutex_lock( &tq->qlock ) ) {
+      LOG( LOG_ERR, "%s %s Pooled Thread: Failed to acquire queue lock!\n", tq->log_prefix, wp->pname );
+      return TQ_STEP_POLL; // retry later
+   }
+   if ( tq->pstage == TQ_STAGE_DONE ) { pthread_mutex_unlock( &tq->qlock ); return TQ_STEP_IDLE; }
+   if ( tq->pstage == TQ_STAGE_INIT ) {
+      pthread_mutex_unlock( &tq->qlock );
+      if ( general_thread_init_behavior( tq, wp, 0, tq->global_state, &tq->pstate ) ) {
+         pooled_thread_done( tq );
+         return TQ_STEP_IDLE;
+      }
+      tq->pstage = TQ_STAGE_RUN;
+      // still holding lock
+   }
+   if ( pooled_resume_behavior( tq, wp ) < 0 ) { goto pooled_term; } // hit standard abort logic
+
+   if ( producer ) {
+      // check if we should be quitting
+      if ( (tq->con_flags & TQ_ABORT)  ||  (tq->con_flags & TQ_FINISHED) ) { goto pooled_term; }
+      // wait while the queue is halted
+      if ( tq->con_flags & TQ_HALT ) {
+         if ( pooled_pause_behavior( tq, wp ) < 0 ) { goto pooled_term; } // hit standard abort logic
+         pthread_mutex_unlock( &tq->qlock );
+         return TQ_STEP_IDLE;
+      }
+      // check if we have a work package to enqueue
+      if ( tq->pwork != NULL ) {
+         // wait while there is no space available
+         if ( TQ_DEPTH( tq ) == tq->max_qdepth ) {
+            pthread_cond_broadcast( &tq->consumer_resume );
+            pthread_mutex_unlock( &tq->qlock );
+            return TQ_STEP_IDLE;
+         }
+         LOG( LOG_INFO, "%s %s Pooled Thread: Storing work package (pos = %d, depth = %d)\n", tq->log_prefix, wp->pname, tq->tail, TQ_DEPTH( tq ) );
+         tq->workpkg[ tq->tail ] = tq->pwork;
+         tq->tail = ( tq->tail + 1 ) % tq->max_qdepth;
+         TQ_DEPTH_INC( tq );
+         tq->pwork = NULL;
+         pthread_cond_signal( &tq->consumer_resume ); // the only possible consumers are master procs
+         tq_group_notify( tq );
+      }
+      pthread_mutex_unlock( &tq->qlock );
+
+      // create our new work pkg
+      int work_res = wp->thread_work_func( &tq->pstate, &tq->pwork );
+      LOG( LOG_INFO, "%s %s Pooled Thread: Generated work package\n", tq->log_prefix, wp->pname );
+      if ( general_thread_post_work_behavior( tq, wp, 0, &tq->pstate, &tq->pwork, work_res ) ) { // failed to acquire lock
+         pooled_thread_done( tq );
+         return TQ_STEP_IDLE;
+      }
+      // a producer which yielded without work should be retried shortly, rather than immediately
+      TQ_Step_Result res = ( tq->pwork == NULL  &&  work_res == 0 ) ? TQ_STEP_POLL : TQ_STEP_AGAIN;
+      pthread_mutex_unlock( &tq->qlock );
+      return res;
+   }
+
+   // check if we should be quitting
+   if ( (tq->con_flags & TQ_ABORT)  ||  ( (TQ_DEPTH( tq ) == 0) && (tq->con_flags & TQ_FINISHED) ) ) { goto pooled_term; }
+   // wait while there is no work available, or while the queue is halted
+   if ( TQ_DEPTH( tq ) == 0  ||  (tq->con_flags & TQ_HALT) ) {
+      if ( pooled_pause_behavior( tq, wp ) < 0 ) { goto pooled_term; } // hit standard abort logic
+      if ( TQ_DEPTH( tq ) == 0 ) { pthread_cond_broadcast( &tq->producer_resume ); }
+      pthread_mutex_unlock( &tq->qlock );
+      return TQ_STEP_IDLE;
+   }
+   LOG( LOG_INFO, "%s %s Pooled Thread: Retrieving work package ( pos = %u, depth = %u )\n", tq->log_prefix, wp->pname, tq->head, TQ_DEPTH( tq ) );
+   tq->pwork = tq->workpkg[ tq->head ];
+   tq->workpkg[ tq->head ] = NULL;
+   tq->head = ( tq->head + 1 ) % tq->max_qdepth;
+   TQ_DEPTH_DEC( tq );
+   pthread_cond_signal( &tq->producer_resume ); // the only possible producers are master procs
+   pthread_mutex_unlock( &tq->qlock );
+
+   // process our new work pkg
+   int work_res = wp->thread_work_func( &tq->pstate, &tq->pwork );
+   LOG( LOG_INFO, "%s %s Pooled Thread: Processed work package\n", tq->log_prefix, wp->pname );
+   tq->pwork = NULL; // clear this value to avoid confusion if we can't reacquire the lock
+   if ( general_thread_post_work_behavior( tq, wp, 0, &tq->pstate, &tq->pwork, work_res ) ) { // failed to acquire lock
+      pooled_thread_done( tq );
+      return TQ_STEP_IDLE;
+   }
+   pthread_mutex_unlock( &tq->qlock );
+   return TQ_STEP_AGAIN;
+
+pooled_term:
+   // still holding lock
+   general_thread_term_behavior( tq, wp, 0, &tq->pstate, &tq->pwork );
+   pooled_thread_done( tq );
+   return TQ_STEP_IDLE;
+}
+
+
+// check if the given timespec is at least POOL_POLL_NSEC behind another
+static char poll_interval_passed( const struct timespec* since, const struct timespec* now ) {
+   long long elapsed = ( (long long)(now->tv_sec - since->tv_sec) * 1000000000LL ) + ( now->tv_nsec - since->tv_nsec );
+   return ( elapsed >= POOL_POLL_NSEC );
+}
+
+
+// defines behavior for all shared pool worker threads
+void* pool_worker( void* arg ) {
+   TQ_Pool pool = (TQ_Pool) arg;
+   if ( pthread_mutex_lock( &pool->plock ) ) {
+      LOG( LOG_ERR, "%s Worker failed to acquire pool lock!\n", pool->log_prefix );
+      return NULL;
+   }
+   while ( 1 ) {
+      // periodically flag any queues which previously yielded for another attempt
+      struct timespec now;
+      clock_gettime( CLOCK_MONOTONIC, &now );
+      if ( pool->pollcnt  &&  poll_interval_passed( &pool->lastpoll, &now ) ) {
+         ThreadQueue pq;
+         for ( pq = pool->queues; pq != NULL; pq = pq->pnext ) {
+            if ( pq->ppoll ) { pq->ppoll = 0; pq->ppending = 1; }
+         }
+         pool->pollcnt = 0;
+         pool->lastpoll = now;
+      }
+      // find the first queue requiring an iteration and not already being serviced
+      ThreadQueue tq = pool->queues;
+      ThreadQueue prev = NULL;
+      while ( tq != NULL  &&  ( tq->pclaimed  ||  !(tq->ppending) ) ) { prev = tq; tq = tq->pnext; }
+      if ( tq == NULL ) {
+         if ( pool->shutdown ) { break; }
+         if ( pool->pollcnt ) {
+            // sleep no longer than the next poll time
+            struct timespec waketime = pool->lastpoll;
+            waketime.tv_nsec += POOL_POLL_NSEC;
+            if ( waketime.tv_nsec >= 1000000000L ) { waketime.tv_sec++; waketime.tv_nsec -= 1000000000L; }
+            pthread_cond_timedwait( &pool->work_avail, &pool->plock, &waketime );
+         }
+         else {
+            pthread_cond_wait( &pool->work_avail, &pool->plock );
+         }
+         continue;
+      }
+      // move this queue to the end of the list, so that all others are serviced first next time
+      if ( tq->pnext != NULL ) {
+         if ( prev ) { prev->pnext = tq->pnext; }
+         else { pool->queues = tq->pnext; }
+         ThreadQueue last = tq->pnext;
+         while ( last->pnext != NULL ) { last = last->pnext; }
+         last->pnext = tq;
+         tq->pnext = NULL;
+      }
+      tq->pclaimed = 1;
+      tq->ppending = 0;
+      if ( tq->ppoll ) { tq->ppoll = 0; pool->pollcnt--; }
+      pthread_mutex_unlock( &pool->plock );
+
+      TQ_Step_Result res = pooled_thread_iteration( tq );
+
+      if ( pthread_mutex_lock( &pool->plock ) ) {
+         // nothing sensible can be done from here, as the queue can never be released
+         LOG( LOG_ERR, "%s Worker failed to reacquire pool lock!\n", pool->log_prefix );
+         return NULL;
+      }
+      tq->pclaimed = 0;
+      if ( res == TQ_STEP_AGAIN ) { tq->ppending = 1; }
+      else if ( res == TQ_STEP_POLL  &&  !(tq->ppending) ) {
+         if ( pool->pollcnt == 0 ) { clock_gettime( CLOCK_MONOTONIC, &pool->lastpoll ); }
+         tq->ppoll = 1;
+         pool->pollcnt++;
+      }
+      pthread_cond_broadcast( &pool->released );
+   }
+   pthread_mutex_unlock( &pool->plock );
+   return NULL;
+}
+
+
+// add a queue to the set serviced by its pool
+static int pool_attach( ThreadQueue tq ) {
+   TQ_Pool pool = tq->pool;
+   if ( pthread_mutex_lock( &pool->plock ) ) {
+      LOG( LOG_ERR, "%s Failed to acquire pool lock!\n", tq->log_prefix );
+      return -1;
+   }
+   if ( pool->shutdown ) {
+      LOG( LOG_ERR, "%s Cannot attach to a terminating pool!\n", tq->log_prefix );
+      pthread_mutex_unlock( &pool->plock );
+      errno = EINVAL;
+      return -1;
+   }
+   tq->pclaimed = 0;
+   tq->ppoll = 0;
+   tq->ppending = 1; // the pooled thread still needs to initialize
+   tq->pnext = pool->queues;
+   pool->queues = tq;
+   pthread_cond_signal( &pool->work_avail );
+   pthread_mutex_unlock( &pool->plock );
+   return 0;
+}
+
+
+// remove a queue from the set serviced by its pool, waiting for any running iteration to complete
+static void pool_detach( ThreadQueue tq ) {
+   TQ_Pool pool = tq->pool;
+   if ( pthread_mutex_lock( &pool->plock ) ) {
+      LOG( LOG_ERR, "%s Failed to acquire pool lock!\n", tq->log_prefix );
+      return;
+   }
+   while ( tq->pclaimed ) { pthread_cond_wait( &pool->released, &pool->plock ); }
+   ThreadQueue* ref = &(pool->queues);
+   while ( *ref != NULL  &&  *ref != tq ) { ref = &((*ref)->pnext); }
+   if ( *ref == tq ) {
+      *ref = tq->pnext;
+      if ( tq->ppoll ) { pool->pollcnt--; }
+   }
+   tq->pnext = NULL;
+   pthread_mutex_unlock( &pool->plock );
+}
+
+
 
 /* -------------------------------------------------------  EXPOSED FUNCTIONS  ------------------------------------------------------- */
 
 
 
+/**
+ * Initializes a new pool of worker threads, which may be shared between any number of ThreadQueues ( see the 
+ *  'pool' value of TQ_Init_Opts ).  Each worker repeatedly selects a queue with work available and runs a single 
+ *  iteration of that queue's thread ( a single work package, pause, resume, etc. ).  As a result, a pooled 
+ *  producer_func() should return zero with a NULL work package, rather than block, if it cannot make progress 
+ *  ( the queue will then be retried once tq_notify() is called for it, or, failing that, polled again shortly ).
+ * @param unsigned int num_threads : Number of worker threads to start
+ * @param const char* log_prefix : String prefix for all log messages produced by the pool ( may be NULL )
+ * @return TQ_Pool : Reference to the new pool, or NULL if an error was encountered
+ */
+TQ_Pool tq_pool_init( unsigned int num_threads, const char* log_prefix ) {
+   if ( num_threads == 0 ) {
+      LOG( LOG_ERR, "Received a zero value for pool thread count\n" );
+      errno = EINVAL;
+      return NULL;
+   }
+   TQ_Pool pool = malloc( sizeof( struct thread_queue_pool_struct ) );
+   if ( pool == NULL ) { LOG( LOG_ERR, "failed to allocate space for TQ_Pool!\n" ); return NULL; }
+   pool->log_prefix = strdup( ( log_prefix != NULL ) ? log_prefix : def_pool_pref );
+   if ( pool->log_prefix == NULL ) { LOG( LOG_ERR, "failed to allocate space for TQ_Pool log prefix!\n" ); free( pool ); return NULL; }
+   pool->threads = malloc( sizeof(pthread_t) * num_threads );
+   if ( pool->threads == NULL ) {
+      LOG( LOG_ERR, "%s failed to allocate space for worker threads!\n", pool->log_prefix );
+      free( pool->log_prefix );
+      free( pool );
+      return NULL;
+   }
+   if ( pthread_mutex_init( &pool->plock, NULL ) ) {
+      free( pool->threads );
+      free( pool->log_prefix );
+      free( pool );
+      return NULL;
+   }
+   // workers poll yielded queues on a CLOCK_MONOTONIC schedule, immune to any adjustment of the system time
+   pthread_condattr_t cattr;
+   if ( pthread_condattr_init( &cattr ) ) {
+      pthread_mutex_destroy( &pool->plock );
+      free( pool->threads );
+      free( pool->log_prefix );
+      free( pool );
+      return NULL;
+   }
+   if ( pthread_condattr_setclock( &cattr, CLOCK_MONOTONIC )  ||  pthread_cond_init( &pool->work_avail, &cattr ) ) {
+      pthread_condattr_destroy( &cattr );
+      pthread_mutex_destroy( &pool->plock );
+      free( pool->threads );
+      free( pool->log_prefix );
+      free( pool );
+      return NULL;
+   }
+   pthread_condattr_destroy( &cattr );
+   if ( pthread_cond_init( &pool->released, NULL ) ) {
+      pthread_cond_destroy( &pool->work_avail );
+      pthread_mutex_destroy( &pool->plock );
+      free( pool->threads );
+      free( pool->log_prefix );
+      free( pool );
+      return NULL;
+   }
+   pool->shutdown = 0;
+   pool->queues = NULL;
+   pool->pollcnt = 0;
+   pool->lastpoll.tv_sec = 0;
+   pool->lastpoll.tv_nsec = 0;
+   LOG( LOG_INFO, "%s Starting %u worker threads\n", pool->log_prefix, num_threads );
+   for ( pool->num_thrds = 0; pool->num_thrds < num_threads; pool->num_thrds++ ) {
+      if ( pthread_create( &pool->threads[pool->num_thrds], NULL, pool_worker, (void*) pool ) ) {
+         LOG( LOG_ERR, "%s failed to create worker thread %u\n", pool->log_prefix, pool->num_thrds );
+         tq_pool_term( pool ); // cleans up any threads we did start
+         return NULL;
+      }
+   }
+   return pool;
+}
+
+
+/**
+ * Terminates all worker threads of the given TQ_Pool and frees it
+ * @param TQ_Pool pool : Pool to be terminated
+ * @return int : Zero on success, or -1 on failure ( errno == EBUSY, if any ThreadQueues still reference the pool )
+ */
+int tq_pool_term( TQ_Pool pool ) {
+   if ( pool == NULL ) {
+      LOG( LOG_ERR, "Received a NULL TQ_Pool reference!\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   if ( pthread_mutex_lock( &pool->plock ) ) {
+      LOG( LOG_ERR, "%s failed to acquire pool lock!\n", pool->log_prefix );
+      return -1;
+   }
+   if ( pool->queues != NULL ) {
+      LOG( LOG_ERR, "%s cannot terminate a pool with ThreadQueues still attached\n", pool->log_prefix );
+      pthread_mutex_unlock( &pool->plock );
+      errno = EBUSY;
+      return -1;
+   }
+   pool->shutdown = 1;
+   pthread_cond_broadcast( &pool->work_avail );
+   pthread_mutex_unlock( &pool->plock );
+   unsigned int tID;
+   for ( tID = 0; tID < pool->num_thrds; tID++ ) {
+      pthread_join( pool->threads[tID], NULL );
+      LOG( LOG_INFO, "%s joined with worker thread %u\n", pool->log_prefix, tID );
+   }
+   pthread_cond_destroy( &pool->released );
+   pthread_cond_destroy( &pool->work_avail );
+   pthread_mutex_destroy( &pool->plock );
+   free( pool->threads );
+   free( pool->log_prefix );
+   free( pool );
+   return 0;
+}
+
+
+/**
+ * Notify a ThreadQueue that some condition outside of the queue itself has changed, such that a pooled thread 
+ *  which previously yielded without progress may now proceed ( no-op for queues with dedicated threads )
+ * @param ThreadQueue tq : ThreadQueue to be notified
+ * @return int : Zero on success and non-zero on failure
+ */
+int tq_notify( ThreadQueue tq ) {
+   if ( tq == NULL ) {
+      LOG( LOG_ERR, "Received a NULL ThreadQueue reference!\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   if ( tq->pool == NULL ) { return 0; }
+   if ( pthread_mutex_lock( &tq->qlock ) ) {
+      LOG( LOG_ERR, "%s Failed to acquire queue lock!\n", tq->log_prefix );
+      return -1;
+   }
+   tq_pool_notify( tq );
+   pthread_mutex_unlock( &tq->qlock );
+   return 0;
+}
+
+
+
 /**
  * Initializes a new ThreadQueue according to the parameters of the passed options struct
  * @param TQ_Init_Opts opts : options struct defining parameters for the created ThreadQueue
@@ -570,6 +1138,16 @@ ThreadQueue tq_init( TQ_Init_Opts* opts ) {
                      tq->log_prefix, (opts->num_threads - opts->num_prod_threads) );
       abort = 1;
    }
+   if ( opts->pool != NULL  &&  opts->num_threads != 1 ) {
+      LOG( LOG_ERR, "%s Received thread count of %u, but pooled queues are limited to a single thread\n", 
+                     tq->log_prefix, opts->num_threads );
+      abort = 1;
+   }
+   if ( opts->spsc  &&  opts->num_threads != 1 ) {
+      LOG( LOG_ERR, "%s Received thread count of %u, but SPSC queues are limited to a single thread\n", 
+                     tq->log_prefix, opts->num_threads );
+      abort = 1;
+   }
    if ( abort ) { FREE_TQP( tq ); return NULL; } // abort if any of the above conditions were true
 
    // initialize all TQ fields we received from the caller
@@ -578,6 +1156,10 @@ ThreadQueue tq_init( TQ_Init_Opts* opts ) {
    tq->qdepth = 0;
    tq->head   = 0;
    tq->tail   = 0;
+   // pooled threads are only ever stepped on a queue notification, so they always use the locked path
+   tq->spsc   = ( opts->spsc  &&  opts->pool == NULL );
+   tq->spsc_waiters = 0;
+   tq->group = NULL;
    // initialize control flags
    tq->con_flags = opts->init_flags;
    // initialize worker pools to NULL (simplifies cleanup logic)
@@ -585,6 +1167,16 @@ ThreadQueue tq_init( TQ_Init_Opts* opts ) {
    tq->cons_pool = NULL;
    // initialize our count of uncollected threads
    tq->uncoll_thrds = 0;
+   // initialize shared pool values
+   tq->pool         = opts->pool;
+   tq->global_state = opts->global_state;
+   tq->pstate       = NULL;
+   tq->pwork        = NULL;
+   tq->pstage       = TQ_STAGE_INIT;
+   tq->pclaimed     = 0;
+   tq->ppending     = 0;
+   tq->ppoll        = 0;
+   tq->pnext        = NULL;
    // initialize pthread control structures
    if ( pthread_mutex_init( &tq->qlock, NULL ) ) { free( tq->log_prefix ); free( tq ); return NULL; }
    if ( pthread_cond_init( &tq->state_resume, NULL ) ) {
@@ -598,13 +1190,24 @@ ThreadQueue tq_init( TQ_Init_Opts* opts ) {
       FREE_TQP( tq );
       return NULL;
    }
-   if ( pthread_cond_init( &tq->consumer_resume, NULL ) ) {
+   // timed dequeues wait on a CLOCK_MONOTONIC deadline, immune to any adjustment of the system time
+   pthread_condattr_t cattr;
+   if ( pthread_condattr_init( &cattr ) ) {
+      pthread_cond_destroy( &tq->producer_resume );
+      pthread_cond_destroy( &tq->state_resume );
+      pthread_mutex_destroy( &tq->qlock );
+      FREE_TQP( tq );
+      return NULL;
+   }
+   if ( pthread_condattr_setclock( &cattr, CLOCK_MONOTONIC )  ||  pthread_cond_init( &tq->consumer_resume, &cattr ) ) {
+      pthread_condattr_destroy( &cattr );
       pthread_cond_destroy( &tq->producer_resume );
       pthread_cond_destroy( &tq->state_resume );
       pthread_mutex_destroy( &tq->qlock );
       FREE_TQP( tq );
       return NULL;
    }
+   pthread_condattr_destroy( &cattr );
 
 #define FREE_PTHREAD_VALUES( TQ ) \
    pthread_cond_destroy( &TQ->consumer_resume );\
@@ -668,7 +1271,10 @@ ThreadQueue tq_init( TQ_Init_Opts* opts ) {
          targ->tID = tID;
          targ->tq = tq;
          LOG( LOG_INFO, "%s Starting %s Thread %u\n", tq->log_prefix, wp->pname, targ->tID );
-         if ( pthread_create( &tq->threads[tID], NULL, producer_thread, (void*) targ ) ) {
+         if ( tq->pool != NULL ) {
+            // this thread will be run by the shared pool, once attached
+         }
+         else if ( pthread_create( &tq->threads[tID], NULL, producer_thread, (void*) targ ) ) {
             LOG( LOG_ERR, "%s failed to create thread %d\n", tq->log_prefix, tID );
             break;
          }
@@ -700,7 +1306,10 @@ ThreadQueue tq_init( TQ_Init_Opts* opts ) {
          targ->tID = tID;
          targ->tq = tq;
          LOG( LOG_INFO, "%s Starting %s Thread %u\n", tq->log_prefix, wp->pname, targ->tID );
-         if ( pthread_create( &tq->threads[tID], NULL, consumer_thread, (void*) targ ) ) {
+         if ( tq->pool != NULL ) {
+            // this thread will be run by the shared pool, once attached
+         }
+         else if ( pthread_create( &tq->threads[tID], NULL, consumer_thread, (void*) targ ) ) {
             LOG( LOG_ERR, "%s failed to create thread %d\n", tq->log_prefix, tID );
             break;
          }
@@ -708,6 +1317,17 @@ ThreadQueue tq_init( TQ_Init_Opts* opts ) {
       }
    }
 
+   // hand a pooled thread over to the pool
+   char attached = 0;
+   if ( tq->pool != NULL  &&  tID == opts->num_threads ) {
+      if ( pool_attach( tq ) ) {
+         LOG( LOG_ERR, "%s failed to attach to the shared pool\n", tq->log_prefix );
+         tq->uncoll_thrds = 0;
+         tID = 0;
+      }
+      else { attached = 1; }
+   }
+
    // check for initialization of all threads
    if ( pthread_mutex_lock( &tq->qlock ) ) { 
       LOG( LOG_ERR, "%s failed to acquire queue lock!\n", tq->log_prefix );
@@ -730,10 +1350,19 @@ ThreadQueue tq_init( TQ_Init_Opts* opts ) {
    // still holding lock (so long as that wasn't the reason we're aborting)
    if ( tID != opts->num_threads ) { // an error occured while creating threads
       LOG( LOG_ERR, "%s failed to init all threads: signaling ABORT!\n", tq->log_prefix );
-      tq->con_flags |= TQ_ABORT; // signal all threads to abort (potentially redundant)
+      TQ_SET_FLAGS( tq, TQ_ABORT ); // signal all threads to abort (potentially redundant)
       pthread_cond_broadcast( &tq->consumer_resume );
       pthread_cond_broadcast( &tq->producer_resume );
       if ( tID < opts->num_threads ) { pthread_mutex_unlock( &tq->qlock ); } //if this wasn't a locking failure, unlock
+      if ( attached ) {
+         // the pooled thread must still terminate, then we can stop it from being serviced
+         pthread_mutex_lock( &tq->qlock );
+         tq_pool_notify( tq );
+         while ( tq->pstage != TQ_STAGE_DONE ) { pthread_cond_wait( &tq->state_resume, &tq->qlock ); }
+         pthread_mutex_unlock( &tq->qlock );
+         pool_detach( tq );
+         tq->uncoll_thrds = 0;
+      }
       for ( tID = 0; tID < tq->uncoll_thrds; tID++ ) {
          pthread_join( tq->threads[tID], NULL ); // just ignore thread status, we are already aborting
          LOG( LOG_INFO, "%s joined with thread %u\n", tq->log_prefix, tID );
@@ -783,6 +1412,8 @@ int tq_get_opts( ThreadQueue tq, TQ_Init_Opts* opts, int log_strlen ) {
    opts->global_state = NULL; // just don't bother
    opts->num_threads = num_threads;
    opts->num_prod_threads = num_prods;
+   opts->pool = tq->pool;
+   opts->spsc = tq->spsc;
    opts->thread_consumer_func = NULL; // init to NULL, just in case
    opts->thread_producer_func = NULL; // init to NULL, just in case
    if ( tq->prod_pool ) {
@@ -818,12 +1449,31 @@ int tq_get_opts( ThreadQueue tq, TQ_Init_Opts* opts, int log_strlen ) {
  * @return int : Zero on success, -1 on failure (such as, if the queue is ABORTED and TQ_ABORT was not specified)
  */
 int tq_enqueue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void* workbuff ) {
+   if ( tq->spsc ) {
+      // lockless path, for the common case of a queue with no flags set and space available
+      int spins = 0;
+      while ( TQ_FLAGS( tq ) == 0 ) {
+         if ( TQ_DEPTH( tq ) < tq->max_qdepth ) {
+            // only the master ( sole producer ) touches the tail, and the consumer cannot see this slot until the depth is raised
+            tq->workpkg[ tq->tail ] = workbuff;
+            tq->tail = (tq->tail + 1 ) % tq->max_qdepth;
+            TQ_DEPTH_INC( tq );
+            spsc_wake( tq );
+            tq_group_notify( tq );
+            return 0;
+         }
+         if ( ++spins > SPSC_SPINS ) { break; }
+         sched_yield(); // give the consumer a chance to make room
+      }
+      // fall back to the locked path, to wait or to handle flags
+   }
    if ( pthread_mutex_lock( &tq->qlock ) ) { return -1; }
 
    // wait for an opening in the queue or for work to be canceled
-   while ( ( tq->qdepth == tq->max_qdepth )  &&  !(tq->con_flags & ~(ignore_flags)) ) {
+   while ( ( TQ_DEPTH( tq ) == tq->max_qdepth )  &&  !(tq->con_flags & ~(ignore_flags)) ) {
       LOG( LOG_INFO, "%s master proc is waiting for an opening to enqueue into\n", tq->log_prefix );
       pthread_cond_broadcast( &tq->consumer_resume ); // our queue is full!  Make sure all consumers are running
+      tq_pool_notify( tq );
       pthread_cond_wait( &tq->producer_resume, &tq->qlock );
       LOG( LOG_INFO, "%s master proc has woken up\n", tq->log_prefix );
    }
@@ -838,22 +1488,24 @@ int tq_enqueue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void* workbuff )
    // insert the new work at the tail of the queue
    tq->workpkg[ tq->tail ] = workbuff;          // insert the workbuff into the queue
    tq->tail = (tq->tail + 1 ) % tq->max_qdepth; // move the tail to the next slot
-   tq->qdepth++;                                // finally, increment the queue depth
+   TQ_DEPTH_INC( tq );                                // finally, increment the queue depth
    LOG( LOG_INFO, "%s master proc has successfully enqueued work\n", tq->log_prefix );
 
    // if the queue length exceeds the work being processed, tell a thread to resume
    if ( tq->cons_pool != NULL ) {
-      if ( tq->qdepth > tq->cons_pool->act_thrds   &&  tq->cons_pool->act_thrds < tq->cons_pool->num_thrds ) {
+      if ( TQ_DEPTH( tq ) > tq->cons_pool->act_thrds   &&  tq->cons_pool->act_thrds < tq->cons_pool->num_thrds ) {
          LOG( LOG_INFO, "%s master signaling an additional %s thread ( running=%u, depth=%u )\n", 
-                        tq->log_prefix, tq->cons_pool->pname, tq->cons_pool->act_thrds, tq->qdepth );
+                        tq->log_prefix, tq->cons_pool->pname, tq->cons_pool->act_thrds, TQ_DEPTH( tq ) );
          pthread_cond_signal( &tq->consumer_resume );
       }
    }
-   else if ( tq->qdepth == 1 ) { // no consumer threads and the queue was empty, signal
+   else if ( TQ_DEPTH( tq ) == 1 ) { // no consumer threads and the queue was empty, signal
       // why are you just using this as a queue?  where are your consumer threads? You're doing it wrong!!!
       LOG( LOG_INFO, "%s master blindly signaling a consumer\n", tq->log_prefix );
       pthread_cond_signal( &tq->consumer_resume );
    }
+   tq_pool_notify( tq );
+   tq_group_notify( tq );
 
    pthread_mutex_unlock( &tq->qlock );
 
@@ -863,27 +1515,57 @@ int tq_enqueue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void* workbuff )
 
 
 /**
- * Retrieve a new element of work from the ThreadQueue.
- *  Note that, if the Queue is empty but not FINISHED, this call will block.
- *  However, if the Queue is empty and FINISED, this call will return zero and 
- *  populate workbuff with a NULL value.
+ * Retrieve a new element of work from the ThreadQueue, optionally giving up at the specified time
  * @param ThreadQueue tq : ThreadQueue from which to retrieve work
  * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
- *                                        (By default, only a TQ_FINISHED state will not result in a failure)
  * @param void** workbuff : Reference to be populated with the work element pointer
- * @return int : The depth of the queue (including the retrieved element) on success,
- *               Zero if the queue is both empty and has ANY control flags set (deadlock protection),
- *               and -1 on failure (such as, if the queue is HALTED or ABORTED, and those flags were not ignored)
+ * @param const struct timespec* abstime : Absolute ( CLOCK_MONOTONIC ) time at which to give up, or NULL to wait indefinitely
+ * @param char poll : If non-zero, never wait, but instead fail with errno == EAGAIN if tq_dequeue() would block
+ * @return int : See tq_dequeue() / tq_timed_dequeue()
  */
-int tq_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff ) {
+static int dequeue_internal( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff, const struct timespec* abstime, char poll ) {
+   if ( tq->spsc ) {
+      // lockless path, for the common case of a queue with no flags set and work available
+      int spins = 0;
+      while ( TQ_FLAGS( tq ) == 0 ) {
+         int depth = TQ_DEPTH( tq );
+         if ( depth ) {
+            // only the master ( sole consumer ) touches the head, and the producer cannot reuse this slot until the depth is lowered
+            if ( workbuff )
+               *workbuff = tq->workpkg[ tq->head ];
+            tq->head = (tq->head + 1) % tq->max_qdepth;
+            TQ_DEPTH_DEC( tq );
+            spsc_wake( tq );
+            return depth;
+         }
+         if ( poll  ||  ++spins > SPSC_SPINS ) { break; }
+         sched_yield(); // give the producer a chance to fill the queue
+      }
+      // fall back to the locked path, to wait or to handle flags
+   }
    if ( pthread_mutex_lock( &tq->qlock ) ) { return -1; }
    ignore_flags |= TQ_FINISHED; // a FINISHED queue can still be dequeued from
 
    // wait for a queue element or for any state flags which could prevent work from being created
-   while ( ( tq->qdepth == 0  &&  !(tq->con_flags) ) ) {
-      LOG( LOG_INFO, "%s master proc is waiting for an element to dequeue\n", tq->log_prefix );
+   while ( ( TQ_DEPTH( tq ) == 0  &&  !(tq->con_flags) ) ) {
       pthread_cond_broadcast( &tq->producer_resume ); // our queue is empty!  Make sure all producers are running
-      pthread_cond_wait( &tq->consumer_resume, &tq->qlock );
+      tq_pool_notify( tq );
+      if ( poll ) {
+         pthread_mutex_unlock( &tq->qlock );
+         errno = EAGAIN;
+         return -1;
+      }
+      LOG( LOG_INFO, "%s master proc is waiting for an element to dequeue\n", tq->log_prefix );
+      if ( abstime == NULL ) {
+         pthread_cond_wait( &tq->consumer_resume, &tq->qlock );
+      }
+      else if ( pthread_cond_timedwait( &tq->consumer_resume, &tq->qlock, abstime ) == ETIMEDOUT  &&
+                TQ_DEPTH( tq ) == 0  &&  !(tq->con_flags) ) {
+         LOG( LOG_INFO, "%s master proc timed out waiting for an element\n", tq->log_prefix );
+         pthread_mutex_unlock( &tq->qlock );
+         errno = ETIMEDOUT;
+         return -1;
+      }
       LOG( LOG_INFO, "%s master proc has woken up\n", tq->log_prefix );
    }
    // check for any oddball conditions which should prevent this work
@@ -894,7 +1576,7 @@ int tq_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff )
       return -1;
    }
    // check for an empty queue
-   if ( tq->qdepth == 0 ) {
+   if ( TQ_DEPTH( tq ) == 0 ) {
       LOG( LOG_INFO, "%s master proc can't dequeue while queue is empty and has flags: %d\n", tq->log_prefix, tq->con_flags );
       pthread_mutex_unlock( &tq->qlock );
       if ( workbuff )
@@ -903,30 +1585,31 @@ int tq_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff )
    }
 
    // note the queue depth before removal, for reporting
-   int depth = tq->qdepth;
+   int depth = TQ_DEPTH( tq );
 
    // remove a work pkg from the head of the queue
    if ( workbuff )
       *workbuff = tq->workpkg[ tq->head ];
    tq->head = (tq->head + 1) % tq->max_qdepth;
-   tq->qdepth--;
+   TQ_DEPTH_DEC( tq );
    LOG( LOG_INFO, "%s master proc has successfully dequeued work\n", tq->log_prefix );
 
    // only wake producers if the queue is in a standard state
    if ( !(tq->con_flags) ) {
       // if the number of empty queue positions exceeds the number of producers, tell a thread to resume
       if ( tq->prod_pool != NULL ) {
-         if ( (tq->max_qdepth - tq->qdepth) > tq->prod_pool->act_thrds   &&  tq->prod_pool->act_thrds < tq->prod_pool->num_thrds ) {
+         if ( (tq->max_qdepth - TQ_DEPTH( tq )) > tq->prod_pool->act_thrds   &&  tq->prod_pool->act_thrds < tq->prod_pool->num_thrds ) {
             LOG( LOG_INFO, "%s master signaling an additional %s thread ( running=%u, depth=%u )\n", 
-                           tq->log_prefix, tq->prod_pool->pname, tq->prod_pool->act_thrds, tq->qdepth );
+                           tq->log_prefix, tq->prod_pool->pname, tq->prod_pool->act_thrds, TQ_DEPTH( tq ) );
             pthread_cond_signal( &tq->producer_resume );
          }
       }
-      else if ( tq->qdepth == (tq->max_qdepth - 1) ) { // no producer threads and the queue was full, signal
+      else if ( TQ_DEPTH( tq ) == (tq->max_qdepth - 1) ) { // no producer threads and the queue was full, signal
          // why are you just using this as a queue?  where are your producer threads? You're doing it wrong!!!
          LOG( LOG_INFO, "%s master blindly signaling a producer\n", tq->log_prefix );
          pthread_cond_signal( &tq->producer_resume );
       }
+      tq_pool_notify( tq );
    }
 
    pthread_mutex_unlock( &tq->qlock );
@@ -935,6 +1618,205 @@ int tq_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff )
 }
 
 
+/**
+ * Retrieve a new element of work from the ThreadQueue.
+ *  Note that, if the Queue is empty but not FINISHED, this call will block.
+ *  However, if the Queue is empty and FINISED, this call will return zero and 
+ *  populate workbuff with a NULL value.
+ * @param ThreadQueue tq : ThreadQueue from which to retrieve work
+ * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
+ *                                        (By default, only a TQ_FINISHED state will not result in a failure)
+ * @param void** workbuff : Reference to be populated with the work element pointer
+ * @return int : The depth of the queue (including the retrieved element) on success,
+ *               Zero if the queue is both empty and has ANY control flags set (deadlock protection),
+ *               and -1 on failure (such as, if the queue is HALTED or ABORTED, and those flags were not ignored)
+ */
+int tq_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff ) {
+   return dequeue_internal( tq, ignore_flags, workbuff, NULL, 0 );
+}
+
+
+/**
+ * Retrieve a new element of work from the ThreadQueue, giving up if none is available by the specified time.
+ *  Aside from the timeout, this behaves identically to tq_dequeue().
+ * @param ThreadQueue tq : ThreadQueue from which to retrieve work
+ * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
+ *                                        (By default, only a TQ_FINISHED state will not result in a failure)
+ * @param void** workbuff : Reference to be populated with the work element pointer
+ * @param const struct timespec* abstime : Absolute ( CLOCK_MONOTONIC ) time at which to give up
+ * @return int : The depth of the queue (including the retrieved element) on success,
+ *               Zero if the queue is both empty and has ANY control flags set (deadlock protection),
+ *               and -1 on failure (errno == ETIMEDOUT, if no element arrived in time)
+ */
+int tq_timed_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff, const struct timespec* abstime ) {
+   return dequeue_internal( tq, ignore_flags, workbuff, abstime, 0 );
+}
+
+
+/**
+ * Initializes a new group of ThreadQueues, allowing a master proc to retrieve work from whichever member 
+ *  queue first has some available ( see tq_dequeue_any() ).
+ *  NOTE -- a ThreadQueue may only belong to a single group at a time, and the group must be terminated 
+ *          before any of its member queues are closed.
+ * @param ThreadQueue* queues : Array of queues to be included in the group
+ * @param unsigned int count : Number of queues in the array
+ * @return TQ_Group : Reference to the new group, or NULL if an error was encountered 
+ *                    ( errno == EBUSY, if a queue already belongs to another group )
+ */
+TQ_Group tq_group_init( ThreadQueue* queues, unsigned int count ) {
+   if ( queues == NULL  ||  count == 0 ) {
+      LOG( LOG_ERR, "Received a NULL queue array or a zero queue count\n" );
+      errno = EINVAL;
+      return NULL;
+   }
+   TQ_Group group = malloc( sizeof( struct thread_queue_group_struct ) );
+   if ( group == NULL ) { LOG( LOG_ERR, "failed to allocate space for TQ_Group!\n" ); return NULL; }
+   group->queues = malloc( sizeof( ThreadQueue ) * count );
+   if ( group->queues == NULL ) {
+      LOG( LOG_ERR, "failed to allocate space for TQ_Group queue list!\n" );
+      free( group );
+      return NULL;
+   }
+   if ( pthread_mutex_init( &group->glock, NULL ) ) {
+      LOG( LOG_ERR, "failed to initialize TQ_Group lock!\n" );
+      free( group->queues );
+      free( group );
+      return NULL;
+   }
+   if ( pthread_cond_init( &group->ready, NULL ) ) {
+      LOG( LOG_ERR, "failed to initialize TQ_Group condition variable!\n" );
+      pthread_mutex_destroy( &group->glock );
+      free( group->queues );
+      free( group );
+      return NULL;
+   }
+   group->changes = 0;
+   group->count = 0;
+   group->next = 0;
+
+   // join each queue to the group
+   for ( ; group->count < count; group->count++ ) {
+      ThreadQueue tq = queues[ group->count ];
+      if ( tq == NULL  ||  pthread_mutex_lock( &tq->qlock ) ) {
+         LOG( LOG_ERR, "failed to acquire queue lock of group member %u!\n", group->count );
+         errno = EINVAL;
+         break;
+      }
+      if ( tq->group != NULL ) {
+         LOG( LOG_ERR, "%s queue already belongs to a group!\n", tq->log_prefix );
+         pthread_mutex_unlock( &tq->qlock );
+         errno = EBUSY;
+         break;
+      }
+      tq->group = group;
+      group->queues[ group->count ] = tq;
+      pthread_mutex_unlock( &tq->qlock );
+   }
+   if ( group->count != count ) {
+      tq_group_term( group ); // removes any queues we have already joined
+      return NULL;
+   }
+   return group;
+}
+
+
+/**
+ * Retrieve a new element of work from whichever selected queue of the TQ_Group first has one available.
+ *  Note that this call will block only while ALL selected queues would cause tq_dequeue() to block.  
+ *  Otherwise, the first such queue is dequeued from exactly as tq_dequeue() would be.
+ *  NOTE -- concurrent calls on the same group must be serialized by the caller.
+ * @param TQ_Group group : TQ_Group from which to retrieve work
+ * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
+ *                                        (By default, only a TQ_FINISHED state will not result in a failure)
+ * @param const char* select : Array ( of length equal to the group size ) indicating which queues to consider, 
+ *                             by non-zero values, or NULL to consider all queues of the group
+ * @param void** workbuff : Reference to be populated with the work element pointer
+ * @param unsigned int* index : Reference to be populated with the group index of the queue dequeued from
+ * @return int : The result of tq_dequeue() for the queue at the populated index,
+ *               or -1 with errno == EINVAL, if no queues were selected
+ */
+int tq_dequeue_any( TQ_Group group, TQ_Control_Flags ignore_flags, const char* select, void** workbuff, unsigned int* index ) {
+   if ( group == NULL  ||  index == NULL ) {
+      LOG( LOG_ERR, "Received a NULL group or index reference\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   while ( 1 ) {
+      // note the change count before checking any queue, so that no change after our check can be missed
+      if ( pthread_mutex_lock( &group->glock ) ) {
+         LOG( LOG_ERR, "master failed to acquire group lock!\n" );
+         return -1;
+      }
+      unsigned long changes = group->changes;
+      pthread_mutex_unlock( &group->glock );
+
+      // check each selected queue, beginning just after the last one dequeued from, so that none are starved
+      char selected = 0;
+      unsigned int pos;
+      for ( pos = 0; pos < group->count; pos++ ) {
+         unsigned int qindex = ( group->next + pos ) % group->count;
+         if ( select != NULL  &&  !(select[qindex]) ) { continue; }
+         selected = 1;
+         errno = 0;
+         int depth = dequeue_internal( group->queues[qindex], ignore_flags, workbuff, NULL, 1 );
+         if ( depth >= 0  ||  errno != EAGAIN ) {
+            *index = qindex;
+            group->next = ( qindex + 1 ) % group->count;
+            return depth;
+         }
+      }
+      if ( !(selected) ) {
+         LOG( LOG_ERR, "No queues of the group were selected\n" );
+         errno = EINVAL;
+         return -1;
+      }
+
+      // wait for any member queue to change
+      if ( pthread_mutex_lock( &group->glock ) ) {
+         LOG( LOG_ERR, "master failed to acquire group lock!\n" );
+         return -1;
+      }
+      while ( group->changes == changes ) {
+         LOG( LOG_INFO, "master proc is waiting for an element to dequeue from any of %u queues\n", group->count );
+         pthread_cond_wait( &group->ready, &group->glock );
+      }
+      pthread_mutex_unlock( &group->glock );
+   }
+}
+
+
+/**
+ * Removes all queues from the given TQ_Group and frees it
+ * @param TQ_Group group : Group to be terminated
+ * @return int : Zero on success, or -1 on failure
+ */
+int tq_group_term( TQ_Group group ) {
+   if ( group == NULL ) {
+      LOG( LOG_ERR, "Received a NULL group\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   int retval = 0;
+   unsigned int qindex;
+   for ( qindex = 0; qindex < group->count; qindex++ ) {
+      ThreadQueue tq = group->queues[qindex];
+      if ( pthread_mutex_lock( &tq->qlock ) ) {
+         LOG( LOG_ERR, "%s failed to acquire queue lock to leave group!\n", tq->log_prefix );
+         tq->group = NULL; // no choice but to proceed without the lock
+         retval = -1;
+         continue;
+      }
+      tq->group = NULL;
+      pthread_mutex_unlock( &tq->qlock );
+   }
+   pthread_cond_destroy( &group->ready );
+   pthread_mutex_destroy( &group->glock );
+   free( group->queues );
+   free( group );
+   return retval;
+}
+
+
 /**
  * Determine the current depth (number of enqueued elements) of the given ThreadQueue
  * @param ThreadQueue tq : ThreadQueue for which to determine depth
@@ -942,7 +1824,7 @@ int tq_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff )
  */
 int tq_depth( ThreadQueue tq ) {
    if ( pthread_mutex_lock( &tq->qlock ) ) { return -1; }
-   int depth = tq->qdepth;
+   int depth = TQ_DEPTH( tq );
    pthread_mutex_unlock( &tq->qlock );
    return depth;
 }
@@ -961,12 +1843,14 @@ int tq_set_flags( ThreadQueue tq, TQ_Control_Flags flags ) {
       return -1;
    }
    // set the requested flags
-   tq->con_flags |= flags;
+   TQ_SET_FLAGS( tq, flags );
    LOG( LOG_INFO, "%s master set flag values: %d\n", tq->log_prefix, (int)flags );
    // wake all threads
    pthread_cond_broadcast( &tq->producer_resume );
    pthread_cond_broadcast( &tq->consumer_resume );
    pthread_cond_broadcast( &tq->state_resume );
+   tq_pool_notify( tq );
+   tq_group_notify( tq );
    // release the lock
    pthread_mutex_unlock( &tq->qlock );
    return 0;
@@ -987,12 +1871,14 @@ int tq_unset_flags( ThreadQueue tq, TQ_Control_Flags flags ) {
       return -1;
    }
    // unset the requested flags
-   tq->con_flags &= ~(flags);
+   TQ_UNSET_FLAGS( tq, flags );
    LOG( LOG_INFO, "%s master removed flag values: %d\n", tq->log_prefix, flags );
    // wake all threads
    pthread_cond_broadcast( &tq->producer_resume );
    pthread_cond_broadcast( &tq->consumer_resume );
    pthread_cond_broadcast( &tq->state_resume );
+   tq_pool_notify( tq );
+   tq_group_notify( tq );
    // release the lock
    pthread_mutex_unlock( &tq->qlock );
    return 0;
@@ -1143,7 +2029,7 @@ int tq_next_thread_status( ThreadQueue tq, void** tstate ) {
       return -1;
    }
    // make sure the queue is not HALTED with queue elements remaining
-   if ( (tq->con_flags & TQ_HALT)  &&  (tq->qdepth > 0) ) {
+   if ( (tq->con_flags & TQ_HALT)  &&  (TQ_DEPTH( tq ) > 0) ) {
       LOG( LOG_ERR, "%s cannont retrieve thread states from a HALTED and non-empty queue!\n", tq->log_prefix );
       errno = EINVAL;
       pthread_mutex_unlock( &tq->qlock );
@@ -1155,6 +2041,19 @@ int tq_next_thread_status( ThreadQueue tq, void** tstate ) {
       if ( tq->prod_pool != NULL ) { tID += tq->prod_pool->num_thrds; }
       if ( tq->cons_pool != NULL ) { tID += tq->cons_pool->num_thrds; }
       tID -= tq->uncoll_thrds; // get thread states in the order they were started
+      if ( tq->pool != NULL ) {
+         // a pooled thread has nothing to join, so just wait for it to complete its termination
+         while ( tq->pstage != TQ_STAGE_DONE ) {
+            LOG( LOG_INFO, "%s master waiting for pooled thread to terminate\n", tq->log_prefix );
+            pthread_cond_wait( &tq->state_resume, &tq->qlock );
+         }
+         if ( tstate != NULL ) { *tstate = tq->pstate; }
+         tq->pstate = NULL;
+         tq->uncoll_thrds--;
+         LOG( LOG_INFO, "%s master collected pooled thread state\n", tq->log_prefix );
+         pthread_mutex_unlock( &tq->qlock );
+         return tcnt;
+      }
       // make sure the thread is ready to join (not still trying to process work)
       while ( ( tq->state_flags[ tID ] & TQ_READY ) != 0 ) {
          LOG( LOG_INFO, "%s master waiting for thread %u to terminate\n", tq->log_prefix, tID );
@@ -1202,15 +2101,23 @@ int tq_close( ThreadQueue tq ) {
       pthread_mutex_unlock( &tq->qlock );
       return -1;
    }
-   if ( tq->qdepth != 0 ) {
+   if ( TQ_DEPTH( tq ) != 0 ) {
       LOG( LOG_ERR, "%s cannont close a queue with elements still remaining!\n", tq->log_prefix );
       errno = EINVAL;
-      int depth = tq->qdepth;
+      int depth = TQ_DEPTH( tq );
       pthread_mutex_unlock( &tq->qlock );
       return depth;
    }
+   if ( tq->group != NULL ) {
+      LOG( LOG_ERR, "%s cannont close a queue which still belongs to a group!\n", tq->log_prefix );
+      errno = EBUSY;
+      pthread_mutex_unlock( &tq->qlock );
+      return -1;
+   }
 
    pthread_mutex_unlock( &tq->qlock );
+   // make sure no pool worker can still reference this queue
+   if ( tq->pool != NULL ) { pool_detach( tq ); }
    // free everything and terminate
    tq_free_all(tq);
    //pthread_exit(NULL);
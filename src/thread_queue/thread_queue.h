@@ -72,6 +72,8 @@ IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
 OF SUCH DAMAGE.
 */
 
+#include <time.h>
+
 
 typedef enum {
    TQ_NONE     = 0,  // filler value, used to indicate no flags at all
@@ -84,6 +86,9 @@ typedef enum {
 } TQ_Control_Flags;
 
 
+typedef struct thread_queue_pool_struct* TQ_Pool; // forward decl.
+
+
 typedef struct queue_init_struct {
    // Queue Info
    char*       log_prefix;  /* string prefix for all log messages produced by this queue */
@@ -94,6 +99,12 @@ typedef struct queue_init_struct {
    void*        global_state;     /* reference to some global initial state, passed to the init_thread state func of all threads */
    unsigned int num_threads;      /* number of threads to initialize */
    unsigned int num_prod_threads; /* number of threads to utilize the thread_producer_func() (those with tID < num_prod_threads) */
+   TQ_Pool      pool;             /* shared pool of workers to run the thread of this queue, rather than a dedicated pthread 
+                                     ( NULL for dedicated threads; pooled queues are limited to a single thread ) */
+   char         spsc;             /* single producer / single consumer queue, limited to a single thread, with any master 
+                                     procs on the other side ( concurrent master calls must be serialized by the caller ).  
+                                     The master then enqueues / dequeues without taking the queue lock, where possible. 
+                                     Ignored for pooled queues. */
 
    /* Please note, the following functions may be run by multiple threads in parallel.
          Beware of placing shared values in the 'state' arguments. */
@@ -185,6 +196,37 @@ typedef struct queue_init_struct {
 
 
 typedef struct thread_queue_struct* ThreadQueue; // forward decl.
+typedef struct thread_queue_group_struct* TQ_Group; // forward decl.
+
+
+/**
+ * Initializes a new pool of worker threads, which may be shared between any number of ThreadQueues ( see the 
+ *  'pool' value of TQ_Init_Opts ).  Each worker repeatedly selects a queue with work available and runs a single 
+ *  iteration of that queue's thread ( a single work package, pause, resume, etc. ).  As a result, a pooled 
+ *  producer_func() should return zero with a NULL work package, rather than block, if it cannot make progress 
+ *  ( the queue will then be retried once tq_notify() is called for it, or, failing that, polled again shortly ).
+ * @param unsigned int num_threads : Number of worker threads to start
+ * @param const char* log_prefix : String prefix for all log messages produced by the pool ( may be NULL )
+ * @return TQ_Pool : Reference to the new pool, or NULL if an error was encountered
+ */
+TQ_Pool tq_pool_init( unsigned int num_threads, const char* log_prefix );
+
+
+/**
+ * Terminates all worker threads of the given TQ_Pool and frees it
+ * @param TQ_Pool pool : Pool to be terminated
+ * @return int : Zero on success, or -1 on failure ( errno == EBUSY, if any ThreadQueues still reference the pool )
+ */
+int tq_pool_term( TQ_Pool pool );
+
+
+/**
+ * Notify a ThreadQueue that some condition outside of the queue itself has changed, such that a pooled thread 
+ *  which previously yielded without progress may now proceed ( no-op for queues with dedicated threads )
+ * @param ThreadQueue tq : ThreadQueue to be notified
+ * @return int : Zero on success and non-zero on failure
+ */
+int tq_notify( ThreadQueue tq );
 
 
 /**
@@ -233,6 +275,60 @@ int tq_enqueue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void* workbuff );
 int tq_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff );
 
 
+/**
+ * Retrieve a new element of work from the ThreadQueue, giving up if none is available by the specified time.
+ *  Aside from the timeout, this behaves identically to tq_dequeue().
+ * @param ThreadQueue tq : ThreadQueue from which to retrieve work
+ * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
+ *                                        (By default, only a TQ_FINISHED state will not result in a failure)
+ * @param void** workbuff : Reference to be populated with the work element pointer
+ * @param const struct timespec* abstime : Absolute ( CLOCK_MONOTONIC ) time at which to give up
+ * @return int : The depth of the queue (including the retrieved element) on success,
+ *               Zero if the queue is both empty and has ANY control flags set (deadlock protection),
+ *               and -1 on failure (errno == ETIMEDOUT, if no element arrived in time)
+ */
+int tq_timed_dequeue( ThreadQueue tq, TQ_Control_Flags ignore_flags, void** workbuff, const struct timespec* abstime );
+
+
+/**
+ * Initializes a new group of ThreadQueues, allowing a master proc to retrieve work from whichever member 
+ *  queue first has some available ( see tq_dequeue_any() ).
+ *  NOTE -- a ThreadQueue may only belong to a single group at a time, and the group must be terminated 
+ *          before any of its member queues are closed.
+ * @param ThreadQueue* queues : Array of queues to be included in the group
+ * @param unsigned int count : Number of queues in the array
+ * @return TQ_Group : Reference to the new group, or NULL if an error was encountered 
+ *                    ( errno == EBUSY, if a queue already belongs to another group )
+ */
+TQ_Group tq_group_init( ThreadQueue* queues, unsigned int count );
+
+
+/**
+ * Retrieve a new element of work from whichever selected queue of the TQ_Group first has one available.
+ *  Note that this call will block only while ALL selected queues would cause tq_dequeue() to block.  
+ *  Otherwise, the first such queue is dequeued from exactly as tq_dequeue() would be.
+ *  NOTE -- concurrent calls on the same group must be serialized by the caller.
+ * @param TQ_Group group : TQ_Group from which to retrieve work
+ * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
+ *                                        (By default, only a TQ_FINISHED state will not result in a failure)
+ * @param const char* select : Array ( of length equal to the group size ) indicating which queues to consider, 
+ *                             by non-zero values, or NULL to consider all queues of the group
+ * @param void** workbuff : Reference to be populated with the work element pointer
+ * @param unsigned int* index : Reference to be populated with the group index of the queue dequeued from
+ * @return int : The result of tq_dequeue() for the queue at the populated index,
+ *               or -1 with errno == EINVAL, if no queues were selected
+ */
+int tq_dequeue_any( TQ_Group group, TQ_Control_Flags ignore_flags, const char* select, void** workbuff, unsigned int* index );
+
+
+/**
+ * Removes all queues from the given TQ_Group and frees it
+ * @param TQ_Group group : Group to be terminated
+ * @return int : Zero on success, or -1 on failure
+ */
+int tq_group_term( TQ_Group group );
+
+
 /**
  * Determine the current depth (number of enqueued elements) of the given ThreadQueue
  * @param ThreadQueue tq : ThreadQueue for which to determine depth